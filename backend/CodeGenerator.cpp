@@ -2,8 +2,8 @@
 /// @file CodeGenerator.cpp
 /// @brief 代码生成器共同类的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>输出改为大缓冲区写入
 /// </table>
 ///
 #include <cstdio>
@@ -29,27 +30,17 @@ CodeGenerator::CodeGenerator(Module * _module) : module(_module)
 /// @return true：成功，false：失败
 bool CodeGenerator::run(std::string outFileName)
 {
-    // 打开文件，也可以以C++的方式打开文件进行操作
-    // 这里主要便于C语言学习的学生
-    if (!outFileName.empty()) {
-        // 指定文件非空时，则创建文件
-        fp = fopen(outFileName.c_str(), "w");
-        if (nullptr == fp) {
-            printf("open file(%s) failed", outFileName.c_str());
-            return false;
-        }
-    } else {
-        fp = nullptr;
+    // 指定文件非空时创建文件，否则输出到标准输出
+    if (!out.open(outFileName)) {
+        printf("open file(%s) failed", outFileName.c_str());
+        return false;
     }
 
     // 执行真正的代码
     const bool result = run();
 
-    // 关闭文件
-    if (fp) {
-        fclose(fp);
-        fp = nullptr;
-    }
+    // 关闭文件，写入失败时也返回失败
+    const bool written = out.close();
 
-    return result;
+    return result && written;
 }
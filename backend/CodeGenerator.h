@@ -2,8 +2,8 @@
 /// @file CodeGenerator.h
 /// @brief 代码生成器共同类的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.6
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,14 +11,22 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加并行线程数设置
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>增加以函数为单位的编译缓存
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>输出改为大缓冲区写入
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>支持各阶段的耗时统计
+/// <tr><td>2026-10-18 <td>1.5     <td>zenglj  <td>增加生成代码的静态估计设置
+/// <tr><td>2026-10-18 <td>1.6     <td>zenglj  <td>增加寄存器分配方法的设置
 /// </table>
 ///
 #pragma once
 
-#include <cstdio>
 #include <string>
 
+#include "BufferedWriter.h"
+#include "CompileCache.h"
 #include "Module.h"
+#include "TimeReport.h"
 
 /// @brief 代码生成的一般类
 class CodeGenerator {
@@ -45,9 +53,57 @@ public:
         this->showLinearIR = show;
     }
 
+    ///
+    /// @brief 设置以函数为单位并行生成代码的线程数
+    /// @param num 线程数，1为不并行，小于等于0时取CPU的硬件线程数
+    ///
+    void setJobs(int num)
+    {
+        this->jobs = num;
+    }
+
+    ///
+    /// @brief 设置以函数为单位的编译缓存，函数的IR不变时直接使用缓存的汇编代码
+    /// @param cache 编译缓存，空指针时不使用
+    /// @param salt 编译器版本与影响代码生成的选项等，参与缓存键值的计算
+    ///
+    void setCache(const CompileCache * cache, const std::string & salt)
+    {
+        this->cache = cache;
+        this->cacheSalt = salt;
+    }
+
+    ///
+    /// @brief 设置各阶段的耗时报告
+    /// @param report 耗时报告，空指针时不统计
+    ///
+    void setTimeReport(TimeReport * report)
+    {
+        this->timeReport = report;
+    }
+
+    ///
+    /// @brief 设置生成代码的周期数、代码大小等静态估计的输出，目前只有ARM32支持
+    /// @param comment 是否以注释的形式输出到各函数的汇编代码之后
+    /// @param jsonFile 以JSON格式输出到的文件，为空时不输出
+    ///
+    void setEstimate(bool comment, const std::string & jsonFile)
+    {
+        this->estimateComment = comment;
+        this->estimateJSON = jsonFile;
+    }
+
+    ///
+    /// @brief 设置是否使用图着色的寄存器分配，目前只有ARM32支持
+    /// @param enable true：图着色，false：朴素的寄存器分配
+    ///
+    void setGraphColoring(bool enable)
+    {
+        this->graphColoring = enable;
+    }
+
 protected:
-    /// @brief 代码产生器运行，结果保存到指定的文件中
-    /// @param fp 输出内容所在文件的指针
+    /// @brief 代码产生器运行，结果输出到out中
     /// @return true：成功，false：失败
     virtual bool run() = 0;
 
@@ -56,11 +112,46 @@ protected:
     ///
     Module * module;
 
-    /// @brief 输出文件指针
-    FILE * fp = nullptr;
+    /// @brief 输出文件
+    BufferedWriter out;
 
     ///
     /// @brief 显示IR指令内容
     ///
     bool showLinearIR = false;
+
+    ///
+    /// @brief 并行生成代码的线程数
+    ///
+    int jobs = 1;
+
+    ///
+    /// @brief 以函数为单位的编译缓存，空指针时不使用
+    ///
+    const CompileCache * cache = nullptr;
+
+    ///
+    /// @brief 参与函数缓存键值计算的编译器版本与选项等
+    ///
+    std::string cacheSalt;
+
+    ///
+    /// @brief 各阶段的耗时报告，空指针时不统计
+    ///
+    TimeReport * timeReport = nullptr;
+
+    ///
+    /// @brief 静态估计是否以注释的形式输出到汇编代码中
+    ///
+    bool estimateComment = false;
+
+    ///
+    /// @brief 静态估计以JSON格式输出到的文件，为空时不输出
+    ///
+    std::string estimateJSON;
+
+    ///
+    /// @brief 是否使用图着色的寄存器分配
+    ///
+    bool graphColoring = false;
 };
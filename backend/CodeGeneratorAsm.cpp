@@ -2,8 +2,8 @@
 /// @file CodeGeneratorAsm.cpp
 /// @brief 后端汇编代码生成器接口的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.5
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,32 +11,197 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>函数的指令选择与输出并行化
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>以函数为单位缓存汇编代码
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>函数体按需加载
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>各函数的汇编代码一次writev写入
+/// <tr><td>2026-10-18 <td>1.5     <td>zenglj  <td>统计寄存器分配、指令选择与汇编输出的耗时
 /// </table>
 ///
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "CodeGenerator.h"
+#include "Common.h"
 #include "CodeGeneratorAsm.h"
+#include "IRConstant.h"
+#include "Instruction.h"
 #include "Module.h"
 #include "Function.h"
+#include "GlobalVariable.h"
+#include "ThreadPool.h"
 
 /// @brief 构造函数
 CodeGeneratorAsm::CodeGeneratorAsm(Module * _module) : CodeGenerator(_module)
 {}
 
+///
+/// @brief 把汇编代码中的Label编号整体平移，Label形如.L5，函数名等标识符中不会出现.
+/// @param text 汇编代码
+/// @param delta 编号的增量
+/// @return std::string 平移后的汇编代码
+///
+static std::string rebaseLabels(std::string_view text, int64_t delta)
+{
+    std::string result;
+    result.reserve(text.size());
+
+    const std::string_view prefix = IR_LABEL_PREFIX;
+
+    size_t pos = 0;
+    for (;;) {
+
+        size_t found = text.find(prefix, pos);
+        if (found == std::string_view::npos) {
+            break;
+        }
+
+        size_t numBegin = found + prefix.size();
+        size_t numEnd = numBegin;
+        while ((numEnd < text.size()) && isDigital(text[numEnd])) {
+            numEnd++;
+        }
+
+        bool isLabel = (numEnd > numBegin) && ((found == 0) || !isLetterDigitalUnderLine(text[found - 1])) &&
+                       ((numEnd == text.size()) || !isLetterDigitalUnderLine(text[numEnd]));
+
+        if (isLabel) {
+            int64_t index = std::strtoll(std::string(text.substr(numBegin, numEnd - numBegin)).c_str(), nullptr, 10);
+            result.append(text.substr(pos, numBegin - pos));
+            result += std::to_string(index + delta);
+        } else {
+            result.append(text.substr(pos, numEnd - pos));
+        }
+
+        pos = numEnd;
+    }
+
+    result.append(text.substr(pos));
+
+    return result;
+}
+
+///
+/// @brief 计算函数的缓存键值。函数的IR文本以及引用的全局变量的定义相同时，生成的汇编代码也相同
+/// @param func 函数，必须在寄存器分配之前计算
+/// @return std::string 键值
+///
+std::string CodeGeneratorAsm::functionCacheKey(Function * func)
+{
+    // 未命名的Value在IR文本中无法区分，这里的命名与IR输出时相同
+    func->renameIR();
+
+    std::string irText;
+    func->toString(irText);
+
+    CacheKey key;
+    key.add("func").add(cacheSalt).add(irText);
+
+    for (auto inst: func->getInterCode().getInsts()) {
+        for (auto operand: inst->getOperandsValue()) {
+            Instanceof(var, GlobalVariable *, operand);
+            if (var) {
+                std::string declare;
+                var->toDeclareString(declare);
+                key.add(declare);
+            }
+        }
+    }
+
+    return key.digest();
+}
+
 /// @brief .text代码段，主要存放CPU指令，以函数为单位
-void CodeGeneratorAsm::genCodeSection()
+/// @return true:成功，false:函数体加载失败
+bool CodeGeneratorAsm::genCodeSection()
 {
     // 重新设置为0
     labelIndex = 0;
 
-    // 遍历所有的函数，以函数为单位，产生指令
+    std::vector<Function *> funcs;
+
+    // 各函数的汇编代码
+    std::vector<std::string> texts;
+
+    // 需要生成并存入缓存的函数的键值，命中缓存或者不使用缓存时为空
+    std::vector<std::string> keys;
+
+    // 各函数第一个Label的编号
+    std::vector<int64_t> labelBases;
+
+    // 寄存器分配前的调整会修改常量、物理寄存器等共享Value的使用关系，必须串行进行。
+    // Label按函数的先后次序编号，每个函数占用连续的一段，与串行生成的结果完全相同
     for (auto func: module->getFunctionList()) {
 
         if (!func->isBuiltin()) {
 
-            // 针对func产生汇编指令
-            genCodeSection(func);
+            // 从二进制IR加载的模块，函数体在这里才创建
+            if (!module->materialize(func)) {
+                return false;
+            }
+
+            std::string key, text;
+            bool hit = false;
+
+            // 缓存项的第一行是生成时第一个Label的编号，命中时据此平移Label编号
+            if (cache) {
+                key = functionCacheKey(func);
+
+                std::string entry;
+                size_t lineEnd;
+                if (cache->load(key, entry) && ((lineEnd = entry.find('\n')) != std::string::npos)) {
+                    int64_t oldBase = std::strtoll(entry.c_str(), nullptr, 10);
+                    text = rebaseLabels(std::string_view(entry).substr(lineEnd + 1), labelIndex - oldBase);
+                    key.clear();
+                    hit = true;
+                }
+            }
+
+            // 命中缓存时不需要寄存器分配，汇编代码已经有了
+            if (!hit) {
+                // 寄存器分配以及栈内局部变量的站内地址重新分配
+                const std::string name = func->getName();
+                TimeReport::Scope timer(timeReport, "regalloc", TimeReport::CPU_THREAD, &name);
+                registerAllocation(func);
+            }
+
+            labelBases.push_back(labelIndex);
+
+            // 汇编指令输出前要确保Label的名字有效，必须是程序级别的唯一，而不是函数内的唯一。要全局编号。
+            for (auto inst: func->getInterCode().getInsts()) {
+                if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+                    inst->setName(IR_LABEL_PREFIX + std::to_string(labelIndex++));
+                }
+            }
+
+            funcs.push_back(func);
+            texts.push_back(std::move(text));
+            keys.push_back(std::move(key));
         }
     }
+
+    // 各函数的指令选择与汇编文本生成互不依赖，并行进行
+    ThreadPool pool(jobs);
+    pool.parallelFor(funcs.size(), [&](size_t index) {
+        if (cache && keys[index].empty()) {
+            // 已从缓存中取得
+            return;
+        }
+
+        genCodeSection(funcs[index], texts[index]);
+
+        if (cache) {
+            (void) cache->store(keys[index], std::to_string(labelBases[index]) + "\n" + texts[index]);
+        }
+    });
+
+    // 按函数的先后次序输出，各函数的代码直接写入文件，不再复制
+    TimeReport::Scope timer(timeReport, "write");
+    out.writeBuffers(texts);
+
+    return true;
 }
 
 /// @brief 产生汇编文件
@@ -51,7 +216,5 @@ bool CodeGeneratorAsm::run()
     genDataSection();
 
     // 产生代码段，即CPU指令，以函数为单位
-    genCodeSection();
-
-    return true;
+    return genCodeSection();
 }
@@ -2,8 +2,8 @@
 /// @file CodeGeneratorAsm.h
 /// @brief 后端汇编代码生成器接口的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.5
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,8 +11,15 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>函数的指令选择与输出并行化
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>以函数为单位缓存汇编代码
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>函数体按需加载
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>各函数的汇编代码一次writev写入
+/// <tr><td>2026-10-18 <td>1.5     <td>zenglj  <td>增加头文件保护
 /// </table>
 ///
+#pragma once
+
 #include <cstdio>
 #include <cstring>
 
@@ -38,9 +45,11 @@ public:
     /// @brief 全局变量Section，主要包含初始化的和未初始化过的
     virtual void genDataSection() = 0;
 
-    /// @brief 针对函数进行汇编指令生成，放到.text代码段中
-    /// @param func 要处理的函数
-    virtual void genCodeSection(Function * func) = 0;
+    /// @brief 针对函数进行汇编指令生成，放到.text代码段中。
+    /// 多个函数可能在不同的线程中同时调用，只能修改本函数的内容
+    /// @param func 要处理的函数，已经完成寄存器分配与Label命名
+    /// @param text 函数的汇编代码追加到该字符串中
+    virtual void genCodeSection(Function * func, std::string & text) = 0;
 
     /// @brief 寄存器分配
     /// @param func 要处理的函数
@@ -52,7 +61,13 @@ protected:
     bool run() override;
 
     /// @brief 汇编指令生成，放到.text代码段中
-    void genCodeSection();
+    /// @return true:成功，false:函数体加载失败
+    bool genCodeSection();
+
+    /// @brief 计算函数的缓存键值，必须在寄存器分配之前计算
+    /// @param func 要处理的函数
+    /// @return std::string 键值
+    std::string functionCacheKey(Function * func);
 
     ///
     /// @brief Label索引编号，要求文件级别的编号，而不是函数级别的编号
@@ -2,8 +2,8 @@
 /// @file CodeGeneratorArm32.cpp
 /// @brief ARM32的后端处理实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.6
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,12 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>函数的汇编代码输出到字符串，支持并行生成
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>输出不再使用fprintf
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>统计指令选择与汇编输出的耗时
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>有剖析数据时按函数热度放到不同的代码段
+/// <tr><td>2026-10-18 <td>1.5     <td>zenglj  <td>增加生成代码的周期数与代码大小的静态估计
+/// <tr><td>2026-10-18 <td>1.6     <td>zenglj  <td>增加图着色的寄存器分配
 /// </table>
 ///
 #include <cstdint>
@@ -21,6 +27,7 @@
 #include <iostream>
 
 #include "BinaryInstruction.h"
+#include "BufferedWriter.h"
 #include "ConstInt.h"
 #include "FormalParam.h"
 #include "Function.h"
@@ -40,6 +47,8 @@
 #include "MoveInstruction.h"
 #include "Type.h"
 #include "Common.h"
+#include "EstimatorArm32.h"
+#include "GraphColorRegisterAllocator.h"
 
 /// @brief 构造函数
 /// @param tab 符号表
@@ -50,21 +59,68 @@ CodeGeneratorArm32::CodeGeneratorArm32(Module * _module) : CodeGeneratorAsm(_mod
 CodeGeneratorArm32::~CodeGeneratorArm32()
 {}
 
+/// @brief 产生汇编文件，需要时输出静态估计的JSON文件
+/// @return true:成功，false:失败
+bool CodeGeneratorArm32::run()
+{
+    if (!CodeGeneratorAsm::run()) {
+        return false;
+    }
+
+    if (!estimateJSON.empty() && !writeEstimates()) {
+        minic_log(LOG_ERROR, "静态估计文件(%s)写入失败", estimateJSON.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 各函数的静态估计按函数的先后次序以JSON格式输出
+/// @return true：成功，false：文件写入失败
+///
+bool CodeGeneratorArm32::writeEstimates()
+{
+    std::string json = "{\n  \"functions\": [";
+
+    bool first = true;
+    for (auto func: module->getFunctionList()) {
+        auto iter = estimates.find(func);
+        if (iter == estimates.end()) {
+            continue;
+        }
+        json += first ? "\n    " : ",\n    ";
+        iter->second.toJSON(json);
+        first = false;
+    }
+
+    json += "\n  ]\n}\n";
+
+    FILE * fp = fopen(estimateJSON.c_str(), "w");
+    if (nullptr == fp) {
+        return false;
+    }
+
+    bool written = fwrite(json.data(), 1, json.size(), fp) == json.size();
+
+    return (fclose(fp) == 0) && written;
+}
+
 /// @brief 产生汇编头部分
 void CodeGeneratorArm32::genHeader()
 {
-    fprintf(fp, "%s\n", ".arch armv7ve");
-    fprintf(fp, "%s\n", ".arm");
-    fprintf(fp, "%s\n", ".fpu vfpv4");
+    out << ".arch armv7ve\n"
+        << ".arm\n"
+        << ".fpu vfpv4\n";
 }
 
 /// @brief 全局变量Section，主要包含初始化的和未初始化过的
 void CodeGeneratorArm32::genDataSection()
 {
     // 生成代码段
-    fprintf(fp, ".text\n");
+    out << ".text\n";
 
-    // 可直接操作文件指针fp进行写操作
+    // 通过out输出，不再直接操作文件
 
     // 目前不支持全局变量和静态变量，以及字符串常量
     // 全局变量分两种情况：初始化的全局变量和未初始化的全局变量
@@ -74,23 +130,25 @@ void CodeGeneratorArm32::genDataSection()
         if (var->isInBSSSection()) {
             if (var->getType()->isPointerType()) {
                 Instanceof(pointer, PointerType *, var->getType());
-                fprintf(fp, ".comm %s, %d, %d\n", var->getName().c_str(), pointer->getPointeeType()->getSize(), var->getAlignment());
+                out << ".comm " << var->getName() << ", " << pointer->getPointeeType()->getSize() << ", "
+                    << var->getAlignment() << '\n';
             } else {
                 // 在BSS段的全局变量，可以包含初值全是0的变量
-            fprintf(fp, ".comm %s, %d, %d\n", var->getName().c_str(), var->getType()->getSize(), var->getAlignment());
+                out << ".comm " << var->getName() << ", " << var->getType()->getSize() << ", " << var->getAlignment()
+                    << '\n';
 			}
         } else {
 
             // 有初值的全局变量
-            fprintf(fp, ".global %s\n", var->getName().c_str());
-            fprintf(fp, ".data\n");
-            fprintf(fp, ".align %d\n", var->getAlignment());
-            fprintf(fp, ".type %s, %%object\n", var->getName().c_str());
-            fprintf(fp, "%s:\n", var->getName().c_str());
+            out << ".global " << var->getName() << '\n';
+            out << ".data\n";
+            out << ".align " << var->getAlignment() << '\n';
+            out << ".type " << var->getName() << ", %object\n";
+            out << var->getName() << ":\n";
             // TODO 后面设置初始化的值，具体请参考ARM的汇编
             if (var->hasInitVal()) {
                 auto initVal = var->getInitVal();
-                fprintf(fp, ".word %d\n", initVal->getVal());
+                out << ".word " << initVal->getVal() << '\n';
 			}
         }
     }
@@ -130,37 +188,81 @@ void CodeGeneratorArm32::getIRValueStr(Value * val, std::string & str)
 
 /// @brief 针对函数进行汇编指令生成，放到.text代码段中
 /// @param func 要处理的函数
-void CodeGeneratorArm32::genCodeSection(Function * func)
+/// @param text 函数的汇编代码追加到该字符串中
+void CodeGeneratorArm32::genCodeSection(Function * func, std::string & text)
 {
-    // 寄存器分配以及栈内局部变量的站内地址重新分配
-    registerAllocation(func);
-
     // 获取函数的指令列表
     std::vector<Instruction *> & IrInsts = func->getInterCode().getInsts();
 
-    // 汇编指令输出前要确保Label的名字有效，必须是程序级别的唯一，而不是函数内的唯一。要全局编号。
-    for (auto inst: IrInsts) {
-        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
-            inst->setName(IR_LABEL_PREFIX + std::to_string(labelIndex++));
-        }
-    }
+    // 函数名，函数的耗时按名字统计
+    const std::string & name = func->getName();
 
     // ILOC代码序列
     ILocArm32 iloc(module);
 
-    // 指令选择生成汇编指令
-    InstSelectorArm32 instSelector(IrInsts, iloc, func, simpleRegisterAllocator);
-    instSelector.setShowLinearIR(this->showLinearIR);
-    instSelector.run();
+    {
+        TimeReport::Scope timer(timeReport, "isel", TimeReport::CPU_THREAD, &name);
+
+        // 简单的朴素寄存器分配方法，每个函数独立一个，以便并行
+        SimpleRegisterAllocator simpleRegisterAllocator;
+
+        // 指令选择生成汇编指令
+        InstSelectorArm32 instSelector(IrInsts, iloc, func, simpleRegisterAllocator);
+        instSelector.setShowLinearIR(this->showLinearIR);
+
+        // 图着色分配过寄存器时，临时寄存器只能用各指令处未被占用的
+        auto iter = reservedRegs.find(func);
+        if (iter != reservedRegs.end()) {
+            instSelector.setReservedRegs(&iter->second);
+        }
+        instSelector.run();
+
+        // 删除无用的Label指令
+        iloc.deleteUnusedLabel();
+    }
+
+    // 在最终的指令序列上静态估计周期数、代码大小等
+    bool estimate = estimateComment || !estimateJSON.empty();
+    ArmEstimate result;
+    if (estimate) {
+        TimeReport::Scope timer(timeReport, "estimate", TimeReport::CPU_THREAD, &name);
 
-    // 删除无用的Label指令
-    iloc.deleteUnusedLabel();
+        EstimatorArm32 estimator(iloc, func);
+        result = estimator.run();
+
+        if (!estimateJSON.empty()) {
+            std::lock_guard<std::mutex> lock(estimateLock);
+            estimates[func] = result;
+        }
+    }
+
+    TimeReport::Scope timer(timeReport, "emit", TimeReport::CPU_THREAD, &name);
+
+    // 有剖析数据时热函数与从未执行的函数分别放到.text.hot与.text.unlikely段，使热代码集中
+    switch (func->getHotness()) {
+        case FunctionHotness::HOT:
+            text += ".section .text.hot,\"ax\",%progbits\n";
+            break;
+        case FunctionHotness::COLD:
+            text += ".section .text.unlikely,\"ax\",%progbits\n";
+            break;
+        case FunctionHotness::NORMAL:
+            text += ".text\n";
+            break;
+        default:
+            break;
+    }
 
     // ILOC代码输出为汇编代码
-    fprintf(fp, ".align %d\n", func->getAlignment());
-    fprintf(fp, ".global %s\n", func->getName().c_str());
-    fprintf(fp, ".type %s, %%function\n", func->getName().c_str());
-    fprintf(fp, "%s:\n", func->getName().c_str());
+    text += ".align ";
+    appendInt(text, func->getAlignment());
+    text += "\n.global ";
+    text += name;
+    text += "\n.type ";
+    text += name;
+    text += ", %function\n";
+    text += name;
+    text += ":\n";
 
     // 开启时输出IR指令作为注释
     if (this->showLinearIR) {
@@ -170,7 +272,7 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
             std::string str;
             getIRValueStr(localVar, str);
             if (!str.empty()) {
-                fprintf(fp, "%s\n", str.c_str());
+                text += str + "\n";
             }
         }
 
@@ -180,13 +282,17 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
                 std::string str;
                 getIRValueStr(inst, str);
                 if (!str.empty()) {
-                    fprintf(fp, "%s\n", str.c_str());
+                    text += str + "\n";
                 }
             }
         }
     }
 
-    iloc.outPut(fp);
+    iloc.outPut(text);
+
+    if (estimateComment) {
+        result.toComment(text);
+    }
 }
 
 /// @brief 寄存器分配
@@ -226,6 +332,11 @@ void CodeGeneratorArm32::registerAllocation(Function * func)
     // 当然也可以不做处理，不过性能更差。这个处理是可选的。
     adjustFuncCallInsts(func);
 
+    // 图着色为临时变量与局部变量分配寄存器，实参、返回值与形参的传送尽量合并到r0-r3
+    if (graphColoring) {
+        graphColorAllocation(func);
+    }
+
     // 为局部变量和临时变量在栈内分配空间，指定偏移，进行栈空间的分配
     stackAlloc(func);
 
@@ -242,6 +353,30 @@ void CodeGeneratorArm32::registerAllocation(Function * func)
 #endif
 }
 
+///
+/// @brief 图着色的寄存器分配，用到的r4-r9加入需要保护的寄存器，冲突图过大时仍用朴素的分配
+/// @param func 要处理的函数
+///
+void CodeGeneratorArm32::graphColorAllocation(Function * func)
+{
+    GraphColorRegisterAllocator allocator(func);
+    if (!allocator.run()) {
+        minic_log(LOG_INFO, "函数%s的冲突图过大，改用朴素的寄存器分配", func->getName().c_str());
+        return;
+    }
+
+    // 需要保护的寄存器在前，push与pop按寄存器编号的次序进行
+    std::vector<int32_t> & protectedRegNo = func->getProtectedReg();
+    uint32_t mask = allocator.getCalleeSavedMask();
+    for (int32_t regno = ARM32_TMP_REG_NO - 1; regno >= 4; regno--) {
+        if (mask & (1u << regno)) {
+            protectedRegNo.insert(protectedRegNo.begin(), regno);
+        }
+    }
+
+    reservedRegs[func] = std::move(allocator.getReservedMasks());
+}
+
 /// @brief 调整函数形参
 /// @param func 要处理的函数
 void CodeGeneratorArm32::adjustFormalParamInsts(Function * func)
@@ -2,8 +2,8 @@
 /// @file CodeGeneratorArm32.h
 /// @brief ARM32的后端处理头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.3
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,10 +11,17 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>函数的汇编代码输出到字符串，支持并行生成
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>增加生成代码的周期数与代码大小的静态估计
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>增加图着色的寄存器分配
 /// </table>
 ///
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "CodeGeneratorAsm.h"
-#include "SimpleRegisterAllocator.h"
+#include "EstimatorArm32.h"
 
 class CodeGeneratorArm32 : public CodeGeneratorAsm {
 
@@ -27,6 +34,10 @@ public:
     ~CodeGeneratorArm32() override;
 
 protected:
+    /// @brief 产生汇编文件，需要时输出静态估计的JSON文件
+    /// @return true:成功，false:失败
+    bool run() override;
+
     /// @brief 产生汇编头部分
     void genHeader() override;
 
@@ -35,7 +46,8 @@ protected:
 
     /// @brief 针对函数进行汇编指令生成，放到.text代码段中
     /// @param func 要处理的函数
-    void genCodeSection(Function * func) override;
+    /// @param text 函数的汇编代码追加到该字符串中
+    void genCodeSection(Function * func, std::string & text) override;
 
     /// @brief 寄存器分配
     /// @param func 要处理的函数
@@ -53,15 +65,31 @@ protected:
     /// @param func 要处理的函数
     void adjustFormalParamInsts(Function * func);
 
+    ///
+    /// @brief 图着色的寄存器分配，用到的r4-r9加入需要保护的寄存器，冲突图过大时仍用朴素的分配
+    /// @param func 要处理的函数
+    ///
+    void graphColorAllocation(Function * func);
+
     ///
     /// @brief 获取IR变量相关信息字符串
     /// @param str
     ///
     void getIRValueStr(Value * val, std::string & str);
 
-private:
     ///
-    /// @brief 简单的朴素寄存器分配方法
+    /// @brief 各函数的静态估计按函数的先后次序以JSON格式输出
+    /// @return true：成功，false：文件写入失败
     ///
-    SimpleRegisterAllocator simpleRegisterAllocator;
+    bool writeEstimates();
+
+private:
+    /// @brief 各函数的静态估计，只在指定JSON文件时记录
+    std::unordered_map<Function *, ArmEstimate> estimates;
+
+    /// @brief 多个函数并行生成时互斥记录静态估计
+    std::mutex estimateLock;
+
+    /// @brief 图着色分配寄存器的函数在各条IR指令处被占用的寄存器，寄存器分配时串行写入，指令选择时只读
+    std::unordered_map<Function *, std::vector<uint32_t>> reservedRegs;
 };
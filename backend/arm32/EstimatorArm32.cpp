@@ -0,0 +1,728 @@
+///
+/// @file EstimatorArm32.cpp
+/// @brief ARM32指令序列的静态周期数与代码大小估计的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "BranchInstruction.h"
+#include "BufferedWriter.h"
+#include "EstimatorArm32.h"
+#include "PlatformArm32.h"
+
+/// @brief 条件标志在寄存器位图中的位置，排在16个通用寄存器之后
+#define ARM32_FLAGS_BIT 16
+
+/// @brief 各操作码的代价，大致按Cortex-A9这类顺序发射的处理器取值
+static const EstimatorArm32::OpCost costTable[(int) ArmOpcode::ARM_OP_MAX] = {
+    {1, 1},   // add
+    {1, 1},   // sub
+    {2, 4},   // mul
+    {20, 20}, // sdiv，除法器不流水
+    {1, 1},   // neg
+    {1, 1},   // mov
+    {1, 1},   // movw
+    {1, 1},   // movt
+    {1, 3},   // ldr
+    {1, 1},   // str
+    {1, 1},   // cmp
+    {2, 0},   // b，含取指重定向
+    {3, 1},   // bl，不含被调函数的执行
+    {3, 0},   // bx
+    {1, 1},   // push，每多一个寄存器多一个周期
+    {1, 3},   // pop，每多一个寄存器多一个周期
+    {0, 0},   // 标签
+    {0, 0},   // 注释
+    {0, 0},   // 占位
+};
+
+/// @brief 是否是会执行的指令，即不是标签、注释与占位，也没有被删除
+static bool isMachineInst(const ArmInst & arm)
+{
+    return !arm.dead && (arm.opcode != ArmOpcode::ARM_OP_LABEL) && (arm.opcode != ArmOpcode::ARM_OP_COMMENT) &&
+           (arm.opcode != ArmOpcode::ARM_OP_NOP);
+}
+
+/// @brief 操作数读取的寄存器位图
+static uint32_t operandRegs(const ArmOperand & opnd)
+{
+    switch (opnd.kind) {
+        case ArmOperandKind::ARM_OPND_REG:
+        case ArmOperandKind::ARM_OPND_MEM:
+            return 1u << opnd.reg;
+        case ArmOperandKind::ARM_OPND_MEM_REG:
+            return (1u << opnd.reg) | (1u << opnd.index);
+        case ArmOperandKind::ARM_OPND_REG_LIST:
+            return (uint32_t) opnd.value;
+        default:
+            return 0;
+    }
+}
+
+///
+/// @brief 获取指令读与写的寄存器位图，条件标志为第ARM32_FLAGS_BIT位
+/// @param arm 指令
+/// @param reads 读的寄存器
+/// @param writes 写的寄存器
+///
+static void regUses(const ArmInst & arm, uint32_t & reads, uint32_t & writes)
+{
+    reads = 0;
+    writes = 0;
+
+    switch (arm.opcode) {
+        case ArmOpcode::ARM_OP_STR:
+            // str r8,[fp,#-16]的结果操作数是源寄存器
+            reads = operandRegs(arm.result) | operandRegs(arm.arg1);
+            break;
+        case ArmOpcode::ARM_OP_CMP:
+            reads = operandRegs(arm.result) | operandRegs(arm.arg1);
+            writes = 1u << ARM32_FLAGS_BIT;
+            break;
+        case ArmOpcode::ARM_OP_MOVT:
+            // 只改写高16位
+            reads = operandRegs(arm.result);
+            writes = reads;
+            break;
+        case ArmOpcode::ARM_OP_B:
+            break;
+        case ArmOpcode::ARM_OP_BX:
+            reads = operandRegs(arm.result);
+            break;
+        case ArmOpcode::ARM_OP_BL:
+            // 实参在r0-r3中，返回后r0-r3与lr被改写
+            reads = 0xF;
+            writes = 0xF | (1u << ARM32_LX_REG_NO);
+            break;
+        case ArmOpcode::ARM_OP_PUSH:
+            reads = operandRegs(arm.result) | (1u << ARM32_SP_REG_NO);
+            writes = 1u << ARM32_SP_REG_NO;
+            break;
+        case ArmOpcode::ARM_OP_POP:
+            reads = 1u << ARM32_SP_REG_NO;
+            writes = operandRegs(arm.result) | (1u << ARM32_SP_REG_NO);
+            break;
+        default:
+            reads = operandRegs(arm.arg1) | operandRegs(arm.arg2);
+            writes = operandRegs(arm.result);
+            break;
+    }
+
+    if (arm.cond != ArmCond::ARM_COND_AL) {
+        reads |= 1u << ARM32_FLAGS_BIT;
+    }
+}
+
+/// @brief 追加保留一位小数的浮点数
+static void appendDouble(std::string & str, double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.1f", value);
+    str += buf;
+}
+
+///
+/// @brief 以汇编注释的形式输出
+/// @param str 追加到该字符串中
+///
+void ArmEstimate::toComment(std::string & str) const
+{
+    str += "\t@ estimate: cycles=";
+    appendDouble(str, cycles);
+    str += profiled ? " (profile, entries=" : " (static";
+    if (profiled) {
+        appendInt(str, entryCount);
+    }
+    str += ")\n\t@ estimate: insts=";
+    appendInt(str, instructions);
+    str += " bytes=";
+    appendInt(str, bytes);
+    str += " spills=";
+    appendInt(str, spills);
+    str += " reloads=";
+    appendInt(str, reloads);
+    str += " branches=";
+    appendInt(str, branches);
+    str += " calls=";
+    appendInt(str, calls);
+    str += "\n\t@ estimate: blocks=";
+    appendInt(str, blocks);
+    str += " loops=";
+    appendInt(str, loops);
+    str += " depth=";
+    appendInt(str, maxLoopDepth);
+    str += " dyn-insts=";
+    appendDouble(str, dynInstructions);
+    str += " dyn-spills=";
+    appendDouble(str, dynSpills);
+    str += " dyn-reloads=";
+    appendDouble(str, dynReloads);
+    str += " dyn-branches=";
+    appendDouble(str, dynBranches);
+    str += '\n';
+}
+
+///
+/// @brief 以JSON对象的形式输出
+/// @param str 追加到该字符串中
+///
+void ArmEstimate::toJSON(std::string & str) const
+{
+    // 函数名是标识符，不需要转义
+    str += "{\"function\": \"";
+    str += function;
+    str += "\", \"profiled\": ";
+    str += profiled ? "true" : "false";
+    str += ", \"entry_count\": ";
+    appendInt(str, entryCount);
+    str += ", \"blocks\": ";
+    appendInt(str, blocks);
+    str += ", \"loops\": ";
+    appendInt(str, loops);
+    str += ", \"max_loop_depth\": ";
+    appendInt(str, maxLoopDepth);
+    str += ", \"instructions\": ";
+    appendInt(str, instructions);
+    str += ", \"bytes\": ";
+    appendInt(str, bytes);
+    str += ", \"spills\": ";
+    appendInt(str, spills);
+    str += ", \"reloads\": ";
+    appendInt(str, reloads);
+    str += ", \"branches\": ";
+    appendInt(str, branches);
+    str += ", \"calls\": ";
+    appendInt(str, calls);
+    str += ", \"cycles\": ";
+    appendDouble(str, cycles);
+    str += ", \"dyn_instructions\": ";
+    appendDouble(str, dynInstructions);
+    str += ", \"dyn_spills\": ";
+    appendDouble(str, dynSpills);
+    str += ", \"dyn_reloads\": ";
+    appendDouble(str, dynReloads);
+    str += ", \"dyn_branches\": ";
+    appendDouble(str, dynBranches);
+    str += '}';
+}
+
+///
+/// @brief 构造函数
+/// @param _iloc 指令序列，必须是最终输出的序列
+/// @param _func 函数，其中的分支指令可能带有剖析数据
+///
+EstimatorArm32::EstimatorArm32(ILocArm32 & _iloc, Function * _func) : iloc(_iloc), func(_func)
+{}
+
+///
+/// @brief 获取操作码的代价
+/// @param opcode 操作码
+/// @return OpCost 代价
+///
+EstimatorArm32::OpCost EstimatorArm32::cost(ArmOpcode opcode)
+{
+    return costTable[(int) opcode];
+}
+
+///
+/// @brief 是否是栈帧内的加载或存储，即基址为fp或者sp
+/// @param arm 指令
+/// @return true：是，false：不是
+///
+bool EstimatorArm32::isStackAccess(const ArmInst & arm)
+{
+    if ((arm.opcode != ArmOpcode::ARM_OP_LDR) && (arm.opcode != ArmOpcode::ARM_OP_STR)) {
+        return false;
+    }
+
+    const ArmOperand & mem = arm.arg1;
+    if ((mem.kind != ArmOperandKind::ARM_OPND_MEM) && (mem.kind != ArmOperandKind::ARM_OPND_MEM_REG)) {
+        return false;
+    }
+
+    return (mem.reg == ARM32_FP_REG_NO) || (mem.reg == ARM32_SP_REG_NO);
+}
+
+///
+/// @brief 划分基本块，建立前驱与后继关系
+///
+void EstimatorArm32::buildBlocks()
+{
+    std::vector<ArmInst> & code = iloc.getCode();
+    const std::vector<std::string> & names = iloc.getNames();
+
+    // 标签的名字表编号-基本块
+    std::unordered_map<int32_t, int32_t> blockOfLabel;
+
+    // 当前所在的IR基本块，第一个标签之前的指令属于入口块
+    std::string irLabel;
+
+    // 上一条会执行的指令是否是跳转，是则下一条指令开始新的基本块
+    bool afterJump = true;
+
+    // 当前基本块是否已有会执行的指令，没有时紧随的标签并入该块
+    bool blockHasInst = false;
+
+    for (size_t k = 0; k < code.size(); k++) {
+
+        const ArmInst & arm = code[k];
+
+        if (arm.dead) {
+            continue;
+        }
+
+        if (arm.isLabel()) {
+            irLabel = names[arm.result.value];
+
+            // 连续的标签属于同一个基本块
+            if (blocks.empty() || blockHasInst) {
+                blocks.emplace_back();
+                blocks.back().begin = k;
+            }
+            blocks.back().irLabel = irLabel;
+            blockOfLabel[arm.result.value] = (int32_t) blocks.size() - 1;
+            blocks.back().end = k + 1;
+            afterJump = false;
+            blockHasInst = false;
+            continue;
+        }
+
+        if (!isMachineInst(arm)) {
+            if (!blocks.empty()) {
+                blocks.back().end = k + 1;
+            }
+            continue;
+        }
+
+        if (afterJump) {
+            blocks.emplace_back();
+            blocks.back().begin = k;
+            blocks.back().irLabel = irLabel;
+        }
+
+        blocks.back().end = k + 1;
+        blockHasInst = true;
+
+        afterJump = (arm.opcode == ArmOpcode::ARM_OP_B) || (arm.opcode == ArmOpcode::ARM_OP_BX);
+    }
+
+    // 后继：按每块最后一条会执行的指令确定
+    for (size_t b = 0; b < blocks.size(); b++) {
+
+        Block & block = blocks[b];
+        const ArmInst * last = nullptr;
+        for (size_t k = block.end; k > block.begin; k--) {
+            if (isMachineInst(code[k - 1])) {
+                last = &code[k - 1];
+                break;
+            }
+        }
+
+        const bool hasNext = (b + 1) < blocks.size();
+
+        if (last && last->isBranch()) {
+            auto iter = blockOfLabel.find(last->result.value);
+            if (iter != blockOfLabel.end()) {
+                block.succs.push_back(iter->second);
+            }
+            if ((last->cond != ArmCond::ARM_COND_AL) && hasNext) {
+                block.succs.push_back((int32_t) b + 1);
+                block.condBranch = block.succs.size() == 2;
+            }
+        } else if (last && (last->opcode == ArmOpcode::ARM_OP_BX)) {
+            // 函数返回
+        } else if (hasNext) {
+            block.succs.push_back((int32_t) b + 1);
+        }
+    }
+
+    for (size_t b = 0; b < blocks.size(); b++) {
+        for (int32_t succ: blocks[b].succs) {
+            std::vector<int32_t> & preds = blocks[succ].preds;
+            if (std::find(preds.begin(), preds.end(), (int32_t) b) == preds.end()) {
+                preds.push_back((int32_t) b);
+            }
+        }
+    }
+
+    // 逆后序，非递归的深度优先遍历
+    if (blocks.empty()) {
+        return;
+    }
+
+    std::vector<bool> visited(blocks.size(), false);
+    std::vector<std::pair<int32_t, size_t>> stack;
+    stack.emplace_back(0, 0);
+    visited[0] = true;
+
+    while (!stack.empty()) {
+        auto & top = stack.back();
+        const Block & block = blocks[top.first];
+        if (top.second < block.succs.size()) {
+            int32_t succ = block.succs[top.second++];
+            if (!visited[succ]) {
+                visited[succ] = true;
+                stack.emplace_back(succ, 0);
+            }
+        } else {
+            rpo.push_back(top.first);
+            stack.pop_back();
+        }
+    }
+
+    std::reverse(rpo.begin(), rpo.end());
+}
+
+///
+/// @brief 由支配关系找出回边与自然循环，计算各基本块的循环嵌套深度
+///
+void EstimatorArm32::computeLoops()
+{
+    if (rpo.empty()) {
+        return;
+    }
+
+    // 逆后序中的位置，不可达的块为-1
+    std::vector<int32_t> order(blocks.size(), -1);
+    for (size_t k = 0; k < rpo.size(); k++) {
+        order[rpo[k]] = (int32_t) k;
+    }
+
+    // Cooper-Harvey-Kennedy的迭代算法求直接支配者
+    std::vector<int32_t> idom(blocks.size(), -1);
+    idom[rpo[0]] = rpo[0];
+
+    auto intersect = [&](int32_t a, int32_t b) {
+        while (a != b) {
+            while (order[a] > order[b]) {
+                a = idom[a];
+            }
+            while (order[b] > order[a]) {
+                b = idom[b];
+            }
+        }
+        return a;
+    };
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t k = 1; k < rpo.size(); k++) {
+            int32_t b = rpo[k];
+            int32_t newIdom = -1;
+            for (int32_t pred: blocks[b].preds) {
+                if (idom[pred] == -1) {
+                    continue;
+                }
+                newIdom = (newIdom == -1) ? pred : intersect(pred, newIdom);
+            }
+            if (idom[b] != newIdom) {
+                idom[b] = newIdom;
+                changed = true;
+            }
+        }
+    }
+
+    auto dominates = [&](int32_t a, int32_t b) {
+        while (b != a) {
+            if (b == rpo[0]) {
+                return false;
+            }
+            b = idom[b];
+        }
+        return true;
+    };
+
+    // 同一循环头的回边合并成一个循环，循环体由回边的源逆向搜索到循环头为止
+    for (int32_t header: rpo) {
+
+        std::vector<int32_t> work;
+        for (int32_t pred: blocks[header].preds) {
+            if ((order[pred] != -1) && dominates(header, pred)) {
+                work.push_back(pred);
+            }
+        }
+
+        if (work.empty()) {
+            continue;
+        }
+
+        loopCount++;
+
+        std::vector<bool> inLoop(blocks.size(), false);
+        inLoop[header] = true;
+        blocks[header].loopDepth++;
+
+        while (!work.empty()) {
+            int32_t b = work.back();
+            work.pop_back();
+            if (inLoop[b]) {
+                continue;
+            }
+            inLoop[b] = true;
+            blocks[b].loopDepth++;
+            for (int32_t pred: blocks[b].preds) {
+                if ((order[pred] != -1) && !inLoop[pred]) {
+                    work.push_back(pred);
+                }
+            }
+        }
+    }
+}
+
+///
+/// @brief 由剖析数据计算各基本块的执行次数
+/// @return true：成功，false：函数没有剖析数据
+///
+bool EstimatorArm32::computeProfileFrequency()
+{
+    if ((func->getHotness() == FunctionHotness::UNKNOWN) || (func->getEntryCount() == 0)) {
+        return false;
+    }
+
+    // IR基本块的标签名-结尾的分支指令
+    std::unordered_map<std::string, BranchInstruction *> branchOfBlock;
+    std::string irLabel;
+    for (auto inst: func->getInterCode().getInsts()) {
+        if (inst->isDead()) {
+            continue;
+        }
+        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            irLabel = inst->getName();
+        } else if (inst->getOp() == IRInstOperator::IRINST_OP_BRANCH) {
+            auto branch = static_cast<BranchInstruction *>(inst);
+            if (branch->hasProfile()) {
+                branchOfBlock[irLabel] = branch;
+            }
+        }
+    }
+
+    const std::vector<ArmInst> & code = iloc.getCode();
+    const std::vector<std::string> & names = iloc.getNames();
+
+    // 条件跳转到目标与顺序执行的次数，由分支指令的跳转次数得到，为负时没有剖析数据
+    std::vector<double> takenCounts(blocks.size(), -1), fallCounts(blocks.size(), -1);
+    for (int32_t b: rpo) {
+
+        const Block & block = blocks[b];
+        if (!block.condBranch) {
+            continue;
+        }
+
+        auto iter = branchOfBlock.find(block.irLabel);
+        if (iter == branchOfBlock.end()) {
+            continue;
+        }
+
+        BranchInstruction * branch = iter->second;
+        uint64_t total = branch->getTrueCount() + branch->getFalseCount();
+
+        // 条件跳转的目标可能是真目标，也可能是条件取反后的假目标
+        const ArmInst * last = nullptr;
+        for (size_t k = block.end; k > block.begin; k--) {
+            if (isMachineInst(code[k - 1])) {
+                last = &code[k - 1];
+                break;
+            }
+        }
+
+        const std::string & target = names[last->result.value];
+        uint64_t taken = (target == branch->getTarget1()->getName()) ? branch->getTrueCount() : branch->getFalseCount();
+        takenCounts[b] = (double) taken;
+        fallCounts[b] = (double) (total - taken);
+    }
+
+    auto edgeCount = [&](int32_t from, int32_t to, const std::vector<double> & counts) {
+        const Block & block = blocks[from];
+        double sum = 0;
+        for (size_t k = 0; k < block.succs.size(); k++) {
+            if (block.succs[k] != to) {
+                continue;
+            }
+            if (block.condBranch && (takenCounts[from] >= 0)) {
+                sum += (k == 0) ? takenCounts[from] : fallCounts[from];
+            } else if (block.condBranch) {
+                sum += counts[from] / 2;
+            } else {
+                sum += counts[from];
+            }
+        }
+        return sum;
+    };
+
+    // 条件跳转的边上是确定的次数，每个循环都至少含一条，按逆后序迭代一般两三遍即收敛
+    std::vector<double> counts(blocks.size(), 0);
+    const double entryCount = (double) func->getEntryCount();
+    const size_t maxPasses = blocks.size() + 2;
+
+    for (size_t pass = 0; pass < maxPasses; pass++) {
+        bool changed = false;
+        for (int32_t b: rpo) {
+            double count = (b == rpo[0]) ? entryCount : 0;
+            for (int32_t pred: blocks[b].preds) {
+                count += edgeCount(pred, b, counts);
+            }
+            if (std::fabs(count - counts[b]) > 1e-6 * std::max(1.0, count)) {
+                changed = true;
+            }
+            counts[b] = count;
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    // 折算为函数每进入一次的频度
+    for (int32_t b: rpo) {
+        blocks[b].freq = counts[b] / entryCount;
+    }
+
+    return true;
+}
+
+///
+/// @brief 计算各基本块的频度
+///
+void EstimatorArm32::computeFrequency()
+{
+    profiled = computeProfileFrequency();
+    if (profiled) {
+        return;
+    }
+
+    for (int32_t b: rpo) {
+        int32_t depth = std::min(blocks[b].loopDepth, MAX_WEIGHTED_DEPTH);
+        blocks[b].freq = std::pow(LOOP_WEIGHT, depth);
+    }
+}
+
+///
+/// @brief 估计一个基本块执行一次的周期数
+/// @param block 基本块
+/// @return int64_t 周期数
+///
+int64_t EstimatorArm32::blockCycles(const Block & block) const
+{
+    const std::vector<ArmInst> & code = iloc.getCode();
+
+    // 各寄存器与条件标志的结果就绪时刻
+    int64_t ready[ARM32_FLAGS_BIT + 1] = {0};
+
+    // 下一条指令最早的发射时刻
+    int64_t issueAt = 0;
+
+    for (size_t k = block.begin; k < block.end; k++) {
+
+        const ArmInst & arm = code[k];
+        if (!isMachineInst(arm)) {
+            continue;
+        }
+
+        uint32_t reads, writes;
+        regUses(arm, reads, writes);
+
+        int64_t start = issueAt;
+        for (int reg = 0; reg <= ARM32_FLAGS_BIT; reg++) {
+            if (reads & (1u << reg)) {
+                start = std::max(start, ready[reg]);
+            }
+        }
+
+        OpCost opCost = cost(arm.opcode);
+        int64_t issue = opCost.issue;
+
+        // push与pop每个寄存器一次访存
+        if ((arm.opcode == ArmOpcode::ARM_OP_PUSH) || (arm.opcode == ArmOpcode::ARM_OP_POP)) {
+            int32_t regs = 0;
+            for (uint32_t mask = (uint32_t) arm.result.value; mask; mask &= mask - 1) {
+                regs++;
+            }
+            issue += std::max(regs - 1, 0);
+        }
+
+        issueAt = start + issue;
+
+        for (int reg = 0; reg <= ARM32_FLAGS_BIT; reg++) {
+            if (writes & (1u << reg)) {
+                ready[reg] = start + opCost.latency;
+            }
+        }
+    }
+
+    return issueAt;
+}
+
+///
+/// @brief 进行估计
+/// @return ArmEstimate 估计结果
+///
+ArmEstimate EstimatorArm32::run()
+{
+    buildBlocks();
+    computeLoops();
+    computeFrequency();
+
+    ArmEstimate estimate;
+    estimate.function = func->getName();
+    estimate.profiled = profiled;
+    estimate.entryCount = func->getEntryCount();
+    estimate.blocks = (int32_t) blocks.size();
+    estimate.loops = loopCount;
+
+    const std::vector<ArmInst> & code = iloc.getCode();
+
+    for (const Block & block: blocks) {
+
+        estimate.maxLoopDepth = std::max(estimate.maxLoopDepth, block.loopDepth);
+
+        int64_t insts = 0, spills = 0, reloads = 0, branches = 0;
+        for (size_t k = block.begin; k < block.end; k++) {
+            const ArmInst & arm = code[k];
+            if (!isMachineInst(arm)) {
+                continue;
+            }
+            insts++;
+            if (isStackAccess(arm)) {
+                if (arm.opcode == ArmOpcode::ARM_OP_STR) {
+                    spills++;
+                } else {
+                    reloads++;
+                }
+            }
+            if (arm.isBranch()) {
+                branches++;
+            } else if (arm.opcode == ArmOpcode::ARM_OP_BL) {
+                estimate.calls++;
+            }
+        }
+
+        estimate.instructions += insts;
+        estimate.spills += spills;
+        estimate.reloads += reloads;
+        estimate.branches += branches;
+
+        // 不可达的块频度为0
+        if (block.freq > 0) {
+            estimate.cycles += block.freq * (double) blockCycles(block);
+            estimate.dynInstructions += block.freq * (double) insts;
+            estimate.dynSpills += block.freq * (double) spills;
+            estimate.dynReloads += block.freq * (double) reloads;
+            estimate.dynBranches += block.freq * (double) branches;
+        }
+    }
+
+    estimate.bytes = estimate.instructions * INST_BYTES;
+
+    return estimate;
+}
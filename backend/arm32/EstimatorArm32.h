@@ -0,0 +1,231 @@
+///
+/// @file EstimatorArm32.h
+/// @brief ARM32指令序列的静态周期数与代码大小估计的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Function.h"
+#include "ILocArm32.h"
+
+///
+/// @brief 一个函数的估计结果
+///
+/// 带dyn前缀的为按基本块频度加权、折算为函数每进入一次的值，其余为静态的条数。
+/// 溢出与重载指栈帧内的存储与加载，即基址为fp或者sp的str与ldr。
+///
+struct ArmEstimate {
+    /// @brief 函数名
+    std::string function;
+
+    /// @brief 频度是否来自剖析数据，否则按循环嵌套深度估计
+    bool profiled = false;
+
+    /// @brief 剖析得到的函数进入次数，没有剖析数据时为0
+    uint64_t entryCount = 0;
+
+    /// @brief 基本块个数
+    int32_t blocks = 0;
+
+    /// @brief 循环个数
+    int32_t loops = 0;
+
+    /// @brief 最大的循环嵌套深度
+    int32_t maxLoopDepth = 0;
+
+    /// @brief 指令条数，不含标签与注释
+    int64_t instructions = 0;
+
+    /// @brief 机器码的字节数
+    int64_t bytes = 0;
+
+    /// @brief 溢出即栈帧内存储的条数
+    int64_t spills = 0;
+
+    /// @brief 重载即栈帧内加载的条数
+    int64_t reloads = 0;
+
+    /// @brief 跳转指令的条数，含条件跳转
+    int64_t branches = 0;
+
+    /// @brief 函数调用指令的条数
+    int64_t calls = 0;
+
+    /// @brief 函数每进入一次的估计周期数
+    double cycles = 0;
+
+    /// @brief 函数每进入一次执行的指令条数
+    double dynInstructions = 0;
+
+    /// @brief 函数每进入一次执行的溢出条数
+    double dynSpills = 0;
+
+    /// @brief 函数每进入一次执行的重载条数
+    double dynReloads = 0;
+
+    /// @brief 函数每进入一次执行的跳转条数
+    double dynBranches = 0;
+
+    ///
+    /// @brief 以汇编注释的形式输出
+    /// @param str 追加到该字符串中
+    ///
+    void toComment(std::string & str) const;
+
+    ///
+    /// @brief 以JSON对象的形式输出
+    /// @param str 追加到该字符串中
+    ///
+    void toJSON(std::string & str) const;
+};
+
+///
+/// @brief 在指令选择后的最终指令序列上静态估计函数的周期数、代码大小、溢出与跳转等，不需要运行程序
+///
+/// 指令序列按标签与跳转划分基本块，由支配关系找出回边与自然循环，得到各基本块的循环嵌套深度。
+/// 基本块的频度在有剖析数据时由函数进入次数与分支的跳转次数得到，否则为LOOP_WEIGHT的循环嵌套深度次方。
+/// 基本块内按顺序发射的流水线估计周期数：每条指令在上一条发射后经过其发射间隔、且源操作数就绪时发射，
+/// 结果在发射后经过其延迟就绪，各操作码的发射间隔与延迟见costTable。
+///
+class EstimatorArm32 {
+
+public:
+    ///
+    /// @brief 一个操作码的代价
+    ///
+    struct OpCost {
+        /// @brief 发射间隔，即与下一条指令发射之间至少间隔的周期数
+        int32_t issue;
+
+        /// @brief 延迟，即结果在发射后可被使用的周期数
+        int32_t latency;
+    };
+
+    ///
+    /// @brief 构造函数
+    /// @param _iloc 指令序列，必须是最终输出的序列
+    /// @param _func 函数，其中的分支指令可能带有剖析数据
+    ///
+    EstimatorArm32(ILocArm32 & _iloc, Function * _func);
+
+    ///
+    /// @brief 进行估计
+    /// @return ArmEstimate 估计结果
+    ///
+    ArmEstimate run();
+
+    ///
+    /// @brief 获取操作码的代价
+    /// @param opcode 操作码
+    /// @return OpCost 代价
+    ///
+    static OpCost cost(ArmOpcode opcode);
+
+    /// @brief 没有剖析数据时每层循环的频度倍数
+    static constexpr double LOOP_WEIGHT = 10.0;
+
+    /// @brief 按循环估计频度时的最大嵌套深度，更深的循环按此深度计算
+    static constexpr int32_t MAX_WEIGHTED_DEPTH = 8;
+
+    /// @brief 每条ARM指令的字节数
+    static constexpr int32_t INST_BYTES = 4;
+
+protected:
+    ///
+    /// @brief 基本块
+    ///
+    struct Block {
+        /// @brief 第一条指令的下标
+        size_t begin = 0;
+
+        /// @brief 最后一条指令之后的下标
+        size_t end = 0;
+
+        /// @brief 所在的IR基本块的标签名，用于查找剖析数据
+        std::string irLabel;
+
+        /// @brief 后继基本块，条件跳转时第一个为跳转目标，第二个为顺序执行的下一块
+        std::vector<int32_t> succs;
+
+        /// @brief 前驱基本块
+        std::vector<int32_t> preds;
+
+        /// @brief 结尾是否是条件跳转
+        bool condBranch = false;
+
+        /// @brief 循环嵌套深度
+        int32_t loopDepth = 0;
+
+        /// @brief 频度
+        double freq = 0;
+    };
+
+    ///
+    /// @brief 划分基本块，建立前驱与后继关系
+    ///
+    void buildBlocks();
+
+    ///
+    /// @brief 由支配关系找出回边与自然循环，计算各基本块的循环嵌套深度
+    ///
+    void computeLoops();
+
+    ///
+    /// @brief 计算各基本块的频度
+    ///
+    void computeFrequency();
+
+    ///
+    /// @brief 由剖析数据计算各基本块的执行次数
+    /// @return true：成功，false：函数没有剖析数据
+    ///
+    bool computeProfileFrequency();
+
+    ///
+    /// @brief 估计一个基本块执行一次的周期数
+    /// @param block 基本块
+    /// @return int64_t 周期数
+    ///
+    int64_t blockCycles(const Block & block) const;
+
+    ///
+    /// @brief 是否是栈帧内的加载或存储，即基址为fp或者sp
+    /// @param arm 指令
+    /// @return true：是，false：不是
+    ///
+    static bool isStackAccess(const ArmInst & arm);
+
+private:
+    /// @brief 指令序列
+    ILocArm32 & iloc;
+
+    /// @brief 函数
+    Function * func;
+
+    /// @brief 基本块，第一个为入口
+    std::vector<Block> blocks;
+
+    /// @brief 逆后序，只含从入口可达的基本块
+    std::vector<int32_t> rpo;
+
+    /// @brief 循环个数
+    int32_t loopCount = 0;
+
+    /// @brief 频度是否来自剖析数据
+    bool profiled = false;
+};
@@ -0,0 +1,1036 @@
+///
+/// @file GraphColorRegisterAllocator.cpp
+/// @brief 基于图着色的寄存器分配器（迭代合并）
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "ArrayType.h"
+#include "FormalParam.h"
+#include "GraphColorRegisterAllocator.h"
+#include "LocalVariable.h"
+#include "MoveInstruction.h"
+#include "PlatformArm32.h"
+#include "PointerType.h"
+#include "RegVariable.h"
+#include "Use.h"
+
+/// @brief 预着色结点的度数，视为无穷大
+static const int32_t PRECOLORED_DEGREE = INT32_MAX / 2;
+
+/// @brief 循环深度超过该值时按该值计算权重，避免溢出代价过大
+static const int32_t MAX_WEIGHT_DEPTH = 8;
+
+///
+/// @brief 是否是数组的首地址，即指向元素个数不为0的数组的指针
+/// @param val 值
+/// @return true：是，false：不是
+///
+static bool isArrayAddress(Value * val)
+{
+    if (!val->getType()->isPointerType()) {
+        return false;
+    }
+
+    auto pointer = static_cast<const PointerType *>(val->getType());
+    auto array = dynamic_cast<const ArrayType *>(pointer->getPointeeType());
+
+    return (array != nullptr) && (array->getNumElements() != 0);
+}
+
+///
+/// @brief 构造函数
+/// @param _func 函数，函数调用指令必须已经调整过实参与返回值
+///
+GraphColorRegisterAllocator::GraphColorRegisterAllocator(Function * _func) : func(_func)
+{}
+
+///
+/// @brief 进行寄存器分配，成功时设置各值的寄存器编号
+/// @return true：成功，false：冲突图过大，应改用朴素的寄存器分配
+///
+bool GraphColorRegisterAllocator::run()
+{
+    splitParams();
+
+    cfg = std::make_unique<ControlFlowGraph>(func);
+    liveness = std::make_unique<Liveness>(*cfg);
+    liveness->run();
+
+    std::vector<int32_t> depths = cfg->computeLoopDepths();
+    blockWeights.resize(depths.size());
+    for (size_t b = 0; b < depths.size(); b++) {
+        blockWeights[b] = std::pow(10.0, std::min(depths[b], MAX_WEIGHT_DEPTH));
+    }
+
+    // 溢出的值改为在栈中后临时寄存器的需求随之变化，重建冲突图直至全部着色
+    for (;;) {
+        if (!scan(false)) {
+            return false;
+        }
+        if (color()) {
+            break;
+        }
+        if (!rewrite()) {
+            return false;
+        }
+    }
+
+    for (size_t n = K; n < nodeValues.size(); n++) {
+
+        Value * val = nodeValues[n];
+        if (val == nullptr) {
+            continue;
+        }
+
+        if (auto inst = dynamic_cast<Instruction *>(val)) {
+            inst->setRegId(colors[n]);
+        } else {
+            static_cast<LocalVariable *>(val)->setRegId(colors[n]);
+        }
+
+        if (colors[n] >= 4) {
+            calleeSavedMask |= 1u << colors[n];
+        }
+    }
+
+    return scan(true);
+}
+
+///
+/// @brief 前四个形参拷贝到新的局部变量上，形参只在函数入口处使用，其余的使用改为局部变量
+///
+/// 形参预着色为r0-r3，直接使用时其寄存器在整个函数内被占用，并且被函数调用破坏。
+/// 拷贝后局部变量可以与形参合并，有冲突时再分配其它寄存器。
+///
+void GraphColorRegisterAllocator::splitParams()
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+    std::vector<FormalParam *> & params = func->getParams();
+
+    auto entry = std::find_if(insts.begin(), insts.end(), [](Instruction * inst) {
+        return inst->getOp() == IRInstOperator::IRINST_OP_ENTRY;
+    });
+    if (entry == insts.end()) {
+        return;
+    }
+
+    std::unordered_map<Value *, LocalVariable *> copies;
+    for (size_t k = 0; (k < params.size()) && (k < 4); k++) {
+        copies[params[k]] = nullptr;
+    }
+
+    for (auto inst: insts) {
+        std::vector<Use *> & operands = inst->getOperands();
+        for (size_t u = 0; u < operands.size(); u++) {
+            auto iter = copies.find(operands[u]->getUsee());
+            if (iter == copies.end()) {
+                continue;
+            }
+            if (iter->second == nullptr) {
+                iter->second = func->newLocalVarValue(iter->first->getType(), iter->first->getName());
+            }
+            inst->setOperand((int32_t) u, iter->second);
+        }
+    }
+
+    // 拷贝指令按形参的次序放在入口指令之后
+    size_t pos = (size_t) (entry - insts.begin()) + 1;
+    for (size_t k = 0; (k < params.size()) && (k < 4); k++) {
+        LocalVariable * local = copies[params[k]];
+        if (local) {
+            insts.insert(insts.begin() + (int64_t) pos++, new MoveInstruction(func, local, params[k]));
+        }
+    }
+}
+
+///
+/// @brief 值对应的结点，常量、全局变量、内存变量、数组等不是结点
+/// @param val 值
+/// @return int32_t 结点编号，不是结点时为-1
+///
+int32_t GraphColorRegisterAllocator::nodeOf(Value * val)
+{
+    auto iter = nodeIndex.find(val);
+    if (iter != nodeIndex.end()) {
+        return iter->second;
+    }
+
+    int32_t node = -1;
+
+    if (dynamic_cast<RegVariable *>(val) != nullptr) {
+        // r0-r9为预着色结点
+        if (val->getRegId() < K) {
+            node = val->getRegId();
+        }
+    } else if (dynamic_cast<FormalParam *>(val) != nullptr) {
+        // 前四个形参在r0-r3中，其余的在栈中
+        std::vector<FormalParam *> & params = func->getParams();
+        for (size_t k = 0; (k < params.size()) && (k < 4); k++) {
+            if (params[k] == val) {
+                node = (int32_t) k;
+            }
+        }
+    } else if (spilled.count(val) == 0) {
+        if (auto inst = dynamic_cast<Instruction *>(val)) {
+            if (inst->hasResultValue()) {
+                node = newNode(val);
+            }
+        } else if ((dynamic_cast<LocalVariable *>(val) != nullptr) && !isArrayAddress(val)) {
+            node = newNode(val);
+        }
+    }
+
+    nodeIndex.emplace(val, node);
+
+    return node;
+}
+
+///
+/// @brief 新建一个结点
+/// @param val 值结点的值，临时寄存器结点为空指针
+/// @return int32_t 结点编号
+///
+int32_t GraphColorRegisterAllocator::newNode(Value * val)
+{
+    int32_t node = (int32_t) nodeValues.size();
+
+    nodeValues.push_back(val);
+    adjList.emplace_back();
+    moveList.emplace_back();
+    degree.push_back(node < K ? PRECOLORED_DEGREE : 0);
+    spillCost.push_back(val ? 0.0 : HUGE_VAL);
+
+    return node;
+}
+
+///
+/// @brief 操作数是否需要借用临时寄存器
+/// @param val 操作数
+/// @param address 数组名作为地址使用时总是需要
+/// @return true：需要，false：不需要
+///
+bool GraphColorRegisterAllocator::needLoad(Value * val, bool address)
+{
+    if (address && val->getType()->isPointerType() &&
+        static_cast<const PointerType *>(val->getType())->getPointeeType()->isArrayType()) {
+        return true;
+    }
+
+    return nodeOf(val) == -1;
+}
+
+///
+/// @brief 翻译指令时需要的临时寄存器个数，与指令选择的翻译方法对应
+/// @param inst IR指令
+/// @return int32_t 个数
+///
+int32_t GraphColorRegisterAllocator::scratchNeed(Instruction * inst)
+{
+    switch (inst->getOp()) {
+        case IRInstOperator::IRINST_OP_ASSIGN:
+            // 内存到内存经过一个寄存器
+            return (needLoad(inst->getOperand(0)) && needLoad(inst->getOperand(1))) ? 1 : 0;
+        case IRInstOperator::IRINST_OP_ADD_I:
+        case IRInstOperator::IRINST_OP_SUB_I:
+        case IRInstOperator::IRINST_OP_MUL_I:
+        case IRInstOperator::IRINST_OP_DIV_I:
+            return needLoad(inst->getOperand(0), true) + needLoad(inst->getOperand(1), true) + needLoad(inst);
+        case IRInstOperator::IRINST_OP_MOD_I:
+            // 另需一个寄存器保存商
+            return needLoad(inst->getOperand(0)) + needLoad(inst->getOperand(1)) + needLoad(inst) + 1;
+        case IRInstOperator::IRINST_OP_MINUS_I:
+            return needLoad(inst->getOperand(0)) + needLoad(inst);
+        case IRInstOperator::IRINST_OP_GT_I:
+        case IRInstOperator::IRINST_OP_LT_I:
+        case IRInstOperator::IRINST_OP_GE_I:
+        case IRInstOperator::IRINST_OP_LE_I:
+        case IRInstOperator::IRINST_OP_EQ_I:
+        case IRInstOperator::IRINST_OP_NE_I:
+            // 比较结果没有被使用时不产生
+            return needLoad(inst->getOperand(0)) + needLoad(inst->getOperand(1)) + (inst->isUsed() && needLoad(inst));
+        case IRInstOperator::IRINST_OP_LOAD:
+            return needLoad(inst->getOperand(0)) + needLoad(inst);
+        case IRInstOperator::IRINST_OP_STORE:
+            return needLoad(inst->getOperand(0)) + needLoad(inst->getOperand(1));
+        case IRInstOperator::IRINST_OP_COUNTER:
+            return 1;
+        case IRInstOperator::IRINST_OP_FUNC_CALL:
+            // 栈传递的实参在调用处重新从内存复制到内存
+            return (inst->getOperandsNum() > 4) ? 1 : 0;
+        default:
+            return 0;
+    }
+}
+
+///
+/// @brief 增加一条冲突边
+/// @param u 结点
+/// @param v 结点
+///
+void GraphColorRegisterAllocator::addEdge(int32_t u, int32_t v)
+{
+    if ((u == v) || ((u < K) && (v < K)) || adjacent(u, v)) {
+        return;
+    }
+
+    adjSet.insert(((uint64_t) std::min(u, v) << 32) | (uint32_t) std::max(u, v));
+    edgeCount++;
+
+    if (u >= K) {
+        adjList[u].push_back(v);
+        degree[u]++;
+    }
+    if (v >= K) {
+        adjList[v].push_back(u);
+        degree[v]++;
+    }
+}
+
+///
+/// @brief 两个结点之间是否有冲突边
+/// @param u 结点
+/// @param v 结点
+/// @return true：有，false：没有
+///
+bool GraphColorRegisterAllocator::adjacent(int32_t u, int32_t v) const
+{
+    return adjSet.count(((uint64_t) std::min(u, v) << 32) | (uint32_t) std::max(u, v)) != 0;
+}
+
+///
+/// @brief 逆序扫描各基本块的指令，建立冲突图或者求各指令处被占用的寄存器
+/// @param final 为true时冲突图已着色，只求被占用的寄存器
+/// @return true：成功，false：冲突边数超过上限
+///
+bool GraphColorRegisterAllocator::scan(bool final)
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+
+    if (final) {
+        reservedMasks.assign(insts.size(), 1u << ARM32_TMP_REG_NO);
+    } else {
+        nodeIndex.clear();
+        nodeValues.clear();
+        adjSet.clear();
+        edgeCount = 0;
+        adjList.clear();
+        degree.clear();
+        spillCost.clear();
+        moveList.clear();
+        moves.clear();
+
+        for (int32_t k = 0; k < K; k++) {
+            newNode(nullptr);
+        }
+    }
+
+    // 全局值对应的结点
+    const std::vector<Value *> & values = liveness->getValues();
+    std::vector<int32_t> globalNodes((size_t) liveness->getGlobalCount());
+    for (size_t id = 0; id < globalNodes.size(); id++) {
+        globalNodes[id] = nodeOf(values[id]);
+    }
+
+    // 稀疏的活跃集合，livePos记录结点在liveList中的位置
+    std::vector<int32_t> liveList;
+    std::vector<int32_t> livePos;
+
+    auto addLive = [&](int32_t n) {
+        if ((size_t) n >= livePos.size()) {
+            livePos.resize(nodeValues.size(), -1);
+        }
+        if (livePos[n] == -1) {
+            livePos[n] = (int32_t) liveList.size();
+            liveList.push_back(n);
+        }
+    };
+
+    auto removeLive = [&](int32_t n) {
+        if (((size_t) n < livePos.size()) && (livePos[n] != -1)) {
+            int32_t last = liveList.back();
+            liveList[livePos[n]] = last;
+            livePos[last] = livePos[n];
+            liveList.pop_back();
+            livePos[n] = -1;
+        }
+    };
+
+    std::vector<int32_t> defs, uses, scratches;
+
+    for (const BasicBlock & block: cfg->getBlocks()) {
+
+        for (int32_t n: liveList) {
+            livePos[n] = -1;
+        }
+        liveList.clear();
+
+        const DynBitSet & liveOut = liveness->getLiveOut(block.index);
+        for (size_t id = liveOut.findFirst(); id != DynBitSet::npos; id = liveOut.findNext(id)) {
+            if (globalNodes[id] != -1) {
+                addLive(globalNodes[id]);
+            }
+        }
+
+        const double weight = blockWeights[block.index];
+
+        for (size_t k = block.end; k-- > block.begin;) {
+
+            Instruction * inst = insts[k];
+            if (inst->isDead()) {
+                continue;
+            }
+
+            defs.clear();
+            uses.clear();
+            int32_t moveSrc = -1;
+
+            auto addUse = [&](Value * val) {
+                int32_t n = nodeOf(val);
+                if (n != -1) {
+                    uses.push_back(n);
+                }
+                return n;
+            };
+
+            switch (inst->getOp()) {
+                case IRInstOperator::IRINST_OP_ASSIGN: {
+                    int32_t dst = nodeOf(inst->getOperand(0));
+                    int32_t src = addUse(inst->getOperand(1));
+                    if (dst != -1) {
+                        defs.push_back(dst);
+                        if ((src != -1) && (src != dst) && ((src >= K) || (dst >= K))) {
+                            moveSrc = src;
+                        }
+                    }
+                    break;
+                }
+                case IRInstOperator::IRINST_OP_FUNC_CALL:
+                    // 调用破坏r0-r3，返回值由其后的赋值指令从r0取得
+                    for (int32_t r = 0; r < 4; r++) {
+                        defs.push_back(r);
+                    }
+                    for (int32_t u = 0; u < inst->getOperandsNum(); u++) {
+                        addUse(inst->getOperand(u));
+                    }
+                    break;
+                case IRInstOperator::IRINST_OP_EXIT:
+                    // 返回值最终送到r0，作为传送尝试合并
+                    if (inst->getOperandsNum() && (addUse(inst->getOperand(0)) >= K) && !final) {
+                        int32_t src = uses.back();
+                        moveList[0].push_back((int32_t) moves.size());
+                        moveList[src].push_back((int32_t) moves.size());
+                        moves.push_back({0, src, weight, MoveState::WORKLIST});
+                    }
+                    break;
+                default:
+                    for (int32_t u = 0; u < inst->getOperandsNum(); u++) {
+                        addUse(inst->getOperand(u));
+                    }
+                    if (inst->hasResultValue()) {
+                        int32_t n = nodeOf(inst);
+                        if (n != -1) {
+                            defs.push_back(n);
+                        }
+                    }
+                    break;
+            }
+
+            if (!final) {
+                for (int32_t n: defs) {
+                    spillCost[n] += weight;
+                }
+                for (int32_t n: uses) {
+                    spillCost[n] += weight;
+                }
+            }
+
+            // 传送的两端不冲突
+            if (moveSrc != -1) {
+                removeLive(moveSrc);
+                if (!final) {
+                    int32_t dst = defs.front();
+                    moveList[dst].push_back((int32_t) moves.size());
+                    moveList[moveSrc].push_back((int32_t) moves.size());
+                    moves.push_back({dst, moveSrc, weight, MoveState::WORKLIST});
+                }
+            }
+
+            for (int32_t n: defs) {
+                addLive(n);
+            }
+
+            int32_t need = scratchNeed(inst);
+
+            if (final) {
+                // 活跃、定值与使用的结点所在的寄存器都被占用，临时寄存器从其余的编号小的开始分配
+                uint32_t mask = reservedMasks[k];
+                for (int32_t n: liveList) {
+                    mask |= 1u << colors[n];
+                }
+                for (int32_t n: uses) {
+                    mask |= 1u << colors[n];
+                }
+                reservedMasks[k] = mask;
+
+                for (int32_t r = 0; (r < K) && (need > 0); r++) {
+                    if ((mask & (1u << r)) == 0) {
+                        if (r >= 4) {
+                            calleeSavedMask |= 1u << r;
+                        }
+                        need--;
+                    }
+                }
+            } else {
+                for (int32_t d: defs) {
+                    for (int32_t n: liveList) {
+                        addEdge(n, d);
+                    }
+                }
+
+                // 取余翻译为sdiv、mul、sub三条指令，结果写入后还要读被除数，两者不能共用寄存器
+                if ((inst->getOp() == IRInstOperator::IRINST_OP_MOD_I) && !defs.empty()) {
+                    int32_t dividend = nodeOf(inst->getOperand(0));
+                    if (dividend != -1) {
+                        addEdge(defs.front(), dividend);
+                    }
+                }
+
+                // 临时寄存器之间以及与占用的寄存器冲突
+                scratches.clear();
+                for (int32_t s = 0; s < need; s++) {
+                    int32_t node = newNode(nullptr);
+                    for (int32_t n: liveList) {
+                        addEdge(node, n);
+                    }
+                    for (int32_t n: uses) {
+                        addEdge(node, n);
+                    }
+                    for (int32_t other: scratches) {
+                        addEdge(node, other);
+                    }
+                    scratches.push_back(node);
+                }
+
+                if (edgeCount > MAX_EDGES) {
+                    return false;
+                }
+            }
+
+            for (int32_t n: defs) {
+                removeLive(n);
+            }
+            for (int32_t n: uses) {
+                addLive(n);
+            }
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 一轮着色，对冲突图进行简化、合并、冻结、溢出与选择
+/// @return true：全部着色，false：有实际溢出的结点
+///
+bool GraphColorRegisterAllocator::color()
+{
+    size_t count = nodeValues.size();
+
+    alias.resize(count);
+    colors.assign(count, -1);
+    states.assign(count, NodeState::INITIAL);
+    visitMark.assign(count, 0);
+    visitStamp = 0;
+
+    for (size_t n = 0; n < count; n++) {
+        alias[n] = (int32_t) n;
+    }
+    for (int32_t r = 0; r < K; r++) {
+        colors[r] = r;
+        states[r] = NodeState::PRECOLORED;
+    }
+
+    simplifyWorklist.clear();
+    freezeWorklist.clear();
+    spillWorklist.clear();
+    selectStack.clear();
+    spilledNodes.clear();
+    coalescedNodes.clear();
+
+    // 循环内的传送先合并
+    worklistMoves.resize(moves.size());
+    for (size_t m = 0; m < moves.size(); m++) {
+        worklistMoves[m] = (int32_t) m;
+    }
+    std::stable_sort(worklistMoves.begin(), worklistMoves.end(), [this](int32_t a, int32_t b) {
+        return moves[a].weight < moves[b].weight;
+    });
+
+    makeWorklist();
+
+    while (simplify() || coalesce() || freeze() || selectSpill()) {
+    }
+
+    assignColors();
+
+    return spilledNodes.empty();
+}
+
+///
+/// @brief 初始化各工作表
+///
+void GraphColorRegisterAllocator::makeWorklist()
+{
+    for (int32_t n = K; n < (int32_t) nodeValues.size(); n++) {
+        if (degree[n] >= K) {
+            states[n] = NodeState::SPILL;
+            spillWorklist.emplace_back(spillPriority(n), n);
+        } else if (moveRelated(n)) {
+            states[n] = NodeState::FREEZE;
+            freezeWorklist.push_back(n);
+        } else {
+            states[n] = NodeState::SIMPLIFY;
+            simplifyWorklist.push_back(n);
+        }
+    }
+
+    std::make_heap(spillWorklist.begin(), spillWorklist.end(), std::greater<>());
+}
+
+///
+/// @brief 简化一个低度数的非传送相关结点
+/// @return true：进行了处理，false：工作表为空
+///
+bool GraphColorRegisterAllocator::simplify()
+{
+    while (!simplifyWorklist.empty()) {
+
+        int32_t n = simplifyWorklist.back();
+        simplifyWorklist.pop_back();
+
+        if (states[n] != NodeState::SIMPLIFY) {
+            continue;
+        }
+
+        states[n] = NodeState::SELECT;
+        selectStack.push_back(n);
+
+        forEachAdjacent(n, [this](int32_t m) { decrementDegree(m); });
+
+        return true;
+    }
+
+    return false;
+}
+
+///
+/// @brief 尝试合并一条传送指令的两端
+/// @return true：进行了处理，false：工作表为空
+///
+bool GraphColorRegisterAllocator::coalesce()
+{
+    while (!worklistMoves.empty()) {
+
+        int32_t m = worklistMoves.back();
+        worklistMoves.pop_back();
+
+        if (moves[m].state != MoveState::WORKLIST) {
+            continue;
+        }
+
+        int32_t x = getAlias(moves[m].src);
+        int32_t y = getAlias(moves[m].dst);
+        int32_t u = x, v = y;
+        if (states[y] == NodeState::PRECOLORED) {
+            u = y;
+            v = x;
+        }
+
+        if (u == v) {
+            moves[m].state = MoveState::COALESCED;
+            addWorklist(u);
+        } else if ((states[v] == NodeState::PRECOLORED) || adjacent(u, v)) {
+            moves[m].state = MoveState::CONSTRAINED;
+            addWorklist(u);
+            addWorklist(v);
+        } else {
+            bool ok;
+            if (states[u] == NodeState::PRECOLORED) {
+                ok = true;
+                for (size_t k = 0; ok && (k < adjList[v].size()); k++) {
+                    int32_t t = adjList[v][k];
+                    if ((states[t] != NodeState::SELECT) && (states[t] != NodeState::COALESCED)) {
+                        ok = georgeOK(t, u);
+                    }
+                }
+            } else {
+                ok = conservative(u, v);
+            }
+
+            if (ok) {
+                moves[m].state = MoveState::COALESCED;
+                combine(u, v);
+                addWorklist(u);
+            } else {
+                moves[m].state = MoveState::ACTIVE;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+///
+/// @brief 冻结一个低度数的传送相关结点，放弃其传送的合并
+/// @return true：进行了处理，false：工作表为空
+///
+bool GraphColorRegisterAllocator::freeze()
+{
+    while (!freezeWorklist.empty()) {
+
+        int32_t u = freezeWorklist.back();
+        freezeWorklist.pop_back();
+
+        if (states[u] != NodeState::FREEZE) {
+            continue;
+        }
+
+        states[u] = NodeState::SIMPLIFY;
+        simplifyWorklist.push_back(u);
+        freezeMoves(u);
+
+        return true;
+    }
+
+    return false;
+}
+
+///
+/// @brief 按溢出代价与度数之比选择一个可能溢出的结点
+/// @return true：进行了处理，false：工作表为空
+///
+bool GraphColorRegisterAllocator::selectSpill()
+{
+    while (!spillWorklist.empty()) {
+
+        std::pop_heap(spillWorklist.begin(), spillWorklist.end(), std::greater<>());
+        auto [priority, n] = spillWorklist.back();
+        spillWorklist.pop_back();
+
+        if (states[n] != NodeState::SPILL) {
+            continue;
+        }
+
+        // 度数减少后优先级变大，按新的优先级重新放入
+        double current = spillPriority(n);
+        if (current > priority) {
+            spillWorklist.emplace_back(current, n);
+            std::push_heap(spillWorklist.begin(), spillWorklist.end(), std::greater<>());
+            continue;
+        }
+
+        states[n] = NodeState::SIMPLIFY;
+        simplifyWorklist.push_back(n);
+        freezeMoves(n);
+
+        return true;
+    }
+
+    return false;
+}
+
+///
+/// @brief 按选择栈的次序着色
+///
+void GraphColorRegisterAllocator::assignColors()
+{
+    while (!selectStack.empty()) {
+
+        int32_t n = selectStack.back();
+        selectStack.pop_back();
+
+        uint32_t okColors = (1u << K) - 1;
+        for (int32_t w: adjList[n]) {
+            int32_t a = getAlias(w);
+            if ((states[a] == NodeState::COLORED) || (states[a] == NodeState::PRECOLORED)) {
+                okColors &= ~(1u << colors[a]);
+            }
+        }
+
+        if (okColors == 0) {
+            states[n] = NodeState::SPILLED;
+            spilledNodes.push_back(n);
+        } else {
+            // 编号小的优先，少用需要保护的寄存器
+            states[n] = NodeState::COLORED;
+            colors[n] = __builtin_ctz(okColors);
+        }
+    }
+
+    for (int32_t n: coalescedNodes) {
+        colors[n] = colors[getAlias(n)];
+    }
+}
+
+///
+/// @brief 对实际溢出的结点，把对应的值标记为溢出，供下一轮使用
+/// @return true：成功，false：无法通过溢出值解决
+///
+bool GraphColorRegisterAllocator::rewrite()
+{
+    for (int32_t n: spilledNodes) {
+
+        int32_t victim = n;
+
+        // 临时寄存器不能溢出，改为溢出与其冲突的代价最小的值
+        if (nodeValues[n] == nullptr) {
+            victim = -1;
+            for (int32_t w: adjList[n]) {
+                int32_t a = getAlias(w);
+                if ((a >= K) && (nodeValues[a] != nullptr) && (states[a] != NodeState::SPILLED) &&
+                    ((victim == -1) || (spillCost[a] < spillCost[victim]))) {
+                    victim = a;
+                }
+            }
+            if (victim == -1) {
+                return false;
+            }
+        }
+
+        spilled.insert(nodeValues[victim]);
+        for (int32_t c: coalescedNodes) {
+            if (getAlias(c) == victim) {
+                spilled.insert(nodeValues[c]);
+            }
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 遍历结点当前有效的邻接结点
+/// @param n 结点
+/// @param visit 访问函数
+///
+template <typename Visit>
+void GraphColorRegisterAllocator::forEachAdjacent(int32_t n, Visit && visit)
+{
+    for (size_t k = 0; k < adjList[n].size(); k++) {
+        int32_t t = adjList[n][k];
+        if ((states[t] != NodeState::SELECT) && (states[t] != NodeState::COALESCED)) {
+            visit(t);
+        }
+    }
+}
+
+///
+/// @brief 遍历结点尚未处理的传送
+/// @param n 结点
+/// @param visit 访问函数
+///
+template <typename Visit>
+void GraphColorRegisterAllocator::forEachNodeMove(int32_t n, Visit && visit)
+{
+    for (size_t k = 0; k < moveList[n].size(); k++) {
+        int32_t m = moveList[n][k];
+        if ((moves[m].state == MoveState::ACTIVE) || (moves[m].state == MoveState::WORKLIST)) {
+            visit(m);
+        }
+    }
+}
+
+///
+/// @brief 结点是否还有尚未处理的传送
+/// @param n 结点
+/// @return true：有，false：没有
+///
+bool GraphColorRegisterAllocator::moveRelated(int32_t n)
+{
+    for (int32_t m: moveList[n]) {
+        if ((moves[m].state == MoveState::ACTIVE) || (moves[m].state == MoveState::WORKLIST)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///
+/// @brief 结点及其邻接结点的传送重新加入合并的工作表
+/// @param n 结点
+///
+void GraphColorRegisterAllocator::enableMoves(int32_t n)
+{
+    forEachNodeMove(n, [this](int32_t m) {
+        if (moves[m].state == MoveState::ACTIVE) {
+            moves[m].state = MoveState::WORKLIST;
+            worklistMoves.push_back(m);
+        }
+    });
+}
+
+///
+/// @brief 邻接结点简化或合并后减少度数
+/// @param n 结点
+///
+void GraphColorRegisterAllocator::decrementDegree(int32_t n)
+{
+    if (states[n] == NodeState::PRECOLORED) {
+        return;
+    }
+
+    int32_t d = degree[n]--;
+    if ((d != K) || (states[n] != NodeState::SPILL)) {
+        return;
+    }
+
+    enableMoves(n);
+    forEachAdjacent(n, [this](int32_t t) { enableMoves(t); });
+
+    if (moveRelated(n)) {
+        states[n] = NodeState::FREEZE;
+        freezeWorklist.push_back(n);
+    } else {
+        states[n] = NodeState::SIMPLIFY;
+        simplifyWorklist.push_back(n);
+    }
+}
+
+///
+/// @brief 结点不再传送相关并且度数低时加入简化工作表
+/// @param n 结点
+///
+void GraphColorRegisterAllocator::addWorklist(int32_t n)
+{
+    if ((states[n] == NodeState::FREEZE) && !moveRelated(n) && (degree[n] < K)) {
+        states[n] = NodeState::SIMPLIFY;
+        simplifyWorklist.push_back(n);
+    }
+}
+
+///
+/// @brief George的合并条件，t与预着色结点r合并后不增加r的高度数邻接结点
+/// @param t 结点
+/// @param r 预着色结点
+/// @return true：满足，false：不满足
+///
+bool GraphColorRegisterAllocator::georgeOK(int32_t t, int32_t r)
+{
+    return (degree[t] < K) || (states[t] == NodeState::PRECOLORED) || adjacent(t, r);
+}
+
+///
+/// @brief Briggs的保守合并条件，合并后高度数邻接结点的个数少于K
+/// @param u 结点
+/// @param v 结点
+/// @return true：满足，false：不满足
+///
+bool GraphColorRegisterAllocator::conservative(int32_t u, int32_t v)
+{
+    int32_t highDegree = 0;
+
+    // 高度数的邻接结点达到K个即可停止，度数大的结点邻接表很长
+    visitStamp++;
+    for (int32_t n: {u, v}) {
+        for (int32_t t: adjList[n]) {
+            if ((states[t] == NodeState::SELECT) || (states[t] == NodeState::COALESCED) ||
+                (visitMark[t] == visitStamp)) {
+                continue;
+            }
+            visitMark[t] = visitStamp;
+            if ((degree[t] >= K) && (++highDegree >= K)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 合并结点v到u
+/// @param u 结点
+/// @param v 结点
+///
+void GraphColorRegisterAllocator::combine(int32_t u, int32_t v)
+{
+    states[v] = NodeState::COALESCED;
+    coalescedNodes.push_back(v);
+    alias[v] = u;
+
+    moveList[u].insert(moveList[u].end(), moveList[v].begin(), moveList[v].end());
+    enableMoves(v);
+
+    spillCost[u] += spillCost[v];
+
+    forEachAdjacent(v, [&](int32_t t) {
+        addEdge(t, u);
+        decrementDegree(t);
+    });
+
+    if ((degree[u] >= K) && (states[u] == NodeState::FREEZE)) {
+        states[u] = NodeState::SPILL;
+        spillWorklist.emplace_back(spillPriority(u), u);
+        std::push_heap(spillWorklist.begin(), spillWorklist.end(), std::greater<>());
+    }
+}
+
+///
+/// @brief 冻结结点的传送
+/// @param u 结点
+///
+void GraphColorRegisterAllocator::freezeMoves(int32_t u)
+{
+    forEachNodeMove(u, [&](int32_t m) {
+        int32_t x = moves[m].src;
+        int32_t y = moves[m].dst;
+        int32_t v = (getAlias(y) == getAlias(u)) ? getAlias(x) : getAlias(y);
+
+        moves[m].state = MoveState::FROZEN;
+
+        if ((states[v] == NodeState::FREEZE) && !moveRelated(v) && (degree[v] < K)) {
+            states[v] = NodeState::SIMPLIFY;
+            simplifyWorklist.push_back(v);
+        }
+    });
+}
+
+///
+/// @brief 获取合并后代表的结点
+/// @param n 结点
+/// @return int32_t 代表结点
+///
+int32_t GraphColorRegisterAllocator::getAlias(int32_t n)
+{
+    while (states[n] == NodeState::COALESCED) {
+        n = alias[n];
+    }
+
+    return n;
+}
+
+///
+/// @brief 结点的溢出优先级，越小越先溢出
+/// @param n 结点
+/// @return double 溢出代价与度数之比
+///
+double GraphColorRegisterAllocator::spillPriority(int32_t n) const
+{
+    return spillCost[n] / std::max(degree[n], 1);
+}
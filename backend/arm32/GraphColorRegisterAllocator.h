@@ -0,0 +1,395 @@
+///
+/// @file GraphColorRegisterAllocator.h
+/// @brief 基于图着色的寄存器分配器（迭代合并）
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "Function.h"
+#include "Liveness.h"
+
+///
+/// @brief George-Appel的迭代合并图着色寄存器分配，用r0-r9共10个寄存器着色，r10仍预留给指令选择
+///
+/// 结点有三类：
+/// (1) 预着色结点r0-r9，实参传递的r0-r3、返回值r0以及前四个形参所在的寄存器都是预着色结点；
+/// (2) 值结点，即临时变量与标量局部变量，着色成功的值分配寄存器，溢出的值仍保存在栈中；
+/// (3) 临时寄存器结点，指令选择翻译一条IR指令时对不在寄存器中的操作数需要借用寄存器，
+///     每个需要的寄存器对应一个结点，与该指令处活跃、定值、使用的结点都冲突，溢出代价无穷大。
+///
+/// 溢出的值不改写IR，由指令选择在使用处用临时寄存器读写，因此每轮溢出后重新计算临时寄存器的需求，
+/// 重建冲突图再次着色，直至没有溢出。溢出代价为各次定值与使用按所在循环深度加权(10的深度次幂)之和。
+///
+/// 分配成功后得到各条IR指令处已被占用的寄存器，指令选择只能在其余的寄存器中分配临时寄存器。
+///
+class GraphColorRegisterAllocator {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 函数，函数调用指令必须已经调整过实参与返回值
+    ///
+    explicit GraphColorRegisterAllocator(Function * _func);
+
+    ///
+    /// @brief 进行寄存器分配，成功时设置各值的寄存器编号
+    /// @return true：成功，false：冲突图过大，应改用朴素的寄存器分配
+    ///
+    bool run();
+
+    ///
+    /// @brief 获取各条IR指令处被占用的寄存器，指令选择不能作为临时寄存器使用
+    /// @return std::vector<uint32_t>& 按IR指令位置的位图，第i位对应ri
+    ///
+    [[nodiscard]] std::vector<uint32_t> & getReservedMasks()
+    {
+        return reservedMasks;
+    }
+
+    ///
+    /// @brief 获取用到的需要保护的寄存器r4-r9
+    /// @return uint32_t 位图，第i位对应ri
+    ///
+    [[nodiscard]] uint32_t getCalleeSavedMask() const
+    {
+        return calleeSavedMask;
+    }
+
+    ///
+    /// @brief 获取溢出到栈中的值的个数
+    /// @return int32_t 个数
+    ///
+    [[nodiscard]] int32_t getSpillCount() const
+    {
+        return (int32_t) spilled.size();
+    }
+
+    ///
+    /// @brief 着色的颜色数，即可分配的寄存器r0-r9
+    ///
+    static const int32_t K = 10;
+
+    ///
+    /// @brief 冲突边数的上限，超过时放弃图着色，避免超大函数耗费过多的时间与内存
+    ///
+    static const int64_t MAX_EDGES = 4000000;
+
+protected:
+    ///
+    /// @brief 前四个形参拷贝到新的局部变量上，形参只在函数入口处使用，其余的使用改为局部变量
+    ///
+    void splitParams();
+
+    ///
+    /// @brief 值对应的结点，常量、全局变量、内存变量、数组等不是结点
+    /// @param val 值
+    /// @return int32_t 结点编号，不是结点时为-1
+    ///
+    int32_t nodeOf(Value * val);
+
+    ///
+    /// @brief 逆序扫描各基本块的指令，建立冲突图或者求各指令处被占用的寄存器
+    /// @param final 为true时冲突图已着色，只求被占用的寄存器
+    /// @return true：成功，false：冲突边数超过上限
+    ///
+    bool scan(bool final);
+
+    ///
+    /// @brief 翻译指令时需要的临时寄存器个数，与指令选择的翻译方法对应
+    /// @param inst IR指令
+    /// @return int32_t 个数
+    ///
+    int32_t scratchNeed(Instruction * inst);
+
+    ///
+    /// @brief 操作数是否需要借用临时寄存器
+    /// @param val 操作数
+    /// @param address 数组名作为地址使用时总是需要
+    /// @return true：需要，false：不需要
+    ///
+    bool needLoad(Value * val, bool address = false);
+
+    ///
+    /// @brief 新建一个结点
+    /// @param val 值结点的值，临时寄存器结点为空指针
+    /// @return int32_t 结点编号
+    ///
+    int32_t newNode(Value * val);
+
+    ///
+    /// @brief 增加一条冲突边
+    /// @param u 结点
+    /// @param v 结点
+    ///
+    void addEdge(int32_t u, int32_t v);
+
+    ///
+    /// @brief 两个结点之间是否有冲突边
+    /// @param u 结点
+    /// @param v 结点
+    /// @return true：有，false：没有
+    ///
+    [[nodiscard]] bool adjacent(int32_t u, int32_t v) const;
+
+    ///
+    /// @brief 一轮着色，对冲突图进行简化、合并、冻结、溢出与选择
+    /// @return true：全部着色，false：有实际溢出的结点
+    ///
+    bool color();
+
+    ///
+    /// @brief 初始化各工作表
+    ///
+    void makeWorklist();
+
+    ///
+    /// @brief 简化一个低度数的非传送相关结点
+    /// @return true：进行了处理，false：工作表为空
+    ///
+    bool simplify();
+
+    ///
+    /// @brief 尝试合并一条传送指令的两端
+    /// @return true：进行了处理，false：工作表为空
+    ///
+    bool coalesce();
+
+    ///
+    /// @brief 冻结一个低度数的传送相关结点，放弃其传送的合并
+    /// @return true：进行了处理，false：工作表为空
+    ///
+    bool freeze();
+
+    ///
+    /// @brief 按溢出代价与度数之比选择一个可能溢出的结点
+    /// @return true：进行了处理，false：工作表为空
+    ///
+    bool selectSpill();
+
+    ///
+    /// @brief 按选择栈的次序着色
+    ///
+    void assignColors();
+
+    ///
+    /// @brief 对实际溢出的结点，把对应的值标记为溢出，供下一轮使用
+    /// @return true：成功，false：无法通过溢出值解决
+    ///
+    bool rewrite();
+
+    ///
+    /// @brief 遍历结点当前有效的邻接结点
+    /// @param n 结点
+    /// @param visit 访问函数
+    ///
+    template <typename Visit>
+    void forEachAdjacent(int32_t n, Visit && visit);
+
+    ///
+    /// @brief 遍历结点尚未处理的传送
+    /// @param n 结点
+    /// @param visit 访问函数
+    ///
+    template <typename Visit>
+    void forEachNodeMove(int32_t n, Visit && visit);
+
+    ///
+    /// @brief 结点是否还有尚未处理的传送
+    /// @param n 结点
+    /// @return true：有，false：没有
+    ///
+    bool moveRelated(int32_t n);
+
+    ///
+    /// @brief 结点及其邻接结点的传送重新加入合并的工作表
+    /// @param n 结点
+    ///
+    void enableMoves(int32_t n);
+
+    ///
+    /// @brief 邻接结点简化或合并后减少度数
+    /// @param n 结点
+    ///
+    void decrementDegree(int32_t n);
+
+    ///
+    /// @brief 结点不再传送相关并且度数低时加入简化工作表
+    /// @param n 结点
+    ///
+    void addWorklist(int32_t n);
+
+    ///
+    /// @brief George的合并条件，t与预着色结点r合并后不增加r的高度数邻接结点
+    /// @param t 结点
+    /// @param r 预着色结点
+    /// @return true：满足，false：不满足
+    ///
+    bool georgeOK(int32_t t, int32_t r);
+
+    ///
+    /// @brief Briggs的保守合并条件，合并后高度数邻接结点的个数少于K
+    /// @param u 结点
+    /// @param v 结点
+    /// @return true：满足，false：不满足
+    ///
+    bool conservative(int32_t u, int32_t v);
+
+    ///
+    /// @brief 合并结点v到u
+    /// @param u 结点
+    /// @param v 结点
+    ///
+    void combine(int32_t u, int32_t v);
+
+    ///
+    /// @brief 冻结结点的传送
+    /// @param u 结点
+    ///
+    void freezeMoves(int32_t u);
+
+    ///
+    /// @brief 获取合并后代表的结点
+    /// @param n 结点
+    /// @return int32_t 代表结点
+    ///
+    int32_t getAlias(int32_t n);
+
+    ///
+    /// @brief 结点的溢出优先级，越小越先溢出
+    /// @param n 结点
+    /// @return double 溢出代价与度数之比
+    ///
+    [[nodiscard]] double spillPriority(int32_t n) const;
+
+private:
+    /// @brief 结点的状态，即所在的工作表或集合
+    enum class NodeState : int8_t {
+        PRECOLORED,
+        INITIAL,
+        SIMPLIFY,
+        FREEZE,
+        SPILL,
+        SPILLED,
+        COALESCED,
+        COLORED,
+        SELECT,
+    };
+
+    /// @brief 传送的状态
+    enum class MoveState : int8_t {
+        WORKLIST,
+        ACTIVE,
+        COALESCED,
+        CONSTRAINED,
+        FROZEN,
+    };
+
+    /// @brief 传送，即赋值指令两端都是结点，或者返回值到r0
+    struct Move {
+        int32_t dst;
+        int32_t src;
+        double weight;
+        MoveState state;
+    };
+
+    /// @brief 函数
+    Function * func;
+
+    /// @brief 控制流图
+    std::unique_ptr<ControlFlowGraph> cfg;
+
+    /// @brief 活跃变量分析
+    std::unique_ptr<Liveness> liveness;
+
+    /// @brief 各基本块的执行频度估计，10的循环深度次幂
+    std::vector<double> blockWeights;
+
+    /// @brief 已溢出到栈中的值，不再作为结点
+    std::unordered_set<Value *> spilled;
+
+    /// @brief 值-结点编号，-1表示不是结点，每轮重建
+    std::unordered_map<Value *, int32_t> nodeIndex;
+
+    /// @brief 值结点的值，预着色与临时寄存器结点为空指针
+    std::vector<Value *> nodeValues;
+
+    /// @brief 冲突边，两端编号拼接为键值
+    std::unordered_set<uint64_t> adjSet;
+
+    /// @brief 冲突边的条数
+    int64_t edgeCount = 0;
+
+    /// @brief 邻接表，预着色结点没有
+    std::vector<std::vector<int32_t>> adjList;
+
+    /// @brief 度数
+    std::vector<int32_t> degree;
+
+    /// @brief 溢出代价
+    std::vector<double> spillCost;
+
+    /// @brief 结点相关的传送
+    std::vector<std::vector<int32_t>> moveList;
+
+    /// @brief 合并到的结点
+    std::vector<int32_t> alias;
+
+    /// @brief 颜色，即寄存器编号
+    std::vector<int32_t> colors;
+
+    /// @brief 结点状态
+    std::vector<NodeState> states;
+
+    /// @brief 传送
+    std::vector<Move> moves;
+
+    /// @brief 简化的工作表，取出时跳过状态已变的结点
+    std::vector<int32_t> simplifyWorklist;
+
+    /// @brief 冻结的工作表，取出时跳过状态已变的结点
+    std::vector<int32_t> freezeWorklist;
+
+    /// @brief 溢出的工作表，按溢出优先级的小根堆，取出时跳过状态已变的结点
+    std::vector<std::pair<double, int32_t>> spillWorklist;
+
+    /// @brief 合并的工作表，权重大的在后面先处理
+    std::vector<int32_t> worklistMoves;
+
+    /// @brief 选择栈
+    std::vector<int32_t> selectStack;
+
+    /// @brief 实际溢出的结点
+    std::vector<int32_t> spilledNodes;
+
+    /// @brief 已合并的结点
+    std::vector<int32_t> coalescedNodes;
+
+    /// @brief Briggs条件统计时去重的标记
+    std::vector<int32_t> visitMark;
+
+    /// @brief 当前的去重标记值
+    int32_t visitStamp = 0;
+
+    /// @brief 各条IR指令处被占用的寄存器
+    std::vector<uint32_t> reservedMasks;
+
+    /// @brief 用到的需要保护的寄存器r4-r9
+    uint32_t calleeSavedMask = 0;
+};
@@ -2,8 +2,8 @@
 /// @file ILocArm32.cpp
 /// @brief 指令序列管理的实现，ILOC的全称为Intermediate Language for Optimizing Compilers
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.7
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,12 +11,20 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>汇编输出到字符串，支持函数并行生成
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>指令直接追加到输出字符串，不产生临时字符串
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>指令改为枚举操作码与整数操作数，输出时才转为字符串
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>记录标签的引用计数，一遍删除无用标签
+/// <tr><td>2026-10-18 <td>1.5     <td>zenglj  <td>删除的Label不再输出空行
+/// <tr><td>2026-10-18 <td>1.6     <td>zenglj  <td>增加名字表的获取
+/// <tr><td>2026-10-18 <td>1.7     <td>zenglj  <td>没有栈帧的函数也设置FP，与出口处的恢复SP对应
 /// </table>
 ///
 #include <cstdio>
 #include <string>
 
 #include "ILocArm32.h"
+#include "BufferedWriter.h"
 #include "ArrayType.h"
 #include "Common.h"
 #include "Function.h"
@@ -25,40 +33,140 @@
 #include "Module.h"
 #include "PointerType.h"
 
-ArmInst::ArmInst(std::string _opcode,
-                 std::string _result,
-                 std::string _arg1,
-                 std::string _arg2,
-                 std::string _cond,
-                 std::string _addition)
-    : opcode(_opcode), cond(_cond), result(_result), arg1(_arg1), arg2(_arg2), addition(_addition), dead(false)
-{}
+/// @brief 操作码的名字
+static const char * const opcodeName[(int) ArmOpcode::ARM_OP_MAX] = {
+    "add",
+    "sub",
+    "mul",
+    "sdiv",
+    "neg",
+    "mov",
+    "movw",
+    "movt",
+    "ldr",
+    "str",
+    "cmp",
+    "b",
+    "bl",
+    "bx",
+    "push",
+    "pop",
+    "",
+    "@",
+    "",
+};
+
+/// @brief 条件后缀
+static const char * const condName[(int) ArmCond::ARM_COND_MAX] = {
+    "",
+    "eq",
+    "ne",
+    "gt",
+    "ge",
+    "lt",
+    "le",
+};
+
+/// @brief 条件取反
+/// @param cond 条件，不能是无条件
+/// @return 取反后的条件
+ArmCond invertCond(ArmCond cond)
+{
+    switch (cond) {
+        case ArmCond::ARM_COND_EQ:
+            return ArmCond::ARM_COND_NE;
+        case ArmCond::ARM_COND_NE:
+            return ArmCond::ARM_COND_EQ;
+        case ArmCond::ARM_COND_GT:
+            return ArmCond::ARM_COND_LE;
+        case ArmCond::ARM_COND_GE:
+            return ArmCond::ARM_COND_LT;
+        case ArmCond::ARM_COND_LT:
+            return ArmCond::ARM_COND_GE;
+        case ArmCond::ARM_COND_LE:
+            return ArmCond::ARM_COND_GT;
+        default:
+            return cond;
+    }
+}
 
-/*
-    指令内容替换
-*/
-void ArmInst::replace(std::string _opcode,
-                      std::string _result,
-                      std::string _arg1,
-                      std::string _arg2,
-                      std::string _cond,
-                      std::string _addition)
+/// @brief 操作数输出
+/// @param str 追加到该字符串中
+/// @param names 标签、符号与文本的名字表
+void ArmOperand::outPut(std::string & str, const std::vector<std::string> & names) const
 {
-    opcode = _opcode;
-    result = _result;
-    arg1 = _arg1;
-    arg2 = _arg2;
-    cond = _cond;
-    addition = _addition;
-
-#if 0
-    // 空操作，则设置为dead
-    if (op == "") {
-        dead = true;
+    switch (kind) {
+        case ArmOperandKind::ARM_OPND_NONE:
+            break;
+        case ArmOperandKind::ARM_OPND_REG:
+            str += PlatformArm32::regName[reg];
+            break;
+        case ArmOperandKind::ARM_OPND_IMM:
+            str += '#';
+            appendInt(str, value);
+            break;
+        case ArmOperandKind::ARM_OPND_LOWER16:
+            str += "#:lower16:";
+            appendInt(str, value);
+            break;
+        case ArmOperandKind::ARM_OPND_UPPER16:
+            str += "#:upper16:";
+            appendInt(str, value);
+            break;
+        case ArmOperandKind::ARM_OPND_LOWER16_SYM:
+            str += "#:lower16:";
+            str += names[value];
+            break;
+        case ArmOperandKind::ARM_OPND_UPPER16_SYM:
+            str += "#:upper16:";
+            str += names[value];
+            break;
+        case ArmOperandKind::ARM_OPND_MEM:
+            // [fp,#-16] [fp]
+            str += '[';
+            str += PlatformArm32::regName[reg];
+            if (value) {
+                str += ",#";
+                appendInt(str, value);
+            }
+            str += ']';
+            break;
+        case ArmOperandKind::ARM_OPND_MEM_REG:
+            // [fp,r8]
+            str += '[';
+            str += PlatformArm32::regName[reg];
+            str += ',';
+            str += PlatformArm32::regName[index];
+            str += ']';
+            break;
+        case ArmOperandKind::ARM_OPND_REG_LIST: {
+            // {r10,fp,lr}，按寄存器编号由小到大
+            bool first = true;
+            str += '{';
+            for (int regNo = 0; regNo < PlatformArm32::maxRegNum; regNo++) {
+                if (value & (1 << regNo)) {
+                    if (!first) {
+                        str += ',';
+                    }
+                    str += PlatformArm32::regName[regNo];
+                    first = false;
+                }
+            }
+            str += '}';
+            break;
+        }
+        case ArmOperandKind::ARM_OPND_LABEL:
+        case ArmOperandKind::ARM_OPND_SYMBOL:
+        case ArmOperandKind::ARM_OPND_TEXT:
+            str += names[value];
+            break;
     }
-#endif
 }
 
+ArmInst::ArmInst(ArmOpcode _opcode, ArmOperand _result, ArmOperand _arg1, ArmOperand _arg2, ArmCond _cond)
+    : opcode(_opcode), cond(_cond), result(_result), arg1(_arg1), arg2(_arg2)
+{}
+
 /*
     设置为无效指令
 */
@@ -70,52 +178,48 @@ void ArmInst::setDead()
 /*
     输出函数
 */
-std::string ArmInst::outPut()
+void ArmInst::outPut(std::string & str, const std::vector<std::string> & names) const
 {
     // 无用代码，什么都不输出
     if (dead) {
-        return "";
+        return;
     }
 
     // 占位指令,可能需要输出一个空操作，看是否支持 FIXME
-    if (opcode.empty()) {
-        return "";
+    if (opcode == ArmOpcode::ARM_OP_NOP) {
+        return;
     }
 
-    std::string ret = opcode;
-
-    if (!cond.empty()) {
-        ret += cond;
+    // 标签 .L1:
+    if (opcode == ArmOpcode::ARM_OP_LABEL) {
+        result.outPut(str, names);
+        str += ':';
+        return;
     }
 
+    str += opcodeName[(int) opcode];
+    str += condName[(int) cond];
+
     // 结果输出
     if (!result.empty()) {
-        if (result == ":") {
-            ret += result;
-        } else {
-            ret += " " + result;
-        }
+        str += ' ';
+        result.outPut(str, names);
     }
 
     // 第一元参数输出
     if (!arg1.empty()) {
-        ret += "," + arg1;
+        str += ',';
+        arg1.outPut(str, names);
     }
 
     // 第二元参数输出
     if (!arg2.empty()) {
-        ret += "," + arg2;
-    }
-
-    // 其他附加信息输出
-    if (!addition.empty()) {
-        ret += "," + addition;
+        str += ',';
+        arg2.outPut(str, names);
     }
-
-    return ret;
 }
 
-#define emit(...) code.push_back(new ArmInst(__VA_ARGS__))
+#define emit(...) code.emplace_back(__VA_ARGS__)
 
 /// @brief 构造函数
 /// @param _module 符号表
@@ -126,140 +230,148 @@ ILocArm32::ILocArm32(Module * _module)
 
 /// @brief 析构函数
 ILocArm32::~ILocArm32()
-{
-    std::list<ArmInst *>::iterator pIter;
+{}
 
-    for (pIter = code.begin(); pIter != code.end(); ++pIter) {
-        delete (*pIter);
+/// @brief 获取标签的编号，第一次出现时加入名字表
+/// @param name 标签名字
+/// @return 编号
+int ILocArm32::labelId(const std::string & name)
+{
+    auto result = labelIds.emplace(name, (int) names.size());
+    if (result.second) {
+        names.push_back(name);
+        labelRefs.resize(names.size(), 0);
     }
+
+    return result.first->second;
 }
 
-/// @brief 删除无用的Label指令
-void ILocArm32::deleteUnusedLabel()
+/// @brief 符号或文本加入名字表
+/// @param name 名字
+/// @return 编号
+int ILocArm32::nameId(const std::string & name)
 {
-    std::list<ArmInst *> labelInsts;
-    for (ArmInst * arm: code) {
-        if ((!arm->dead) && (arm->opcode[0] == '.') && (arm->result == ":")) {
-            labelInsts.push_back(arm);
-        }
+    names.push_back(name);
+    return (int) names.size() - 1;
+}
+
+///
+/// @brief 设置死指令，是跳转指令时减少目标标签的引用计数
+/// @param arm 指令，必须属于本序列
+///
+void ILocArm32::setDead(ArmInst & arm)
+{
+    if (arm.dead) {
+        return;
     }
 
-    // 检测Label指令是否在被使用，也就是是否有跳转到该Label的指令
-    // 如果没有使用，则设置为dead
-    for (ArmInst * labelArm: labelInsts) {
-        bool labelUsed = false;
+    if (arm.isBranch()) {
+        labelRefs[arm.result.value]--;
+    }
 
-        for (ArmInst * arm: code) {
-            // TODO 转移语句的指令标识符根据定义修改判断
-            if ((!arm->dead) && (arm->opcode[0] == 'b') && (arm->result == labelArm->opcode)) {
-                labelUsed = true;
-                break;
-            }
-        }
+    arm.setDead();
+}
+
+///
+/// @brief 修改跳转指令的目标标签，同时维护新旧标签的引用计数
+/// @param arm 跳转指令，必须属于本序列
+/// @param label 新的目标Label名称
+///
+void ILocArm32::setBranchTarget(ArmInst & arm, const std::string & label)
+{
+    int id = labelId(label);
+
+    if (!arm.dead) {
+        labelRefs[arm.result.value]--;
+        labelRefs[id]++;
+    }
+
+    arm.result.value = id;
+}
 
-        if (!labelUsed) {
-            labelArm->setDead();
+/// @brief 删除无用的Label指令
+void ILocArm32::deleteUnusedLabel()
+{
+    // 跳转指令的引用计数在产生或改写时已维护好，没有被引用的Label设置为dead
+    for (ArmInst & arm: code) {
+        if ((!arm.dead) && arm.isLabel() && (labelRefs[arm.result.value] == 0)) {
+            arm.setDead();
         }
     }
 }
 
 /// @brief 输出汇编
-/// @param file 输出的文件指针
+/// @param text 汇编代码追加到该字符串中
 /// @param outputEmpty 是否输出空语句
-void ILocArm32::outPut(FILE * file, bool outputEmpty)
+void ILocArm32::outPut(std::string & text, bool outputEmpty)
 {
-    for (auto arm: code) {
+    // 每条指令平均不到32个字符，预留空间避免多次扩容
+    text.reserve(text.size() + code.size() * 32);
 
-        std::string s = arm->outPut();
+    for (auto & arm: code) {
 
-        if (arm->result == ":") {
+        if (arm.isLabel() && !arm.dead) {
             // Label指令，不需要Tab输出
-            fprintf(file, "%s\n", s.c_str());
+            arm.outPut(text, names);
+            text += '\n';
             continue;
         }
 
-        if (!s.empty()) {
-            fprintf(file, "\t%s\n", s.c_str());
+        // 先追加Tab，指令为空时再去掉
+        size_t start = text.size();
+        text += '\t';
+        arm.outPut(text, names);
+
+        if (text.size() > start + 1) {
+            text += '\n';
         } else if ((outputEmpty)) {
-            fprintf(file, "\n");
+            text.back() = '\n';
+        } else {
+            text.pop_back();
         }
     }
 }
 
 /// @brief 获取当前的代码序列
 /// @return 代码序列
-std::list<ArmInst *> & ILocArm32::getCode()
+std::vector<ArmInst> & ILocArm32::getCode()
 {
     return code;
 }
 
-/**
- * 数字变字符串，若flag为真，则变为立即数寻址（加#）
- */
-std::string ILocArm32::toStr(int num, bool flag)
+/// @brief 获取标签、符号与文本的名字表
+/// @return 名字表
+const std::vector<std::string> & ILocArm32::getNames() const
 {
-    std::string ret;
-
-    if (flag) {
-        ret = "#";
-    }
-
-    ret += std::to_string(num);
-
-    return ret;
+    return names;
 }
 
 /*
     产生标签
 */
-void ILocArm32::label(std::string name)
+void ILocArm32::label(const std::string & name)
 {
     // .L1:
-    emit(name, ":");
-}
-
-/// @brief 0个源操作数指令
-/// @param op 操作码
-/// @param rs 操作数
-void ILocArm32::inst(std::string op, std::string rs)
-{
-    emit(op, rs);
-}
-
-/// @brief 一个操作数指令
-/// @param op 操作码
-/// @param rs 操作数
-/// @param arg1 源操作数
-void ILocArm32::inst(std::string op, std::string rs, std::string arg1)
-{
-    emit(op, rs, arg1);
-}
-
-/// @brief 两个操作数指令
-/// @param op 操作码
-/// @param rs 操作数
-/// @param arg1 源操作数
-/// @param arg2 源操作数
-void ILocArm32::inst(std::string op, std::string rs, std::string arg1, std::string arg2)
-{
-    emit(op, rs, arg1, arg2);
+    emit(ArmOpcode::ARM_OP_LABEL, ArmOperand::makeName(ArmOperandKind::ARM_OPND_LABEL, labelId(name)));
 }
 
-/// @brief 无结果，两个操作数指令
+/// @brief 普通指令，无结果的指令（如cmp）第一个源操作数放在rs中
 /// @param op 操作码
+/// @param rs 结果操作数
 /// @param arg1 源操作数
 /// @param arg2 源操作数
-void ILocArm32::inst_no_res(std::string op, std::string arg1, std::string arg2)
+/// @param cond 条件
+void ILocArm32::inst(ArmOpcode op, ArmOperand rs, ArmOperand arg1, ArmOperand arg2, ArmCond cond)
 {
-    emit(op, arg1, arg2);
+    emit(op, rs, arg1, arg2, cond);
 }
 
 ///
 /// @brief 注释指令，不包含分号
 ///
-void ILocArm32::comment(std::string str)
+void ILocArm32::comment(const std::string & str)
 {
-    emit("@", str);
+    emit(ArmOpcode::ARM_OP_COMMENT, ArmOperand::makeName(ArmOperandKind::ARM_OPND_TEXT, nameId(str)));
 }
 
 /*
@@ -269,25 +381,32 @@ void ILocArm32::load_imm(int rs_reg_no, int constant)
 {
     // movw:把 16 位立即数放到寄存器的低16位，高16位清0
     // movt:把 16 位立即数放到寄存器的高16位，低 16位不影响
-    if (0 == ((constant >> 16) & 0xFFFF)) {
-        // 如果高16位本来就为0，直接movw
-        emit("movw", PlatformArm32::regName[rs_reg_no], "#:lower16:" + std::to_string(constant));
-    } else {
+    emit(ArmOpcode::ARM_OP_MOVW,
+         ArmOperand::makeReg(rs_reg_no),
+         ArmOperand{ArmOperandKind::ARM_OPND_LOWER16, 0, 0, constant});
+
+    if (0 != ((constant >> 16) & 0xFFFF)) {
         // 如果高16位不为0，先movw，然后movt
-        emit("movw", PlatformArm32::regName[rs_reg_no], "#:lower16:" + std::to_string(constant));
-        emit("movt", PlatformArm32::regName[rs_reg_no], "#:upper16:" + std::to_string(constant));
+        emit(ArmOpcode::ARM_OP_MOVT,
+             ArmOperand::makeReg(rs_reg_no),
+             ArmOperand{ArmOperandKind::ARM_OPND_UPPER16, 0, 0, constant});
     }
 }
 
 /// @brief 加载符号值 ldr r0,=g ldr r0,=.L1
 /// @param rs_reg_no 结果寄存器编号
 /// @param name 符号名
-void ILocArm32::load_symbol(int rs_reg_no, std::string name)
+void ILocArm32::load_symbol(int rs_reg_no, const std::string & name)
 {
     // movw r10, #:lower16:a
     // movt r10, #:upper16:a
-    emit("movw", PlatformArm32::regName[rs_reg_no], "#:lower16:" + name);
-    emit("movt", PlatformArm32::regName[rs_reg_no], "#:upper16:" + name);
+    int id = nameId(name);
+    emit(ArmOpcode::ARM_OP_MOVW,
+         ArmOperand::makeReg(rs_reg_no),
+         ArmOperand::makeName(ArmOperandKind::ARM_OPND_LOWER16_SYM, id));
+    emit(ArmOpcode::ARM_OP_MOVT,
+         ArmOperand::makeReg(rs_reg_no),
+         ArmOperand::makeName(ArmOperandKind::ARM_OPND_UPPER16_SYM, id));
 }
 
 /// @brief 基址寻址 ldr r0,[fp,#100]
@@ -296,30 +415,18 @@ void ILocArm32::load_symbol(int rs_reg_no, std::string name)
 /// @param offset 偏移
 void ILocArm32::load_base(int rs_reg_no, int base_reg_no, int offset)
 {
-    std::string rsReg = PlatformArm32::regName[rs_reg_no];
-    std::string base = PlatformArm32::regName[base_reg_no];
-
     if (PlatformArm32::isDisp(offset)) {
         // 有效的偏移常量
-        if (offset) {
-            // [fp,#-16] [fp]
-            base += "," + toStr(offset);
-        }
+        // ldr r8,[fp,#-16]
+        emit(ArmOpcode::ARM_OP_LDR, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeMem(base_reg_no, offset));
     } else {
 
         // ldr r8,=-4096
         load_imm(rs_reg_no, offset);
 
-        // fp,r8
-        base += "," + rsReg;
+        // ldr r8,[fp,r8]
+        emit(ArmOpcode::ARM_OP_LDR, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeMemReg(base_reg_no, rs_reg_no));
     }
-
-    // 内存寻址
-    base = "[" + base + "]";
-
-    // ldr r8,[fp,#-16]
-    // ldr r8,[fp,r8]
-    emit("ldr", rsReg, base);
 }
 
 /// @brief 基址寻址 str r0,[fp,#100]
@@ -329,32 +436,19 @@ void ILocArm32::load_base(int rs_reg_no, int base_reg_no, int offset)
 /// @param tmp_reg_no 可能需要临时寄存器编号
 void ILocArm32::store_base(int src_reg_no, int base_reg_no, int disp, int tmp_reg_no)
 {
-    std::string base = PlatformArm32::regName[base_reg_no];
-
     if (PlatformArm32::isDisp(disp)) {
-        // 有效的偏移常量
-
-        // 若disp为0，则直接采用基址，否则采用基址+偏移
-        // [fp,#-16] [fp]
-        if (disp) {
-            base += "," + toStr(disp);
-        }
+        // 有效的偏移常量，若disp为0，则直接采用基址，否则采用基址+偏移
+        // str r8,[fp,#-16]
+        emit(ArmOpcode::ARM_OP_STR, ArmOperand::makeReg(src_reg_no), ArmOperand::makeMem(base_reg_no, disp));
     } else {
         // 先把立即数赋值给指定的寄存器tmpReg，然后采用基址+寄存器的方式进行
 
         // ldr r9,=-4096
         load_imm(tmp_reg_no, disp);
 
-        // fp,r9
-        base += "," + PlatformArm32::regName[tmp_reg_no];
+        // str r8,[fp,r9]
+        emit(ArmOpcode::ARM_OP_STR, ArmOperand::makeReg(src_reg_no), ArmOperand::makeMemReg(base_reg_no, tmp_reg_no));
     }
-
-    // 内存间接寻址
-    base = "[" + base + "]";
-
-    // str r8,[fp,#-16]
-    // str r8,[fp,r9]
-    emit("str", PlatformArm32::regName[src_reg_no], base);
 }
 
 /// @brief 寄存器Mov操作
@@ -362,7 +456,7 @@ void ILocArm32::store_base(int src_reg_no, int base_reg_no, int disp, int tmp_re
 /// @param src_reg_no 源寄存器
 void ILocArm32::mov_reg(int rs_reg_no, int src_reg_no)
 {
-    emit("mov", PlatformArm32::regName[rs_reg_no], PlatformArm32::regName[src_reg_no]);
+    emit(ArmOpcode::ARM_OP_MOV, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeReg(src_reg_no));
 }
 
 /// @brief 加载变量到寄存器，保证将变量放到reg中
@@ -385,7 +479,7 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
         if (src_regId != rs_reg_no) {
 
             // mov r8,r2 | 这里有优化空间——消除r8
-            emit("mov", PlatformArm32::regName[rs_reg_no], PlatformArm32::regName[src_regId]);
+            mov_reg(rs_reg_no, src_regId);
         }
     } else if (Instanceof(globalVar, GlobalVariable *, src_var)) {
         // 全局变量
@@ -396,7 +490,7 @@ void ILocArm32::load_var(int rs_reg_no, Value * src_var)
         load_symbol(rs_reg_no, globalVar->getName());
 
         // ldr r8, [r8]
-        emit("ldr", PlatformArm32::regName[rs_reg_no], "[" + PlatformArm32::regName[rs_reg_no] + "]");
+        emit(ArmOpcode::ARM_OP_LDR, ArmOperand::makeReg(rs_reg_no), ArmOperand::makeMem(rs_reg_no));
 
     } else {
 
@@ -437,7 +531,6 @@ void ILocArm32::lea_var(int rs_reg_no, Value * var)
     if (Instanceof(globalVar, GlobalVariable *, var)) {
         load_symbol(rs_reg_no, globalVar->getName());
 
-        // emit("ldr", PlatformArm32::regName[rs_reg_no], "[" + PlatformArm32::regName[rs_reg_no] + "]");
     } else {
         bool result = var->getMemoryAddr(&var_baseRegId, &var_offset);
     	if (!result) {
@@ -469,7 +562,7 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
         if (src_reg_no != dest_reg_id) {
 
             // mov r2,r8 | 这里有优化空间——消除r8
-            emit("mov", PlatformArm32::regName[dest_reg_id], PlatformArm32::regName[src_reg_no]);
+            mov_reg(dest_reg_id, src_reg_no);
         }
 
     } else if (Instanceof(globalVar, GlobalVariable *, dest_var)) {
@@ -479,7 +572,7 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
         load_symbol(tmp_reg_no, globalVar->getName());
 
         // str r8, [r10]
-        emit("str", PlatformArm32::regName[src_reg_no], "[" + PlatformArm32::regName[tmp_reg_no] + "]");
+        emit(ArmOpcode::ARM_OP_STR, ArmOperand::makeReg(src_reg_no), ArmOperand::makeMem(tmp_reg_no));
 
     } else {
 
@@ -508,18 +601,21 @@ void ILocArm32::store_var(int src_reg_no, Value * dest_var, int tmp_reg_no)
 /// @param off 偏移
 void ILocArm32::leaStack(int rs_reg_no, int base_reg_no, int off)
 {
-    std::string rs_reg_name = PlatformArm32::regName[rs_reg_no];
-    std::string base_reg_name = PlatformArm32::regName[base_reg_no];
-
     if (PlatformArm32::constExpr(off))
         // add r8,fp,#-16
-        emit("add", rs_reg_name, base_reg_name, toStr(off));
+        emit(ArmOpcode::ARM_OP_ADD,
+             ArmOperand::makeReg(rs_reg_no),
+             ArmOperand::makeReg(base_reg_no),
+             ArmOperand::makeImm(off));
     else {
         // ldr r8,=-257
         load_imm(rs_reg_no, off);
 
         // add r8,fp,r8
-        emit("add", rs_reg_name, base_reg_name, rs_reg_name);
+        emit(ArmOpcode::ARM_OP_ADD,
+             ArmOperand::makeReg(rs_reg_no),
+             ArmOperand::makeReg(base_reg_no),
+             ArmOperand::makeReg(rs_reg_no));
     }
 }
 
@@ -531,54 +627,66 @@ void ILocArm32::allocStack(Function * func, int tmp_reg_no)
     // 计算栈帧大小
     int off = func->getMaxDep();
 
-    // 不需要在栈内额外分配空间，则什么都不做
+    // 保存SP寄存器到FP寄存器中，出口处总是通过FP恢复SP，栈帧为空时也要设置
+    mov_reg(ARM32_FP_REG_NO, ARM32_SP_REG_NO);
+
+    // 不需要在栈内额外分配空间
     if (0 == off) {
         return;
     }
 
-    // 保存SP寄存器到FP寄存器中
-    mov_reg(ARM32_FP_REG_NO, ARM32_SP_REG_NO);
-
     if (PlatformArm32::constExpr(off)) {
         // sub sp,sp,#16
-        emit("sub", "sp", "sp", toStr(off));
+        emit(ArmOpcode::ARM_OP_SUB,
+             ArmOperand::makeReg(ARM32_SP_REG_NO),
+             ArmOperand::makeReg(ARM32_SP_REG_NO),
+             ArmOperand::makeImm(off));
     } else {
         // ldr r8,=257
         load_imm(tmp_reg_no, off);
 
         // sub sp,sp,r8
-        emit("sub", "sp", "sp", PlatformArm32::regName[tmp_reg_no]);
+        emit(ArmOpcode::ARM_OP_SUB,
+             ArmOperand::makeReg(ARM32_SP_REG_NO),
+             ArmOperand::makeReg(ARM32_SP_REG_NO),
+             ArmOperand::makeReg(tmp_reg_no));
     }
 }
 
 /// @brief 调用函数fun
 /// @param fun
-void ILocArm32::call_fun(std::string name)
+void ILocArm32::call_fun(const std::string & name)
 {
     // 函数返回值在r0,不需要保护
-    emit("bl", name);
+    emit(ArmOpcode::ARM_OP_BL, ArmOperand::makeName(ArmOperandKind::ARM_OPND_SYMBOL, nameId(name)));
 }
 
 /// @brief NOP操作
 void ILocArm32::nop()
 {
     // FIXME 无操作符，要确认是否用nop指令
-    emit("");
+    emit(ArmOpcode::ARM_OP_NOP);
 }
 
 ///
 /// @brief 无条件跳转指令
 /// @param label 目标Label名称
 ///
-void ILocArm32::jump(std::string label)
+void ILocArm32::jump(const std::string & label)
 {
-    emit("b", label);
+    int id = labelId(label);
+    labelRefs[id]++;
+
+    emit(ArmOpcode::ARM_OP_B, ArmOperand::makeName(ArmOperandKind::ARM_OPND_LABEL, id));
 }
 
 /// @brief 条件跳转指令
-/// @param op 操作码
+/// @param cond 条件
 /// @param label 目标Label名称
-void ILocArm32::branch(std::string op, std::string label)
+void ILocArm32::branch(ArmCond cond, const std::string & label)
 {
-    emit(op, label);
+    int id = labelId(label);
+    labelRefs[id]++;
+
+    emit(ArmOpcode::ARM_OP_B, ArmOperand::makeName(ArmOperandKind::ARM_OPND_LABEL, id), ArmOperand{}, ArmOperand{}, cond);
 }
@@ -2,8 +2,8 @@
 /// @file ILocArm32.h
 /// @brief 指令序列管理的头文件，ILOC的全称为Intermediate Language for Optimizing Compilers
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.6
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,93 +11,267 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>汇编输出到字符串，支持函数并行生成
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>指令直接追加到输出字符串，不产生临时字符串
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>指令改为枚举操作码与整数操作数，输出时才转为字符串
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>记录标签的引用计数，一遍删除无用标签
+/// <tr><td>2026-10-18 <td>1.5     <td>zenglj  <td>加载立即数改为公有，供剖析计数使用
+/// <tr><td>2026-10-18 <td>1.6     <td>zenglj  <td>增加名字表的获取
 /// </table>
 ///
 #pragma once
 
-#include <list>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "Module.h"
 
 #define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
 
+/// @brief ARM32指令的操作码
+enum class ArmOpcode : std::uint8_t {
+    ARM_OP_ADD,
+    ARM_OP_SUB,
+    ARM_OP_MUL,
+    ARM_OP_SDIV,
+    ARM_OP_NEG,
+    ARM_OP_MOV,
+    ARM_OP_MOVW,
+    ARM_OP_MOVT,
+    ARM_OP_LDR,
+    ARM_OP_STR,
+    ARM_OP_CMP,
+    ARM_OP_B,
+    ARM_OP_BL,
+    ARM_OP_BX,
+    ARM_OP_PUSH,
+    ARM_OP_POP,
+
+    /// @brief 标签，输出为名字加冒号
+    ARM_OP_LABEL,
+
+    /// @brief 注释，输出为@加内容
+    ARM_OP_COMMENT,
+
+    /// @brief 占位指令，不输出
+    ARM_OP_NOP,
+
+    ARM_OP_MAX,
+};
+
+/// @brief ARM32指令的执行条件
+enum class ArmCond : std::uint8_t {
+    /// @brief 无条件执行，不输出后缀
+    ARM_COND_AL,
+    ARM_COND_EQ,
+    ARM_COND_NE,
+    ARM_COND_GT,
+    ARM_COND_GE,
+    ARM_COND_LT,
+    ARM_COND_LE,
+
+    ARM_COND_MAX,
+};
+
+/// @brief 操作数的种类
+enum class ArmOperandKind : std::uint8_t {
+    /// @brief 无操作数
+    ARM_OPND_NONE,
+
+    /// @brief 寄存器 r0
+    ARM_OPND_REG,
+
+    /// @brief 立即数 #100
+    ARM_OPND_IMM,
+
+    /// @brief 立即数的低16位 #:lower16:100
+    ARM_OPND_LOWER16,
+
+    /// @brief 立即数的高16位 #:upper16:100
+    ARM_OPND_UPPER16,
+
+    /// @brief 符号地址的低16位 #:lower16:a
+    ARM_OPND_LOWER16_SYM,
+
+    /// @brief 符号地址的高16位 #:upper16:a
+    ARM_OPND_UPPER16_SYM,
+
+    /// @brief 基址加立即数偏移寻址 [fp,#-16]，偏移为0时为[fp]
+    ARM_OPND_MEM,
+
+    /// @brief 基址加寄存器偏移寻址 [fp,r8]
+    ARM_OPND_MEM_REG,
+
+    /// @brief 寄存器列表 {r10,fp,lr}
+    ARM_OPND_REG_LIST,
+
+    /// @brief 标签
+    ARM_OPND_LABEL,
+
+    /// @brief 符号，如函数名
+    ARM_OPND_SYMBOL,
+
+    /// @brief 注释等文本
+    ARM_OPND_TEXT,
+};
+
+/// @brief ARM32指令的操作数
+struct ArmOperand {
+
+    /// @brief 种类
+    ArmOperandKind kind = ArmOperandKind::ARM_OPND_NONE;
+
+    /// @brief 寄存器号，内存寻址时为基址寄存器号
+    std::uint8_t reg = 0;
+
+    /// @brief 寄存器偏移寻址时的偏移寄存器号
+    std::uint8_t index = 0;
+
+    /// @brief 立即数、偏移、寄存器列表的位图，或标签、符号、文本在名字表中的编号
+    std::int32_t value = 0;
+
+    /// @brief 寄存器操作数
+    static ArmOperand makeReg(int regNo)
+    {
+        return {ArmOperandKind::ARM_OPND_REG, (std::uint8_t) regNo, 0, 0};
+    }
+
+    /// @brief 立即数操作数
+    static ArmOperand makeImm(int32_t imm)
+    {
+        return {ArmOperandKind::ARM_OPND_IMM, 0, 0, imm};
+    }
+
+    /// @brief 基址加立即数偏移的内存操作数
+    static ArmOperand makeMem(int baseRegNo, int32_t offset = 0)
+    {
+        return {ArmOperandKind::ARM_OPND_MEM, (std::uint8_t) baseRegNo, 0, offset};
+    }
+
+    /// @brief 基址加寄存器偏移的内存操作数
+    static ArmOperand makeMemReg(int baseRegNo, int indexRegNo)
+    {
+        return {ArmOperandKind::ARM_OPND_MEM_REG, (std::uint8_t) baseRegNo, (std::uint8_t) indexRegNo, 0};
+    }
+
+    /// @brief 寄存器列表操作数
+    /// @param mask 寄存器位图，第i位对应ri
+    static ArmOperand makeRegList(std::uint32_t mask)
+    {
+        return {ArmOperandKind::ARM_OPND_REG_LIST, 0, 0, (std::int32_t) mask};
+    }
+
+    /// @brief 名字表中的标签、符号或文本
+    static ArmOperand makeName(ArmOperandKind kind, int id)
+    {
+        return {kind, 0, 0, id};
+    }
+
+    /// @brief 是否有操作数
+    bool empty() const
+    {
+        return kind == ArmOperandKind::ARM_OPND_NONE;
+    }
+
+    /// @brief 操作数输出
+    /// @param str 追加到该字符串中
+    /// @param names 标签、符号与文本的名字表
+    void outPut(std::string & str, const std::vector<std::string> & names) const;
+};
+
 /// @brief 底层汇编指令：ARM32
 struct ArmInst {
 
     /// @brief 操作码
-    std::string opcode;
+    ArmOpcode opcode;
 
     /// @brief 条件
-    std::string cond;
+    ArmCond cond;
+
+    /// @brief 标识指令是否无效
+    bool dead = false;
 
     /// @brief 结果
-    std::string result;
+    ArmOperand result;
 
     /// @brief 源操作数1
-    std::string arg1;
+    ArmOperand arg1;
 
     /// @brief 源操作数2
-    std::string arg2;
-
-    /// @brief 附加信息
-    std::string addition;
-
-    /// @brief 标识指令是否无效
-    bool dead;
+    ArmOperand arg2;
 
     /// @brief 构造函数
-    /// @param op
-    /// @param rs
-    /// @param s1
-    /// @param s2
-    /// @param add
-    ArmInst(std::string op,
-            std::string rs = "",
-            std::string s1 = "",
-            std::string s2 = "",
-            std::string cond = "",
-            std::string extra = "");
-
-    /// @brief 指令更新
-    /// @param op
-    /// @param rs
-    /// @param s1
-    /// @param s2
-    /// @param add
-    void replace(std::string op,
-                 std::string rs = "",
-                 std::string s1 = "",
-                 std::string s2 = "",
-                 std::string cond = "",
-                 std::string extra = "");
+    /// @param op 操作码
+    /// @param rs 结果
+    /// @param s1 源操作数1
+    /// @param s2 源操作数2
+    /// @param cond 条件
+    ArmInst(ArmOpcode op,
+            ArmOperand rs = {},
+            ArmOperand s1 = {},
+            ArmOperand s2 = {},
+            ArmCond cond = ArmCond::ARM_COND_AL);
 
     /// @brief 设置死指令
     void setDead();
 
+    /// @brief 是否是标签
+    bool isLabel() const
+    {
+        return opcode == ArmOpcode::ARM_OP_LABEL;
+    }
+
+    /// @brief 是否是跳转到标签的指令，含条件跳转
+    bool isBranch() const
+    {
+        return (opcode == ArmOpcode::ARM_OP_B) && (result.kind == ArmOperandKind::ARM_OPND_LABEL);
+    }
+
     /// @brief 指令字符串输出函数
-    /// @return
-    std::string outPut();
+    /// @param str 指令追加到该字符串中，无效指令不追加
+    /// @param names 标签、符号与文本的名字表
+    void outPut(std::string & str, const std::vector<std::string> & names) const;
 };
 
+/// @brief 条件取反
+/// @param cond 条件，不能是无条件
+/// @return 取反后的条件
+ArmCond invertCond(ArmCond cond);
+
 /// @brief 底层汇编序列-ARM32
 class ILocArm32 {
 
     /// @brief ARM汇编序列
-    std::list<ArmInst *> code;
+    std::vector<ArmInst> code;
+
+    /// @brief 标签、符号与注释文本的名字表，操作数中记录编号
+    std::vector<std::string> names;
+
+    /// @brief 标签名字-名字表中的编号，同名标签的编号相同
+    std::unordered_map<std::string, int> labelIds;
+
+    /// @brief 按名字表编号记录的标签被跳转指令引用的次数，产生或改写跳转指令时维护
+    std::vector<int32_t> labelRefs;
 
     /// @brief 符号表
     Module * module;
 
-    /// @brief 加载立即数 ldr r0,=#100
-    /// @param rs_reg_no 结果寄存器号
-    /// @param num 立即数
-    void load_imm(int rs_reg_no, int num);
+    /// @brief 获取标签的编号，第一次出现时加入名字表
+    /// @param name 标签名字
+    /// @return 编号
+    int labelId(const std::string & name);
+
+    /// @brief 符号或文本加入名字表
+    /// @param name 名字
+    /// @return 编号
+    int nameId(const std::string & name);
 
     /// @brief 加载符号值 ldr r0,=g; ldr r0,[r0]
     /// @param rsReg 结果寄存器号
     /// @param name Label名字
-    void load_symbol(int rs_reg_no, std::string name);
+    void load_symbol(int rs_reg_no, const std::string & name);
 
     /// @brief 加载栈内变量地址
     /// @param rsReg 结果寄存器号
@@ -113,21 +287,24 @@ public:
     /// @brief 析构函数
     ~ILocArm32();
 
+    /// @brief 加载立即数 ldr r0,=#100
+    /// @param rs_reg_no 结果寄存器号
+    /// @param num 立即数
+    void load_imm(int rs_reg_no, int num);
+
     ///
     /// @brief 注释指令，不包含分号
     /// @param str 注释内容
     ///
-    void comment(std::string str);
-
-    /// @brief 数字变字符串，若flag为真，则变为立即数寻址（加#）
-    /// @param num 立即数
-    /// @param flag 是否家#
-    /// @return 字符串
-    std::string toStr(int num, bool flag = true);
+    void comment(const std::string & str);
 
     /// @brief 获取当前的代码序列
     /// @return 代码序列
-    std::list<ArmInst *> & getCode();
+    std::vector<ArmInst> & getCode();
+
+    /// @brief 获取标签、符号与文本的名字表
+    /// @return 名字表
+    const std::vector<std::string> & getNames() const;
 
     /// @brief Load指令，基址寻址 ldr r0,[fp,#100]
     /// @param rs_reg_no 结果寄存器
@@ -144,31 +321,19 @@ public:
 
     /// @brief 标签指令
     /// @param name
-    void label(std::string name);
-
-    /// @brief 一个操作数指令
-    /// @param op 操作码
-    /// @param rs 操作数
-    void inst(std::string op, std::string rs);
+    void label(const std::string & name);
 
-    /// @brief 一个操作数指令
+    /// @brief 普通指令，无结果的指令（如cmp）第一个源操作数放在rs中
     /// @param op 操作码
-    /// @param rs 操作数
-    /// @param arg1 源操作数
-    void inst(std::string op, std::string rs, std::string arg1);
-
-    /// @brief 一个操作数指令
-    /// @param op 操作码
-    /// @param rs 操作数
+    /// @param rs 结果操作数
     /// @param arg1 源操作数
     /// @param arg2 源操作数
-    void inst(std::string op, std::string rs, std::string arg1, std::string arg2);
-
-    /// @brief 无结果，两个操作数指令
-	/// @param op 操作码
-	/// @param arg1 源操作数
-	/// @param arg2 源操作数
-	void inst_no_res(std::string op, std::string arg1, std::string arg2);
+    /// @param cond 条件
+    void inst(ArmOpcode op,
+              ArmOperand rs,
+              ArmOperand arg1 = {},
+              ArmOperand arg2 = {},
+              ArmCond cond = ArmCond::ARM_COND_AL);
 
     /// @brief 加载变量到寄存器
     /// @param rs_reg_no 结果寄存器
@@ -193,7 +358,7 @@ public:
 
     /// @brief 调用函数fun
     /// @param fun
-    void call_fun(std::string name);
+    void call_fun(const std::string & name);
 
     /// @brief 分配栈帧
     /// @param func 函数
@@ -211,19 +376,32 @@ public:
     /// @brief 无条件跳转指令
     /// @param label 目标Label名称
     ///
-    void jump(std::string label);
+    void jump(const std::string & label);
 
     ///
     /// @brief 条件跳转指令
-    /// @param op 操作码
+    /// @param cond 条件
     /// @param label 目标Label名称
     ///
-	void branch(std::string op, std::string label);
+    void branch(ArmCond cond, const std::string & label);
 
     /// @brief 输出汇编
-    /// @param file 输出的文件指针
+    /// @param text 汇编代码追加到该字符串中
     /// @param outputEmpty 是否输出空语句
-    void outPut(FILE * file, bool outputEmpty = false);
+    void outPut(std::string & text, bool outputEmpty = false);
+
+    ///
+    /// @brief 设置死指令，是跳转指令时减少目标标签的引用计数
+    /// @param arm 指令，必须属于本序列
+    ///
+    void setDead(ArmInst & arm);
+
+    ///
+    /// @brief 修改跳转指令的目标标签，同时维护新旧标签的引用计数
+    /// @param arm 跳转指令，必须属于本序列
+    /// @param label 新的目标Label名称
+    ///
+    void setBranchTarget(ArmInst & arm, const std::string & label);
 
     /// @brief 删除无用的Label指令
     void deleteUnusedLabel();
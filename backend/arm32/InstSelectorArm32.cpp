@@ -2,8 +2,8 @@
 /// @file InstSelectorArm32.cpp
 /// @brief 指令选择器-ARM32的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.4
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,10 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>释放临时指令前解除操作数的使用
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>使用枚举操作码、条件与寄存器号生成指令
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>增加剖析计数指令的翻译，跳转到紧随其后的Label时不产生跳转指令
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>图着色分配后按各指令处被占用的寄存器分配临时寄存器
 /// </table>
 ///
 #include <cstdint>
@@ -19,6 +23,7 @@
 #include "ArrayType.h"
 #include "BranchInstruction.h"
 #include "Common.h"
+#include "CounterInstruction.h"
 #include "GlobalVariable.h"
 #include "ILocArm32.h"
 #include "InstSelectorArm32.h"
@@ -75,6 +80,8 @@ InstSelectorArm32::InstSelectorArm32(vector<Instruction *> & _irCode,
 
     translator_handlers[IRInstOperator::IRINST_OP_FUNC_CALL] = &InstSelectorArm32::translate_call;
     translator_handlers[IRInstOperator::IRINST_OP_ARG] = &InstSelectorArm32::translate_arg;
+
+    translator_handlers[IRInstOperator::IRINST_OP_COUNTER] = &InstSelectorArm32::translate_counter;
 }
 
 ///
@@ -86,15 +93,40 @@ InstSelectorArm32::~InstSelectorArm32()
 /// @brief 指令选择执行
 void InstSelectorArm32::run()
 {
-    for (auto inst: ir) {
+    for (size_t k = 0; k < ir.size(); ++k) {
+
+        Instruction * inst = ir[k];
 
         // 逐个指令进行翻译
         if (!inst->isDead()) {
+
+            // 跳转到紧随其后的Label时可顺序执行，不需要跳转指令
+            size_t next = k + 1;
+            while ((next < ir.size()) && ir[next]->isDead()) {
+                ++next;
+            }
+            nextInst = (next < ir.size()) ? ir[next] : nullptr;
+
+            // 已分配给值并且在该指令处被占用的寄存器不能作为临时寄存器
+            if (reservedRegs) {
+                simpleRegisterAllocator.setReserved((*reservedRegs)[k]);
+            }
+
             translate(inst);
         }
     }
 }
 
+///
+/// @brief 是否顺序执行就到达Label指令，即下一条有效的IR指令是该Label指令
+/// @param label Label指令
+/// @return true：是，不需要跳转，false：否
+///
+bool InstSelectorArm32::isFallthrough(Instruction * label) const
+{
+    return label == nextInst;
+}
+
 /// @brief 指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate(Instruction * inst)
@@ -153,8 +185,10 @@ void InstSelectorArm32::translate_goto(Instruction * inst)
 {
     Instanceof(gotoInst, GotoInstruction *, inst);
 
-    // 无条件跳转
-    iloc.jump(gotoInst->getTarget()->getName());
+    // 无条件跳转，目标紧随其后时顺序执行即可
+    if (!isFallthrough(gotoInst->getTarget())) {
+        iloc.jump(gotoInst->getTarget()->getName());
+    }
 }
 
 /// @brief 函数入口指令翻译成ARM32汇编
@@ -162,21 +196,9 @@ void InstSelectorArm32::translate_goto(Instruction * inst)
 void InstSelectorArm32::translate_entry(Instruction * inst)
 {
     // 查看保护的寄存器
-    auto & protectedRegNo = func->getProtectedReg();
-    auto & protectedRegStr = func->getProtectedRegStr();
-
-    bool first = true;
-    for (auto regno: protectedRegNo) {
-        if (first) {
-            protectedRegStr = PlatformArm32::regName[regno];
-            first = false;
-        } else {
-            protectedRegStr += "," + PlatformArm32::regName[regno];
-        }
-    }
-
-    if (!protectedRegStr.empty()) {
-        iloc.inst("push", "{" + protectedRegStr + "}");
+    uint32_t protectedRegMask = getProtectedRegMask();
+    if (protectedRegMask) {
+        iloc.inst(ArmOpcode::ARM_OP_PUSH, ArmOperand::makeRegList(protectedRegMask));
     }
 
     // 为fun分配栈帧，含局部变量、函数调用值传递的空间等
@@ -196,15 +218,27 @@ void InstSelectorArm32::translate_exit(Instruction * inst)
     }
 
     // 恢复栈空间
-    iloc.inst("mov", "sp", "fp");
+    iloc.mov_reg(ARM32_SP_REG_NO, ARM32_FP_REG_NO);
 
     // 保护寄存器的恢复
-    auto & protectedRegStr = func->getProtectedRegStr();
-    if (!protectedRegStr.empty()) {
-        iloc.inst("pop", "{" + protectedRegStr + "}");
+    uint32_t protectedRegMask = getProtectedRegMask();
+    if (protectedRegMask) {
+        iloc.inst(ArmOpcode::ARM_OP_POP, ArmOperand::makeRegList(protectedRegMask));
     }
 
-    iloc.inst("bx", "lr");
+    iloc.inst(ArmOpcode::ARM_OP_BX, ArmOperand::makeReg(ARM32_LX_REG_NO));
+}
+
+/// @brief 获取函数需要保护的寄存器位图
+/// @return 位图，第i位对应ri
+uint32_t InstSelectorArm32::getProtectedRegMask()
+{
+    uint32_t mask = 0;
+    for (auto regno: func->getProtectedReg()) {
+        mask |= 1u << regno;
+    }
+
+    return mask;
 }
 
 /// @brief 赋值指令翻译成ARM32汇编
@@ -273,7 +307,7 @@ void InstSelectorArm32::translate_assign(Instruction * inst)
 /// @param operator_name 操作码
 /// @param rs_reg_no 结果寄存器号
 /// @param op1_reg_no 源操作数1寄存器号
-void InstSelectorArm32::translate_one_operator(Instruction * inst, string operator_name)
+void InstSelectorArm32::translate_one_operator(Instruction * inst, ArmOpcode operator_name)
 {
     Value * result = inst;
     Value * arg1 = inst->getOperand(0);
@@ -303,9 +337,7 @@ void InstSelectorArm32::translate_one_operator(Instruction * inst, string operat
     }
 
     // r8 -> r10
-    iloc.inst(operator_name,
-              PlatformArm32::regName[load_result_reg_no],
-              PlatformArm32::regName[load_arg1_reg_no]);
+    iloc.inst(operator_name, ArmOperand::makeReg(load_result_reg_no), ArmOperand::makeReg(load_arg1_reg_no));
 
     // 结果不是寄存器，则需要把rs_reg_name保存到结果变量中
     if (result_reg_no == -1) {
@@ -327,7 +359,7 @@ void InstSelectorArm32::translate_one_operator(Instruction * inst, string operat
 /// @param rs_reg_no 结果寄存器号
 /// @param op1_reg_no 源操作数1寄存器号
 /// @param op2_reg_no 源操作数2寄存器号
-void InstSelectorArm32::translate_two_operator(Instruction * inst, string operator_name)
+void InstSelectorArm32::translate_two_operator(Instruction * inst, ArmOpcode operator_name)
 {
     Value * result = inst;
     Value * arg1 = inst->getOperand(0);
@@ -424,9 +456,9 @@ void InstSelectorArm32::translate_two_operator(Instruction * inst, string operat
 
     // r8 + r9 -> r10
     iloc.inst(operator_name,
-              PlatformArm32::regName[load_result_reg_no],
-              PlatformArm32::regName[load_arg1_reg_no],
-              PlatformArm32::regName[load_arg2_reg_no]);
+              ArmOperand::makeReg(load_result_reg_no),
+              ArmOperand::makeReg(load_arg1_reg_no),
+              ArmOperand::makeReg(load_arg2_reg_no));
 
     // 结果不是寄存器，则需要把rs_reg_name保存到结果变量中
     if (result_reg_no == -1) {
@@ -445,8 +477,8 @@ void InstSelectorArm32::translate_two_operator(Instruction * inst, string operat
 
 /// @brief 无结果寄存器指令翻译成ARM32汇编
 /// @param inst IR指令
-/// @param operator_name 操作码
-void InstSelectorArm32::translate_no_result(Instruction * inst, string operator_name)
+/// @param cond 比较的条件
+void InstSelectorArm32::translate_no_result(Instruction * inst, ArmCond cond)
 {
     Value * arg1 = inst->getOperand(0);
     Value * arg2 = inst->getOperand(1);
@@ -480,9 +512,7 @@ void InstSelectorArm32::translate_no_result(Instruction * inst, string operator_
     }
 
     // r8 + r9
-    iloc.inst_no_res("cmp",
-              PlatformArm32::regName[load_arg1_reg_no],
-              PlatformArm32::regName[load_arg2_reg_no]);
+    iloc.inst(ArmOpcode::ARM_OP_CMP, ArmOperand::makeReg(load_arg1_reg_no), ArmOperand::makeReg(load_arg2_reg_no));
 
     // 如果当前这条指令的结果在后续将会被使用
     if (inst->isUsed()) {
@@ -495,31 +525,18 @@ void InstSelectorArm32::translate_no_result(Instruction * inst, string operator_
 			load_result_reg_no = result_reg_no;
         }
         
-        if (operator_name == "bgt") {
-            iloc.inst("movgt", PlatformArm32::regName[load_result_reg_no], "#1");
-            iloc.inst("movle", PlatformArm32::regName[load_result_reg_no], "#0");
-            iloc.store_var(load_result_reg_no, inst, ARM32_TMP_REG_NO);
-        } else if (operator_name == "blt") {
-            iloc.inst("movlt", PlatformArm32::regName[load_result_reg_no], "#1");
-            iloc.inst("movge", PlatformArm32::regName[load_result_reg_no], "#0");
-            iloc.store_var(load_result_reg_no, inst, ARM32_TMP_REG_NO);
-        } else if (operator_name == "bge") {
-            iloc.inst("movge", PlatformArm32::regName[load_result_reg_no], "#1");
-            iloc.inst("movlt", PlatformArm32::regName[load_result_reg_no], "#0");
-            iloc.store_var(load_result_reg_no, inst, ARM32_TMP_REG_NO);
-        } else if (operator_name == "ble") {
-            iloc.inst("movle", PlatformArm32::regName[load_result_reg_no], "#1");
-            iloc.inst("movgt", PlatformArm32::regName[load_result_reg_no], "#0");
-            iloc.store_var(load_result_reg_no, inst, ARM32_TMP_REG_NO);
-        } else if (operator_name == "beq") {
-            iloc.inst("moveq", PlatformArm32::regName[load_result_reg_no], "#1");
-            iloc.inst("movne", PlatformArm32::regName[load_result_reg_no], "#0");
-            iloc.store_var(load_result_reg_no, inst, ARM32_TMP_REG_NO);
-        } else if (operator_name == "bne") {
-            iloc.inst("movne", PlatformArm32::regName[load_result_reg_no], "#1");
-            iloc.inst("moveq", PlatformArm32::regName[load_result_reg_no], "#0");
-            iloc.store_var(load_result_reg_no, inst, ARM32_TMP_REG_NO);
-        }
+        // 条件成立时为1，否则为0
+        iloc.inst(ArmOpcode::ARM_OP_MOV,
+                  ArmOperand::makeReg(load_result_reg_no),
+                  ArmOperand::makeImm(1),
+                  {},
+                  cond);
+        iloc.inst(ArmOpcode::ARM_OP_MOV,
+                  ArmOperand::makeReg(load_result_reg_no),
+                  ArmOperand::makeImm(0),
+                  {},
+                  invertCond(cond));
+        iloc.store_var(load_result_reg_no, inst, ARM32_TMP_REG_NO);
 
         simpleRegisterAllocator.free(inst);
 	}
@@ -533,35 +550,35 @@ void InstSelectorArm32::translate_no_result(Instruction * inst, string operator_
 /// @param inst IR指令
 void InstSelectorArm32::translate_add_int32(Instruction * inst)
 {
-    translate_two_operator(inst, "add");
+    translate_two_operator(inst, ArmOpcode::ARM_OP_ADD);
 }
 
 /// @brief 整数减法指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_sub_int32(Instruction * inst)
 {
-    translate_two_operator(inst, "sub");
+    translate_two_operator(inst, ArmOpcode::ARM_OP_SUB);
 }
 
 /// @brief 整数求负指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_minus_int32(Instruction * inst)
 {
-    translate_one_operator(inst, "neg");
+    translate_one_operator(inst, ArmOpcode::ARM_OP_NEG);
 }
 
 /// @brief 整数乘法指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_mul_int32(Instruction * inst)
 {
-    translate_two_operator(inst, "mul");
+    translate_two_operator(inst, ArmOpcode::ARM_OP_MUL);
 }
 
 /// @brief 整数除法指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_div_int32(Instruction * inst)
 {
-    translate_two_operator(inst, "sdiv");
+    translate_two_operator(inst, ArmOpcode::ARM_OP_SDIV);
 }
 
 /// @brief 整数取余指令翻译成ARM32汇编
@@ -615,22 +632,22 @@ void InstSelectorArm32::translate_mod_int32(Instruction * inst)
     }
 
     // 首先执行sdiv求商
-    iloc.inst("sdiv",
-              PlatformArm32::regName[quotient_reg_no],
-              PlatformArm32::regName[load_dividend_reg_no],
-              PlatformArm32::regName[load_divisor_reg_no]);
+    iloc.inst(ArmOpcode::ARM_OP_SDIV,
+              ArmOperand::makeReg(quotient_reg_no),
+              ArmOperand::makeReg(load_dividend_reg_no),
+              ArmOperand::makeReg(load_divisor_reg_no));
 
     // 接着计算商 * 除数
-    iloc.inst("mul",
-              PlatformArm32::regName[load_result_reg_no],
-              PlatformArm32::regName[quotient_reg_no],
-              PlatformArm32::regName[load_divisor_reg_no]);
+    iloc.inst(ArmOpcode::ARM_OP_MUL,
+              ArmOperand::makeReg(load_result_reg_no),
+              ArmOperand::makeReg(quotient_reg_no),
+              ArmOperand::makeReg(load_divisor_reg_no));
 
     // 最后计算余数，得到真正的结果
-    iloc.inst("sub",
-              PlatformArm32::regName[load_result_reg_no],
-              PlatformArm32::regName[load_dividend_reg_no],
-              PlatformArm32::regName[load_result_reg_no]);
+    iloc.inst(ArmOpcode::ARM_OP_SUB,
+              ArmOperand::makeReg(load_result_reg_no),
+              ArmOperand::makeReg(load_dividend_reg_no),
+              ArmOperand::makeReg(load_result_reg_no));
 
     // 结果不是寄存器，则需要把rs_reg_name保存到结果变量中
     if (result_reg_no == -1) {
@@ -652,45 +669,45 @@ void InstSelectorArm32::translate_mod_int32(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_gt_int32(Instruction * inst)
 {
-    translate_no_result(inst, "bgt");
+    translate_no_result(inst, ArmCond::ARM_COND_GT);
     haveCmp = true;
-    cmpType = "bgt";
+    cmpCond = ArmCond::ARM_COND_GT;
 }
 
 /// @brief 关系运算<指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_lt_int32(Instruction * inst)
 {
-	translate_no_result(inst, "blt");
+	translate_no_result(inst, ArmCond::ARM_COND_LT);
     haveCmp = true;
-    cmpType = "blt";
+    cmpCond = ArmCond::ARM_COND_LT;
 }
 
 /// @brief 关系运算>=指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_ge_int32(Instruction * inst)
 {
-	translate_no_result(inst, "bge");
+	translate_no_result(inst, ArmCond::ARM_COND_GE);
     haveCmp = true;
-    cmpType = "bge";
+    cmpCond = ArmCond::ARM_COND_GE;
 }
 
 /// @brief 关系运算<=指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_le_int32(Instruction * inst)
 {
-	translate_no_result(inst, "ble");
+	translate_no_result(inst, ArmCond::ARM_COND_LE);
     haveCmp = true;
-    cmpType = "ble";
+    cmpCond = ArmCond::ARM_COND_LE;
 }
 
 /// @brief 关系运算==指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_eq_int32(Instruction * inst)
 {
-	translate_no_result(inst, "beq");
+	translate_no_result(inst, ArmCond::ARM_COND_EQ);
     haveCmp = true;
-    cmpType = "beq";
+    cmpCond = ArmCond::ARM_COND_EQ;
 
 }
 
@@ -698,9 +715,9 @@ void InstSelectorArm32::translate_eq_int32(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_ne_int32(Instruction * inst)
 {
-	translate_no_result(inst, "bne");
+	translate_no_result(inst, ArmCond::ARM_COND_NE);
     haveCmp = true;
-    cmpType = "bne";
+    cmpCond = ArmCond::ARM_COND_NE;
 }
 
 /// @brief 分支跳转指令翻译成ARM32汇编
@@ -712,10 +729,16 @@ void InstSelectorArm32::translate_branch(Instruction * inst)
     auto falseLbel = branchInst->getTarget2()->getName();
 
     if (haveCmp == true) {
-        iloc.branch(cmpType, trueLabel);
-        iloc.jump(falseLbel);
+        // 紧随其后的目标不需要跳转，真目标紧随其后时条件取反跳转到假目标
+        if (isFallthrough(branchInst->getTarget1())) {
+            iloc.branch(invertCond(cmpCond), falseLbel);
+        } else {
+            iloc.branch(cmpCond, trueLabel);
+            if (!isFallthrough(branchInst->getTarget2())) {
+                iloc.jump(falseLbel);
+            }
+        }
         haveCmp = false;
-        cmpType.clear();
 	}
 }
 
@@ -744,9 +767,7 @@ void InstSelectorArm32::translate_load(Instruction * inst)
         load_addr_reg_no = addr_reg_no;
 	}
 
-    iloc.inst("ldr",
-              PlatformArm32::regName[load_result_reg_no],
-              "[" + PlatformArm32::regName[load_addr_reg_no] + "]");
+    iloc.inst(ArmOpcode::ARM_OP_LDR, ArmOperand::makeReg(load_result_reg_no), ArmOperand::makeMem(load_addr_reg_no));
 
     if (result_reg_no != load_result_reg_no) {
         iloc.store_var(load_result_reg_no, result, ARM32_TMP_REG_NO);
@@ -781,9 +802,7 @@ void InstSelectorArm32::translate_store(Instruction * inst)
         load_result_reg_no = result_reg_no;
     }
 
-    iloc.inst("str",
-              PlatformArm32::regName[load_result_reg_no],
-              "[" + PlatformArm32::regName[load_addr_reg_no] + "]");
+    iloc.inst(ArmOpcode::ARM_OP_STR, ArmOperand::makeReg(load_result_reg_no), ArmOperand::makeMem(load_addr_reg_no));
 
     simpleRegisterAllocator.free(addr);
     simpleRegisterAllocator.free(result);
@@ -835,6 +854,8 @@ void InstSelectorArm32::translate_call(Instruction * inst)
             // 翻译赋值指令
             translate_assign(assignInst);
 
+            // 临时指令释放前先解除对操作数的使用，避免在共享的寄存器Value中残留Use
+            assignInst->clearOperands();
             delete assignInst;
         }
 
@@ -851,6 +872,7 @@ void InstSelectorArm32::translate_call(Instruction * inst)
             // 翻译赋值指令
             translate_assign(assignInst);
 
+            assignInst->clearOperands();
             delete assignInst;
         }
     }
@@ -873,6 +895,7 @@ void InstSelectorArm32::translate_call(Instruction * inst)
         // 翻译赋值指令
         translate_assign(assignInst);
 
+        assignInst->clearOperands();
         delete assignInst;
     }
 
@@ -914,3 +937,38 @@ void InstSelectorArm32::translate_arg(Instruction * inst)
 
     realArgCount++;
 }
+
+///
+/// @brief 剖析计数指令翻译成ARM32汇编，计数器表的元素加一
+/// @param inst IR指令
+///
+void InstSelectorArm32::translate_counter(Instruction * inst)
+{
+    Instanceof(counterInst, CounterInstruction *, inst);
+
+    int32_t offset = counterInst->getIndex() * 4;
+
+    // r10 = 计数器表的地址，偏移超出ldr/str的范围时加到地址上
+    iloc.lea_var(ARM32_TMP_REG_NO, counterInst->getTable());
+
+    int32_t count_reg_no = simpleRegisterAllocator.Allocate();
+
+    if (!PlatformArm32::isDisp(offset)) {
+        iloc.load_imm(count_reg_no, offset);
+        iloc.inst(ArmOpcode::ARM_OP_ADD,
+                  ArmOperand::makeReg(ARM32_TMP_REG_NO),
+                  ArmOperand::makeReg(ARM32_TMP_REG_NO),
+                  ArmOperand::makeReg(count_reg_no));
+        offset = 0;
+    }
+
+    // ldr r0,[r10,#off]; add r0,r0,#1; str r0,[r10,#off]
+    iloc.inst(ArmOpcode::ARM_OP_LDR, ArmOperand::makeReg(count_reg_no), ArmOperand::makeMem(ARM32_TMP_REG_NO, offset));
+    iloc.inst(ArmOpcode::ARM_OP_ADD,
+              ArmOperand::makeReg(count_reg_no),
+              ArmOperand::makeReg(count_reg_no),
+              ArmOperand::makeImm(1));
+    iloc.inst(ArmOpcode::ARM_OP_STR, ArmOperand::makeReg(count_reg_no), ArmOperand::makeMem(ARM32_TMP_REG_NO, offset));
+
+    simpleRegisterAllocator.free(count_reg_no);
+}
@@ -2,8 +2,8 @@
 /// @file InstSelectorArm32.h
 /// @brief 指令选择器-ARM32
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.3
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,9 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>使用枚举操作码、条件与寄存器号生成指令
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>增加剖析计数指令的翻译，跳转到紧随其后的Label时不产生跳转指令
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>图着色分配后按各指令处被占用的寄存器分配临时寄存器
 /// </table>
 ///
 #pragma once
@@ -123,18 +126,18 @@ protected:
 
     /// @brief 一元操作指令翻译成ARM32汇编
     /// @param inst IR指令
-    /// @param parameter_name 操作码
-    void translate_one_operator(Instruction * inst, string operator_name);
+    /// @param operator_name 操作码
+    void translate_one_operator(Instruction * inst, ArmOpcode operator_name);
 
     /// @brief 二元操作指令翻译成ARM32汇编
     /// @param inst IR指令
     /// @param operator_name 操作码
-    void translate_two_operator(Instruction * inst, string operator_name);
+    void translate_two_operator(Instruction * inst, ArmOpcode operator_name);
 
     /// @brief 无结果寄存器指令翻译成ARM32汇编
     /// @param inst IR指令
-    /// @param operator_name 操作码
-    void translate_no_result(Instruction * inst, string operator_name);
+    /// @param cond 比较的条件
+    void translate_no_result(Instruction * inst, ArmCond cond);
 
     /// @brief 加载指令翻译成ARM32汇编
     /// @param inst IR指令
@@ -154,11 +157,28 @@ protected:
     ///
     void translate_arg(Instruction * inst);
 
+    ///
+    /// @brief 剖析计数指令翻译成ARM32汇编
+    /// @param inst IR指令
+    ///
+    void translate_counter(Instruction * inst);
+
+    ///
+    /// @brief 是否顺序执行就到达Label指令，即下一条有效的IR指令是该Label指令
+    /// @param label Label指令
+    /// @return true：是，不需要跳转，false：否
+    ///
+    bool isFallthrough(Instruction * label) const;
+
     ///
     /// @brief 输出IR指令
     ///
     void outputIRInstruction(Instruction * inst);
 
+    /// @brief 获取函数需要保护的寄存器位图
+    /// @return 位图，第i位对应ri
+    uint32_t getProtectedRegMask();
+
     /// @brief IR翻译动作函数原型
     typedef void (InstSelectorArm32::*translate_handler)(Instruction *);
 
@@ -186,8 +206,14 @@ protected:
     /// @brief 判断先前是否有cmp指令
     bool haveCmp = false;
 
-    /// @brief 保存关系运算类型
-    std::string cmpType;
+    /// @brief 保存关系运算的条件
+    ArmCond cmpCond = ArmCond::ARM_COND_AL;
+
+    /// @brief 正在翻译的IR指令之后的下一条有效指令，没有时为空
+    Instruction * nextInst = nullptr;
+
+    /// @brief 各条IR指令处被占用、不能作为临时寄存器的寄存器，为空时不限制
+    const std::vector<uint32_t> * reservedRegs = nullptr;
 
 public:
     /// @brief 构造函数
@@ -213,6 +239,15 @@ public:
         showLinearIR = show;
     }
 
+    ///
+    /// @brief 设置各条IR指令处被占用的寄存器，图着色分配寄存器后使用
+    /// @param masks 按IR指令位置的位图，第i位对应ri，为空时不限制
+    ///
+    void setReservedRegs(const std::vector<uint32_t> * masks)
+    {
+        reservedRegs = masks;
+    }
+
     /// @brief 指令选择
     void run();
 };
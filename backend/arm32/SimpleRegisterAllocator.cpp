@@ -2,8 +2,8 @@
 /// @file SimpleRegisterAllocator.cpp
 /// @brief 简单或朴素的寄存器分配器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,9 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>每个函数一个分配器，析构时释放仍占用的Load寄存器
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>寄存器位图改用DynBitSet
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>增加不可分配的保留寄存器，供图着色分配后的指令选择使用
 /// </table>
 ///
 #include <algorithm>
@@ -22,6 +25,16 @@
 SimpleRegisterAllocator::SimpleRegisterAllocator()
 {}
 
+///
+/// @brief 析构时释放变量仍占用的Load寄存器，避免常量等共享变量的分配结果带入下一个函数
+///
+SimpleRegisterAllocator::~SimpleRegisterAllocator()
+{
+    for (auto var: regValues) {
+        var->setLoadRegId(-1);
+    }
+}
+
 ///
 /// @brief 分配一个寄存器。如果没有，则选取寄存器中最晚使用的寄存器，同时溢出寄存器到变量中
 /// @return int 寄存器编号
@@ -36,22 +49,21 @@ int SimpleRegisterAllocator::Allocate(Value * var, int32_t no)
 
     int32_t regno = -1;
 
+    // 保留的寄存器视为已被占用
+    DynBitSet busy = regBitmap;
+    busy |= reserved;
+
     // 尝试指定的寄存器是否可用
-    if ((no != -1) && !regBitmap.test(no)) {
+    if ((no != -1) && !busy.test(no)) {
 
         // 可用
         regno = no;
     } else {
 
-        // 查询空闲的寄存器
-        for (int k = 0; k < PlatformArm32::maxUsableRegNum; ++k) {
-
-            if (!regBitmap.test(k)) {
-
-                // 找到空闲寄存器
-                regno = k;
-                break;
-            }
+        // 查询编号最小的空闲寄存器
+        size_t k = busy.findFirstZero();
+        if (k != DynBitSet::npos) {
+            regno = (int32_t) k;
         }
     }
 
@@ -147,6 +159,21 @@ void SimpleRegisterAllocator::free(int32_t no)
     }
 }
 
+///
+/// @brief 设置不可分配的寄存器，即图着色分配给值的、在当前指令处被占用的寄存器
+/// @param mask 位图，第i位对应ri
+///
+void SimpleRegisterAllocator::setReserved(uint32_t mask)
+{
+    for (int32_t no = 0; no < PlatformArm32::maxUsableRegNum; no++) {
+        if (mask & (1u << no)) {
+            reserved.set(no);
+        } else {
+            reserved.reset(no);
+        }
+    }
+}
+
 ///
 /// @brief 寄存器被置位，使用过的寄存器被置位
 /// @param no
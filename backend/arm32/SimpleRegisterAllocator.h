@@ -2,8 +2,8 @@
 /// @file SimpleRegisterAllocator.h
 /// @brief 简单或朴素的寄存器分配器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,13 +11,17 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>每个函数一个分配器，析构时释放仍占用的Load寄存器
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>寄存器位图改用DynBitSet
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>增加不可分配的保留寄存器，供图着色分配后的指令选择使用
 /// </table>
 ///
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
-#include "BitMap.h"
+#include "DynBitSet.h"
 #include "Value.h"
 #include "PlatformArm32.h"
 
@@ -29,6 +33,11 @@ public:
     ///
     SimpleRegisterAllocator();
 
+    ///
+    /// @brief 析构时释放变量仍占用的Load寄存器，避免常量等共享变量的分配结果带入下一个函数
+    ///
+    ~SimpleRegisterAllocator();
+
     ///
     /// @brief 尝试按指定的寄存器编号进行分配，若能分配，则直接分配，否则从小达到的次序分配一个寄存器。
     /// 如果没有，则选取寄存器中最晚使用的寄存器，同时溢出寄存器到变量中
@@ -56,6 +65,12 @@ public:
     ///
     void free(int32_t);
 
+    ///
+    /// @brief 设置不可分配的寄存器，即图着色分配给值的、在当前指令处被占用的寄存器
+    /// @param mask 位图，第i位对应ri
+    ///
+    void setReserved(uint32_t mask);
+
 protected:
     ///
     /// @brief 寄存器被置位，使用过的寄存器被置位
@@ -67,7 +82,7 @@ protected:
     ///
     /// @brief 寄存器位图：1已被占用，0未被使用
     ///
-    BitMap<PlatformArm32::maxUsableRegNum> regBitmap;
+    DynBitSet regBitmap{PlatformArm32::maxUsableRegNum};
 
     ///
     /// @brief 寄存器被那个Value占用。按照时间次序加入
@@ -77,5 +92,10 @@ protected:
     ///
     /// @brief 使用过的所有寄存器编号
     ///
-    BitMap<PlatformArm32::maxUsableRegNum> usedBitmap;
+    DynBitSet usedBitmap{PlatformArm32::maxUsableRegNum};
+
+    ///
+    /// @brief 不可分配的寄存器
+    ///
+    DynBitSet reserved{PlatformArm32::maxUsableRegNum};
 };
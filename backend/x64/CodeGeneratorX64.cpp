@@ -0,0 +1,225 @@
+///
+/// @file CodeGeneratorX64.cpp
+/// @brief x86-64的后端处理实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>指令选择独立出来供JIT使用
+/// </table>
+///
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "CodeGeneratorX64.h"
+#include "BufferedWriter.h"
+#include "FormalParam.h"
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "GlobalVariable.h"
+#include "ILocX64.h"
+#include "InstSelectorX64.h"
+#include "Module.h"
+#include "PlatformX64.h"
+#include "PointerType.h"
+#include "RegisterAllocatorX64.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+CodeGeneratorX64::CodeGeneratorX64(Module * _module) : CodeGeneratorAsm(_module)
+{}
+
+/// @brief 析构函数
+CodeGeneratorX64::~CodeGeneratorX64()
+{}
+
+/// @brief 产生汇编头部分
+void CodeGeneratorX64::genHeader()
+{
+    // 栈不需要可执行，避免链接时的警告
+    out << ".section .note.GNU-stack,\"\",@progbits\n";
+}
+
+/// @brief 全局变量Section，主要包含初始化的和未初始化过的
+void CodeGeneratorX64::genDataSection()
+{
+    for (auto var: module->getGlobalVariables()) {
+
+        // 数组的类型为指向数组的指针，大小为数组的大小
+        int32_t size;
+        if (var->getType()->isPointerType()) {
+            Instanceof(pointer, PointerType *, var->getType());
+            size = pointer->getPointeeType()->getSize();
+        } else {
+            size = var->getType()->getSize();
+        }
+
+        if (var->isInBSSSection()) {
+            // 在BSS段的全局变量，可以包含初值全是0的变量
+            out << ".comm " << var->getName() << ", " << size << ", " << var->getAlignment() << '\n';
+        } else {
+            // 有初值的全局变量
+            out << ".globl " << var->getName() << '\n';
+            out << ".data\n";
+            out << ".align " << var->getAlignment() << '\n';
+            out << ".type " << var->getName() << ", @object\n";
+            out << ".size " << var->getName() << ", " << size << '\n';
+            out << var->getName() << ":\n";
+            if (var->hasInitVal()) {
+                out << ".long " << var->getInitVal()->getVal() << '\n';
+            } else {
+                out << ".zero " << size << '\n';
+            }
+        }
+    }
+}
+
+/// @brief 指令选择，JIT也由此得到函数的指令序列再编码为机器码
+/// @param func 要处理的函数，已经完成寄存器分配与Label命名
+/// @param iloc 指令序列
+void CodeGeneratorX64::instSelect(Function * func, ILocX64 & iloc)
+{
+    InstSelectorX64 instSelector(func->getInterCode().getInsts(), iloc, func);
+    instSelector.setShowLinearIR(this->showLinearIR);
+    instSelector.run();
+
+    // 删除无用的Label指令
+    iloc.deleteUnusedLabel();
+}
+
+/// @brief 针对函数进行汇编指令生成，放到.text代码段中
+/// @param func 要处理的函数
+/// @param text 函数的汇编代码追加到该字符串中
+void CodeGeneratorX64::genCodeSection(Function * func, std::string & text)
+{
+    const std::string & name = func->getName();
+
+    ILocX64 iloc;
+
+    {
+        TimeReport::Scope timer(timeReport, "isel", TimeReport::CPU_THREAD, &name);
+
+        instSelect(func, iloc);
+    }
+
+    TimeReport::Scope timer(timeReport, "emit", TimeReport::CPU_THREAD, &name);
+
+    // 有剖析数据时热函数与从未执行的函数分别放到.text.hot与.text.unlikely段
+    switch (func->getHotness()) {
+        case FunctionHotness::HOT:
+            text += ".section .text.hot,\"ax\",@progbits\n";
+            break;
+        case FunctionHotness::COLD:
+            text += ".section .text.unlikely,\"ax\",@progbits\n";
+            break;
+        default:
+            text += ".text\n";
+            break;
+    }
+
+    // 函数入口按16字节对齐，与gcc相同
+    text += ".p2align 4\n.globl ";
+    text += name;
+    text += "\n.type ";
+    text += name;
+    text += ", @function\n";
+    text += name;
+    text += ":\n";
+
+    iloc.outPut(text);
+
+    // 函数的大小，perf等工具据此把采样地址对应到函数
+    text += ".size ";
+    text += name;
+    text += ", .-";
+    text += name;
+    text += '\n';
+}
+
+/// @brief 寄存器分配
+/// @param func 函数指针
+void CodeGeneratorX64::registerAllocation(Function * func)
+{
+    // 内置函数不需要处理
+    if (func->isBuiltin()) {
+        return;
+    }
+
+    // 被调用者保存的寄存器分配给使用最频繁的变量，同时记录为需要保护的寄存器
+    RegisterAllocatorX64 allocator(func);
+    allocator.run();
+
+    // 其余的变量在栈内分配空间
+    stackAlloc(func);
+}
+
+/// @brief 栈空间分配，没有分配寄存器的变量都在栈中
+/// @param func 要处理的函数
+void CodeGeneratorX64::stackAlloc(Function * func)
+{
+    // 栈帧空间（低地址在前，高地址在后）
+    // --------------------- rsp，16字节对齐
+    // 第七个及之后的实参的栈传递空间
+    // ---------------------
+    // 没有分配寄存器的局部变量、形参、临时变量
+    // ---------------------
+    // 保护的被调用者保存的寄存器
+    // --------------------- rbp
+    // 保存的rbp、返回地址
+    // ---------------------
+    // 第七个及之后的形参，每个8字节
+    // ---------------------
+
+    int32_t savedSize = 8 * (int32_t) func->getProtectedReg().size();
+    int32_t sp_esp = savedSize;
+
+    auto alloc = [&](Value * var) {
+        int32_t size = PlatformX64::frameSize(var);
+        int32_t align = (size >= 8) ? 8 : 4;
+        sp_esp = (sp_esp + size + align - 1) & ~(align - 1);
+        return -sp_esp;
+    };
+
+    auto & params = func->getParams();
+    for (int k = 0; k < (int) params.size(); k++) {
+        if (k >= PlatformX64::maxArgRegNum) {
+            // 调用者栈中的实参，跳过保存的rbp与返回地址
+            params[k]->setMemoryAddr(X64_RBP_REG_NO, 16 + 8 * (k - PlatformX64::maxArgRegNum));
+        } else if (params[k]->getRegId() == -1) {
+            params[k]->setMemoryAddr(X64_RBP_REG_NO, alloc(params[k]));
+        }
+    }
+
+    for (auto var: func->getVarValues()) {
+        if ((var->getRegId() == -1) && (!var->getMemoryAddr())) {
+            var->setMemoryAddr(X64_RBP_REG_NO, alloc(var));
+        }
+    }
+
+    // 栈传递的实参个数
+    int32_t maxStackArgs = 0;
+
+    for (auto inst: func->getInterCode().getInsts()) {
+        if (inst->hasResultValue() && (inst->getRegId() == -1)) {
+            inst->setMemoryAddr(X64_RBP_REG_NO, alloc(inst));
+        }
+        if (Instanceof(callInst, FuncCallInstruction *, inst)) {
+            maxStackArgs = std::max(maxStackArgs, callInst->getOperandsNum() - PlatformX64::maxArgRegNum);
+        }
+    }
+
+    sp_esp += 8 * maxStackArgs;
+
+    // 进入函数时rsp加8为16的倍数，压入rbp后rbp为16的倍数，调用时rsp也要为16的倍数
+    sp_esp = (sp_esp + 15) & ~15;
+
+    // 保护寄存器的空间由push分配，这里只记录需要sub的大小
+    func->setMaxDep(sp_esp - savedSize);
+}
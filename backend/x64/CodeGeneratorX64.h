@@ -0,0 +1,59 @@
+///
+/// @file CodeGeneratorX64.h
+/// @brief x86-64的后端处理头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>指令选择独立出来供JIT使用
+/// </table>
+///
+#pragma once
+
+#include "CodeGeneratorAsm.h"
+#include "ILocX64.h"
+
+///
+/// @brief x86-64的汇编代码生成器，产生GAS的AT&T语法，遵循System V的调用约定，可与tests/std.c链接
+///
+class CodeGeneratorX64 : public CodeGeneratorAsm {
+
+public:
+    /// @brief 构造函数
+    /// @param module 符号表
+    CodeGeneratorX64(Module * module);
+
+    /// @brief 析构函数
+    ~CodeGeneratorX64() override;
+
+    /// @brief 指令选择，JIT也由此得到函数的指令序列再编码为机器码
+    /// @param func 要处理的函数，已经完成寄存器分配与Label命名
+    /// @param iloc 指令序列
+    void instSelect(Function * func, ILocX64 & iloc);
+
+    /// @brief 寄存器分配
+    /// @param func 要处理的函数
+    void registerAllocation(Function * func) override;
+
+protected:
+    /// @brief 产生汇编头部分
+    void genHeader() override;
+
+    /// @brief 全局变量Section，主要包含初始化的和未初始化过的
+    void genDataSection() override;
+
+    /// @brief 针对函数进行汇编指令生成，放到.text代码段中
+    /// @param func 要处理的函数
+    /// @param text 函数的汇编代码追加到该字符串中
+    void genCodeSection(Function * func, std::string & text) override;
+
+    /// @brief 栈空间分配，没有分配寄存器的变量都在栈中
+    /// @param func 要处理的函数
+    void stackAlloc(Function * func);
+};
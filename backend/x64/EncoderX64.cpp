@@ -0,0 +1,399 @@
+///
+/// @file EncoderX64.cpp
+/// @brief x86-64指令编码的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <cstdint>
+
+#include "EncoderX64.h"
+#include "Common.h"
+#include "PlatformX64.h"
+
+/// @brief 条件码在Jcc与SETcc操作码中的编码
+static const uint8_t condCode[(int) X64Cond::X64_COND_MAX] = {
+    0x0,
+    0x4, // e
+    0x5, // ne
+    0xF, // g
+    0xD, // ge
+    0xC, // l
+    0xE, // le
+};
+
+/// @brief 是否可以用8位有符号数表示
+static bool isInt8(int64_t value)
+{
+    return (value >= -128) && (value <= 127);
+}
+
+/// @brief 构造函数
+/// @param _resolver 符号的地址解析函数
+EncoderX64::EncoderX64(SymbolResolver _resolver) : resolver(std::move(_resolver))
+{}
+
+/// @brief 产生32位的立即数或者偏移，小端
+/// @param value 值
+void EncoderX64::emit32(int32_t value)
+{
+    uint32_t v = (uint32_t) value;
+    for (int k = 0; k < 4; k++) {
+        bytes.push_back((uint8_t) (v >> (8 * k)));
+    }
+}
+
+/// @brief 回填4字节的值
+/// @param pos 位置
+/// @param value 值
+void EncoderX64::patch32(size_t pos, int32_t value)
+{
+    uint32_t v = (uint32_t) value;
+    for (int k = 0; k < 4; k++) {
+        bytes[pos + k] = (uint8_t) (v >> (8 * k));
+    }
+}
+
+/// @brief 产生带ModRM的指令：REX前缀、操作码、ModRM以及SIB与偏移
+/// @param opcode 操作码，1到2字节
+/// @param w 是否是64位操作数
+/// @param regField ModRM的reg字段，寄存器号或者操作码扩展
+/// @param rm ModRM的r/m操作数，寄存器或者内存
+/// @param byteRegs reg字段或者r/m是否是8位寄存器
+/// @return true：成功，false：符号未定义
+bool EncoderX64::emitModRM(std::initializer_list<uint8_t> opcode,
+                           bool w,
+                           int regField,
+                           const X64Operand & rm,
+                           bool byteRegs)
+{
+    int rmReg = (rm.kind == X64OperandKind::X64_OPND_MEM_SYM) ? 0 : rm.reg;
+
+    // REX前缀：W为64位操作数，R与B分别扩展reg与r/m字段。spl、bpl、sil、dil必须有REX前缀
+    uint8_t rex = 0x40;
+    if (w) {
+        rex |= 0x08;
+    }
+    if (regField & 8) {
+        rex |= 0x04;
+    }
+    if (rmReg & 8) {
+        rex |= 0x01;
+    }
+    bool needRex = (rex != 0x40);
+    if (byteRegs) {
+        bool rmByteReg = (rm.kind == X64OperandKind::X64_OPND_REG) && (rm.size == 1);
+        needRex = needRex || ((regField >= 4) && (regField <= 7)) || (rmByteReg && (rmReg >= 4) && (rmReg <= 7));
+    }
+    if (needRex) {
+        bytes.push_back(rex);
+    }
+
+    bytes.insert(bytes.end(), opcode.begin(), opcode.end());
+
+    uint8_t reg = (uint8_t) ((regField & 7) << 3);
+
+    switch (rm.kind) {
+        case X64OperandKind::X64_OPND_REG:
+            bytes.push_back((uint8_t) (0xC0 | reg | (rmReg & 7)));
+            break;
+
+        case X64OperandKind::X64_OPND_MEM: {
+            // rbp与r13作基址时没有无偏移的形式，rsp与r12作基址时必须有SIB
+            int32_t disp = rm.value;
+            uint8_t mod;
+            if ((disp == 0) && ((rmReg & 7) != X64_RBP_REG_NO)) {
+                mod = 0x00;
+            } else if (isInt8(disp)) {
+                mod = 0x40;
+            } else {
+                mod = 0x80;
+            }
+            bytes.push_back((uint8_t) (mod | reg | (rmReg & 7)));
+            if ((rmReg & 7) == X64_RSP_REG_NO) {
+                bytes.push_back(0x24);
+            }
+            if (mod == 0x40) {
+                bytes.push_back((uint8_t) disp);
+            } else if (mod == 0x80) {
+                emit32(disp);
+            }
+            break;
+        }
+
+        case X64OperandKind::X64_OPND_MEM_SYM: {
+            // disp32(%rip)，偏移相对于指令的结束位置，之后可能还有立即数，先占位
+            uint64_t addr;
+            if (!resolver(X64OperandKind::X64_OPND_MEM_SYM, (*names)[rm.value], addr)) {
+                return false;
+            }
+            bytes.push_back((uint8_t) (0x05 | reg));
+            ripFixupPos = bytes.size();
+            ripTarget = addr + rm.disp;
+            emit32(0);
+            break;
+        }
+
+        default:
+            minic_log(LOG_ERROR, "x86-64编码时操作数的种类(%d)不支持", (int) rm.kind);
+            return false;
+    }
+
+    return true;
+}
+
+/// @brief PC相对寻址的偏移，在指令编码结束后才能计算
+/// @return true：成功，false：目标超出32位偏移的范围
+bool EncoderX64::fixRipRelative()
+{
+    if (ripFixupPos == 0) {
+        return true;
+    }
+
+    int64_t offset = (int64_t) (ripTarget - (base + bytes.size()));
+    if ((offset < INT32_MIN) || (offset > INT32_MAX)) {
+        minic_log(LOG_ERROR, "x86-64编码时PC相对寻址的目标超出范围");
+        return false;
+    }
+
+    patch32(ripFixupPos, (int32_t) offset);
+    ripFixupPos = 0;
+
+    return true;
+}
+
+/// @brief 编码一条指令
+/// @param x64 指令
+/// @return true：成功，false：有不支持的指令或者符号未定义
+bool EncoderX64::encodeInst(const X64Inst & x64)
+{
+    const X64Operand & dst = x64.dst;
+    const X64Operand & src = x64.src;
+    bool w = (x64.size == 8);
+
+    // 双操作数的算术运算：/r形式的操作码（目的为r/m、目的为寄存器）与立即数形式的操作码扩展
+    uint8_t aluBase = 0, aluExt = 0;
+
+    switch (x64.opcode) {
+        case X64Opcode::X64_OP_LABEL:
+            labelPos[dst.value] = (int64_t) bytes.size();
+            return true;
+
+        case X64Opcode::X64_OP_COMMENT:
+        case X64Opcode::X64_OP_NOP:
+            return true;
+
+        case X64Opcode::X64_OP_MOV:
+            if (src.kind == X64OperandKind::X64_OPND_IMM) {
+                if ((dst.kind == X64OperandKind::X64_OPND_REG) && !w) {
+                    // movl $imm,%r32：B8+r id
+                    if (dst.reg & 8) {
+                        bytes.push_back(0x41);
+                    }
+                    bytes.push_back((uint8_t) (0xB8 + (dst.reg & 7)));
+                    emit32(src.value);
+                    return true;
+                }
+                // C7 /0 id，64位时立即数有符号扩展
+                if (!emitModRM({0xC7}, w, 0, dst)) {
+                    return false;
+                }
+                emit32(src.value);
+                return true;
+            }
+            if (src.kind == X64OperandKind::X64_OPND_REG) {
+                return emitModRM({0x89}, w, src.reg, dst);
+            }
+            return emitModRM({0x8B}, w, dst.reg, src);
+
+        case X64Opcode::X64_OP_MOVSLQ:
+            return emitModRM({0x63}, true, dst.reg, src);
+
+        case X64Opcode::X64_OP_MOVZBL:
+            return emitModRM({0x0F, 0xB6}, false, dst.reg, src, true);
+
+        case X64Opcode::X64_OP_LEA:
+            return emitModRM({0x8D}, w, dst.reg, src);
+
+        case X64Opcode::X64_OP_ADD:
+            aluBase = 0x00;
+            aluExt = 0;
+            break;
+        case X64Opcode::X64_OP_SUB:
+            aluBase = 0x28;
+            aluExt = 5;
+            break;
+        case X64Opcode::X64_OP_XOR:
+            aluBase = 0x30;
+            aluExt = 6;
+            break;
+        case X64Opcode::X64_OP_CMP:
+            aluBase = 0x38;
+            aluExt = 7;
+            break;
+
+        case X64Opcode::X64_OP_TEST:
+            if (src.kind == X64OperandKind::X64_OPND_IMM) {
+                if (!emitModRM({0xF7}, w, 0, dst)) {
+                    return false;
+                }
+                emit32(src.value);
+                return true;
+            }
+            return emitModRM({0x85}, w, src.reg, dst);
+
+        case X64Opcode::X64_OP_IMUL:
+            if (src.kind == X64OperandKind::X64_OPND_IMM) {
+                // imul $imm,%r即imul r, r, imm
+                if (isInt8(src.value)) {
+                    if (!emitModRM({0x6B}, w, dst.reg, dst)) {
+                        return false;
+                    }
+                    bytes.push_back((uint8_t) src.value);
+                } else {
+                    if (!emitModRM({0x69}, w, dst.reg, dst)) {
+                        return false;
+                    }
+                    emit32(src.value);
+                }
+                return true;
+            }
+            return emitModRM({0x0F, 0xAF}, w, dst.reg, src);
+
+        case X64Opcode::X64_OP_NEG:
+            return emitModRM({0xF7}, w, 3, dst);
+
+        case X64Opcode::X64_OP_IDIV:
+            return emitModRM({0xF7}, w, 7, dst);
+
+        case X64Opcode::X64_OP_CLTD:
+            bytes.push_back(0x99);
+            return true;
+
+        case X64Opcode::X64_OP_SET:
+            return emitModRM({0x0F, (uint8_t) (0x90 | condCode[(int) x64.cond])}, false, 0, dst, true);
+
+        case X64Opcode::X64_OP_JMP:
+        case X64Opcode::X64_OP_J:
+            if (dst.kind != X64OperandKind::X64_OPND_LABEL) {
+                break;
+            }
+            if (x64.opcode == X64Opcode::X64_OP_JMP) {
+                bytes.push_back(0xE9);
+            } else {
+                bytes.push_back(0x0F);
+                bytes.push_back((uint8_t) (0x80 | condCode[(int) x64.cond]));
+            }
+            labelFixups.emplace_back(bytes.size(), dst.value);
+            emit32(0);
+            return true;
+
+        case X64Opcode::X64_OP_CALL: {
+            if (dst.kind != X64OperandKind::X64_OPND_SYMBOL) {
+                break;
+            }
+            // call *slot(%rip)：FF /2
+            uint64_t slot;
+            if (!resolver(X64OperandKind::X64_OPND_SYMBOL, (*names)[dst.value], slot)) {
+                return false;
+            }
+            bytes.push_back(0xFF);
+            bytes.push_back(0x15);
+            ripFixupPos = bytes.size();
+            ripTarget = slot;
+            emit32(0);
+            return true;
+        }
+
+        case X64Opcode::X64_OP_PUSH:
+        case X64Opcode::X64_OP_POP:
+            if (dst.kind != X64OperandKind::X64_OPND_REG) {
+                break;
+            }
+            if (dst.reg & 8) {
+                bytes.push_back(0x41);
+            }
+            bytes.push_back((uint8_t) (((x64.opcode == X64Opcode::X64_OP_PUSH) ? 0x50 : 0x58) + (dst.reg & 7)));
+            return true;
+
+        case X64Opcode::X64_OP_RET:
+            bytes.push_back(0xC3);
+            return true;
+
+        default:
+            break;
+    }
+
+    if ((x64.opcode == X64Opcode::X64_OP_ADD) || (x64.opcode == X64Opcode::X64_OP_SUB) ||
+        (x64.opcode == X64Opcode::X64_OP_XOR) || (x64.opcode == X64Opcode::X64_OP_CMP)) {
+
+        if (src.kind == X64OperandKind::X64_OPND_IMM) {
+            // 83 /ext ib 或 81 /ext id
+            if (isInt8(src.value)) {
+                if (!emitModRM({0x83}, w, aluExt, dst)) {
+                    return false;
+                }
+                bytes.push_back((uint8_t) src.value);
+            } else {
+                if (!emitModRM({0x81}, w, aluExt, dst)) {
+                    return false;
+                }
+                emit32(src.value);
+            }
+            return true;
+        }
+
+        if (src.kind == X64OperandKind::X64_OPND_REG) {
+            return emitModRM({(uint8_t) (aluBase + 0x01)}, w, src.reg, dst);
+        }
+
+        return emitModRM({(uint8_t) (aluBase + 0x03)}, w, dst.reg, src);
+    }
+
+    minic_log(LOG_ERROR, "x86-64编码时指令(%d)不支持", (int) x64.opcode);
+    return false;
+}
+
+/// @brief 编码指令序列
+/// @param iloc 指令序列
+/// @param _base 机器码将要存放的地址，PC相对寻址据此计算偏移
+/// @return true：成功，false：有不支持的指令或者符号未定义
+bool EncoderX64::encode(ILocX64 & iloc, uint64_t _base)
+{
+    base = _base;
+    names = &iloc.getNames();
+    bytes.clear();
+    labelFixups.clear();
+    labelPos.assign(names->size(), -1);
+
+    for (const X64Inst & x64: iloc.getCode()) {
+
+        if (x64.dead) {
+            continue;
+        }
+
+        if (!encodeInst(x64) || !fixRipRelative()) {
+            return false;
+        }
+    }
+
+    // 回填跳转的偏移，偏移相对于跳转指令的结束位置
+    for (auto & fixup: labelFixups) {
+        int64_t target = labelPos[fixup.second];
+        if (target < 0) {
+            minic_log(LOG_ERROR, "x86-64编码时标签(%s)未定义", (*names)[fixup.second].c_str());
+            return false;
+        }
+        patch32(fixup.first, (int32_t) (target - (int64_t) (fixup.first + 4)));
+    }
+
+    return true;
+}
@@ -0,0 +1,132 @@
+///
+/// @file EncoderX64.h
+/// @brief x86-64指令编码的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ILocX64.h"
+
+///
+/// @brief 把ILocX64的指令序列编码为x86-64的机器码
+///
+/// 跳转一律采用rel32的形式，标签在编码结束时回填。全局变量采用PC相对寻址，函数调用通过调用槽间接进行，
+/// 即call *slot(%rip)，槽中保存被调用函数的地址，因此目标函数可以在编码之后才确定或者改变。
+///
+class EncoderX64 {
+
+public:
+    ///
+    /// @brief 符号的地址解析函数
+    /// @param kind 内存操作数时为X64_OPND_MEM_SYM，要求变量的地址；函数调用时为X64_OPND_SYMBOL，要求调用槽的地址
+    /// @param name 符号名
+    /// @param addr 地址
+    /// @return true：成功，false：符号未定义
+    ///
+    typedef std::function<bool(X64OperandKind kind, const std::string & name, uint64_t & addr)> SymbolResolver;
+
+    ///
+    /// @brief 构造函数
+    /// @param _resolver 符号的地址解析函数
+    ///
+    explicit EncoderX64(SymbolResolver _resolver);
+
+    ///
+    /// @brief 编码指令序列
+    /// @param iloc 指令序列
+    /// @param base 机器码将要存放的地址，PC相对寻址据此计算偏移
+    /// @return true：成功，false：有不支持的指令或者符号未定义
+    ///
+    bool encode(ILocX64 & iloc, uint64_t base);
+
+    ///
+    /// @brief 获取编码后的机器码
+    /// @return 机器码
+    ///
+    const std::vector<uint8_t> & getBytes() const
+    {
+        return bytes;
+    }
+
+protected:
+    ///
+    /// @brief 编码一条指令
+    /// @param x64 指令
+    /// @return true：成功，false：有不支持的指令或者符号未定义
+    ///
+    bool encodeInst(const X64Inst & x64);
+
+    ///
+    /// @brief 产生带ModRM的指令：REX前缀、操作码、ModRM以及SIB与偏移
+    /// @param opcode 操作码，1到2字节
+    /// @param w 是否是64位操作数
+    /// @param regField ModRM的reg字段，寄存器号或者操作码扩展
+    /// @param rm ModRM的r/m操作数，寄存器或者内存
+    /// @param byteRegs reg字段或者r/m是否是8位寄存器
+    /// @return true：成功，false：符号未定义
+    ///
+    bool emitModRM(std::initializer_list<uint8_t> opcode,
+                   bool w,
+                   int regField,
+                   const X64Operand & rm,
+                   bool byteRegs = false);
+
+    ///
+    /// @brief 产生32位的立即数或者偏移，小端
+    /// @param value 值
+    ///
+    void emit32(int32_t value);
+
+    ///
+    /// @brief 回填4字节的值
+    /// @param pos 位置
+    /// @param value 值
+    ///
+    void patch32(size_t pos, int32_t value);
+
+    ///
+    /// @brief PC相对寻址的偏移，在指令编码结束后才能计算
+    /// @return true：成功，false：目标超出32位偏移的范围
+    ///
+    bool fixRipRelative();
+
+private:
+    /// @brief 符号的地址解析函数
+    SymbolResolver resolver;
+
+    /// @brief 指令序列的名字表
+    const std::vector<std::string> * names = nullptr;
+
+    /// @brief 机器码的存放地址
+    uint64_t base = 0;
+
+    /// @brief 编码后的机器码
+    std::vector<uint8_t> bytes;
+
+    /// @brief 按名字表编号记录的标签位置，-1为未出现
+    std::vector<int64_t> labelPos;
+
+    /// @brief 需要回填的rel32跳转偏移的位置与目标标签的编号
+    std::vector<std::pair<size_t, int>> labelFixups;
+
+    /// @brief 当前指令中PC相对寻址的偏移位置，没有时为0
+    size_t ripFixupPos = 0;
+
+    /// @brief 当前指令中PC相对寻址的目标地址
+    uint64_t ripTarget = 0;
+};
@@ -0,0 +1,409 @@
+///
+/// @file ILocX64.cpp
+/// @brief x86-64指令序列管理的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <string>
+
+#include "ILocX64.h"
+#include "BufferedWriter.h"
+#include "Common.h"
+#include "ConstInt.h"
+#include "GlobalVariable.h"
+#include "PlatformX64.h"
+
+/// @brief 操作码的名字
+static const char * const opcodeName[(int) X64Opcode::X64_OP_MAX] = {
+    "mov",
+    "movslq",
+    "movzbl",
+    "lea",
+    "add",
+    "sub",
+    "imul",
+    "neg",
+    "cltd",
+    "idiv",
+    "cmp",
+    "test",
+    "xor",
+    "set",
+    "jmp",
+    "j",
+    "call",
+    "push",
+    "pop",
+    "ret",
+    "",
+    "#",
+    "",
+};
+
+/// @brief 条件后缀
+static const char * const condName[(int) X64Cond::X64_COND_MAX] = {
+    "",
+    "e",
+    "ne",
+    "g",
+    "ge",
+    "l",
+    "le",
+};
+
+/// @brief 条件取反
+/// @param cond 条件，不能是无条件
+/// @return 取反后的条件
+X64Cond invertCond(X64Cond cond)
+{
+    switch (cond) {
+        case X64Cond::X64_COND_E:
+            return X64Cond::X64_COND_NE;
+        case X64Cond::X64_COND_NE:
+            return X64Cond::X64_COND_E;
+        case X64Cond::X64_COND_G:
+            return X64Cond::X64_COND_LE;
+        case X64Cond::X64_COND_GE:
+            return X64Cond::X64_COND_L;
+        case X64Cond::X64_COND_L:
+            return X64Cond::X64_COND_GE;
+        case X64Cond::X64_COND_LE:
+            return X64Cond::X64_COND_G;
+        default:
+            return cond;
+    }
+}
+
+/// @brief 操作数输出
+/// @param str 追加到该字符串中
+/// @param names 标签、符号与文本的名字表
+void X64Operand::outPut(std::string & str, const std::vector<std::string> & names) const
+{
+    switch (kind) {
+        case X64OperandKind::X64_OPND_NONE:
+            break;
+        case X64OperandKind::X64_OPND_REG:
+            str += '%';
+            str += PlatformX64::regName(reg, size);
+            break;
+        case X64OperandKind::X64_OPND_IMM:
+            str += '$';
+            appendInt(str, value);
+            break;
+        case X64OperandKind::X64_OPND_MEM:
+            // -16(%rbp) (%rax)
+            if (value) {
+                appendInt(str, value);
+            }
+            str += "(%";
+            str += PlatformX64::regName64[reg];
+            str += ')';
+            break;
+        case X64OperandKind::X64_OPND_MEM_SYM:
+            // a(%rip) a+4(%rip)
+            str += names[value];
+            if (disp) {
+                str += '+';
+                appendInt(str, disp);
+            }
+            str += "(%rip)";
+            break;
+        case X64OperandKind::X64_OPND_LABEL:
+        case X64OperandKind::X64_OPND_SYMBOL:
+        case X64OperandKind::X64_OPND_TEXT:
+            str += names[value];
+            break;
+    }
+}
+
+X64Inst::X64Inst(X64Opcode _opcode, int _size, X64Operand _dst, X64Operand _src, X64Cond _cond)
+    : opcode(_opcode), cond(_cond), size((std::uint8_t) _size), dst(_dst), src(_src)
+{}
+
+/// @brief 指令字符串输出函数
+/// @param str 指令追加到该字符串中，无效指令不追加
+/// @param names 标签、符号与文本的名字表
+void X64Inst::outPut(std::string & str, const std::vector<std::string> & names) const
+{
+    // 无用代码或占位指令，什么都不输出
+    if (dead || (opcode == X64Opcode::X64_OP_NOP)) {
+        return;
+    }
+
+    // 标签 .L1:
+    if (opcode == X64Opcode::X64_OP_LABEL) {
+        dst.outPut(str, names);
+        str += ':';
+        return;
+    }
+
+    str += opcodeName[(int) opcode];
+    str += condName[(int) cond];
+    if (size == 8) {
+        str += 'q';
+    } else if (size == 4) {
+        str += 'l';
+    }
+
+    // AT&T语法，源操作数在前
+    if (!src.empty()) {
+        str += ' ';
+        src.outPut(str, names);
+        str += ',';
+        dst.outPut(str, names);
+    } else if (!dst.empty()) {
+        str += ' ';
+        dst.outPut(str, names);
+    }
+}
+
+#define emit(...) code.emplace_back(__VA_ARGS__)
+
+/// @brief 构造函数
+ILocX64::ILocX64()
+{}
+
+/// @brief 获取标签的编号，第一次出现时加入名字表
+/// @param name 标签名字
+/// @return 编号
+int ILocX64::labelId(const std::string & name)
+{
+    auto result = labelIds.emplace(name, (int) names.size());
+    if (result.second) {
+        names.push_back(name);
+        labelRefs.resize(names.size(), 0);
+    }
+
+    return result.first->second;
+}
+
+/// @brief 符号或文本加入名字表
+/// @param name 名字
+/// @return 编号
+int ILocX64::nameId(const std::string & name)
+{
+    names.push_back(name);
+    return (int) names.size() - 1;
+}
+
+/// @brief 普通指令
+/// @param op 操作码
+/// @param size 操作数的字节数
+/// @param dst 目的操作数
+/// @param src 源操作数
+/// @param cond 条件
+void ILocX64::inst(X64Opcode op, int size, X64Operand dst, X64Operand src, X64Cond cond)
+{
+    emit(op, size, dst, src, cond);
+}
+
+/// @brief 注释指令
+/// @param str 注释内容
+void ILocX64::comment(const std::string & str)
+{
+    emit(X64Opcode::X64_OP_COMMENT, 0, X64Operand::makeName(X64OperandKind::X64_OPND_TEXT, nameId(str)));
+}
+
+/// @brief 标签指令
+/// @param name 标签名字
+void ILocX64::label(const std::string & name)
+{
+    emit(X64Opcode::X64_OP_LABEL, 0, X64Operand::makeName(X64OperandKind::X64_OPND_LABEL, labelId(name)));
+}
+
+/// @brief 无条件跳转指令
+/// @param label 目标Label名称
+void ILocX64::jump(const std::string & label)
+{
+    int id = labelId(label);
+    labelRefs[id]++;
+
+    emit(X64Opcode::X64_OP_JMP, 0, X64Operand::makeName(X64OperandKind::X64_OPND_LABEL, id));
+}
+
+/// @brief 条件跳转指令
+/// @param cond 条件
+/// @param label 目标Label名称
+void ILocX64::branch(X64Cond cond, const std::string & label)
+{
+    int id = labelId(label);
+    labelRefs[id]++;
+
+    emit(X64Opcode::X64_OP_J, 0, X64Operand::makeName(X64OperandKind::X64_OPND_LABEL, id), X64Operand{}, cond);
+}
+
+/// @brief 调用函数
+/// @param name 函数名
+void ILocX64::call_fun(const std::string & name)
+{
+    emit(X64Opcode::X64_OP_CALL, 0, X64Operand::makeName(X64OperandKind::X64_OPND_SYMBOL, nameId(name)));
+}
+
+/// @brief 加载立即数，为0时用xor清零
+/// @param rs_reg_no 结果寄存器
+/// @param num 立即数
+/// @param size 字节数
+void ILocX64::load_imm(int rs_reg_no, int32_t num, int size)
+{
+    if (num == 0) {
+        // xorl %eax,%eax 同时清零高32位
+        emit(X64Opcode::X64_OP_XOR, 4, X64Operand::makeReg(rs_reg_no, 4), X64Operand::makeReg(rs_reg_no, 4));
+    } else {
+        // movq $-1,%rax 立即数有符号扩展
+        emit(X64Opcode::X64_OP_MOV, size, X64Operand::makeReg(rs_reg_no, size), X64Operand::makeImm(num));
+    }
+}
+
+/// @brief 寄存器Mov操作，寄存器相同时不产生指令
+/// @param rs_reg_no 结果寄存器
+/// @param src_reg_no 源寄存器
+/// @param size 字节数
+void ILocX64::mov_reg(int rs_reg_no, int src_reg_no, int size)
+{
+    if (rs_reg_no != src_reg_no) {
+        emit(X64Opcode::X64_OP_MOV, size, X64Operand::makeReg(rs_reg_no, size), X64Operand::makeReg(src_reg_no, size));
+    }
+}
+
+/// @brief 变量作为源操作数时的操作数，可以是立即数、寄存器或者内存
+/// @param var 变量，不能是数组对象
+/// @return 操作数
+X64Operand ILocX64::operand(Value * var)
+{
+    if (Instanceof(constVal, ConstInt *, var)) {
+        // 整型常量 $100
+        return X64Operand::makeImm(constVal->getVal());
+    }
+
+    if (var->getRegId() != -1) {
+        // 寄存器变量
+        return X64Operand::makeReg(var->getRegId(), PlatformX64::valueSize(var));
+    }
+
+    if (Instanceof(globalVar, GlobalVariable *, var)) {
+        // 全局变量 a(%rip)
+        return X64Operand::makeMemSym(nameId(globalVar->getName()));
+    }
+
+    // 栈内变量 -16(%rbp)
+    int32_t baseRegId = -1;
+    int64_t offset = -1;
+    if (!var->getMemoryAddr(&baseRegId, &offset)) {
+        minic_log(LOG_ERROR, "BUG");
+    }
+
+    return X64Operand::makeMem(baseRegId, (int32_t) offset);
+}
+
+/// @brief 加载变量到寄存器，数组对象加载其地址
+/// @param rs_reg_no 结果寄存器
+/// @param var 变量
+void ILocX64::load_var(int rs_reg_no, Value * var)
+{
+    if (PlatformX64::isArrayObject(var)) {
+        lea_var(rs_reg_no, var);
+    } else if (Instanceof(constVal, ConstInt *, var)) {
+        load_imm(rs_reg_no, constVal->getVal());
+    } else if (var->getRegId() != -1) {
+        mov_reg(rs_reg_no, var->getRegId(), PlatformX64::valueSize(var));
+    } else {
+        // movl -16(%rbp),%eax
+        int size = PlatformX64::valueSize(var);
+        emit(X64Opcode::X64_OP_MOV, size, X64Operand::makeReg(rs_reg_no, size), operand(var));
+    }
+}
+
+/// @brief 加载变量到64位寄存器，32位整数有符号扩展，用于地址运算
+/// @param rs_reg_no 结果寄存器
+/// @param var 变量
+void ILocX64::load_var64(int rs_reg_no, Value * var)
+{
+    if (PlatformX64::isArrayObject(var) || (PlatformX64::valueSize(var) == 8)) {
+        load_var(rs_reg_no, var);
+    } else if (Instanceof(constVal, ConstInt *, var)) {
+        load_imm(rs_reg_no, constVal->getVal(), 8);
+    } else {
+        // movslq -16(%rbp),%rax
+        emit(X64Opcode::X64_OP_MOVSLQ, 0, X64Operand::makeReg(rs_reg_no, 8), operand(var));
+    }
+}
+
+/// @brief 加载变量地址到寄存器
+/// @param rs_reg_no 结果寄存器
+/// @param var 变量
+void ILocX64::lea_var(int rs_reg_no, Value * var)
+{
+    // leaq a(%rip),%rax 或 leaq -16(%rbp),%rax
+    emit(X64Opcode::X64_OP_LEA, 8, X64Operand::makeReg(rs_reg_no, 8), operand(var));
+}
+
+/// @brief 保存寄存器到变量
+/// @param src_reg_no 源寄存器号
+/// @param var 变量
+void ILocX64::store_var(int src_reg_no, Value * var)
+{
+    int size = PlatformX64::valueSize(var);
+
+    if (var->getRegId() != -1) {
+        mov_reg(var->getRegId(), src_reg_no, size);
+    } else {
+        // movl %eax,-16(%rbp)
+        emit(X64Opcode::X64_OP_MOV, size, operand(var), X64Operand::makeReg(src_reg_no, size));
+    }
+}
+
+/// @brief 设置死指令，是跳转指令时减少目标标签的引用计数
+/// @param x64 指令，必须属于本序列
+void ILocX64::setDead(X64Inst & x64)
+{
+    if (x64.dead) {
+        return;
+    }
+
+    if (x64.isBranch()) {
+        labelRefs[x64.dst.value]--;
+    }
+
+    x64.dead = true;
+}
+
+/// @brief 删除无用的Label指令
+void ILocX64::deleteUnusedLabel()
+{
+    for (X64Inst & x64: code) {
+        if ((!x64.dead) && x64.isLabel() && (labelRefs[x64.dst.value] == 0)) {
+            x64.dead = true;
+        }
+    }
+}
+
+/// @brief 输出汇编
+/// @param text 汇编代码追加到该字符串中
+void ILocX64::outPut(std::string & text)
+{
+    text.reserve(text.size() + code.size() * 24);
+
+    for (auto & x64: code) {
+
+        if (x64.dead || (x64.opcode == X64Opcode::X64_OP_NOP)) {
+            continue;
+        }
+
+        // Label指令不需要Tab
+        if (!x64.isLabel()) {
+            text += '\t';
+        }
+
+        x64.outPut(text, names);
+        text += '\n';
+    }
+}
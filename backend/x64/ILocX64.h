@@ -0,0 +1,358 @@
+///
+/// @file ILocX64.h
+/// @brief x86-64指令序列管理的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加名字表的获取
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Module.h"
+
+/// @brief x86-64指令的操作码，输出为AT&T语法
+enum class X64Opcode : std::uint8_t {
+    X64_OP_MOV,
+
+    /// @brief 32位有符号扩展到64位
+    X64_OP_MOVSLQ,
+
+    /// @brief 8位无符号扩展到32位
+    X64_OP_MOVZBL,
+    X64_OP_LEA,
+    X64_OP_ADD,
+    X64_OP_SUB,
+    X64_OP_IMUL,
+    X64_OP_NEG,
+
+    /// @brief eax有符号扩展到edx:eax
+    X64_OP_CLTD,
+    X64_OP_IDIV,
+    X64_OP_CMP,
+    X64_OP_TEST,
+    X64_OP_XOR,
+
+    /// @brief 条件成立时8位寄存器置1，否则置0
+    X64_OP_SET,
+    X64_OP_JMP,
+
+    /// @brief 条件跳转
+    X64_OP_J,
+    X64_OP_CALL,
+    X64_OP_PUSH,
+    X64_OP_POP,
+    X64_OP_RET,
+
+    /// @brief 标签，输出为名字加冒号
+    X64_OP_LABEL,
+
+    /// @brief 注释，输出为#加内容
+    X64_OP_COMMENT,
+
+    /// @brief 占位指令，不输出
+    X64_OP_NOP,
+
+    X64_OP_MAX,
+};
+
+/// @brief 条件码，比较为有符号比较
+enum class X64Cond : std::uint8_t {
+    /// @brief 无条件，不输出后缀
+    X64_COND_NONE,
+    X64_COND_E,
+    X64_COND_NE,
+    X64_COND_G,
+    X64_COND_GE,
+    X64_COND_L,
+    X64_COND_LE,
+
+    X64_COND_MAX,
+};
+
+/// @brief 操作数的种类
+enum class X64OperandKind : std::uint8_t {
+    /// @brief 无操作数
+    X64_OPND_NONE,
+
+    /// @brief 寄存器 %eax
+    X64_OPND_REG,
+
+    /// @brief 立即数 $100
+    X64_OPND_IMM,
+
+    /// @brief 基址加偏移寻址 -16(%rbp)，偏移为0时为(%rbp)
+    X64_OPND_MEM,
+
+    /// @brief 符号加偏移的PC相对寻址 a+4(%rip)
+    X64_OPND_MEM_SYM,
+
+    /// @brief 标签
+    X64_OPND_LABEL,
+
+    /// @brief 符号，如函数名
+    X64_OPND_SYMBOL,
+
+    /// @brief 注释等文本
+    X64_OPND_TEXT,
+};
+
+/// @brief x86-64指令的操作数
+struct X64Operand {
+
+    /// @brief 种类
+    X64OperandKind kind = X64OperandKind::X64_OPND_NONE;
+
+    /// @brief 寄存器号，内存寻址时为基址寄存器号
+    std::uint8_t reg = 0;
+
+    /// @brief 寄存器操作数的字节数，8、4或1
+    std::uint8_t size = 0;
+
+    /// @brief 立即数、偏移，或标签、符号、文本在名字表中的编号
+    std::int32_t value = 0;
+
+    /// @brief 符号寻址时的偏移
+    std::int32_t disp = 0;
+
+    /// @brief 寄存器操作数
+    static X64Operand makeReg(int regNo, int size)
+    {
+        return {X64OperandKind::X64_OPND_REG, (std::uint8_t) regNo, (std::uint8_t) size, 0, 0};
+    }
+
+    /// @brief 立即数操作数
+    static X64Operand makeImm(int32_t imm)
+    {
+        return {X64OperandKind::X64_OPND_IMM, 0, 0, imm, 0};
+    }
+
+    /// @brief 基址加偏移的内存操作数
+    static X64Operand makeMem(int baseRegNo, int32_t offset = 0)
+    {
+        return {X64OperandKind::X64_OPND_MEM, (std::uint8_t) baseRegNo, 0, offset, 0};
+    }
+
+    /// @brief 符号加偏移的内存操作数
+    static X64Operand makeMemSym(int id, int32_t disp = 0)
+    {
+        return {X64OperandKind::X64_OPND_MEM_SYM, 0, 0, id, disp};
+    }
+
+    /// @brief 名字表中的标签、符号或文本
+    static X64Operand makeName(X64OperandKind kind, int id)
+    {
+        return {kind, 0, 0, id, 0};
+    }
+
+    /// @brief 是否有操作数
+    bool empty() const
+    {
+        return kind == X64OperandKind::X64_OPND_NONE;
+    }
+
+    /// @brief 是否是内存操作数
+    bool isMem() const
+    {
+        return (kind == X64OperandKind::X64_OPND_MEM) || (kind == X64OperandKind::X64_OPND_MEM_SYM);
+    }
+
+    /// @brief 操作数输出
+    /// @param str 追加到该字符串中
+    /// @param names 标签、符号与文本的名字表
+    void outPut(std::string & str, const std::vector<std::string> & names) const;
+};
+
+/// @brief 底层汇编指令：x86-64
+struct X64Inst {
+
+    /// @brief 操作码
+    X64Opcode opcode;
+
+    /// @brief 条件，只用于set与j
+    X64Cond cond;
+
+    /// @brief 操作数的字节数，决定l或q后缀，0为没有后缀
+    std::uint8_t size;
+
+    /// @brief 标识指令是否无效
+    bool dead = false;
+
+    /// @brief 目的操作数，单操作数指令的唯一操作数
+    X64Operand dst;
+
+    /// @brief 源操作数
+    X64Operand src;
+
+    /// @brief 构造函数
+    /// @param op 操作码
+    /// @param size 操作数的字节数
+    /// @param dst 目的操作数
+    /// @param src 源操作数
+    /// @param cond 条件
+    X64Inst(X64Opcode op,
+            int size = 0,
+            X64Operand dst = {},
+            X64Operand src = {},
+            X64Cond cond = X64Cond::X64_COND_NONE);
+
+    /// @brief 是否是标签
+    bool isLabel() const
+    {
+        return opcode == X64Opcode::X64_OP_LABEL;
+    }
+
+    /// @brief 是否是跳转到标签的指令，含条件跳转
+    bool isBranch() const
+    {
+        return ((opcode == X64Opcode::X64_OP_JMP) || (opcode == X64Opcode::X64_OP_J)) &&
+               (dst.kind == X64OperandKind::X64_OPND_LABEL);
+    }
+
+    /// @brief 指令字符串输出函数
+    /// @param str 指令追加到该字符串中，无效指令不追加
+    /// @param names 标签、符号与文本的名字表
+    void outPut(std::string & str, const std::vector<std::string> & names) const;
+};
+
+/// @brief 条件取反
+/// @param cond 条件，不能是无条件
+/// @return 取反后的条件
+X64Cond invertCond(X64Cond cond);
+
+/// @brief 底层汇编序列-x86-64
+class ILocX64 {
+
+    /// @brief 汇编序列
+    std::vector<X64Inst> code;
+
+    /// @brief 标签、符号与注释文本的名字表，操作数中记录编号
+    std::vector<std::string> names;
+
+    /// @brief 标签名字-名字表中的编号，同名标签的编号相同
+    std::unordered_map<std::string, int> labelIds;
+
+    /// @brief 按名字表编号记录的标签被跳转指令引用的次数
+    std::vector<int32_t> labelRefs;
+
+    /// @brief 获取标签的编号，第一次出现时加入名字表
+    /// @param name 标签名字
+    /// @return 编号
+    int labelId(const std::string & name);
+
+public:
+    /// @brief 构造函数
+    ILocX64();
+
+    /// @brief 符号或文本加入名字表
+    /// @param name 名字
+    /// @return 编号
+    int nameId(const std::string & name);
+
+    /// @brief 获取当前的代码序列
+    /// @return 代码序列
+    std::vector<X64Inst> & getCode()
+    {
+        return code;
+    }
+
+    /// @brief 获取标签、符号与文本的名字表，操作数中的编号即下标
+    /// @return 名字表
+    const std::vector<std::string> & getNames() const
+    {
+        return names;
+    }
+
+    /// @brief 普通指令
+    /// @param op 操作码
+    /// @param size 操作数的字节数
+    /// @param dst 目的操作数
+    /// @param src 源操作数
+    /// @param cond 条件
+    void inst(X64Opcode op,
+              int size,
+              X64Operand dst = {},
+              X64Operand src = {},
+              X64Cond cond = X64Cond::X64_COND_NONE);
+
+    /// @brief 注释指令
+    /// @param str 注释内容
+    void comment(const std::string & str);
+
+    /// @brief 标签指令
+    /// @param name 标签名字
+    void label(const std::string & name);
+
+    /// @brief 无条件跳转指令
+    /// @param label 目标Label名称
+    void jump(const std::string & label);
+
+    /// @brief 条件跳转指令
+    /// @param cond 条件
+    /// @param label 目标Label名称
+    void branch(X64Cond cond, const std::string & label);
+
+    /// @brief 调用函数
+    /// @param name 函数名
+    void call_fun(const std::string & name);
+
+    /// @brief 加载立即数，为0时用xor清零
+    /// @param rs_reg_no 结果寄存器
+    /// @param num 立即数
+    /// @param size 字节数
+    void load_imm(int rs_reg_no, int32_t num, int size = 4);
+
+    /// @brief 寄存器Mov操作，寄存器相同时不产生指令
+    /// @param rs_reg_no 结果寄存器
+    /// @param src_reg_no 源寄存器
+    /// @param size 字节数
+    void mov_reg(int rs_reg_no, int src_reg_no, int size);
+
+    /// @brief 变量作为源操作数时的操作数，可以是立即数、寄存器或者内存
+    /// @param var 变量，不能是数组对象
+    /// @return 操作数
+    X64Operand operand(Value * var);
+
+    /// @brief 加载变量到寄存器，数组对象加载其地址
+    /// @param rs_reg_no 结果寄存器
+    /// @param var 变量
+    void load_var(int rs_reg_no, Value * var);
+
+    /// @brief 加载变量到64位寄存器，32位整数有符号扩展，用于地址运算
+    /// @param rs_reg_no 结果寄存器
+    /// @param var 变量
+    void load_var64(int rs_reg_no, Value * var);
+
+    /// @brief 加载变量地址到寄存器
+    /// @param rs_reg_no 结果寄存器
+    /// @param var 变量
+    void lea_var(int rs_reg_no, Value * var);
+
+    /// @brief 保存寄存器到变量
+    /// @param src_reg_no 源寄存器号
+    /// @param var 变量
+    void store_var(int src_reg_no, Value * var);
+
+    /// @brief 设置死指令，是跳转指令时减少目标标签的引用计数
+    /// @param x64 指令，必须属于本序列
+    void setDead(X64Inst & x64);
+
+    /// @brief 删除无用的Label指令
+    void deleteUnusedLabel();
+
+    /// @brief 输出汇编
+    /// @param text 汇编代码追加到该字符串中
+    void outPut(std::string & text);
+};
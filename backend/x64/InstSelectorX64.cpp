@@ -0,0 +1,586 @@
+///
+/// @file InstSelectorX64.cpp
+/// @brief 指令选择器-x86-64的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <cstdio>
+#include <unordered_map>
+
+#include "InstSelectorX64.h"
+#include "BranchInstruction.h"
+#include "Common.h"
+#include "ConstInt.h"
+#include "CounterInstruction.h"
+#include "FormalParam.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+#include "PlatformX64.h"
+
+/// @brief 构造函数
+/// @param _irCode 指令
+/// @param _iloc ILoc
+/// @param _func 函数
+InstSelectorX64::InstSelectorX64(std::vector<Instruction *> & _irCode, ILocX64 & _iloc, Function * _func)
+    : ir(_irCode), iloc(_iloc), func(_func)
+{
+    translator_handlers[IRInstOperator::IRINST_OP_ENTRY] = &InstSelectorX64::translate_entry;
+    translator_handlers[IRInstOperator::IRINST_OP_EXIT] = &InstSelectorX64::translate_exit;
+
+    translator_handlers[IRInstOperator::IRINST_OP_LABEL] = &InstSelectorX64::translate_label;
+    translator_handlers[IRInstOperator::IRINST_OP_GOTO] = &InstSelectorX64::translate_goto;
+
+    translator_handlers[IRInstOperator::IRINST_OP_ASSIGN] = &InstSelectorX64::translate_assign;
+
+    translator_handlers[IRInstOperator::IRINST_OP_ADD_I] = &InstSelectorX64::translate_add_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_SUB_I] = &InstSelectorX64::translate_sub_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_MINUS_I] = &InstSelectorX64::translate_minus_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_MUL_I] = &InstSelectorX64::translate_mul_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_DIV_I] = &InstSelectorX64::translate_div_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_MOD_I] = &InstSelectorX64::translate_mod_int32;
+
+    translator_handlers[IRInstOperator::IRINST_OP_GT_I] = &InstSelectorX64::translate_cmp_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_LT_I] = &InstSelectorX64::translate_cmp_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_GE_I] = &InstSelectorX64::translate_cmp_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_LE_I] = &InstSelectorX64::translate_cmp_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_EQ_I] = &InstSelectorX64::translate_cmp_int32;
+    translator_handlers[IRInstOperator::IRINST_OP_NE_I] = &InstSelectorX64::translate_cmp_int32;
+
+    translator_handlers[IRInstOperator::IRINST_OP_BRANCH] = &InstSelectorX64::translate_branch;
+
+    translator_handlers[IRInstOperator::IRINST_OP_LOAD] = &InstSelectorX64::translate_load;
+    translator_handlers[IRInstOperator::IRINST_OP_STORE] = &InstSelectorX64::translate_store;
+
+    translator_handlers[IRInstOperator::IRINST_OP_FUNC_CALL] = &InstSelectorX64::translate_call;
+    translator_handlers[IRInstOperator::IRINST_OP_ARG] = &InstSelectorX64::translate_nop;
+
+    translator_handlers[IRInstOperator::IRINST_OP_COUNTER] = &InstSelectorX64::translate_counter;
+}
+
+/// @brief 析构函数
+InstSelectorX64::~InstSelectorX64()
+{}
+
+/// @brief 指令选择执行
+void InstSelectorX64::run()
+{
+    flagsOnly = flagsOnlyCompares(ir);
+
+    for (size_t k = 0; k < ir.size(); ++k) {
+
+        Instruction * inst = ir[k];
+
+        if (!inst->isDead()) {
+
+            // 跳转到紧随其后的Label时可顺序执行，不需要跳转指令
+            size_t next = k + 1;
+            while ((next < ir.size()) && ir[next]->isDead()) {
+                ++next;
+            }
+            nextInst = (next < ir.size()) ? ir[next] : nullptr;
+
+            translate(inst);
+        }
+    }
+}
+
+/// @brief 找出结果只被紧随其后的分支指令使用的关系运算指令，比较结果留在标志寄存器中即可，不需要保存
+/// @param insts 函数的指令
+/// @return 这样的关系运算指令
+std::unordered_set<Instruction *> InstSelectorX64::flagsOnlyCompares(std::vector<Instruction *> & insts)
+{
+    std::unordered_set<Instruction *> result;
+
+    // 各Value被使用的次数
+    std::unordered_map<Value *, int32_t> useCount;
+    for (auto inst: insts) {
+        if (!inst->isDead()) {
+            for (auto operand: inst->getOperandsValue()) {
+                useCount[operand]++;
+            }
+        }
+    }
+
+    Instruction * prev = nullptr;
+    for (auto inst: insts) {
+        if (inst->isDead()) {
+            continue;
+        }
+        if (prev && (inst->getOp() == IRInstOperator::IRINST_OP_BRANCH) && (inst->getOperand(0) == prev) &&
+            (useCount[prev] == 1)) {
+            result.insert(prev);
+        }
+        prev = ((inst->getOp() >= IRInstOperator::IRINST_OP_LT_I) && (inst->getOp() <= IRInstOperator::IRINST_OP_NE_I))
+                   ? inst
+                   : nullptr;
+    }
+
+    return result;
+}
+
+/// @brief 是否顺序执行就到达Label指令，即下一条有效的IR指令是该Label指令
+/// @param label Label指令
+/// @return true：是，不需要跳转，false：否
+bool InstSelectorX64::isFallthrough(Instruction * label) const
+{
+    return label == nextInst;
+}
+
+/// @brief 指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate(Instruction * inst)
+{
+    IRInstOperator op = inst->getOp();
+
+    auto pIter = translator_handlers.find(op);
+    if (pIter == translator_handlers.end()) {
+        // 没有找到，则说明当前不支持
+        printf("Translate: Operator(%d) not support", (int) op);
+        return;
+    }
+
+    if (showLinearIR) {
+        outputIRInstruction(inst);
+    }
+
+    // 比较结果只能被紧随其后的指令使用
+    prevFlagsInst = flagsInst;
+    flagsInst = nullptr;
+
+    (this->*(pIter->second))(inst);
+}
+
+/// @brief 输出IR指令
+/// @param inst IR指令
+void InstSelectorX64::outputIRInstruction(Instruction * inst)
+{
+    std::string irStr;
+    inst->toString(irStr);
+    if (!irStr.empty()) {
+        iloc.comment(irStr);
+    }
+}
+
+/// @brief 不产生指令的IR，如实参指令，实参在函数调用时处理
+/// @param inst IR指令
+void InstSelectorX64::translate_nop(Instruction * inst)
+{
+    (void) inst;
+}
+
+/// @brief Label指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_label(Instruction * inst)
+{
+    Instanceof(labelInst, LabelInstruction *, inst);
+
+    iloc.label(labelInst->getName());
+}
+
+/// @brief goto指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_goto(Instruction * inst)
+{
+    Instanceof(gotoInst, GotoInstruction *, inst);
+
+    // 无条件跳转，目标紧随其后时顺序执行即可
+    if (!isFallthrough(gotoInst->getTarget())) {
+        iloc.jump(gotoInst->getTarget()->getName());
+    }
+}
+
+/// @brief 函数入口指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_entry(Instruction * inst)
+{
+    (void) inst;
+
+    // pushq %rbp; movq %rsp,%rbp
+    iloc.inst(X64Opcode::X64_OP_PUSH, 8, X64Operand::makeReg(X64_RBP_REG_NO, 8));
+    iloc.mov_reg(X64_RBP_REG_NO, X64_RSP_REG_NO, 8);
+
+    // 保护分配给变量的被调用者保存的寄存器
+    for (auto regNo: func->getProtectedReg()) {
+        iloc.inst(X64Opcode::X64_OP_PUSH, 8, X64Operand::makeReg(regNo, 8));
+    }
+
+    // 栈帧含局部变量、临时变量、栈传递的实参等，调用时rsp保持16字节对齐
+    if (func->getMaxDep() > 0) {
+        iloc.inst(X64Opcode::X64_OP_SUB,
+                  8,
+                  X64Operand::makeReg(X64_RSP_REG_NO, 8),
+                  X64Operand::makeImm(func->getMaxDep()));
+    }
+
+    // 寄存器传递的形参保存到分配的寄存器或者栈中，之后参数寄存器可以自由使用
+    auto & params = func->getParams();
+    for (int k = 0; (k < (int) params.size()) && (k < PlatformX64::maxArgRegNum); k++) {
+        iloc.store_var(PlatformX64::argRegNo[k], params[k]);
+    }
+}
+
+/// @brief 函数出口指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_exit(Instruction * inst)
+{
+    if (inst->getOperandsNum()) {
+        // 返回值在eax中
+        iloc.load_var(X64_RAX_REG_NO, inst->getOperand(0));
+    }
+
+    std::vector<int32_t> & protectedRegNo = func->getProtectedReg();
+
+    if (protectedRegNo.empty()) {
+        iloc.mov_reg(X64_RSP_REG_NO, X64_RBP_REG_NO, 8);
+    } else {
+        // 栈指针指向保护的寄存器，逆序恢复
+        iloc.inst(X64Opcode::X64_OP_LEA,
+                  8,
+                  X64Operand::makeReg(X64_RSP_REG_NO, 8),
+                  X64Operand::makeMem(X64_RBP_REG_NO, -8 * (int32_t) protectedRegNo.size()));
+        for (auto iter = protectedRegNo.rbegin(); iter != protectedRegNo.rend(); ++iter) {
+            iloc.inst(X64Opcode::X64_OP_POP, 8, X64Operand::makeReg(*iter, 8));
+        }
+    }
+
+    iloc.inst(X64Opcode::X64_OP_POP, 8, X64Operand::makeReg(X64_RBP_REG_NO, 8));
+    iloc.inst(X64Opcode::X64_OP_RET, 0);
+}
+
+/// @brief 赋值指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_assign(Instruction * inst)
+{
+    Value * result = inst->getOperand(0);
+    Value * arg1 = inst->getOperand(1);
+
+    if (result->getRegId() != -1) {
+        // 立即数、寄存器、内存 => 寄存器
+        iloc.load_var(result->getRegId(), arg1);
+    } else if ((arg1->getRegId() != -1) && !PlatformX64::isArrayObject(arg1)) {
+        // 寄存器 => 内存
+        iloc.store_var(arg1->getRegId(), result);
+    } else if (Instanceof(constVal, ConstInt *, arg1)) {
+        // 立即数 => 内存，movl $1,-4(%rbp)
+        iloc.inst(X64Opcode::X64_OP_MOV,
+                  PlatformX64::valueSize(result),
+                  iloc.operand(result),
+                  X64Operand::makeImm(constVal->getVal()));
+    } else {
+        // 内存 => 内存，借助rax
+        iloc.load_var(X64_RAX_REG_NO, arg1);
+        iloc.store_var(X64_RAX_REG_NO, result);
+    }
+}
+
+/// @brief 二元运算指令翻译成x86-64汇编，x86-64为二地址指令，结果与第一个源操作数相同
+/// @param inst IR指令
+/// @param op 操作码
+void InstSelectorX64::translate_two_operator(Instruction * inst, X64Opcode op)
+{
+    Value * result = inst;
+    Value * arg1 = inst->getOperand(0);
+    Value * arg2 = inst->getOperand(1);
+
+    if (PlatformX64::valueSize(result) == 8) {
+
+        // 地址运算，数组的地址加上32位的偏移，偏移要有符号扩展到64位
+        iloc.load_var64(X64_RAX_REG_NO, arg1);
+
+        if (Instanceof(constVal, ConstInt *, arg2)) {
+            iloc.inst(op, 8, X64Operand::makeReg(X64_RAX_REG_NO, 8), X64Operand::makeImm(constVal->getVal()));
+        } else {
+            iloc.load_var64(X64_RCX_REG_NO, arg2);
+            iloc.inst(op, 8, X64Operand::makeReg(X64_RAX_REG_NO, 8), X64Operand::makeReg(X64_RCX_REG_NO, 8));
+        }
+
+        iloc.store_var(X64_RAX_REG_NO, result);
+        return;
+    }
+
+    // 结果在寄存器中时直接在该寄存器中运算，但不能覆盖第二个源操作数
+    int32_t rs_reg_no = X64_RAX_REG_NO;
+    if ((result->getRegId() != -1) && (result->getRegId() != arg2->getRegId())) {
+        rs_reg_no = result->getRegId();
+    }
+
+    // movl a,%eax; addl b,%eax; movl %eax,c
+    iloc.load_var(rs_reg_no, arg1);
+    iloc.inst(op, 4, X64Operand::makeReg(rs_reg_no, 4), iloc.operand(arg2));
+    iloc.store_var(rs_reg_no, result);
+}
+
+/// @brief 整数加法指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_add_int32(Instruction * inst)
+{
+    translate_two_operator(inst, X64Opcode::X64_OP_ADD);
+}
+
+/// @brief 整数减法指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_sub_int32(Instruction * inst)
+{
+    translate_two_operator(inst, X64Opcode::X64_OP_SUB);
+}
+
+/// @brief 整数乘法指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_mul_int32(Instruction * inst)
+{
+    translate_two_operator(inst, X64Opcode::X64_OP_IMUL);
+}
+
+/// @brief 整数求负指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_minus_int32(Instruction * inst)
+{
+    Value * result = inst;
+
+    int32_t rs_reg_no = (result->getRegId() != -1) ? result->getRegId() : X64_RAX_REG_NO;
+
+    iloc.load_var(rs_reg_no, inst->getOperand(0));
+    iloc.inst(X64Opcode::X64_OP_NEG, 4, X64Operand::makeReg(rs_reg_no, 4));
+    iloc.store_var(rs_reg_no, result);
+}
+
+/// @brief 除法与取余指令翻译成x86-64汇编
+/// @param inst IR指令
+/// @param result_reg_no 结果所在的寄存器，商在rax中，余数在rdx中
+void InstSelectorX64::translate_divide(Instruction * inst, int result_reg_no)
+{
+    Value * arg1 = inst->getOperand(0);
+    Value * arg2 = inst->getOperand(1);
+
+    // 被除数有符号扩展到edx:eax
+    iloc.load_var(X64_RAX_REG_NO, arg1);
+    iloc.inst(X64Opcode::X64_OP_CLTD, 0);
+
+    // idiv不能使用立即数
+    if (Instanceof(constVal, ConstInt *, arg2)) {
+        iloc.load_imm(X64_RCX_REG_NO, constVal->getVal());
+        iloc.inst(X64Opcode::X64_OP_IDIV, 4, X64Operand::makeReg(X64_RCX_REG_NO, 4));
+    } else {
+        iloc.inst(X64Opcode::X64_OP_IDIV, 4, iloc.operand(arg2));
+    }
+
+    iloc.store_var(result_reg_no, inst);
+}
+
+/// @brief 整数除法指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_div_int32(Instruction * inst)
+{
+    translate_divide(inst, X64_RAX_REG_NO);
+}
+
+/// @brief 整数取余指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_mod_int32(Instruction * inst)
+{
+    translate_divide(inst, X64_RDX_REG_NO);
+}
+
+/// @brief 关系运算指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_cmp_int32(Instruction * inst)
+{
+    Value * arg1 = inst->getOperand(0);
+    Value * arg2 = inst->getOperand(1);
+
+    X64Cond cond;
+    switch (inst->getOp()) {
+        case IRInstOperator::IRINST_OP_GT_I:
+            cond = X64Cond::X64_COND_G;
+            break;
+        case IRInstOperator::IRINST_OP_LT_I:
+            cond = X64Cond::X64_COND_L;
+            break;
+        case IRInstOperator::IRINST_OP_GE_I:
+            cond = X64Cond::X64_COND_GE;
+            break;
+        case IRInstOperator::IRINST_OP_LE_I:
+            cond = X64Cond::X64_COND_LE;
+            break;
+        case IRInstOperator::IRINST_OP_EQ_I:
+            cond = X64Cond::X64_COND_E;
+            break;
+        default:
+            cond = X64Cond::X64_COND_NE;
+            break;
+    }
+
+    // 第一个操作数必须在寄存器中，cmpl b,%eax按eax - b设置标志
+    int32_t lhs_reg_no = arg1->getRegId();
+    if (lhs_reg_no == -1) {
+        lhs_reg_no = X64_RAX_REG_NO;
+        iloc.load_var(lhs_reg_no, arg1);
+    }
+
+    iloc.inst(X64Opcode::X64_OP_CMP, 4, X64Operand::makeReg(lhs_reg_no, 4), iloc.operand(arg2));
+
+    // 结果被使用时才保存，set与movzbl不改变标志，紧随其后的分支仍可以直接使用
+    if (inst->isUsed() && (flagsOnly.find(inst) == flagsOnly.end())) {
+        iloc.inst(X64Opcode::X64_OP_SET, 0, X64Operand::makeReg(X64_RAX_REG_NO, 1), {}, cond);
+        iloc.inst(X64Opcode::X64_OP_MOVZBL,
+                  0,
+                  X64Operand::makeReg(X64_RAX_REG_NO, 4),
+                  X64Operand::makeReg(X64_RAX_REG_NO, 1));
+        iloc.store_var(X64_RAX_REG_NO, inst);
+    }
+
+    flagsInst = inst;
+    flagsCond = cond;
+}
+
+/// @brief 分支跳转指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_branch(Instruction * inst)
+{
+    Instanceof(branchInst, BranchInstruction *, inst);
+
+    Value * condVal = inst->getOperand(0);
+    LabelInstruction * trueTarget = branchInst->getTarget1();
+    LabelInstruction * falseTarget = branchInst->getTarget2();
+
+    X64Cond cond;
+
+    if (condVal == prevFlagsInst) {
+        // 紧随关系运算之后，直接使用标志寄存器
+        cond = flagsCond;
+    } else if (Instanceof(constVal, ConstInt *, condVal)) {
+        // 条件为常量，只跳转到一个目标
+        LabelInstruction * target = constVal->getVal() ? trueTarget : falseTarget;
+        if (!isFallthrough(target)) {
+            iloc.jump(target->getName());
+        }
+        return;
+    } else {
+        // 条件值与0比较
+        if (condVal->getRegId() != -1) {
+            iloc.inst(X64Opcode::X64_OP_TEST,
+                      4,
+                      X64Operand::makeReg(condVal->getRegId(), 4),
+                      X64Operand::makeReg(condVal->getRegId(), 4));
+        } else {
+            iloc.inst(X64Opcode::X64_OP_CMP, 4, iloc.operand(condVal), X64Operand::makeImm(0));
+        }
+        cond = X64Cond::X64_COND_NE;
+    }
+
+    // 紧随其后的目标不需要跳转，真目标紧随其后时条件取反跳转到假目标
+    if (isFallthrough(trueTarget)) {
+        iloc.branch(invertCond(cond), falseTarget->getName());
+    } else {
+        iloc.branch(cond, trueTarget->getName());
+        if (!isFallthrough(falseTarget)) {
+            iloc.jump(falseTarget->getName());
+        }
+    }
+}
+
+/// @brief 加载指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_load(Instruction * inst)
+{
+    Value * result = inst;
+    Value * addr = inst->getOperand(0);
+
+    int32_t addr_reg_no = addr->getRegId();
+    if ((addr_reg_no == -1) || PlatformX64::isArrayObject(addr)) {
+        addr_reg_no = X64_RCX_REG_NO;
+        iloc.load_var(addr_reg_no, addr);
+    }
+
+    int32_t rs_reg_no = (result->getRegId() != -1) ? result->getRegId() : X64_RAX_REG_NO;
+    int32_t size = PlatformX64::valueSize(result);
+
+    // movl (%rcx),%eax
+    iloc.inst(X64Opcode::X64_OP_MOV, size, X64Operand::makeReg(rs_reg_no, size), X64Operand::makeMem(addr_reg_no));
+    iloc.store_var(rs_reg_no, result);
+}
+
+/// @brief 存储指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_store(Instruction * inst)
+{
+    Value * addr = inst->getOperand(0);
+    Value * value = inst->getOperand(1);
+
+    int32_t addr_reg_no = addr->getRegId();
+    if ((addr_reg_no == -1) || PlatformX64::isArrayObject(addr)) {
+        addr_reg_no = X64_RCX_REG_NO;
+        iloc.load_var(addr_reg_no, addr);
+    }
+
+    int32_t size = PlatformX64::valueSize(value);
+
+    X64Operand src;
+    if (Instanceof(constVal, ConstInt *, value)) {
+        // movl $1,(%rcx)
+        src = X64Operand::makeImm(constVal->getVal());
+    } else if ((value->getRegId() != -1) && !PlatformX64::isArrayObject(value)) {
+        src = X64Operand::makeReg(value->getRegId(), size);
+    } else {
+        iloc.load_var(X64_RAX_REG_NO, value);
+        src = X64Operand::makeReg(X64_RAX_REG_NO, size);
+    }
+
+    iloc.inst(X64Opcode::X64_OP_MOV, size, X64Operand::makeMem(addr_reg_no), src);
+}
+
+/// @brief 函数调用指令翻译成x86-64汇编
+/// @param inst IR指令
+void InstSelectorX64::translate_call(Instruction * inst)
+{
+    Instanceof(callInst, FuncCallInstruction *, inst);
+
+    int32_t operandNum = callInst->getOperandsNum();
+
+    // 第七个及之后的实参通过栈传递，每个占8字节，栈空间在栈帧的底部已预留
+    for (int32_t k = PlatformX64::maxArgRegNum; k < operandNum; k++) {
+        iloc.load_var(X64_RAX_REG_NO, callInst->getOperand(k));
+        iloc.inst(X64Opcode::X64_OP_MOV,
+                  8,
+                  X64Operand::makeMem(X64_RSP_REG_NO, 8 * (k - PlatformX64::maxArgRegNum)),
+                  X64Operand::makeReg(X64_RAX_REG_NO, 8));
+    }
+
+    // 前六个实参通过寄存器传递，变量不在参数寄存器中，加载时不会相互覆盖
+    for (int32_t k = 0; (k < operandNum) && (k < PlatformX64::maxArgRegNum); k++) {
+        iloc.load_var(PlatformX64::argRegNo[k], callInst->getOperand(k));
+    }
+
+    // 可变参数的函数通过al得知使用的向量寄存器个数，这里为0
+    iloc.load_imm(X64_RAX_REG_NO, 0);
+
+    iloc.call_fun(callInst->getName());
+
+    // 返回值在eax中
+    if (callInst->hasResultValue()) {
+        iloc.store_var(X64_RAX_REG_NO, callInst);
+    }
+}
+
+/// @brief 剖析计数指令翻译成x86-64汇编，计数器表的元素加一
+/// @param inst IR指令
+void InstSelectorX64::translate_counter(Instruction * inst)
+{
+    Instanceof(counterInst, CounterInstruction *, inst);
+
+    // addl $1,__minic_prof_counters+4(%rip)
+    iloc.inst(X64Opcode::X64_OP_ADD,
+              4,
+              X64Operand::makeMemSym(iloc.nameId(counterInst->getTable()->getName()), counterInst->getIndex() * 4),
+              X64Operand::makeImm(1));
+}
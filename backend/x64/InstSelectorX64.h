@@ -0,0 +1,184 @@
+///
+/// @file InstSelectorX64.h
+/// @brief 指令选择器-x86-64的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+#include "Function.h"
+#include "ILocX64.h"
+#include "Instruction.h"
+
+/// @brief 指令选择器-x86-64
+///
+/// 变量在寄存器分配后位于被调用者保存的寄存器或者栈中，调用者保存的寄存器都可以在一条IR指令内临时使用。
+class InstSelectorX64 {
+
+    /// @brief 所有的IR指令
+    std::vector<Instruction *> & ir;
+
+    /// @brief 指令变换
+    ILocX64 & iloc;
+
+    /// @brief 要处理的函数
+    Function * func;
+
+protected:
+    /// @brief 指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate(Instruction * inst);
+
+    /// @brief 不产生指令的IR，如实参指令，实参在函数调用时处理
+    /// @param inst IR指令
+    void translate_nop(Instruction * inst);
+
+    /// @brief 函数入口指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_entry(Instruction * inst);
+
+    /// @brief 函数出口指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_exit(Instruction * inst);
+
+    /// @brief 赋值指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_assign(Instruction * inst);
+
+    /// @brief Label指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_label(Instruction * inst);
+
+    /// @brief goto指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_goto(Instruction * inst);
+
+    /// @brief 整数加法指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_add_int32(Instruction * inst);
+
+    /// @brief 整数减法指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_sub_int32(Instruction * inst);
+
+    /// @brief 整数乘法指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_mul_int32(Instruction * inst);
+
+    /// @brief 整数求负指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_minus_int32(Instruction * inst);
+
+    /// @brief 整数除法指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_div_int32(Instruction * inst);
+
+    /// @brief 整数取余指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_mod_int32(Instruction * inst);
+
+    /// @brief 关系运算指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_cmp_int32(Instruction * inst);
+
+    /// @brief 分支跳转指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_branch(Instruction * inst);
+
+    /// @brief 加载指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_load(Instruction * inst);
+
+    /// @brief 存储指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_store(Instruction * inst);
+
+    /// @brief 函数调用指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_call(Instruction * inst);
+
+    /// @brief 剖析计数指令翻译成x86-64汇编
+    /// @param inst IR指令
+    void translate_counter(Instruction * inst);
+
+    /// @brief 二元运算指令翻译成x86-64汇编，x86-64为二地址指令，结果与第一个源操作数相同
+    /// @param inst IR指令
+    /// @param op 操作码
+    void translate_two_operator(Instruction * inst, X64Opcode op);
+
+    /// @brief 除法与取余指令翻译成x86-64汇编
+    /// @param inst IR指令
+    /// @param result_reg_no 结果所在的寄存器，商在rax中，余数在rdx中
+    void translate_divide(Instruction * inst, int result_reg_no);
+
+    /// @brief 是否顺序执行就到达Label指令，即下一条有效的IR指令是该Label指令
+    /// @param label Label指令
+    /// @return true：是，不需要跳转，false：否
+    bool isFallthrough(Instruction * label) const;
+
+    /// @brief 输出IR指令
+    /// @param inst IR指令
+    void outputIRInstruction(Instruction * inst);
+
+    /// @brief IR翻译动作函数原型
+    typedef void (InstSelectorX64::*translate_handler)(Instruction *);
+
+    /// @brief IR动作处理函数清单
+    std::map<IRInstOperator, translate_handler> translator_handlers;
+
+    /// @brief 显示IR指令内容
+    bool showLinearIR = false;
+
+    /// @brief 正在翻译的IR指令之后的下一条有效指令，没有时为空
+    Instruction * nextInst = nullptr;
+
+    /// @brief 标志寄存器中保存的是哪条关系运算指令的比较结果，没有时为空
+    Instruction * flagsInst = nullptr;
+
+    /// @brief 标志寄存器中的比较结果对应的条件
+    X64Cond flagsCond = X64Cond::X64_COND_NONE;
+
+    /// @brief 上一条翻译的IR指令留在标志寄存器中的关系运算指令，只有紧随其后的指令可使用
+    Instruction * prevFlagsInst = nullptr;
+
+    /// @brief 结果只在标志寄存器中的关系运算指令
+    std::unordered_set<Instruction *> flagsOnly;
+
+public:
+    /// @brief 构造函数
+    /// @param _irCode IR指令
+    /// @param _iloc 后端指令
+    /// @param _func 函数
+    InstSelectorX64(std::vector<Instruction *> & _irCode, ILocX64 & _iloc, Function * _func);
+
+    /// @brief 析构函数
+    ~InstSelectorX64();
+
+    /// @brief 设置是否输出线性IR的内容
+    /// @param show true显示，false显示
+    void setShowLinearIR(bool show)
+    {
+        showLinearIR = show;
+    }
+
+    /// @brief 指令选择
+    void run();
+
+    /// @brief 找出结果只被紧随其后的分支指令使用的关系运算指令，比较结果留在标志寄存器中即可，不需要保存
+    /// @param insts 函数的指令
+    /// @return 这样的关系运算指令
+    static std::unordered_set<Instruction *> flagsOnlyCompares(std::vector<Instruction *> & insts);
+};
@@ -0,0 +1,431 @@
+///
+/// @file JitX64.cpp
+/// @brief 在本机内存中即时编译并执行的x86-64 JIT的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// 只有x86-64的Linux主机可以直接执行产生的机器码
+#if defined(__x86_64__) && defined(__linux__)
+#define MINIC_JIT_HOST 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "JitX64.h"
+#include "Common.h"
+#include "EncoderX64.h"
+#include "Function.h"
+#include "GlobalVariable.h"
+#include "IRConstant.h"
+#include "PointerType.h"
+#include "Profile.h"
+
+/// @brief 代码区的字节数，只保留地址空间，写入代码时才占用内存
+static constexpr size_t JIT_CODE_SIZE = 64 << 20;
+
+/// @brief 内置函数putint，与tests/std.c中的实现相同
+static void builtinPutint(int32_t k)
+{
+    printf("%d", k);
+}
+
+/// @brief 内置函数getint
+static int32_t builtinGetint()
+{
+    int32_t n;
+    if (scanf("%d", &n) != 1) {
+        n = 0;
+    }
+    return n;
+}
+
+/// @brief 内置函数putch
+static void builtinPutch(int32_t c)
+{
+    putchar((char) c);
+}
+
+/// @brief 内置函数getch
+static int32_t builtinGetch()
+{
+    char c = 0;
+    if (scanf("%c", &c) != 1) {
+        c = 0;
+    }
+    return c;
+}
+
+/// @brief 内置函数putarray
+static void builtinPutarray(int32_t n, const int32_t * d)
+{
+    printf("%d:", n);
+    for (int32_t k = 0; k < n; k++) {
+        printf(" %d", d[k]);
+    }
+    printf("\n");
+}
+
+/// @brief 内置函数getarray
+static int32_t builtinGetarray(int32_t * a)
+{
+    int32_t n = 0;
+    if (scanf("%d", &n) != 1) {
+        n = 0;
+    }
+    for (int32_t k = 0; k < n; k++) {
+        if (scanf("%d", &a[k]) != 1) {
+            a[k] = 0;
+        }
+    }
+    return n;
+}
+
+/// @brief 剖析数据的输出函数，与tests/std.c中的实现输出相同格式的剖析数据
+static void builtinProfDump(int32_t checksum, int32_t n, const uint32_t * counters)
+{
+    const char * path = getenv("MINIC_PROFILE_FILE");
+    if ((path == nullptr) || (*path == '\0')) {
+        path = PROFILE_DEFAULT_FILE;
+    }
+    FILE * fp = fopen(path, "w");
+    if (fp == nullptr) {
+        minic_log(LOG_ERROR, "剖析数据文件%s创建失败", path);
+        return;
+    }
+    fprintf(fp, "%s %d %d\n", PROFILE_MAGIC, checksum, n);
+    for (int32_t k = 0; k < n; k++) {
+        fprintf(fp, "%u\n", counters[k]);
+    }
+    fclose(fp);
+}
+
+/// @brief 内置函数的地址
+/// @param name 函数名
+/// @return 地址，不支持时为0
+static uint64_t builtinAddress(const std::string & name)
+{
+    static const std::unordered_map<std::string, uint64_t> builtins = {
+        {"putint", reinterpret_cast<uintptr_t>(&builtinPutint)},
+        {"getint", reinterpret_cast<uintptr_t>(&builtinGetint)},
+        {"putch", reinterpret_cast<uintptr_t>(&builtinPutch)},
+        {"getch", reinterpret_cast<uintptr_t>(&builtinGetch)},
+        {"putarray", reinterpret_cast<uintptr_t>(&builtinPutarray)},
+        {"getarray", reinterpret_cast<uintptr_t>(&builtinGetarray)},
+        {IR_PROFILE_DUMP, reinterpret_cast<uintptr_t>(&builtinProfDump)},
+    };
+
+    auto iter = builtins.find(name);
+    return (iter == builtins.end()) ? 0 : iter->second;
+}
+
+/// @brief 构造函数
+/// @param _module 要执行的模块
+JitX64::JitX64(Module * _module) : module(_module), generator(_module)
+{}
+
+/// @brief 析构函数，释放代码与数据的内存
+JitX64::~JitX64()
+{
+#ifdef MINIC_JIT_HOST
+    if (region != nullptr) {
+        munmap(region, regionSize);
+    }
+#endif
+}
+
+/// @brief 代码区中下一段代码的地址，16字节对齐
+/// @return 地址
+uint8_t * JitX64::nextCode() const
+{
+    return codeBegin + ((codeEnd - codeBegin + 15) & ~(size_t) 15);
+}
+
+/// @brief 分配代码与数据的内存，为全局变量分配空间并设置初值
+/// @return true：成功，false：内存不足
+bool JitX64::layoutMemory()
+{
+#ifdef MINIC_JIT_HOST
+    // 调用槽表在前，全局变量在后
+    std::vector<size_t> offsets;
+    size_t dataSize = 8 * functions.size();
+
+    for (auto var: module->getGlobalVariables()) {
+
+        // 数组的类型为指向数组的指针，大小为数组的大小
+        size_t size;
+        if (var->getType()->isPointerType()) {
+            Instanceof(pointer, PointerType *, var->getType());
+            size = pointer->getPointeeType()->getSize();
+        } else {
+            size = var->getType()->getSize();
+        }
+
+        size_t align = (size_t) var->getAlignment();
+        dataSize = (dataSize + align - 1) & ~(align - 1);
+        offsets.push_back(dataSize);
+        dataSize += size;
+    }
+
+    // 代码区从新的页开始，与数据的保护属性不同
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t dataPages = (dataSize + pageSize - 1) & ~(pageSize - 1);
+    regionSize = dataPages + JIT_CODE_SIZE;
+
+    void * addr = mmap(nullptr, regionSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (addr == MAP_FAILED) {
+        regionSize = 0;
+        minic_log(LOG_ERROR, "JIT的内存分配失败");
+        return false;
+    }
+
+    region = (uint8_t *) addr;
+    if ((dataPages > 0) && (mprotect(region, dataPages, PROT_READ | PROT_WRITE) != 0)) {
+        minic_log(LOG_ERROR, "JIT的数据区保护属性设置失败");
+        return false;
+    }
+
+    slots = (uint64_t *) region;
+    codeBegin = codeEnd = region + dataPages;
+
+    // 匿名映射的内存初值为0，只需设置有初值的全局变量
+    auto & vars = module->getGlobalVariables();
+    for (size_t k = 0; k < vars.size(); k++) {
+        uint8_t * varAddr = region + offsets[k];
+        globalAddress[vars[k]->getName()] = varAddr;
+        if (vars[k]->hasInitVal()) {
+            int32_t value = vars[k]->getInitVal()->getVal();
+            memcpy(varAddr, &value, sizeof(value));
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// @brief 设置各函数的调用槽，非内置函数产生桩代码
+/// @return true：成功，false：内置函数不支持或者代码区已满
+bool JitX64::createSlots()
+{
+    std::vector<uint8_t> stubs;
+    std::vector<size_t> stubOffsets(functions.size(), 0);
+
+    auto emit64 = [&](uint64_t value) {
+        for (int k = 0; k < 8; k++) {
+            stubs.push_back((uint8_t) (value >> (8 * k)));
+        }
+    };
+
+    for (int32_t index = 0; index < (int32_t) functions.size(); index++) {
+
+        Function * func = functions[index];
+
+        if (func->isBuiltin()) {
+            // 内置函数在调用时才报告不支持，没有调用的内置函数不影响执行
+            slots[index] = builtinAddress(func->getName());
+            continue;
+        }
+
+        // 桩代码：保存参数寄存器，调用lazyCompile(this, index)，恢复参数寄存器后跳转到编译好的函数。
+        // 进入时rsp加8为16的倍数，压入6个寄存器再减8后为16的倍数。栈传递的参数原样保留
+        stubOffsets[index] = stubs.size();
+        stubs.insert(stubs.end(), {0x57, 0x56, 0x52, 0x51, 0x41, 0x50, 0x41, 0x51, 0x48, 0x83, 0xEC, 0x08});
+        stubs.insert(stubs.end(), {0x48, 0xBF});
+        emit64(reinterpret_cast<uintptr_t>(this));
+        stubs.push_back(0xBE);
+        for (int k = 0; k < 4; k++) {
+            stubs.push_back((uint8_t) ((uint32_t) index >> (8 * k)));
+        }
+        stubs.insert(stubs.end(), {0x48, 0xB8});
+        emit64(reinterpret_cast<uintptr_t>(&JitX64::lazyCompile));
+        stubs.insert(stubs.end(), {0xFF, 0xD0, 0x48, 0x83, 0xC4, 0x08});
+        stubs.insert(stubs.end(), {0x41, 0x59, 0x41, 0x58, 0x59, 0x5A, 0x5E, 0x5F, 0xFF, 0xE0});
+
+        // 各桩代码16字节对齐
+        stubs.resize((stubs.size() + 15) & ~(size_t) 15, 0xCC);
+    }
+
+    uint8_t * addr = nextCode();
+    if (!writeCode(stubs, addr)) {
+        return false;
+    }
+
+    for (int32_t index = 0; index < (int32_t) functions.size(); index++) {
+        if (!functions[index]->isBuiltin()) {
+            slots[index] = reinterpret_cast<uintptr_t>(addr + stubOffsets[index]);
+        }
+    }
+
+    return true;
+}
+
+/// @brief 机器码写入代码区
+/// @param bytes 机器码
+/// @param addr 写入的地址，必须是nextCode返回的地址
+/// @return true：成功，false：代码区已满或者修改内存的保护属性失败
+bool JitX64::writeCode(const std::vector<uint8_t> & bytes, uint8_t * addr)
+{
+#ifdef MINIC_JIT_HOST
+    if (bytes.empty()) {
+        return true;
+    }
+
+    if (addr + bytes.size() > region + regionSize) {
+        minic_log(LOG_ERROR, "JIT的代码区已满");
+        return false;
+    }
+
+    // 写入时可写不可执行，写完后可执行不可写，与已有代码共用的页也暂时不可执行，此时不在执行JIT的代码
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    uintptr_t first = reinterpret_cast<uintptr_t>(addr) & ~(pageSize - 1);
+    uintptr_t last = (reinterpret_cast<uintptr_t>(addr) + bytes.size() + pageSize - 1) & ~(pageSize - 1);
+
+    if (mprotect(reinterpret_cast<void *>(first), last - first, PROT_READ | PROT_WRITE) != 0) {
+        minic_log(LOG_ERROR, "JIT的代码区保护属性设置失败");
+        return false;
+    }
+
+    memcpy(addr, bytes.data(), bytes.size());
+
+    if (mprotect(reinterpret_cast<void *>(first), last - first, PROT_READ | PROT_EXEC) != 0) {
+        minic_log(LOG_ERROR, "JIT的代码区保护属性设置失败");
+        return false;
+    }
+
+    __builtin___clear_cache(reinterpret_cast<char *>(addr), reinterpret_cast<char *>(addr + bytes.size()));
+
+    codeEnd = addr + bytes.size();
+
+    return true;
+#else
+    (void) bytes;
+    (void) addr;
+    return false;
+#endif
+}
+
+/// @brief 编译函数，成功后调用槽指向函数的机器码
+/// @param index 函数编号
+/// @return true：成功，false：函数体加载失败、有不支持的IR或者代码区已满
+bool JitX64::compile(int32_t index)
+{
+    Function * func = functions[index];
+
+    // 从二进制IR加载的模块，函数体在第一次调用时才创建
+    if (!module->materialize(func)) {
+        return false;
+    }
+
+    generator.registerAllocation(func);
+
+    // Label只在函数内跳转，函数内唯一即可
+    for (auto inst: func->getInterCode().getInsts()) {
+        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            inst->setName(IR_LABEL_PREFIX + std::to_string(labelIndex++));
+        }
+    }
+
+    ILocX64 iloc;
+    generator.instSelect(func, iloc);
+
+    // 全局变量取得其地址，函数调用取得其调用槽的地址
+    EncoderX64 encoder([this](X64OperandKind kind, const std::string & name, uint64_t & addr) {
+        if (kind == X64OperandKind::X64_OPND_MEM_SYM) {
+            auto iter = globalAddress.find(name);
+            if (iter != globalAddress.end()) {
+                addr = reinterpret_cast<uintptr_t>(iter->second);
+                return true;
+            }
+        } else {
+            auto iter = functionIndex.find(name);
+            if ((iter != functionIndex.end()) && (slots[iter->second] != 0)) {
+                addr = reinterpret_cast<uintptr_t>(&slots[iter->second]);
+                return true;
+            }
+        }
+        minic_log(LOG_ERROR, "JIT时符号%s未定义或者不支持", name.c_str());
+        return false;
+    });
+
+    uint8_t * addr = nextCode();
+    if (!encoder.encode(iloc, reinterpret_cast<uintptr_t>(addr)) || !writeCode(encoder.getBytes(), addr)) {
+        minic_log(LOG_ERROR, "函数%s的机器码生成失败", func->getName().c_str());
+        return false;
+    }
+
+    slots[index] = reinterpret_cast<uintptr_t>(addr);
+    compiled[index] = true;
+
+    return true;
+}
+
+/// @brief 桩代码调用的编译函数，编译失败时返回到run中
+/// @param jit JIT
+/// @param index 函数编号
+/// @return 函数的机器码地址
+void * JitX64::lazyCompile(JitX64 * jit, int32_t index)
+{
+    if (!jit->compiled[index] && !jit->compile(index)) {
+        // 无法返回到调用者的机器码中，直接回到run，其间只有JIT产生的函数的栈帧
+        std::longjmp(jit->errorJump, 1);
+    }
+
+    return reinterpret_cast<void *>(jit->slots[index]);
+}
+
+/// @brief 编译main函数并执行，其它函数在第一次调用时编译
+/// @param exitValue main函数的返回值
+/// @return true：成功，false：宿主不支持或者编译出错
+bool JitX64::run(int32_t & exitValue)
+{
+#ifdef MINIC_JIT_HOST
+    for (auto func: module->getFunctionList()) {
+        functionIndex[func->getName()] = (int32_t) functions.size();
+        functions.push_back(func);
+    }
+    compiled.assign(functions.size(), false);
+
+    auto iter = functionIndex.find("main");
+    if ((iter == functionIndex.end()) || functions[iter->second]->isBuiltin()) {
+        minic_log(LOG_ERROR, "JIT时没有找到main函数");
+        return false;
+    }
+    int32_t mainIndex = iter->second;
+
+    if (!layoutMemory() || !createSlots()) {
+        return false;
+    }
+
+    if (setjmp(errorJump) != 0) {
+        fflush(stdout);
+        return false;
+    }
+
+    typedef int32_t (*MainFunction)();
+    auto entry = reinterpret_cast<MainFunction>(reinterpret_cast<uintptr_t>(lazyCompile(this, mainIndex)));
+
+    exitValue = entry();
+
+    fflush(stdout);
+
+    return true;
+#else
+    (void) exitValue;
+    minic_log(LOG_ERROR, "JIT只支持x86-64的Linux主机");
+    return false;
+#endif
+}
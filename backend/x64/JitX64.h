@@ -0,0 +1,142 @@
+///
+/// @file JitX64.h
+/// @brief 在本机内存中即时编译并执行的x86-64 JIT的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <csetjmp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CodeGeneratorX64.h"
+#include "Module.h"
+
+///
+/// @brief x86-64的JIT，把IR经指令选择后直接编码为本机机器码，在进程内从main函数开始执行
+///
+/// 一块mmap的内存中依次是调用槽表、全局变量与代码区，代码与数据的距离在32位偏移以内，可以PC相对寻址。
+/// 每个函数占一个调用槽，函数调用都是call *slot(%rip)。内置函数的槽中是宿主中实现的函数的地址；
+/// 其它函数的槽开始时指向该函数的桩代码，第一次调用时桩代码调用编译函数，编译完成后槽改为函数的机器码地址，
+/// 之后的调用直接进入函数。代码区写入时可写不可执行，写完后可执行不可写。
+///
+/// 除0等与本机指令相同，会产生信号，这一点与解释执行不同。
+///
+class JitX64 {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 要执行的模块
+    ///
+    explicit JitX64(Module * _module);
+
+    ///
+    /// @brief 析构函数，释放代码与数据的内存
+    ///
+    ~JitX64();
+
+    JitX64(const JitX64 &) = delete;
+    JitX64 & operator=(const JitX64 &) = delete;
+
+    ///
+    /// @brief 编译main函数并执行，其它函数在第一次调用时编译
+    /// @param exitValue main函数的返回值
+    /// @return true：成功，false：宿主不支持或者编译出错
+    ///
+    bool run(int32_t & exitValue);
+
+protected:
+    ///
+    /// @brief 分配代码与数据的内存，为全局变量分配空间并设置初值
+    /// @return true：成功，false：内存不足
+    ///
+    bool layoutMemory();
+
+    ///
+    /// @brief 设置各函数的调用槽，非内置函数产生桩代码
+    /// @return true：成功，false：内置函数不支持或者代码区已满
+    ///
+    bool createSlots();
+
+    ///
+    /// @brief 编译函数，成功后调用槽指向函数的机器码
+    /// @param index 函数编号
+    /// @return true：成功，false：函数体加载失败、有不支持的IR或者代码区已满
+    ///
+    bool compile(int32_t index);
+
+    ///
+    /// @brief 机器码写入代码区
+    /// @param bytes 机器码
+    /// @param addr 写入的地址，必须是nextCode返回的地址
+    /// @return true：成功，false：代码区已满或者修改内存的保护属性失败
+    ///
+    bool writeCode(const std::vector<uint8_t> & bytes, uint8_t * addr);
+
+    ///
+    /// @brief 代码区中下一段代码的地址，16字节对齐
+    /// @return 地址
+    ///
+    uint8_t * nextCode() const;
+
+    ///
+    /// @brief 桩代码调用的编译函数，编译失败时返回到run中
+    /// @param jit JIT
+    /// @param index 函数编号
+    /// @return 函数的机器码地址
+    ///
+    static void * lazyCompile(JitX64 * jit, int32_t index);
+
+private:
+    /// @brief 要执行的模块
+    Module * module;
+
+    /// @brief 寄存器分配与指令选择与汇编输出相同
+    CodeGeneratorX64 generator;
+
+    /// @brief 各函数，下标为函数编号，与调用槽一一对应
+    std::vector<Function *> functions;
+
+    /// @brief 函数名-函数编号
+    std::unordered_map<std::string, int32_t> functionIndex;
+
+    /// @brief 全局变量名-地址
+    std::unordered_map<std::string, uint8_t *> globalAddress;
+
+    /// @brief mmap的内存
+    uint8_t * region = nullptr;
+
+    /// @brief mmap的内存的字节数
+    size_t regionSize = 0;
+
+    /// @brief 调用槽表，位于内存的开始
+    uint64_t * slots = nullptr;
+
+    /// @brief 代码区的开始
+    uint8_t * codeBegin = nullptr;
+
+    /// @brief 代码区已使用的末尾
+    uint8_t * codeEnd = nullptr;
+
+    /// @brief 各函数是否已编译
+    std::vector<bool> compiled;
+
+    /// @brief Label的编号，函数内唯一即可
+    int64_t labelIndex = 0;
+
+    /// @brief 延迟编译失败时返回到run中
+    std::jmp_buf errorJump;
+};
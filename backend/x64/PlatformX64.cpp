@@ -0,0 +1,145 @@
+///
+/// @file PlatformX64.cpp
+/// @brief x86-64平台相关的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "PlatformX64.h"
+
+#include "ArrayType.h"
+#include "PointerType.h"
+
+const char * const PlatformX64::regName64[PlatformX64::maxRegNum] = {
+    "rax", // 返回值，除法的被除数与商，临时寄存器
+    "rcx", // 第4个参数，临时寄存器
+    "rdx", // 第3个参数，除法的余数
+    "rbx", // 被调用者保存
+    "rsp", // 栈指针
+    "rbp", // 帧指针，局部变量寻址
+    "rsi", // 第2个参数
+    "rdi", // 第1个参数
+    "r8",  // 第5个参数
+    "r9",  // 第6个参数
+    "r10", // 调用者保存
+    "r11", // 调用者保存，临时寄存器
+    "r12", // 被调用者保存
+    "r13", // 被调用者保存
+    "r14", // 被调用者保存
+    "r15", // 被调用者保存
+};
+
+const char * const PlatformX64::regName32[PlatformX64::maxRegNum] = {
+    "eax",
+    "ecx",
+    "edx",
+    "ebx",
+    "esp",
+    "ebp",
+    "esi",
+    "edi",
+    "r8d",
+    "r9d",
+    "r10d",
+    "r11d",
+    "r12d",
+    "r13d",
+    "r14d",
+    "r15d",
+};
+
+const char * const PlatformX64::regName8[PlatformX64::maxRegNum] = {
+    "al",
+    "cl",
+    "dl",
+    "bl",
+    "spl",
+    "bpl",
+    "sil",
+    "dil",
+    "r8b",
+    "r9b",
+    "r10b",
+    "r11b",
+    "r12b",
+    "r13b",
+    "r14b",
+    "r15b",
+};
+
+const int PlatformX64::argRegNo[PlatformX64::maxArgRegNum] = {
+    X64_RDI_REG_NO,
+    X64_RSI_REG_NO,
+    X64_RDX_REG_NO,
+    X64_RCX_REG_NO,
+    X64_R8_REG_NO,
+    X64_R9_REG_NO,
+};
+
+const int PlatformX64::calleeSavedRegNo[PlatformX64::maxCalleeSavedRegNum] = {
+    X64_RBX_REG_NO,
+    X64_R12_REG_NO,
+    X64_R13_REG_NO,
+    X64_R14_REG_NO,
+    X64_R15_REG_NO,
+};
+
+/// @brief 寄存器的名字
+/// @param regNo 寄存器编号
+/// @param size 字节数，8、4或1
+/// @return 名字
+const char * PlatformX64::regName(int regNo, int size)
+{
+    if (size == 8) {
+        return regName64[regNo];
+    } else if (size == 1) {
+        return regName8[regNo];
+    }
+
+    return regName32[regNo];
+}
+
+/// @brief 是否是数组对象本身，即局部或全局数组，其值为数组的地址，需要lea取得
+/// @param val 变量
+/// @return true：是，false：否，形参数组保存的是地址，不是数组对象
+bool PlatformX64::isArrayObject(Value * val)
+{
+    if (!val->getType()->isPointerType()) {
+        return false;
+    }
+
+    Instanceof(pointer, PointerType *, val->getType());
+    Instanceof(array, const ArrayType *, pointer->getPointeeType());
+
+    // 形参中的数组第一维为0，保存的是实参数组的地址
+    return array && (array->getNumElements() != 0);
+}
+
+/// @brief 变量的值占用的字节数，指针为8字节，其它为4字节
+/// @param val 变量
+/// @return 字节数
+int PlatformX64::valueSize(Value * val)
+{
+    return val->getType()->isPointerType() ? 8 : 4;
+}
+
+/// @brief 变量在栈帧内占用的字节数，数组对象为整个数组的大小
+/// @param val 变量
+/// @return 字节数
+int PlatformX64::frameSize(Value * val)
+{
+    if (isArrayObject(val)) {
+        Instanceof(pointer, PointerType *, val->getType());
+        return pointer->getPointeeType()->getSize();
+    }
+
+    return valueSize(val);
+}
@@ -0,0 +1,92 @@
+///
+/// @file PlatformX64.h
+/// @brief x86-64平台相关的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+
+#include "Value.h"
+
+// 寄存器编号与指令编码中的编号一致
+#define X64_RAX_REG_NO 0
+#define X64_RCX_REG_NO 1
+#define X64_RDX_REG_NO 2
+#define X64_RBX_REG_NO 3
+#define X64_RSP_REG_NO 4
+#define X64_RBP_REG_NO 5
+#define X64_RSI_REG_NO 6
+#define X64_RDI_REG_NO 7
+#define X64_R8_REG_NO 8
+#define X64_R9_REG_NO 9
+#define X64_R10_REG_NO 10
+#define X64_R11_REG_NO 11
+#define X64_R12_REG_NO 12
+#define X64_R13_REG_NO 13
+#define X64_R14_REG_NO 14
+#define X64_R15_REG_NO 15
+
+// 在操作过程中临时借助的寄存器，都是调用者保存的寄存器，不分配给变量
+#define X64_TMP_REG_NO X64_RAX_REG_NO
+#define X64_TMP2_REG_NO X64_RCX_REG_NO
+#define X64_TMP3_REG_NO X64_R11_REG_NO
+
+class PlatformX64 {
+
+public:
+    /// @brief 最大寄存器数目
+    static const int maxRegNum = 16;
+
+    /// @brief 64位寄存器的名字，rax-r15
+    static const char * const regName64[maxRegNum];
+
+    /// @brief 32位寄存器的名字，eax-r15d
+    static const char * const regName32[maxRegNum];
+
+    /// @brief 8位寄存器的名字，al-r15b
+    static const char * const regName8[maxRegNum];
+
+    /// @brief System V调用约定中通过寄存器传递的整数参数个数
+    static const int maxArgRegNum = 6;
+
+    /// @brief 依次传递前六个整数参数的寄存器
+    static const int argRegNo[maxArgRegNum];
+
+    /// @brief 被调用者保存的寄存器中可分配给变量的个数
+    static const int maxCalleeSavedRegNum = 5;
+
+    /// @brief 可分配给变量的被调用者保存的寄存器，rbx、r12-r15
+    static const int calleeSavedRegNo[maxCalleeSavedRegNum];
+
+    /// @brief 寄存器的名字
+    /// @param regNo 寄存器编号
+    /// @param size 字节数，8、4或1
+    /// @return 名字
+    static const char * regName(int regNo, int size);
+
+    /// @brief 是否是数组对象本身，即局部或全局数组，其值为数组的地址，需要lea取得
+    /// @param val 变量
+    /// @return true：是，false：否，形参数组保存的是地址，不是数组对象
+    static bool isArrayObject(Value * val);
+
+    /// @brief 变量的值占用的字节数，指针为8字节，其它为4字节
+    /// @param val 变量
+    /// @return 字节数
+    static int valueSize(Value * val);
+
+    /// @brief 变量在栈帧内占用的字节数，数组对象为整个数组的大小
+    /// @param val 变量
+    /// @return 字节数
+    static int frameSize(Value * val);
+};
@@ -0,0 +1,170 @@
+///
+/// @file RegisterAllocatorX64.cpp
+/// @brief x86-64的寄存器分配的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+#include <unordered_set>
+
+#include "RegisterAllocatorX64.h"
+#include "BranchInstruction.h"
+#include "FormalParam.h"
+#include "GotoInstruction.h"
+#include "InstSelectorX64.h"
+#include "LocalVariable.h"
+#include "PlatformX64.h"
+
+/// @brief 循环嵌套层数的上限，超过后权重不再增加，避免溢出
+#define X64_MAX_LOOP_DEPTH 6
+
+/// @brief 构造函数
+/// @param _func 要分配的函数
+RegisterAllocatorX64::RegisterAllocatorX64(Function * _func) : func(_func)
+{}
+
+/// @brief 计算每条指令所在循环的嵌套层数
+/// @return 与指令列表一一对应的层数
+std::vector<int32_t> RegisterAllocatorX64::loopDepths()
+{
+    auto & insts = func->getInterCode().getInsts();
+
+    std::unordered_map<Instruction *, int32_t> labelIndex;
+    for (int32_t k = 0; k < (int32_t) insts.size(); k++) {
+        if (insts[k]->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            labelIndex[insts[k]] = k;
+        }
+    }
+
+    // 差分数组，跳转回前面的Label时，从Label到跳转指令之间的指令都在循环内
+    std::vector<int32_t> delta(insts.size() + 1, 0);
+
+    auto backEdge = [&](int32_t from, Instruction * target) {
+        auto iter = labelIndex.find(target);
+        if ((iter != labelIndex.end()) && (iter->second <= from)) {
+            delta[iter->second]++;
+            delta[from + 1]--;
+        }
+    };
+
+    for (int32_t k = 0; k < (int32_t) insts.size(); k++) {
+        if (insts[k]->isDead()) {
+            continue;
+        }
+        if (Instanceof(gotoInst, GotoInstruction *, insts[k])) {
+            backEdge(k, gotoInst->getTarget());
+        } else if (Instanceof(branchInst, BranchInstruction *, insts[k])) {
+            backEdge(k, branchInst->getTarget1());
+            backEdge(k, branchInst->getTarget2());
+        }
+    }
+
+    std::vector<int32_t> depths(insts.size());
+    int32_t depth = 0;
+    for (size_t k = 0; k < insts.size(); k++) {
+        depth += delta[k];
+        depths[k] = std::min(depth, X64_MAX_LOOP_DEPTH);
+    }
+
+    return depths;
+}
+
+/// @brief 变量是否可以分配寄存器
+/// @param val 变量
+/// @return true：可以，false：不可以
+bool RegisterAllocatorX64::isCandidate(Value * val)
+{
+    return weights.find(val) != weights.end();
+}
+
+/// @brief 分配寄存器，设置变量的寄存器编号，并把用到的寄存器加入函数需要保护的寄存器中
+void RegisterAllocatorX64::run()
+{
+    auto & insts = func->getInterCode().getInsts();
+
+    // 候选：标量的局部变量、寄存器传递的形参、有结果的指令。数组对象必须在内存中
+    auto addCandidate = [&](Value * val) {
+        if ((val->getRegId() == -1) && !PlatformX64::isArrayObject(val) && weights.emplace(val, 0).second) {
+            candidates.push_back(val);
+        }
+    };
+
+    auto & params = func->getParams();
+    for (int k = 0; (k < (int) params.size()) && (k < PlatformX64::maxArgRegNum); k++) {
+        addCandidate(params[k]);
+    }
+    for (auto var: func->getVarValues()) {
+        addCandidate(var);
+    }
+
+    // 比较结果只留在标志寄存器中的关系运算指令不需要寄存器
+    std::unordered_set<Instruction *> flagsOnly = InstSelectorX64::flagsOnlyCompares(insts);
+
+    for (auto inst: insts) {
+        if (!inst->isDead() && inst->hasResultValue() && (flagsOnly.find(inst) == flagsOnly.end())) {
+            addCandidate(inst);
+        }
+    }
+
+    // 使用与定值的次数按循环层数加权，每层8倍
+    std::vector<int32_t> depths = loopDepths();
+    for (size_t k = 0; k < insts.size(); k++) {
+
+        Instruction * inst = insts[k];
+        if (inst->isDead()) {
+            continue;
+        }
+
+        uint64_t weight = uint64_t(1) << (3 * depths[k]);
+
+        if (isCandidate(inst)) {
+            weights[inst] += weight;
+        }
+
+        for (auto operand: inst->getOperandsValue()) {
+            if (isCandidate(operand)) {
+                weights[operand] += weight;
+            }
+        }
+    }
+
+    // 按权重从大到小，权重相同时按出现的次序
+    std::stable_sort(candidates.begin(), candidates.end(), [&](Value * a, Value * b) {
+        return weights[a] > weights[b];
+    });
+
+    std::vector<int32_t> & protectedRegNo = func->getProtectedReg();
+    protectedRegNo.clear();
+
+    int32_t count = std::min((int32_t) candidates.size(), (int32_t) PlatformX64::maxCalleeSavedRegNum);
+    for (int32_t k = 0; k < count; k++) {
+
+        Value * val = candidates[k];
+
+        // 只使用一两次的变量放在寄存器中得不偿失，保存与恢复寄存器也有开销
+        if (weights[val] < 3) {
+            break;
+        }
+
+        int32_t regNo = PlatformX64::calleeSavedRegNo[k];
+
+        if (Instanceof(param, FormalParam *, val)) {
+            param->setRegId(regNo);
+        } else if (Instanceof(var, LocalVariable *, val)) {
+            var->setRegId(regNo);
+        } else if (Instanceof(inst, Instruction *, val)) {
+            inst->setRegId(regNo);
+        }
+
+        protectedRegNo.push_back(regNo);
+    }
+}
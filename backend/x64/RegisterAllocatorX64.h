@@ -0,0 +1,69 @@
+///
+/// @file RegisterAllocatorX64.h
+/// @brief x86-64的寄存器分配的头文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Function.h"
+
+///
+/// @brief x86-64的寄存器分配
+///
+/// 被调用者保存的寄存器rbx、r12-r15在整个函数内分配给使用最频繁的标量变量，其它变量留在栈中。
+/// 这些寄存器跨函数调用保持不变，因此不需要活跃区间分析，只在入口处保存、出口处恢复。
+/// 使用次数按所在循环的嵌套层数加权，循环由向前跳转的Label识别。
+/// 调用者保存的寄存器不分配给变量，供指令选择时临时使用。
+///
+class RegisterAllocatorX64 {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要分配的函数
+    ///
+    explicit RegisterAllocatorX64(Function * _func);
+
+    ///
+    /// @brief 分配寄存器，设置变量的寄存器编号，并把用到的寄存器加入函数需要保护的寄存器中
+    ///
+    void run();
+
+protected:
+    ///
+    /// @brief 计算每条指令所在循环的嵌套层数
+    /// @return 与指令列表一一对应的层数
+    ///
+    std::vector<int32_t> loopDepths();
+
+    ///
+    /// @brief 变量是否可以分配寄存器
+    /// @param val 变量
+    /// @return true：可以，false：不可以
+    ///
+    bool isCandidate(Value * val);
+
+private:
+    /// @brief 要分配的函数
+    Function * func;
+
+    /// @brief 候选变量的加权使用次数
+    std::unordered_map<Value *, uint64_t> weights;
+
+    /// @brief 候选变量按首次出现的次序，使权重相同时的分配结果稳定
+    std::vector<Value *> candidates;
+};
@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# @file compile_bench.py
+# @brief 编译器自身的速度测试：用gen_minic.py生成各种形态的大程序，分别统计三种前端、IRGenerator
+#        与ARM32代码生成各阶段的时间与内存分配次数，与基线比较
+# @author zenglj (zenglj@live.com)
+# @version 1.0
+# @date 2026-10-18
+#
+# @copyright Copyright (c) 2026
+#
+# 用法示例：
+#   python3 bench/compile_bench.py --minic build/minic
+#   python3 bench/compile_bench.py --minic build/minic --filter functions --repetitions 10
+#   python3 bench/compile_bench.py --minic build/minic --update-baseline
+#
+# 各阶段的数据来自minic的--time-report-json。每个测试重复运行多次，时间取最小值，分配次数每次都相同。
+# 输出与Google Benchmark的格式相同，--json的结果可以直接用Google Benchmark的tools/compare.py比较。
+# 时间受机器负载影响，阈值较宽；分配次数是确定的，阈值较严，适合在CI中发现退化。
+#
+
+import argparse
+import datetime
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.dirname(BENCH_DIR)
+
+sys.path.insert(0, BENCH_DIR)
+import gen_minic  # noqa: E402
+
+# 前端名 -> minic的选项
+FRONTENDS = {
+    "flexbison": [],
+    "recursive-descent": ["-D"],
+    "antlr4": ["-A"],
+}
+
+ALL_FRONTENDS = ["flexbison", "recursive-descent", "antlr4"]
+
+# 测试用例：名字、形态、规模、文法、前端、统计的阶段
+# basic文法的程序三种前端都可以分析，full文法只有Antlr4可以分析。
+# IRGenerator目前不支持数组初值，array-init只统计前端。
+CASES = [
+    ("functions_basic", "functions", 2000, "basic", ALL_FRONTENDS, None),
+    ("nesting_basic", "nesting", 500, "basic", ALL_FRONTENDS, None),
+    ("expression_basic", "expression", 20000, "basic", ALL_FRONTENDS, None),
+    ("globals_basic", "globals", 10000, "basic", ALL_FRONTENDS, None),
+    ("functions_full", "functions", 2000, "full", ["antlr4"], None),
+    ("nesting_full", "nesting", 300, "full", ["antlr4"], None),
+    ("expression_full", "expression", 20000, "full", ["antlr4"], None),
+    ("array_init_full", "array-init", 20000, "full", ["antlr4"], ["frontend"]),
+    ("mixed_full", "mixed", 4000, "full", ["antlr4"], None),
+]
+
+# 报告的阶段，codegen为CodeGeneratorArm32各阶段之和
+PHASES = ["frontend", "irgen", "regalloc", "isel", "emit", "codegen", "total"]
+CODEGEN_PHASES = ["regalloc", "isel", "emit", "write"]
+
+
+def fail(msg):
+    print("error: " + msg, file=sys.stderr)
+    sys.exit(2)
+
+
+def generate(work_dir, case, scale):
+    """生成用例的源程序，已存在且参数相同时不再生成"""
+    name, shape, size, grammar = case[:4]
+    size = max(1, int(size * scale))
+    path = os.path.join(work_dir, "%s_%d.c" % (name, size))
+    if not os.path.isfile(path):
+        text = gen_minic.Generator(size, grammar == "full", 1).generate(shape)
+        with open(path, "w") as f:
+            f.write(text)
+    return path
+
+
+def run_once(args, source, frontend, work_dir):
+    """编译一次，返回阶段名 -> 统计，以及minic的返回值"""
+    report = os.path.join(work_dir, "report.json")
+    output = os.path.join(work_dir, "out.s")
+    if os.path.exists(report):
+        os.remove(report)
+
+    cmd = [args.minic, "-S"] + FRONTENDS[frontend] + ["-j", "1", "-o", output,
+                                                      "--time-report-json=" + report, source]
+    proc = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+
+    if not os.path.isfile(report):
+        fail("no time report from: %s\n%s" % (" ".join(cmd), proc.stderr.decode(errors="replace")))
+
+    with open(report) as f:
+        data = json.load(f)
+
+    phases = {p["name"]: p for p in data["phases"]}
+    phases["total"] = data["total"]
+
+    codegen = [phases[p] for p in CODEGEN_PHASES if p in phases]
+    if codegen:
+        phases["codegen"] = {
+            "wall": sum(p["wall"] for p in codegen),
+            "cpu": sum(p["cpu"] for p in codegen),
+            "allocs": sum(p.get("allocs", 0) for p in codegen),
+            "alloc_bytes": sum(p.get("alloc_bytes", 0) for p in codegen),
+            "peak_rss_kb": max(p["peak_rss_kb"] for p in codegen),
+        }
+
+    return phases, proc.returncode, proc.stderr.decode(errors="replace")
+
+
+def run_case(args, case, work_dir):
+    """一个用例在各前端下重复运行，返回Google Benchmark格式的结果列表"""
+    name, _, _, _, frontends, stages = case
+    source = generate(work_dir, case, args.scale)
+
+    results = []
+    for frontend in frontends:
+        best = {}
+        for _ in range(args.repetitions):
+            phases, rc, err = run_once(args, source, frontend, work_dir)
+            if rc != 0 and stages is None:
+                fail("minic failed on %s with %s:\n%s" % (source, frontend, err))
+            for phase in stages or PHASES:
+                if phase not in phases:
+                    fail("phase %s missing for %s with %s" % (phase, source, frontend))
+                p = phases[phase]
+                b = best.setdefault(phase, dict(p))
+                b["wall"] = min(b["wall"], p["wall"])
+                b["cpu"] = min(b["cpu"], p["cpu"])
+
+        for phase in stages or PHASES:
+            p = best[phase]
+            bench_name = "%s/%s/%s" % (name, frontend, phase)
+            results.append({
+                "name": bench_name,
+                "run_name": bench_name,
+                "run_type": "iteration",
+                "repetitions": args.repetitions,
+                "iterations": 1,
+                "real_time": p["wall"] * 1e3,
+                "cpu_time": p["cpu"] * 1e3,
+                "time_unit": "ms",
+                "allocs": p.get("allocs", 0),
+                "alloc_bytes": p.get("alloc_bytes", 0),
+                "peak_rss_kb": p.get("peak_rss_kb", 0),
+            })
+    return results
+
+
+def print_results(results):
+    print("%-48s %12s %12s %12s %14s" % ("Benchmark", "Time", "CPU", "Allocs", "Alloc(KB)"))
+    print("-" * 102)
+    for r in results:
+        print("%-48s %9.3f ms %9.3f ms %12d %14d" % (r["name"], r["real_time"], r["cpu_time"], r["allocs"],
+                                                    r["alloc_bytes"] // 1024))
+
+
+def compare(baseline, results, args):
+    """与基线比较CPU时间与分配次数，返回退化的个数。基线的CPU时间小于min_time时不比较时间"""
+    base = {b["name"]: b for b in baseline.get("benchmarks", [])}
+    regressions = 0
+    print("\nComparison with baseline (cpu time threshold %+.0f%%, allocs threshold %+.1f%%)" %
+          (args.time_threshold * 100, args.alloc_threshold * 100))
+    for r in results:
+        b = base.get(r["name"])
+        if b is None:
+            print("  %-48s new" % r["name"])
+            continue
+        notes = []
+        for key, threshold in (("cpu_time", args.time_threshold), ("allocs", args.alloc_threshold)):
+            old, new = b.get(key, 0), r[key]
+            if not old or (key == "cpu_time" and old < args.min_time):
+                continue
+            ratio = (new - old) / old
+            if ratio > threshold:
+                notes.append("%s %+.1f%% REGRESSION" % (key, ratio * 100))
+                regressions += 1
+            elif ratio < -threshold:
+                notes.append("%s %+.1f%% improved" % (key, ratio * 100))
+        print("  %-48s %s" % (r["name"], ", ".join(notes) if notes else "ok"))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="minic compile-time benchmarks")
+    parser.add_argument("--minic", default=os.path.join(REPO_DIR, "build", "minic"), help="minic executable")
+    parser.add_argument("--filter", default=None, help="only run benchmarks whose case name contains this")
+    parser.add_argument("--frontends", nargs="*", choices=ALL_FRONTENDS, default=None,
+                        help="front ends to run (default: all that can parse each case)")
+    parser.add_argument("--repetitions", type=int, default=5, help="runs per benchmark, the minimum is reported")
+    parser.add_argument("--scale", type=float, default=1.0, help="multiply every case size by this")
+    parser.add_argument("--work-dir", default=None, help="directory for the generated programs")
+    parser.add_argument("--json", default=None, help="write the results to this JSON file")
+    parser.add_argument("--baseline", default=os.path.join(BENCH_DIR, "baseline-compile.json"),
+                        help="baseline JSON (default bench/baseline-compile.json)")
+    parser.add_argument("--update-baseline", action="store_true", help="write the results as the new baseline")
+    parser.add_argument("--time-threshold", type=float, default=0.10, help="allowed cpu time increase (0.10)")
+    parser.add_argument("--alloc-threshold", type=float, default=0.01, help="allowed allocation increase (0.01)")
+    parser.add_argument("--min-time", type=float, default=1.0,
+                        help="skip the time comparison of benchmarks faster than this many ms (1.0)")
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.minic):
+        fail("minic not found: " + args.minic)
+    args.minic = os.path.abspath(args.minic)
+    if args.repetitions < 1:
+        fail("--repetitions must be positive")
+
+    work_dir = args.work_dir or tempfile.mkdtemp(prefix="minic-compile-bench-")
+    os.makedirs(work_dir, exist_ok=True)
+
+    results = []
+    for case in CASES:
+        if args.filter and args.filter not in case[0]:
+            continue
+        frontends = [f for f in case[4] if not args.frontends or f in args.frontends]
+        if frontends:
+            results += run_case(args, case[:4] + (frontends, case[5]), work_dir)
+
+    print_results(results)
+
+    report = {
+        "context": {
+            "date": datetime.datetime.now().isoformat(timespec="seconds"),
+            "executable": args.minic,
+            "num_cpus": os.cpu_count(),
+            "scale": args.scale,
+        },
+        "benchmarks": results,
+    }
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+
+    if args.update_baseline:
+        with open(args.baseline, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+        print("baseline written to " + args.baseline)
+        return 0
+
+    if os.path.isfile(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if baseline.get("context", {}).get("scale", 1.0) != args.scale:
+            fail("baseline %s was recorded with a different --scale" % args.baseline)
+        if compare(baseline, results, args):
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
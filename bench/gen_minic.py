@@ -0,0 +1,330 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# @file gen_minic.py
+# @brief 按给定的规模与形态生成符合MiniC.g4文法的源程序，用于测试编译器自身的速度
+# @author zenglj (zenglj@live.com)
+# @version 1.0
+# @date 2026-10-18
+#
+# @copyright Copyright (c) 2026
+#
+# 形态(--shape)：
+#   functions   大量的函数，函数之间相互调用
+#   nesting     深度嵌套的语句
+#   expression  很大的表达式
+#   array-init  很大的数组初值
+#   globals     大量的全局变量
+#   mixed       除array-init外以上几种的组合（IRGenerator目前不支持数组初值）
+#
+# 文法(--grammar)：
+#   full   MiniC.g4的全部文法，即Antlr4前端可以分析的程序
+#   basic  flex/bison与递归下降前端也能分析的子集：只有int型的简单变量，无形参的函数，
+#          语句只有return、赋值、块与表达式，运算只有加减
+#
+# 用法示例：
+#   python3 bench/gen_minic.py --shape functions --size 2000 -o big.c
+#   python3 bench/gen_minic.py --shape expression --size 5000 --grammar basic -o expr.c
+#
+# 相同的参数与随机数种子生成相同的程序。生成的程序也是合法的C程序，除数都是非0的常量。
+#
+
+import argparse
+import random
+import sys
+
+SHAPES = ["functions", "nesting", "expression", "array-init", "globals", "mixed"]
+
+# 每行输出的初值个数
+INIT_PER_LINE = 16
+
+# 缩进的最大层数，深度嵌套时文件大小不随深度平方增长
+MAX_INDENT = 32
+
+
+class Generator:
+    """程序生成器，full为False时只使用basic子集"""
+
+    def __init__(self, size, full, seed):
+        self.size = size
+        self.full = full
+        self.rand = random.Random(seed)
+        self.lines = []
+        self.indent = 0
+
+    def emit(self, text):
+        self.lines.append("    " * min(self.indent, MAX_INDENT) + text)
+
+    def text(self):
+        return "\n".join(self.lines) + "\n"
+
+    # ---------------- 表达式 ----------------
+
+    def leaf(self, names):
+        """叶子：变量或者常量"""
+        if names and self.rand.random() < 0.7:
+            return self.rand.choice(names)
+        return str(self.rand.randint(0, 1000))
+
+    def expr(self, names, terms):
+        """含terms个叶子的随机表达式树，返回表达式文本。树的形状随机，深度期望为O(log terms)"""
+        if terms <= 1:
+            return self.leaf(names)
+
+        left = self.rand.randint(1, terms - 1)
+        lhs = self.expr(names, left)
+        rhs = self.expr(names, terms - left)
+
+        if not self.full:
+            op = self.rand.choice(["+", "-"])
+            return "(%s %s %s)" % (lhs, op, rhs)
+
+        op = self.rand.choice(["+", "-", "*", "+", "-", "/", "%"])
+        if op in ("/", "%"):
+            # 除数为非0常量，生成的程序可以运行
+            return "(%s %s %d)" % (lhs, op, self.rand.randint(1, 97))
+        return "(%s %s %s)" % (lhs, op, rhs)
+
+    def cond(self, names):
+        """条件表达式，full时才使用"""
+        op = self.rand.choice(["<", ">", "<=", ">=", "==", "!="])
+        c = "%s %s %s" % (self.leaf(names), op, self.leaf(names))
+        r = self.rand.random()
+        if r < 0.2:
+            c = "%s && %s > %d" % (c, self.leaf(names), self.rand.randint(0, 100))
+        elif r < 0.4:
+            c = "!(%s) || %s" % (c, self.leaf(names))
+        return c
+
+    # ---------------- 语句与函数 ----------------
+
+    def simple_stmts(self, names, count, callees):
+        """赋值语句与函数调用"""
+        for _ in range(count):
+            target = self.rand.choice(names)
+            if callees and self.rand.random() < 0.3:
+                callee, params = self.rand.choice(callees)
+                args = ", ".join(self.leaf(names) for _ in range(params))
+                self.emit("%s = %s(%s) + %s;" % (target, callee, args, self.leaf(names)))
+            else:
+                self.emit("%s = %s;" % (target, self.expr(names, self.rand.randint(2, 6))))
+
+    def function(self, name, params, callees, body):
+        """函数定义，body(names)生成函数体中声明之后的语句，局部变量为v0..v3"""
+        if self.full and params:
+            plist = ", ".join("int p%d" % k for k in range(params))
+        else:
+            params = 0
+            plist = ""
+        self.emit("int %s(%s)" % (name, plist))
+        self.emit("{")
+        self.indent += 1
+        self.emit("int v0, v1, v2, v3;")
+        names = ["v0", "v1", "v2", "v3"] + ["p%d" % k for k in range(params)]
+        for v in names[:4]:
+            self.emit("%s = %s;" % (v, self.leaf(names[4:])))
+        body(names)
+        self.emit("return %s;" % self.expr(names, 3))
+        self.indent -= 1
+        self.emit("}")
+        self.emit("")
+        return params
+
+    def nested(self, names, depth):
+        """深度为depth的嵌套语句。basic时为嵌套的块，每层声明一个新的局部变量"""
+        if depth == 0:
+            self.simple_stmts(names, 2, [])
+            return
+
+        if not self.full:
+            self.emit("{")
+            self.indent += 1
+            var = "n%d" % depth
+            self.emit("int %s;" % var)
+            self.emit("%s = %s;" % (var, self.expr(names, 3)))
+            self.nested(names + [var], depth - 1)
+            self.indent -= 1
+            self.emit("}")
+            return
+
+        kind = self.rand.choice(["if", "ifelse", "while"])
+        if kind == "while":
+            # 循环变量递增，循环一定结束
+            var = "w%d" % depth
+            self.emit("int %s;" % var)
+            self.emit("%s = 0;" % var)
+            self.emit("while (%s < %d) {" % (var, self.rand.randint(1, 3)))
+            self.indent += 1
+            self.emit("%s = %s + 1;" % (var, var))
+            self.nested(names + [var], depth - 1)
+            if self.rand.random() < 0.3:
+                self.emit("if (%s) continue;" % self.cond(names))
+            if self.rand.random() < 0.3:
+                self.emit("if (%s) break;" % self.cond(names))
+            self.indent -= 1
+            self.emit("}")
+        else:
+            self.emit("if (%s) {" % self.cond(names))
+            self.indent += 1
+            self.nested(names, depth - 1)
+            self.indent -= 1
+            if kind == "ifelse":
+                self.emit("} else {")
+                self.indent += 1
+                self.simple_stmts(names, 1, [])
+                self.indent -= 1
+            self.emit("}")
+
+    # ---------------- 各种形态 ----------------
+
+    def gen_functions(self, count):
+        callees = []
+        for k in range(count):
+            params = self.rand.randint(0, 4)
+            near = callees[-8:]
+            params = self.function("f%d" % k, params, near,
+                                   lambda names, near=near: self.simple_stmts(names, self.rand.randint(3, 10), near))
+            callees.append(("f%d" % k, params))
+        return callees
+
+    def gen_nesting(self, depth):
+        self.function("nest", 0, [], lambda names: self.nested(names, depth))
+        return [("nest", 0)]
+
+    def gen_expression(self, terms):
+        def body(names):
+            # 拆成若干个语句，每个语句的表达式有约1000个叶子，避免语法树过深
+            left = terms
+            while left > 0:
+                n = min(left, 1000)
+                self.emit("v0 = v0 + %s;" % self.expr(names, n))
+                left -= n
+        self.function("expr", 0, [], body)
+        return [("expr", 0)]
+
+    def gen_array_init(self, elements):
+        """全局与局部的一维、二维数组的初值"""
+        if not self.full:
+            fail("array-init needs --grammar full")
+
+        def values(n):
+            return [str(self.rand.randint(0, 9999)) for _ in range(n)]
+
+        def emit_list(prefix, vals, suffix):
+            self.emit(prefix + "{")
+            self.indent += 1
+            for k in range(0, len(vals), INIT_PER_LINE):
+                tail = "," if k + INIT_PER_LINE < len(vals) else ""
+                self.emit(", ".join(vals[k:k + INIT_PER_LINE]) + tail)
+            self.indent -= 1
+            self.emit("}" + suffix)
+
+        half = max(elements // 2, 1)
+        emit_list("int ga[%d] = " % half, values(half), ";")
+
+        cols = 16
+        rows = max(half // cols, 1)
+        self.emit("int gm[%d][%d] = {" % (rows, cols))
+        self.indent += 1
+        for r in range(rows):
+            self.emit("{" + ", ".join(values(cols)) + "}" + ("," if r + 1 < rows else ""))
+        self.indent -= 1
+        self.emit("};")
+        self.emit("")
+
+        def body(names):
+            local = min(half, 4096)
+            emit_list("int la[%d] = " % local, values(local), ";")
+            self.emit("v0 = ga[%d] + gm[%d][%d] + la[%d];" % (half - 1, rows - 1, cols - 1, local - 1))
+        self.function("arrays", 0, [], body)
+        return [("arrays", 0)]
+
+    def gen_globals(self, count):
+        names = ["g%d" % k for k in range(count)]
+        for k in range(0, count, 8):
+            group = names[k:k + 8]
+            if self.full:
+                self.emit("int " + ", ".join("%s = %d" % (g, self.rand.randint(0, 9999)) for g in group) + ";")
+            else:
+                self.emit("int " + ", ".join(group) + ";")
+        if self.full:
+            self.emit("int garr[%d];" % max(count, 1))
+        self.emit("")
+
+        def body(names_):
+            # 每个全局变量都至少被引用一次
+            for k in range(0, count, 8):
+                group = names[k:k + 8]
+                self.emit("v1 = v1 + " + " - ".join(group) + ";")
+            self.emit("v2 = v1;")
+        self.function("globals", 0, [], body)
+        return [("globals", 0)]
+
+    def gen_main(self, callees):
+        self.emit("int main()")
+        self.emit("{")
+        self.indent += 1
+        self.emit("int s;")
+        self.emit("s = 0;")
+        for name, params in callees[-16:]:
+            args = ", ".join(str(self.rand.randint(0, 9)) for _ in range(params))
+            self.emit("s = s + %s(%s);" % (name, args))
+        self.emit("putint(s);")
+        self.emit("return 0;")
+        self.indent -= 1
+        self.emit("}")
+
+    def generate(self, shape):
+        size = self.size
+        if shape == "functions":
+            callees = self.gen_functions(size)
+        elif shape == "nesting":
+            callees = self.gen_nesting(size)
+        elif shape == "expression":
+            callees = self.gen_expression(size)
+        elif shape == "array-init":
+            callees = self.gen_array_init(size)
+        elif shape == "globals":
+            callees = self.gen_globals(size)
+        else:
+            callees = self.gen_globals(size // 4)
+            callees += self.gen_functions(size // 4)
+            callees += self.gen_nesting(min(size // 16, 200))
+            callees += self.gen_expression(size)
+        self.gen_main(callees)
+        return self.text()
+
+
+def fail(msg):
+    print("error: " + msg, file=sys.stderr)
+    sys.exit(2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="generate MiniC programs for compiler throughput tests")
+    parser.add_argument("--shape", choices=SHAPES, default="mixed", help="program shape")
+    parser.add_argument("--size", type=int, default=1000,
+                        help="functions, nesting depth, expression leaves, array elements or globals")
+    parser.add_argument("--grammar", choices=["full", "basic"], default="full", help="grammar subset")
+    parser.add_argument("--seed", type=int, default=1, help="random seed")
+    parser.add_argument("-o", "--output", default="-", help="output file (default stdout)")
+    args = parser.parse_args()
+
+    if args.size < 1:
+        fail("--size must be positive")
+
+    # 嵌套的深度与表达式树的深度都对应生成器的递归深度
+    sys.setrecursionlimit(max(1000, args.size * 4 + 100))
+
+    text = Generator(args.size, args.grammar == "full", args.seed).generate(args.shape)
+
+    if args.output == "-":
+        sys.stdout.write(text)
+    else:
+        with open(args.output, "w") as f:
+            f.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# @file run_bench.py
+# @brief 生成代码的性能测试：用minic编译kernels下的各个程序，在qemu-arm下运行并统计执行的指令数，
+#        与基线比较，超过阈值的视为性能退化
+# @author zenglj (zenglj@live.com)
+# @version 1.0
+# @date 2026-10-18
+#
+# @copyright Copyright (c) 2026
+#
+# 用法示例：
+#   python3 bench/run_bench.py --minic build/minic
+#   python3 bench/run_bench.py --minic build/minic --update-baseline
+#   python3 bench/run_bench.py --minic build/minic --target X64
+#
+# ARM32时优先使用qemu的insn插件（--plugin或者环境变量QEMU_INSN_PLUGIN指定libinsn.so）计数，
+# 没有插件时用-d in_asm,exec,nochain的日志计数：in_asm给出每个翻译块的指令条数，exec给出每次执行的翻译块。
+# X64时在本机运行，有perf时统计instructions:u与cycles:u，否则取多次运行中最短的时间。
+#
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import threading
+import time
+
+# 默认允许的相对增加量
+DEFAULT_THRESHOLD = 0.02
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.dirname(BENCH_DIR)
+
+# qemu插件的输出，如insns: 123或者total insns: 123
+PLUGIN_INSNS_RE = re.compile(rb"(?:total )?insns: (\d+)")
+
+# in_asm日志中翻译块开始的地址行，如0x00010558:  e92d4800  push {fp, lr}
+IN_ASM_INSN_RE = re.compile(rb"^0x([0-9a-fA-F]+):\s")
+
+# exec日志中执行翻译块的行，如Trace 0: 0x7f.. [00000000/00010558/00000000/00000000] main
+# 老版本的qemu为Trace 0x7f.. [00010558] main
+EXEC_TRACE_RE = re.compile(rb"^Trace .*?\[(?:[0-9a-fA-F]+/)?([0-9a-fA-F]+)[/\]]")
+
+
+def fail(msg):
+    print("error: " + msg, file=sys.stderr)
+    sys.exit(2)
+
+
+def find_tool(explicit, candidates):
+    """显式指定的工具优先，否则在PATH中依次查找"""
+    if explicit:
+        return explicit if shutil.which(explicit) or os.path.isfile(explicit) else None
+    for name in candidates:
+        path = shutil.which(name)
+        if path:
+            return path
+    return None
+
+
+def list_kernels(kernel_dir, names):
+    """kernels目录下的.ir文件，names非空时只取指定的"""
+    all_kernels = sorted(f[:-3] for f in os.listdir(kernel_dir) if f.endswith(".ir"))
+    if not names:
+        return all_kernels
+    for name in names:
+        if name not in all_kernels:
+            fail("kernel %s not found in %s" % (name, kernel_dir))
+    return names
+
+
+def reference_output(minic, ir_file):
+    """minic解释执行的输出与返回值作为参考结果"""
+    proc = subprocess.run([minic, "-S", "-R", ir_file], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    if proc.returncode < 0:
+        fail("minic -R %s crashed: %s" % (ir_file, proc.stderr.decode(errors="replace")))
+    return proc.stdout, proc.returncode
+
+
+def build_kernel(args, name, ir_file, work_dir):
+    """编译为汇编后与tests/std.c链接成可执行程序"""
+    asm = os.path.join(work_dir, name + ".s")
+    exe = os.path.join(work_dir, name)
+
+    cmd = [args.minic, "-S", "-o", asm, ir_file]
+    if args.target == "X64":
+        cmd[2:2] = ["-t", "X64"]
+    if subprocess.run(cmd).returncode != 0:
+        fail("minic failed on " + ir_file)
+
+    std_c = os.path.join(REPO_DIR, "tests", "std.c")
+    std_h = os.path.join(REPO_DIR, "tests", "std.h")
+    cmd = [args.cc, "-O2", "--include", std_h, "-o", exe, asm, std_c]
+    if args.target == "ARM32":
+        cmd.insert(1, "-static")
+    if subprocess.run(cmd).returncode != 0:
+        fail("link failed for " + name)
+
+    return exe
+
+
+def count_plugin(args, exe):
+    """qemu的insn插件统计指令数"""
+    proc = subprocess.run([args.qemu, "-plugin", args.plugin, "-d", "plugin", exe],
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    total = None
+    for m in PLUGIN_INSNS_RE.finditer(proc.stderr):
+        total = (total or 0) + int(m.group(1))
+    if total is None:
+        fail("no instruction count in qemu plugin output for " + exe)
+    return proc.stdout, proc.returncode, total
+
+
+def count_trace(args, exe):
+    """qemu的in_asm与exec日志统计指令数，日志可能很大，边读边统计"""
+    proc = subprocess.Popen([args.qemu, "-d", "in_asm,exec,nochain", exe],
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+
+    # 翻译块的开始地址 -> 指令条数；同一地址可能重新翻译，取最后一次
+    block_insns = {}
+    block_start = None
+    total = 0
+
+    # stdout在子线程中读取，避免管道写满后qemu阻塞
+    out_chunks = []
+    reader = threading.Thread(target=lambda: out_chunks.append(proc.stdout.read()))
+    reader.start()
+
+    for line in proc.stderr:
+        if line.startswith(b"IN:"):
+            block_start = None
+            continue
+        m = IN_ASM_INSN_RE.match(line)
+        if m:
+            pc = int(m.group(1), 16)
+            if block_start is None:
+                block_start = pc
+                block_insns[pc] = 0
+            block_insns[block_start] += 1
+            continue
+        block_start = None
+        m = EXEC_TRACE_RE.match(line)
+        if m:
+            total += block_insns.get(int(m.group(1), 16), 0)
+
+    proc.wait()
+    reader.join()
+    return out_chunks[0] if out_chunks else b"", proc.returncode, total
+
+
+def count_perf(args, exe):
+    """perf统计用户态的指令数与周期数"""
+    proc = subprocess.run([args.perf, "stat", "-x", ",", "-e", "instructions:u,cycles:u", exe],
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    values = {}
+    for line in proc.stderr.decode(errors="replace").splitlines():
+        fields = line.split(",")
+        if len(fields) > 2 and fields[0].isdigit():
+            values[fields[2].split(":")[0]] = int(fields[0])
+    return proc.stdout, proc.returncode, values
+
+
+def run_kernel(args, exe):
+    """运行一次，返回输出、返回值与各项指标"""
+    if args.target == "ARM32":
+        if args.plugin:
+            out, rc, insns = count_plugin(args, exe)
+        else:
+            out, rc, insns = count_trace(args, exe)
+        return out, rc, {"insns": insns}
+
+    if args.perf:
+        out, rc, values = count_perf(args, exe)
+        if "instructions" in values:
+            return out, rc, {"insns": values["instructions"], "cycles": values.get("cycles", 0)}
+
+    best = None
+    for _ in range(args.repeat):
+        start = time.perf_counter()
+        proc = subprocess.run([exe], stdout=subprocess.PIPE)
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return proc.stdout, proc.returncode, {"time_us": int(best * 1e6)}
+
+
+def compare(baseline, results, metric, threshold_arg):
+    """与基线比较，返回退化的kernel个数。阈值依次取kernel自己的、命令行的、基线文件的"""
+    regressions = 0
+    base_kernels = baseline.get("kernels", {})
+    for name, values in results.items():
+        value = values.get(metric)
+        base = base_kernels.get(name, {})
+        if value is None:
+            continue
+        if metric not in base:
+            print("  %-10s %14d  (new, no baseline)" % (name, value))
+            continue
+        threshold = base.get("threshold", threshold_arg)
+        if threshold is None:
+            threshold = baseline.get("threshold", DEFAULT_THRESHOLD)
+        old = base[metric]
+        ratio = (value - old) / old if old else 0.0
+        if ratio > threshold:
+            status = "REGRESSION"
+            regressions += 1
+        elif ratio < -threshold:
+            status = "improved"
+        else:
+            status = "ok"
+        print("  %-10s %14d  base %14d  %+7.2f%%  %s" % (name, value, old, ratio * 100, status))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="minic generated-code benchmarks")
+    parser.add_argument("--minic", default=os.path.join(REPO_DIR, "build", "minic"), help="minic executable")
+    parser.add_argument("--target", default="ARM32", choices=["ARM32", "X64"], help="target CPU")
+    parser.add_argument("--kernels", nargs="*", help="kernels to run (default: all in bench/kernels)")
+    parser.add_argument("--work-dir", default=None, help="directory for .s files and executables")
+    parser.add_argument("--no-build", action="store_true", help="use executables already in --bin-dir")
+    parser.add_argument("--bin-dir", default=None, help="directory of prebuilt executables")
+    parser.add_argument("--cc", default=None, help="C compiler used to assemble and link")
+    parser.add_argument("--qemu", default=None, help="qemu-arm executable")
+    parser.add_argument("--plugin", default=os.environ.get("QEMU_INSN_PLUGIN"),
+                        help="qemu insn plugin (libinsn.so), default $QEMU_INSN_PLUGIN")
+    parser.add_argument("--perf", default=None, help="perf executable for X64")
+    parser.add_argument("--baseline", default=None, help="baseline JSON (default bench/baseline-<target>.json)")
+    parser.add_argument("--update-baseline", action="store_true", help="write the results as the new baseline")
+    parser.add_argument("--threshold", type=float, default=None,
+                        help="allowed relative increase (default: from the baseline, else %g)" % DEFAULT_THRESHOLD)
+    parser.add_argument("--json", default=None, help="write the results to this JSON file")
+    parser.add_argument("--repeat", type=int, default=5, help="runs per kernel when timing")
+    args = parser.parse_args()
+
+    kernel_dir = os.path.join(BENCH_DIR, "kernels")
+    kernels = list_kernels(kernel_dir, args.kernels)
+
+    if not os.path.isfile(args.minic):
+        fail("minic not found: " + args.minic)
+    args.minic = os.path.abspath(args.minic)
+
+    if args.target == "ARM32":
+        args.cc = find_tool(args.cc, ["arm-linux-gnueabihf-gcc"])
+        args.qemu = find_tool(args.qemu, ["qemu-arm", "qemu-arm-static"])
+        if not args.qemu:
+            fail("qemu-arm not found")
+        metric = "insns"
+    else:
+        args.cc = find_tool(args.cc, ["gcc", "cc", "clang"])
+        args.perf = find_tool(args.perf, ["perf"])
+        metric = "insns" if args.perf else "time_us"
+
+    if not args.no_build and not args.cc:
+        fail("C compiler for %s not found" % args.target)
+
+    work_dir = args.work_dir or os.path.join(os.getcwd(), "bench-" + args.target.lower())
+    bin_dir = args.bin_dir or work_dir
+    os.makedirs(work_dir, exist_ok=True)
+
+    baseline_file = args.baseline or os.path.join(BENCH_DIR, "baseline-%s.json" % args.target.lower())
+
+    results = {}
+    mismatches = 0
+    for name in kernels:
+        ir_file = os.path.join(kernel_dir, name + ".ir")
+        expected_out, expected_rc = reference_output(args.minic, ir_file)
+
+        exe = os.path.join(bin_dir, name) if args.no_build else build_kernel(args, name, ir_file, work_dir)
+        if not os.path.isfile(exe):
+            fail("executable not found: " + exe)
+
+        out, rc, values = run_kernel(args, exe)
+        if out != expected_out or rc != expected_rc:
+            print("  %-10s output mismatch (exit %d, expected %d)" % (name, rc, expected_rc))
+            mismatches += 1
+            continue
+        results[name] = values
+
+    report = {"target": args.target, "metric": metric,
+              "threshold": DEFAULT_THRESHOLD if args.threshold is None else args.threshold,
+              "kernels": results}
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+    print("%s, metric %s" % (args.target, metric))
+
+    if args.update_baseline:
+        if mismatches:
+            fail("baseline not updated: %d kernel(s) produced wrong output" % mismatches)
+        # 保留已有基线中为单个kernel设置的阈值
+        old_kernels = {}
+        if os.path.isfile(baseline_file):
+            with open(baseline_file) as f:
+                old_kernels = json.load(f).get("kernels", {})
+        for name, values in results.items():
+            if "threshold" in old_kernels.get(name, {}):
+                values["threshold"] = old_kernels[name]["threshold"]
+        with open(baseline_file, "w") as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+            f.write("\n")
+        for name, values in results.items():
+            print("  %-10s %14d" % (name, values[metric]))
+        print("baseline written to " + baseline_file)
+        return 0
+
+    regressions = 0
+    if os.path.isfile(baseline_file):
+        with open(baseline_file) as f:
+            baseline = json.load(f)
+        if baseline.get("metric") != metric:
+            fail("baseline %s uses metric %s, this run measures %s" % (baseline_file, baseline.get("metric"), metric))
+        regressions = compare(baseline, results, metric, args.threshold)
+    else:
+        for name, values in results.items():
+            print("  %-10s %14d  (no baseline file)" % (name, values[metric]))
+
+    if regressions or mismatches:
+        print("%d regression(s), %d output mismatch(es)" % (regressions, mismatches))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -2,8 +2,8 @@
 /// @file AST.cpp
 /// @brief 抽象语法树AST管理的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,11 +12,13 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>AST节点池改为每个线程一个，支持批量编译
 /// </table>
 ///
 #include <cstdarg>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "AST.h"
 #include "AttrType.h"
@@ -26,6 +28,113 @@
 /* 整个AST的根节点 */
 ast_node * ast_root = nullptr;
 
+/// @brief AST节点池每次扩充的节点个数
+#define AST_NODE_POOL_CHUNK 512
+
+///
+/// @brief AST节点池。按块批量申请节点空间，释放的节点放入空闲链表供后续复用，
+/// 避免每个节点单独调用一次系统的内存分配。每个线程各有一个节点池，
+/// 批量编译时不同线程中的编译任务互不干扰，但节点的申请与释放必须在同一个线程中
+///
+class ASTNodePool {
+public:
+    ~ASTNodePool()
+    {
+        for (auto chunk: chunks) {
+            ::operator delete(chunk);
+        }
+    }
+
+    /// @brief 分配一个节点的空间
+    /// @return void* 节点空间
+    void * allocate()
+    {
+        if (!freeList) {
+            grow(AST_NODE_POOL_CHUNK);
+        }
+
+        FreeNode * node = freeList;
+        freeList = node->next;
+        freeCount--;
+
+        return node;
+    }
+
+    /// @brief 归还一个节点的空间
+    /// @param ptr 节点空间
+    void release(void * ptr)
+    {
+        FreeNode * node = static_cast<FreeNode *>(ptr);
+        node->next = freeList;
+        freeList = node;
+        freeCount++;
+    }
+
+    /// @brief 确保空闲节点至少有count个
+    /// @param count 节点个数
+    void reserve(size_t count)
+    {
+        if (count > freeCount) {
+            grow(count - freeCount);
+        }
+    }
+
+private:
+    /// @brief 空闲节点，复用节点本身的空间保存链表指针
+    struct FreeNode {
+        FreeNode * next;
+    };
+
+    /// @brief 申请一块能容纳count个节点的空间，并加入空闲链表
+    /// @param count 节点个数
+    void grow(size_t count)
+    {
+        char * chunk = static_cast<char *>(::operator new(count * sizeof(ast_node)));
+        chunks.push_back(chunk);
+
+        // 逆序加入，使得分配的次序与地址的次序一致
+        for (size_t k = count; k > 0; --k) {
+            release(chunk + (k - 1) * sizeof(ast_node));
+        }
+    }
+
+    /// @brief 空闲链表
+    FreeNode * freeList = nullptr;
+
+    /// @brief 空闲节点的个数
+    size_t freeCount = 0;
+
+    /// @brief 所有申请的块，节点池析构时释放
+    std::vector<char *> chunks;
+};
+
+/// @brief 本线程所有AST节点共用的节点池
+static thread_local ASTNodePool astNodePool;
+
+/// @brief 节点的空间从AST节点池中分配
+/// @param size 空间大小
+/// @return void* 节点空间
+void * ast_node::operator new(size_t size)
+{
+    return astNodePool.allocate();
+}
+
+/// @brief 节点的空间归还给AST节点池
+/// @param ptr 节点空间
+void ast_node::operator delete(void * ptr)
+{
+    if (ptr) {
+        astNodePool.release(ptr);
+    }
+}
+
+/// @brief 预先在节点池中准备好指定个数的空闲节点
+/// @param count 节点个数
+void ast_node::Reserve(size_t count)
+{
+    astNodePool.reserve(count);
+}
+
 /// @brief 创建指定节点类型的节点
 /// @param _node_type 节点类型
 /// @param _line_no 行号
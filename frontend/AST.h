@@ -282,6 +282,25 @@ public:
     /// @param node
     ///
     static void Delete(ast_node * node);
+
+    ///
+    /// @brief 预先在节点池中准备好指定个数的空闲节点，避免分析过程中逐块扩充
+    /// @param count 节点个数
+    ///
+    static void Reserve(size_t count);
+
+    ///
+    /// @brief 节点的空间从AST节点池中分配
+    /// @param size 空间大小
+    /// @return void* 节点空间
+    ///
+    static void * operator new(size_t size);
+
+    ///
+    /// @brief 节点的空间归还给AST节点池
+    /// @param ptr 节点空间
+    ///
+    static void operator delete(void * ptr);
 };
 
 /// @brief AST资源清理
@@ -0,0 +1,515 @@
+///
+/// @file CharScanner.cpp
+/// @brief 词法分析用的字符批量扫描函数，支持SSE2/AVX2向量化
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加源代码的规范化，用于编译缓存
+/// </table>
+///
+#include "CharScanner.h"
+#include "Common.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_HAS_X86 1
+#include <immintrin.h>
+#endif
+
+/// @brief 是否为空白符
+/// @param c 字符
+/// @return true：是，false：不是
+static inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/// @brief 扫描函数表，启动时根据CPU能力选择一次
+struct ScanOps {
+    /// @brief 空白符串的结束位置
+    const char * (*blankEnd)(const char * p, const char * end);
+
+    /// @brief 标识符的结束位置
+    const char * (*identEnd)(const char * p, const char * end);
+
+    /// @brief 数字串的结束位置
+    const char * (*digitEnd)(const char * p, const char * end);
+
+    /// @brief 第一个换行符的位置
+    const char * (*findNewline)(const char * p, const char * end);
+
+    /// @brief 第一个*\/中*的位置
+    const char * (*findStarSlash)(const char * p, const char * end);
+
+    /// @brief 换行数
+    int64_t (*countLines)(const char * p, const char * end);
+
+    /// @brief 实现的名字
+    const char * name;
+};
+
+//
+// 标量实现，非x86平台使用，也用于向量实现中不足一个向量的尾部
+//
+
+static const char * scalarBlankEnd(const char * p, const char * end)
+{
+    while ((p < end) && isBlank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static const char * scalarIdentEnd(const char * p, const char * end)
+{
+    while ((p < end) && isLetterDigitalUnderLine(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static const char * scalarDigitEnd(const char * p, const char * end)
+{
+    while ((p < end) && isDigital(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static const char * scalarFindNewline(const char * p, const char * end)
+{
+    while ((p < end) && (*p != '\n') && (*p != '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+static const char * scalarFindStarSlash(const char * p, const char * end)
+{
+    for (; p + 1 < end; ++p) {
+        if ((p[0] == '*') && (p[1] == '/')) {
+            return p;
+        }
+    }
+    return end;
+}
+
+// 换行数 = \n的个数 + \r的个数 - \r\n的个数，\r\n按照\r所在的位置计入
+static int64_t scalarCountLines(const char * p, const char * end)
+{
+    int64_t lines = 0;
+    for (; p < end; ++p) {
+        if (*p == '\n') {
+            lines++;
+        } else if (*p == '\r') {
+            lines++;
+            if ((p + 1 < end) && (p[1] == '\n')) {
+                lines--;
+            }
+        }
+    }
+    return lines;
+}
+
+static const ScanOps scalarOps = {
+    scalarBlankEnd,
+    scalarIdentEnd,
+    scalarDigitEnd,
+    scalarFindNewline,
+    scalarFindStarSlash,
+    scalarCountLines,
+    "scalar",
+};
+
+#ifdef SCAN_HAS_X86
+
+//
+// SSE2实现，一次处理16个字节。字符范围检查采用无符号饱和比较：
+// c在[lo, lo + n]内当且仅当min(c - lo, n) == c - lo
+//
+
+__attribute__((target("sse2"))) static inline __m128i sse2InRange(__m128i v, char lo, char n)
+{
+    __m128i t = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(n)), t);
+}
+
+__attribute__((target("sse2"))) static inline __m128i sse2IsBlank(__m128i v)
+{
+    __m128i sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    __m128i tab = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+    __m128i lf = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+    __m128i cr = _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'));
+    return _mm_or_si128(_mm_or_si128(sp, tab), _mm_or_si128(lf, cr));
+}
+
+__attribute__((target("sse2"))) static inline __m128i sse2IsIdent(__m128i v)
+{
+    // 大小写字母统一转成小写后检查
+    __m128i alpha = sse2InRange(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z' - 'a');
+    __m128i digit = sse2InRange(v, '0', 9);
+    __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    return _mm_or_si128(_mm_or_si128(alpha, digit), under);
+}
+
+__attribute__((target("sse2"))) static const char * sse2BlankEnd(const char * p, const char * end)
+{
+    for (; p + 16 <= end; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *) p);
+        unsigned mask = ~(unsigned) _mm_movemask_epi8(sse2IsBlank(v)) & 0xFFFFu;
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return scalarBlankEnd(p, end);
+}
+
+__attribute__((target("sse2"))) static const char * sse2IdentEnd(const char * p, const char * end)
+{
+    for (; p + 16 <= end; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *) p);
+        unsigned mask = ~(unsigned) _mm_movemask_epi8(sse2IsIdent(v)) & 0xFFFFu;
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return scalarIdentEnd(p, end);
+}
+
+__attribute__((target("sse2"))) static const char * sse2DigitEnd(const char * p, const char * end)
+{
+    for (; p + 16 <= end; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *) p);
+        unsigned mask = ~(unsigned) _mm_movemask_epi8(sse2InRange(v, '0', 9)) & 0xFFFFu;
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return scalarDigitEnd(p, end);
+}
+
+__attribute__((target("sse2"))) static const char * sse2FindNewline(const char * p, const char * end)
+{
+    for (; p + 16 <= end; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *) p);
+        __m128i lf = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+        __m128i cr = _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'));
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_or_si128(lf, cr));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return scalarFindNewline(p, end);
+}
+
+// 同时加载p与p+1开始的两个向量，逐字节比较即可得到*/的位置
+__attribute__((target("sse2"))) static const char * sse2FindStarSlash(const char * p, const char * end)
+{
+    for (; p + 17 <= end; p += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *) p);
+        __m128i b = _mm_loadu_si128((const __m128i *) (p + 1));
+        __m128i star = _mm_cmpeq_epi8(a, _mm_set1_epi8('*'));
+        __m128i slash = _mm_cmpeq_epi8(b, _mm_set1_epi8('/'));
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(star, slash));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return scalarFindStarSlash(p, end);
+}
+
+__attribute__((target("sse2"))) static int64_t sse2CountLines(const char * p, const char * end)
+{
+    int64_t lines = 0;
+    for (; p + 17 <= end; p += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *) p);
+        __m128i b = _mm_loadu_si128((const __m128i *) (p + 1));
+        __m128i cr = _mm_cmpeq_epi8(a, _mm_set1_epi8('\r'));
+        unsigned lf = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_set1_epi8('\n')));
+        unsigned crlf = (unsigned) _mm_movemask_epi8(_mm_and_si128(cr, _mm_cmpeq_epi8(b, _mm_set1_epi8('\n'))));
+        lines += __builtin_popcount(lf) + __builtin_popcount((unsigned) _mm_movemask_epi8(cr)) -
+                 __builtin_popcount(crlf);
+    }
+    return lines + scalarCountLines(p, end);
+}
+
+static const ScanOps sse2Ops = {
+    sse2BlankEnd,
+    sse2IdentEnd,
+    sse2DigitEnd,
+    sse2FindNewline,
+    sse2FindStarSlash,
+    sse2CountLines,
+    "sse2",
+};
+
+//
+// AVX2实现，一次处理32个字节，算法与SSE2相同
+//
+
+__attribute__((target("avx2"))) static inline __m256i avx2InRange(__m256i v, char lo, char n)
+{
+    __m256i t = _mm256_sub_epi8(v, _mm256_set1_epi8(lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(n)), t);
+}
+
+__attribute__((target("avx2"))) static inline __m256i avx2IsBlank(__m256i v)
+{
+    __m256i sp = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+    __m256i tab = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'));
+    __m256i lf = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+    __m256i cr = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'));
+    return _mm256_or_si256(_mm256_or_si256(sp, tab), _mm256_or_si256(lf, cr));
+}
+
+__attribute__((target("avx2"))) static inline __m256i avx2IsIdent(__m256i v)
+{
+    __m256i alpha = avx2InRange(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z' - 'a');
+    __m256i digit = avx2InRange(v, '0', 9);
+    __m256i under = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+    return _mm256_or_si256(_mm256_or_si256(alpha, digit), under);
+}
+
+__attribute__((target("avx2"))) static const char * avx2BlankEnd(const char * p, const char * end)
+{
+    for (; p + 32 <= end; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) p);
+        unsigned mask = ~(unsigned) _mm256_movemask_epi8(avx2IsBlank(v));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return sse2BlankEnd(p, end);
+}
+
+__attribute__((target("avx2"))) static const char * avx2IdentEnd(const char * p, const char * end)
+{
+    for (; p + 32 <= end; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) p);
+        unsigned mask = ~(unsigned) _mm256_movemask_epi8(avx2IsIdent(v));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return sse2IdentEnd(p, end);
+}
+
+__attribute__((target("avx2"))) static const char * avx2DigitEnd(const char * p, const char * end)
+{
+    for (; p + 32 <= end; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) p);
+        unsigned mask = ~(unsigned) _mm256_movemask_epi8(avx2InRange(v, '0', 9));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return sse2DigitEnd(p, end);
+}
+
+__attribute__((target("avx2"))) static const char * avx2FindNewline(const char * p, const char * end)
+{
+    for (; p + 32 <= end; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) p);
+        __m256i lf = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+        __m256i cr = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'));
+        unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_or_si256(lf, cr));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return sse2FindNewline(p, end);
+}
+
+__attribute__((target("avx2"))) static const char * avx2FindStarSlash(const char * p, const char * end)
+{
+    for (; p + 33 <= end; p += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) p);
+        __m256i b = _mm256_loadu_si256((const __m256i *) (p + 1));
+        __m256i star = _mm256_cmpeq_epi8(a, _mm256_set1_epi8('*'));
+        __m256i slash = _mm256_cmpeq_epi8(b, _mm256_set1_epi8('/'));
+        unsigned mask = (unsigned) _mm256_movemask_epi8(_mm256_and_si256(star, slash));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return sse2FindStarSlash(p, end);
+}
+
+__attribute__((target("avx2"))) static int64_t avx2CountLines(const char * p, const char * end)
+{
+    int64_t lines = 0;
+    for (; p + 33 <= end; p += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) p);
+        __m256i b = _mm256_loadu_si256((const __m256i *) (p + 1));
+        __m256i cr = _mm256_cmpeq_epi8(a, _mm256_set1_epi8('\r'));
+        unsigned lf = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_set1_epi8('\n')));
+        unsigned crlf =
+            (unsigned) _mm256_movemask_epi8(_mm256_and_si256(cr, _mm256_cmpeq_epi8(b, _mm256_set1_epi8('\n'))));
+        lines += __builtin_popcount(lf) + __builtin_popcount((unsigned) _mm256_movemask_epi8(cr)) -
+                 __builtin_popcount(crlf);
+    }
+    return lines + sse2CountLines(p, end);
+}
+
+static const ScanOps avx2Ops = {
+    avx2BlankEnd,
+    avx2IdentEnd,
+    avx2DigitEnd,
+    avx2FindNewline,
+    avx2FindStarSlash,
+    avx2CountLines,
+    "avx2",
+};
+
+#endif
+
+/// @brief 根据CPU能力选择扫描实现
+/// @return 扫描函数表
+static const ScanOps & selectScanOps()
+{
+#ifdef SCAN_HAS_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return avx2Ops;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return sse2Ops;
+    }
+#endif
+    return scalarOps;
+}
+
+/// @brief 获取扫描函数表，只在第一次调用时选择
+/// @return 扫描函数表
+static const ScanOps & scanOps()
+{
+    static const ScanOps & ops = selectScanOps();
+    return ops;
+}
+
+const char * scan_skip_blank(const char * p, const char * end, int64_t & lines)
+{
+    const ScanOps & ops = scanOps();
+
+    const char * q = ops.blankEnd(p, end);
+
+    // 空白串内部的\r\n不会被截断，可以直接统计
+    lines += ops.countLines(p, q);
+
+    return q;
+}
+
+const char * scan_ident_end(const char * p, const char * end)
+{
+    return scanOps().identEnd(p, end);
+}
+
+const char * scan_digit_end(const char * p, const char * end)
+{
+    return scanOps().digitEnd(p, end);
+}
+
+const char * scan_find_newline(const char * p, const char * end)
+{
+    return scanOps().findNewline(p, end);
+}
+
+const char * scan_find_comment_end(const char * p, const char * end, int64_t & lines)
+{
+    const ScanOps & ops = scanOps();
+
+    const char * q = ops.findStarSlash(p, end);
+    if (q >= end) {
+        return nullptr;
+    }
+
+    lines += ops.countLines(p, q);
+
+    return q + 2;
+}
+
+int64_t scan_count_lines(const char * p, const char * end)
+{
+    return scanOps().countLines(p, end);
+}
+
+/// @brief 规范化时是否归为标识符类字符，.归入此类是为了保留1 .5与1.5的区别
+/// @param c 字符
+/// @return true：是，false：不是
+static inline bool isWordChar(char c)
+{
+    return isLetterDigitalUnderLine(c) || (c == '.');
+}
+
+std::string scan_normalize_source(const char * p, const char * end)
+{
+    std::string text;
+    text.reserve((size_t) (end - p));
+
+    int64_t lines = 0;
+
+    // 前一个Token之后是否有空白或注释
+    bool gap = false;
+
+    while (p < end) {
+
+        const char * q = scan_skip_blank(p, end, lines);
+        if (q != p) {
+            gap = true;
+            p = q;
+            continue;
+        }
+
+        if ((*p == '/') && (p + 1 < end) && (p[1] == '/')) {
+            p = scan_find_newline(p + 2, end);
+            gap = true;
+            continue;
+        }
+
+        if ((*p == '/') && (p + 1 < end) && (p[1] == '*')) {
+            q = scan_find_comment_end(p + 2, end, lines);
+            if (q == nullptr) {
+                // 注释没有结束，原样保留，编译时会报错
+                text.append(p, end);
+                break;
+            }
+            p = q;
+            gap = true;
+            continue;
+        }
+
+        bool word = isWordChar(*p);
+
+        if (gap && !text.empty() && (isWordChar(text.back()) == word)) {
+            text.push_back(' ');
+        }
+        gap = false;
+
+        if (word) {
+            // 标识符、数字与.组成的串一次复制
+            q = p;
+            do {
+                q = scan_ident_end(q, end);
+                while ((q < end) && (*q == '.')) {
+                    q++;
+                }
+            } while ((q < end) && isLetterDigitalUnderLine(*q));
+            text.append(p, q);
+            p = q;
+        } else {
+            text.push_back(*p++);
+        }
+    }
+
+    return text;
+}
+
+const char * scan_impl_name()
+{
+    return scanOps().name;
+}
@@ -0,0 +1,97 @@
+///
+/// @file CharScanner.h
+/// @brief 词法分析用的字符批量扫描函数，支持SSE2/AVX2向量化
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加源代码的规范化，用于编译缓存
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+///
+/// 这些函数一次处理16（SSE2）或32（AVX2）个字节，运行时根据CPU的能力选择实现，
+/// 非x86平台或者CPU不支持时采用逐字节的标量实现。
+///
+/// 行号统计规则与手写词法分析一致：\n、单独的\r以及\r\n都算作一个换行。
+/// 所有函数都不会读取[p, end)以外的内存。
+///
+
+///
+/// @brief 跳过空白符（空格、TAB、回车与换行），同时统计跳过的换行数
+/// @param p 开始位置
+/// @param end 结束位置
+/// @param lines 累加跳过的换行数
+/// @return const char* 第一个非空白符的位置，没有时返回end
+///
+const char * scan_skip_blank(const char * p, const char * end, int64_t & lines);
+
+///
+/// @brief 查找标识符的结束位置，标识符的后续字符为字母、数字或下划线
+/// @param p 开始位置
+/// @param end 结束位置
+/// @return const char* 第一个非标识符字符的位置，没有时返回end
+///
+const char * scan_ident_end(const char * p, const char * end);
+
+///
+/// @brief 查找十进制数字串的结束位置
+/// @param p 开始位置
+/// @param end 结束位置
+/// @return const char* 第一个非数字字符的位置，没有时返回end
+///
+const char * scan_digit_end(const char * p, const char * end);
+
+///
+/// @brief 查找第一个换行符（\n或\r），用于单行注释的跳过
+/// @param p 开始位置
+/// @param end 结束位置
+/// @return const char* 换行符的位置，没有时返回end
+///
+const char * scan_find_newline(const char * p, const char * end);
+
+///
+/// @brief 查找多行注释的结束符号*\/，同时统计注释内的换行数
+/// @param p 注释内容的开始位置，即/\*之后
+/// @param end 结束位置
+/// @param lines 累加注释内的换行数
+/// @return const char* *\/之后的位置，没有找到时返回nullptr
+///
+const char * scan_find_comment_end(const char * p, const char * end, int64_t & lines);
+
+///
+/// @brief 统计[p, end)内的换行数
+/// @param p 开始位置
+/// @param end 结束位置
+/// @return int64_t 换行数
+///
+int64_t scan_count_lines(const char * p, const char * end);
+
+///
+/// @brief 把源代码规范化为只与Token序列相关的文本，用于编译缓存的键值计算
+///
+/// 注释视为空白，空白串要么删除，要么替换为一个空格：只有两侧都是标识符类字符（含数字与.）
+/// 或者都是运算符类字符时才保留一个空格，以免相邻Token合并成另外的Token。
+/// 因此只有空白、注释、换行不同的两个源文件规范化后的结果相同。
+///
+/// @param p 开始位置
+/// @param end 结束位置
+/// @return std::string 规范化后的文本
+///
+std::string scan_normalize_source(const char * p, const char * end);
+
+///
+/// @brief 获取当前选用的扫描实现的名字
+/// @return const char* avx2、sse2或scalar
+///
+const char * scan_impl_name();
@@ -2,8 +2,8 @@
 /// @file Antlr4CSTVisitor.cpp
 /// @brief Antlr4的具体语法树的遍历产生AST
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,10 +12,10 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>直接产生AST节点，不再经过std::any
 /// </table>
 ///
 
-#include <any>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -32,13 +32,6 @@
 
 #define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
 
-/// @brief 用于从 visitVarDef 向 visitVarDecl 传递变量定义信息的辅助结构体
-struct VarDefInfo {
-	ast_node * id_node;                     // id节点，原visitVarDef返回值
-    std::vector<ast_node*> dim_nodes;   	// 维度表达式节点列表
-    ast_node* init_node = nullptr;      	// 初始化值节点
-};
-
 /// @brief 构造函数
 MiniCCSTVisitor::MiniCCSTVisitor()
 {}
@@ -47,55 +40,14 @@ MiniCCSTVisitor::MiniCCSTVisitor()
 MiniCCSTVisitor::~MiniCCSTVisitor()
 {}
 
-/// @brief 遍历CST产生AST
-/// @param root CST语法树的根结点
-/// @return AST的根节点
-ast_node * MiniCCSTVisitor::run(MiniCParser::CompileUnitContext * root)
-{
-    return std::any_cast<ast_node *>(visitCompileUnit(root));
-}
-
-/// @brief 非终结运算符compileUnit的遍历
-/// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitCompileUnit(MiniCParser::CompileUnitContext * ctx)
-{
-    // compileUnit: (funcDef | varDecl)* EOF
-
-    // 请注意这里必须先遍历全局变量后遍历函数。肯定可以确保全局变量先声明后使用的规则，但有些情况却不能检查出。
-    // 事实上可能函数A后全局变量B后函数C，这时在函数A中是不能使用变量B的，需要报语义错误，但目前的处理不会。
-    // 因此在进行语义检查时，可能追加检查行号和列号，如果函数的行号/列号在全局变量的行号/列号的前面则需要报语义错误
-    // TODO 请追加实现。
-
-    ast_node * temp_node;
-    ast_node * compileUnitNode = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
-
-    // 可能多个变量，因此必须循环遍历
-    for (auto varCtx: ctx->varDecl()) {
-
-        // 变量函数定义
-        temp_node = std::any_cast<ast_node *>(visitVarDecl(varCtx));
-        (void) compileUnitNode->insert_son_node(temp_node);
-    }
-
-    // 可能有多个函数，因此必须循环遍历
-    for (auto funcCtx: ctx->funcDef()) {
-
-        // 变量函数定义
-        temp_node = std::any_cast<ast_node *>(visitFuncDef(funcCtx));
-        (void) compileUnitNode->insert_son_node(temp_node);
-    }
-
-    return compileUnitNode;
-}
-
 /// @brief 非终结运算符funcDef的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitFuncDef(MiniCParser::FuncDefContext * ctx)
+ast_node * MiniCCSTVisitor::visitFuncDef(MiniCParser::FuncDefContext * ctx)
 {
     // 识别的文法产生式：funcDef: funcType T_ID T_L_PAREN funcFParams? T_R_PAREN block;
 
     // 函数返回类型，终结符
-    type_attr funcReturnType = std::any_cast<type_attr>(visitFuncType(ctx->funcType()));
+    type_attr funcReturnType = visitFuncType(ctx->funcType());
 
     // 创建函数名的标识符终结符节点，终结符
     char * id = strdup(ctx->T_ID()->getText().c_str());
@@ -105,11 +57,11 @@ std::any MiniCCSTVisitor::visitFuncDef(MiniCParser::FuncDefContext * ctx)
     ast_node * formalParamsNode = nullptr;
     // 如果有形参，那么进行设置
     if (ctx->funcFParams()) {
-        formalParamsNode = std::any_cast<ast_node *>(visitFuncFParams(ctx->funcFParams()));
+        formalParamsNode = visitFuncFParams(ctx->funcFParams());
 	}
 
     // 遍历block结点创建函数体节点，非终结符
-    auto blockNode = std::any_cast<ast_node *>(visitBlock(ctx->block()));
+    auto blockNode = visitBlock(ctx->block());
 
     // 创建函数定义的节点，孩子有类型，函数名，语句块和形参(实际上无)
     // create_func_def函数内会释放funcId中指向的标识符空间，切记，之后不要再释放，之前一定要是通过strdup函数或者malloc分配的空间
@@ -118,7 +70,7 @@ std::any MiniCCSTVisitor::visitFuncDef(MiniCParser::FuncDefContext * ctx)
 
 /// @brief 非终结运算符funcType的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitFuncType(MiniCParser::FuncTypeContext * ctx)
+type_attr MiniCCSTVisitor::visitFuncType(MiniCParser::FuncTypeContext * ctx)
 {
 	// 识别的文法产生式：funcType: T_INT | T_VOID;
 
@@ -139,7 +91,7 @@ std::any MiniCCSTVisitor::visitFuncType(MiniCParser::FuncTypeContext * ctx)
 
 /// @brief 非终结运算符funcFParams的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitFuncFParams(MiniCParser::FuncFParamsContext * ctx)
+ast_node * MiniCCSTVisitor::visitFuncFParams(MiniCParser::FuncFParamsContext * ctx)
 {
     // 识别的文法产生式：funcFParams: funcFParam (T_COMMA funcFParam)*;
 
@@ -147,7 +99,7 @@ std::any MiniCCSTVisitor::visitFuncFParams(MiniCParser::FuncFParamsContext * ctx
 
     for (auto paramCtx: ctx->funcFParam()) {
 		// 形参节点
-        ast_node * param_node = std::any_cast<ast_node *>(visitFuncFParam(paramCtx));
+        ast_node * param_node = visitFuncFParam(paramCtx);
 		// 插入形参节点
         (void) params_node->insert_son_node(param_node);
     }
@@ -157,11 +109,11 @@ std::any MiniCCSTVisitor::visitFuncFParams(MiniCParser::FuncFParamsContext * ctx
 
 /// @brief 非终结运算符funcFParam的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitFuncFParam(MiniCParser::FuncFParamContext * ctx)
+ast_node * MiniCCSTVisitor::visitFuncFParam(MiniCParser::FuncFParamContext * ctx)
 {
 	// 识别的文法产生式：funcFParam: basicType T_ID (T_L_BRACKET expr? T_R_BRACKET (T_L_BRACKET expr T_R_BRACKET)*)?;
 
-    type_attr typeAttr = std::any_cast<type_attr>(visitBasicType(ctx->basicType()));
+    type_attr typeAttr = visitBasicType(ctx->basicType());
     auto varId = ctx->T_ID()->getText();
     int64_t lineNo = (int64_t) ctx->T_ID()->getSymbol()->getLine();
 
@@ -183,7 +135,7 @@ std::any MiniCCSTVisitor::visitFuncFParam(MiniCParser::FuncFParamContext * ctx)
 
         std::vector<ast_node *> dim_nodes;
         for (auto dimCtx: ctx->dims) {
-			ast_node * expr_node = std::any_cast<ast_node *>(visitExpr(dimCtx));
+			ast_node * expr_node = visitExpr(dimCtx);
 			ast_node * dim_node = create_contain_node(ast_operator_type::AST_OP_ARRAY_DIM, expr_node);
 
             dim_nodes.push_back(dim_node);
@@ -212,7 +164,7 @@ std::any MiniCCSTVisitor::visitFuncFParam(MiniCParser::FuncFParamContext * ctx)
 
 /// @brief 非终结运算符block的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBlock(MiniCParser::BlockContext * ctx)
+ast_node * MiniCCSTVisitor::visitBlock(MiniCParser::BlockContext * ctx)
 {
     // 识别的文法产生式：block : T_L_BRACE blockItemList? T_R_BRACE';
     if (!ctx->blockItemList()) {
@@ -230,7 +182,7 @@ std::any MiniCCSTVisitor::visitBlock(MiniCParser::BlockContext * ctx)
 
 /// @brief 非终结运算符blockItemList的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBlockItemList(MiniCParser::BlockItemListContext * ctx)
+ast_node * MiniCCSTVisitor::visitBlockItemList(MiniCParser::BlockItemListContext * ctx)
 {
     // 识别的文法产生式：blockItemList : blockItem +;
     // 正闭包 循环 至少一个blockItem
@@ -239,7 +191,7 @@ std::any MiniCCSTVisitor::visitBlockItemList(MiniCParser::BlockItemListContext *
     for (auto blockItemCtx: ctx->blockItem()) {
 
         // 非终结符，需遍历
-        auto blockItem = std::any_cast<ast_node *>(visitBlockItem(blockItemCtx));
+        auto blockItem = visitBlockItem(blockItemCtx);
 
         // 插入到块节点中
         (void) block_node->insert_son_node(blockItem);
@@ -252,7 +204,7 @@ std::any MiniCCSTVisitor::visitBlockItemList(MiniCParser::BlockItemListContext *
 /// @brief 非终结运算符blockItem的遍历
 /// @param ctx CST上下文
 ///
-std::any MiniCCSTVisitor::visitBlockItem(MiniCParser::BlockItemContext * ctx)
+ast_node * MiniCCSTVisitor::visitBlockItem(MiniCParser::BlockItemContext * ctx)
 {
     // 识别的文法产生式：blockItem : stmt | varDecl
     if (ctx->stmt()) {
@@ -268,7 +220,7 @@ std::any MiniCCSTVisitor::visitBlockItem(MiniCParser::BlockItemContext * ctx)
 
 /// @brief 非终结运算符stmt中的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitStmt(MiniCParser::StmtContext * ctx)
+ast_node * MiniCCSTVisitor::visitStmt(MiniCParser::StmtContext * ctx)
 {
     // 识别的文法产生式：stmt: T_ID T_ASSIGN expr T_SEMICOLON  # assignStatement
     // | T_RETURN expr T_SEMICOLON # returnStatement
@@ -303,14 +255,14 @@ std::any MiniCCSTVisitor::visitStmt(MiniCParser::StmtContext * ctx)
 /// @brief 非终结运算符stmt中的returnStatement的遍历
 /// @param ctx CST上下文
 ///
-std::any MiniCCSTVisitor::visitReturnStatement(MiniCParser::ReturnStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitReturnStatement(MiniCParser::ReturnStatementContext * ctx)
 {
     // 识别的文法产生式：returnStatement -> T_RETURN expr? T_SEMICOLON
 
     // 非终结符，表达式expr遍历
     ast_node * exprNode = nullptr;
     if (ctx->expr()) {
-        exprNode = std::any_cast<ast_node *>(visitExpr(ctx->expr()));
+        exprNode = visitExpr(ctx->expr());
 	}
 
     // 创建返回节点，其孩子为Expr
@@ -319,7 +271,7 @@ std::any MiniCCSTVisitor::visitReturnStatement(MiniCParser::ReturnStatementConte
 
 /// @brief 内部产生的非终结符ifStatement的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitIfStatement(MiniCParser::IfStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitIfStatement(MiniCParser::IfStatementContext * ctx)
 {
 	// 识别产生式：stmt: ifStmt
 
@@ -328,7 +280,7 @@ std::any MiniCCSTVisitor::visitIfStatement(MiniCParser::IfStatementContext * ctx
 
 /// @brief 内部产生的非终结符whileStatement的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitWhileStatement(MiniCParser::WhileStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitWhileStatement(MiniCParser::WhileStatementContext * ctx)
 {
     // 识别产生式：stmt: whileStmt
     
@@ -337,7 +289,7 @@ std::any MiniCCSTVisitor::visitWhileStatement(MiniCParser::WhileStatementContext
 
 /// @brief 内部产生的非终结符breakStatement的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBreakStatement(MiniCParser::BreakStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitBreakStatement(MiniCParser::BreakStatementContext * ctx)
 {
     // 识别产生式：stmt: breakStmt
     
@@ -346,7 +298,7 @@ std::any MiniCCSTVisitor::visitBreakStatement(MiniCParser::BreakStatementContext
 
 /// @brief 内部产生的非终结符continueStatement的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitContinueStatement(MiniCParser::ContinueStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitContinueStatement(MiniCParser::ContinueStatementContext * ctx)
 {
     // 识别产生式：stmt: continueStmt
     
@@ -355,7 +307,7 @@ std::any MiniCCSTVisitor::visitContinueStatement(MiniCParser::ContinueStatementC
 
 /// @brief 非终结运算符expr的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitExpr(MiniCParser::ExprContext * ctx)
+ast_node * MiniCCSTVisitor::visitExpr(MiniCParser::ExprContext * ctx)
 {
     // 识别产生式：expr: lOrExp
 
@@ -364,7 +316,7 @@ std::any MiniCCSTVisitor::visitExpr(MiniCParser::ExprContext * ctx)
 
 /// @brief 非终结符cond的遍历
 /// @param ctx
-std::any MiniCCSTVisitor::visitCond(MiniCParser::CondContext * ctx)
+ast_node * MiniCCSTVisitor::visitCond(MiniCParser::CondContext * ctx)
 {
     // 识别产生式：cond: lOrExp
 
@@ -373,15 +325,15 @@ std::any MiniCCSTVisitor::visitCond(MiniCParser::CondContext * ctx)
 
 /// @brief 内部产生的非终结符assignStatement的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitAssignStatement(MiniCParser::AssignStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitAssignStatement(MiniCParser::AssignStatementContext * ctx)
 {
     // 识别文法产生式：assignStatement: lVal T_ASSIGN expr T_SEMICOLON
 
     // 赋值左侧左值Lval遍历产生节点
-    auto lvalNode = std::any_cast<ast_node *>(visitLVal(ctx->lVal()));
+    auto lvalNode = visitLVal(ctx->lVal());
 
     // 赋值右侧expr遍历
-    auto exprNode = std::any_cast<ast_node *>(visitExpr(ctx->expr()));
+    auto exprNode = visitExpr(ctx->expr());
 
     // 创建一个AST_OP_ASSIGN类型的中间节点，孩子为Lval和Expr
     return ast_node::New(ast_operator_type::AST_OP_ASSIGN, lvalNode, exprNode, nullptr);
@@ -389,7 +341,7 @@ std::any MiniCCSTVisitor::visitAssignStatement(MiniCParser::AssignStatementConte
 
 /// @brief 内部产生的非终结符blockStatement的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBlockStatement(MiniCParser::BlockStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitBlockStatement(MiniCParser::BlockStatementContext * ctx)
 {
     // 识别文法产生式 blockStatement: block
 
@@ -398,7 +350,7 @@ std::any MiniCCSTVisitor::visitBlockStatement(MiniCParser::BlockStatementContext
 
 /// @brief 非终结符mulExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitMulExp(MiniCParser::MulExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitMulExp(MiniCParser::MulExpContext * ctx)
 {
     // 识别的文法产生式：mulExp : unaryExp (mulOp unaryExp)*;
 
@@ -417,16 +369,16 @@ std::any MiniCCSTVisitor::visitMulExp(MiniCParser::MulExpContext * ctx)
     for (int k = 0; k < (int) opsCtxVec.size(); k++) {
 
         // 获取运算符
-        ast_operator_type op = std::any_cast<ast_operator_type>(visitMulOp(opsCtxVec[k]));
+        ast_operator_type op = visitMulOp(opsCtxVec[k]);
 
         if (k == 0) {
 
             // 左操作数
-            left = std::any_cast<ast_node *>(visitUnaryExp(ctx->unaryExp()[k]));
+            left = visitUnaryExp(ctx->unaryExp()[k]);
         }
 
         // 右操作数
-        right = std::any_cast<ast_node *>(visitUnaryExp(ctx->unaryExp()[k + 1]));
+        right = visitUnaryExp(ctx->unaryExp()[k + 1]);
 
         // 新建结点作为下一个运算符的右操作符
         left = ast_node::New(op, left, right, nullptr);
@@ -437,7 +389,7 @@ std::any MiniCCSTVisitor::visitMulExp(MiniCParser::MulExpContext * ctx)
 
 /// @brief 非终结符mulOp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitMulOp(MiniCParser::MulOpContext * ctx)
+ast_operator_type MiniCCSTVisitor::visitMulOp(MiniCParser::MulOpContext * ctx)
 {
     // 识别的文法产生式：mulOp: T_MUL | T_DIV | T_MOD
     if (ctx->T_MUL()) {
@@ -451,7 +403,7 @@ std::any MiniCCSTVisitor::visitMulOp(MiniCParser::MulOpContext * ctx)
 
 /// @brief 非终结符AddExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitAddExp(MiniCParser::AddExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitAddExp(MiniCParser::AddExpContext * ctx)
 {
     // 识别的文法产生式：addExp : mulExp (addOp mulExp)*;
 
@@ -470,16 +422,16 @@ std::any MiniCCSTVisitor::visitAddExp(MiniCParser::AddExpContext * ctx)
     for (int k = 0; k < (int) opsCtxVec.size(); k++) {
 
         // 获取运算符
-        ast_operator_type op = std::any_cast<ast_operator_type>(visitAddOp(opsCtxVec[k]));
+        ast_operator_type op = visitAddOp(opsCtxVec[k]);
 
         if (k == 0) {
 
             // 左操作数
-            left = std::any_cast<ast_node *>(visitMulExp(ctx->mulExp()[k]));
+            left = visitMulExp(ctx->mulExp()[k]);
         }
 
         // 右操作数
-        right = std::any_cast<ast_node *>(visitMulExp(ctx->mulExp()[k + 1]));
+        right = visitMulExp(ctx->mulExp()[k + 1]);
 
         // 新建结点作为下一个运算符的右操作符
         left = ast_node::New(op, left, right, nullptr);
@@ -491,7 +443,7 @@ std::any MiniCCSTVisitor::visitAddExp(MiniCParser::AddExpContext * ctx)
 
 /// @brief 非终结运算符addOp的遍历
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitAddOp(MiniCParser::AddOpContext * ctx)
+ast_operator_type MiniCCSTVisitor::visitAddOp(MiniCParser::AddOpContext * ctx)
 {
     // 识别的文法产生式：addOp : T_ADD | T_SUB
 
@@ -504,7 +456,7 @@ std::any MiniCCSTVisitor::visitAddOp(MiniCParser::AddOpContext * ctx)
 
 /// @brief 非终结符relExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitRelExp(MiniCParser::RelExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitRelExp(MiniCParser::RelExpContext * ctx)
 {
     // 识别的文法产生式：relExp: addExp (relOp addExp)*
 
@@ -522,15 +474,15 @@ std::any MiniCCSTVisitor::visitRelExp(MiniCParser::RelExpContext * ctx)
     for (int k = 0; k < (int) opsCtxVec.size(); k++) {
 
         // 获取运算符
-        ast_operator_type op = std::any_cast<ast_operator_type>(visitRelOp(opsCtxVec[k]));
+        ast_operator_type op = visitRelOp(opsCtxVec[k]);
 
         if (k == 0) {
             // 左操作数
-            left = std::any_cast<ast_node *>(visitAddExp(ctx->addExp()[k]));
+            left = visitAddExp(ctx->addExp()[k]);
         }
 
         // 右操作数
-        right = std::any_cast<ast_node *>(visitAddExp(ctx->addExp()[k + 1]));
+        right = visitAddExp(ctx->addExp()[k + 1]);
 
         // 新建结点作为下一个运算符的右操作符
         left = ast_node::New(op, left, right, nullptr);
@@ -541,7 +493,7 @@ std::any MiniCCSTVisitor::visitRelExp(MiniCParser::RelExpContext * ctx)
 
 /// @brief 非终结符relOp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitRelOp(MiniCParser::RelOpContext * ctx)
+ast_operator_type MiniCCSTVisitor::visitRelOp(MiniCParser::RelOpContext * ctx)
 {
     if (ctx->T_LT()) {
         return ast_operator_type::AST_OP_LT;
@@ -556,7 +508,7 @@ std::any MiniCCSTVisitor::visitRelOp(MiniCParser::RelOpContext * ctx)
 
 /// @brief 非终结符eqExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitEqExp(MiniCParser::EqExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitEqExp(MiniCParser::EqExpContext * ctx)
 {
     // 识别的文法产生式：eqExp: relExp (eqOp relExp)*
 
@@ -574,15 +526,15 @@ std::any MiniCCSTVisitor::visitEqExp(MiniCParser::EqExpContext * ctx)
     for (int k = 0; k < (int) opsCtxVec.size(); k++) {
 
         // 获取运算符
-        ast_operator_type op = std::any_cast<ast_operator_type>(visitEqOp(opsCtxVec[k]));
+        ast_operator_type op = visitEqOp(opsCtxVec[k]);
 
         if (k == 0) {
             // 左操作数
-            left = std::any_cast<ast_node *>(visitRelExp(ctx->relExp()[k]));
+            left = visitRelExp(ctx->relExp()[k]);
         }
 
         // 右操作数
-        right = std::any_cast<ast_node *>(visitRelExp(ctx->relExp()[k + 1]));
+        right = visitRelExp(ctx->relExp()[k + 1]);
 
         // 新建结点作为下一个运算符的右操作符
         left = ast_node::New(op, left, right, nullptr);
@@ -593,7 +545,7 @@ std::any MiniCCSTVisitor::visitEqExp(MiniCParser::EqExpContext * ctx)
 
 /// @brief 非终结符eqOp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitEqOp(MiniCParser::EqOpContext * ctx)
+ast_operator_type MiniCCSTVisitor::visitEqOp(MiniCParser::EqOpContext * ctx)
 {
     if (ctx->T_EQ()) {
         return ast_operator_type::AST_OP_EQ;
@@ -604,7 +556,7 @@ std::any MiniCCSTVisitor::visitEqOp(MiniCParser::EqOpContext * ctx)
 
 /// @brief 非终结符lAndExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitLAndExp(MiniCParser::LAndExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitLAndExp(MiniCParser::LAndExpContext * ctx)
 {
     // 识别的文法产生式：lAndExp: eqExp (lAndOp eqExp)*
 
@@ -622,15 +574,15 @@ std::any MiniCCSTVisitor::visitLAndExp(MiniCParser::LAndExpContext * ctx)
     for (int k = 0; k < (int) opsCtxVec.size(); k++) {
 
         // 获取运算符
-        ast_operator_type op = std::any_cast<ast_operator_type>(visitLAndOp(opsCtxVec[k]));
+        ast_operator_type op = visitLAndOp(opsCtxVec[k]);
 
         if (k == 0) {
             // 左操作数
-            left = std::any_cast<ast_node *>(visitEqExp(ctx->eqExp()[k]));
+            left = visitEqExp(ctx->eqExp()[k]);
         }
 
         // 右操作数
-        right = std::any_cast<ast_node *>(visitEqExp(ctx->eqExp()[k + 1]));
+        right = visitEqExp(ctx->eqExp()[k + 1]);
 
         // 新建结点作为下一个运算符的右操作符
         left = ast_node::New(op, left, right, nullptr);
@@ -641,18 +593,19 @@ std::any MiniCCSTVisitor::visitLAndExp(MiniCParser::LAndExpContext * ctx)
 
 /// @brief 非终结符lAndOp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitLAndOp(MiniCParser::LAndOpContext * ctx)
+ast_operator_type MiniCCSTVisitor::visitLAndOp(MiniCParser::LAndOpContext * ctx)
 {
     if (ctx->T_AND()) {
         return ast_operator_type::AST_OP_AND;
     } else {
-        return std::any{nullptr};
+        // 文法上不可能出现，返回非法运算符
+        return ast_operator_type::AST_OP_MAX;
 	}
 }
 
 /// @brief 非终结符lOrExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitLOrExp(MiniCParser::LOrExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitLOrExp(MiniCParser::LOrExpContext * ctx)
 {
     // 识别的文法产生式：lOrExp: lAndExp (lOrOp lAndExp)*
 
@@ -670,15 +623,15 @@ std::any MiniCCSTVisitor::visitLOrExp(MiniCParser::LOrExpContext * ctx)
     for (int k = 0; k < (int) opsCtxVec.size(); k++) {
 
         // 获取运算符
-        ast_operator_type op = std::any_cast<ast_operator_type>(visitLOrOp(opsCtxVec[k]));
+        ast_operator_type op = visitLOrOp(opsCtxVec[k]);
 
         if (k == 0) {
             // 左操作数
-            left = std::any_cast<ast_node *>(visitLAndExp(ctx->lAndExp()[k]));
+            left = visitLAndExp(ctx->lAndExp()[k]);
         }
 
         // 右操作数
-        right = std::any_cast<ast_node *>(visitLAndExp(ctx->lAndExp()[k + 1]));
+        right = visitLAndExp(ctx->lAndExp()[k + 1]);
 
         // 新建结点作为下一个运算符的右操作符
         left = ast_node::New(op, left, right, nullptr);
@@ -689,18 +642,19 @@ std::any MiniCCSTVisitor::visitLOrExp(MiniCParser::LOrExpContext * ctx)
 
 /// @brief 非终结符lOrOp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitLOrOp(MiniCParser::LOrOpContext * ctx)
+ast_operator_type MiniCCSTVisitor::visitLOrOp(MiniCParser::LOrOpContext * ctx)
 {
     if (ctx->T_OR()) {
         return ast_operator_type::AST_OP_OR;
     } else {
-        return std::any{nullptr};
+        // 文法上不可能出现，返回非法运算符
+        return ast_operator_type::AST_OP_MAX;
 	}
 }
 
 /// @brief 非终结符initVal的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitInitVal(MiniCParser::InitValContext * ctx)
+ast_node * MiniCCSTVisitor::visitInitVal(MiniCParser::InitValContext * ctx)
 {
     // 识别文法产生式：initVal: expr | T_L_BRACE initVal (T_COMMA initVal)* T_R_BRACE;
 
@@ -711,7 +665,7 @@ std::any MiniCCSTVisitor::visitInitVal(MiniCParser::InitValContext * ctx)
         ast_node * multiple_val_node = create_contain_node(ast_operator_type::AST_OP_ARRAY_INIT);
 
         for (auto valCtx: ctx->initVal()) {
-            ast_node * val_node = std::any_cast<ast_node *>(visitInitVal(valCtx));
+            ast_node * val_node = visitInitVal(valCtx);
             (void) multiple_val_node->insert_son_node(val_node);
         }
 
@@ -723,16 +677,16 @@ std::any MiniCCSTVisitor::visitInitVal(MiniCParser::InitValContext * ctx)
 
 /// @brief 非终结符ifStmt的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitIfStmt(MiniCParser::IfStmtContext * ctx)
+ast_node * MiniCCSTVisitor::visitIfStmt(MiniCParser::IfStmtContext * ctx)
 {
     // 识别文法产生式：ifStmt: T_IF T_L_PAREN cond T_R_PAREN stmt? (T_ELSE stmt)?
 
     // 首先识别cond条件表达式
-    ast_node * condNode = std::any_cast<ast_node *>(visitCond(ctx->cond()));
+    ast_node * condNode = visitCond(ctx->cond());
 
     // 然后识别条件为真的语句块
     // 现在可以正确接受nullptr了
-    ast_node * thenNode = std::any_cast<ast_node *>(visitStmt(ctx->stmt(0)));
+    ast_node * thenNode = visitStmt(ctx->stmt(0));
 
     // 最后识别可选的else语句块
     ast_node * elseNode = nullptr;
@@ -740,7 +694,7 @@ std::any MiniCCSTVisitor::visitIfStmt(MiniCParser::IfStmtContext * ctx)
     if (ctx->T_ELSE() != nullptr) {
         // 再检查ctx是否有多个stmt
         if (ctx->stmt().size() > 1 && ctx->stmt(1)) {
-            elseNode = std::any_cast<ast_node *>(visitStmt(ctx->stmt(1)));
+            elseNode = visitStmt(ctx->stmt(1));
 		}
     }
 
@@ -755,15 +709,15 @@ std::any MiniCCSTVisitor::visitIfStmt(MiniCParser::IfStmtContext * ctx)
 
 /// @brief 非终结符whileStmt的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitWhileStmt(MiniCParser::WhileStmtContext * ctx)
+ast_node * MiniCCSTVisitor::visitWhileStmt(MiniCParser::WhileStmtContext * ctx)
 {
     // 识别文法产生式：whileStmt: T_WHILE T_L_PAREN cond T_R_PAREN stmt
 
     // 首先识别cond条件表达式
-    ast_node * condNode = std::any_cast<ast_node *>(visitCond(ctx->cond()));
+    ast_node * condNode = visitCond(ctx->cond());
 
     // 然后识别循环体
-    ast_node * loopNode = std::any_cast<ast_node *>(visitStmt(ctx->stmt()));
+    ast_node * loopNode = visitStmt(ctx->stmt());
 
     // 创建AST节点
     ast_node * whileNode = create_contain_node(ast_operator_type::AST_OP_WHILE,
@@ -775,7 +729,7 @@ std::any MiniCCSTVisitor::visitWhileStmt(MiniCParser::WhileStmtContext * ctx)
 
 /// @brief 非终结符breakStmt的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBreakStmt(MiniCParser::BreakStmtContext * ctx)
+ast_node * MiniCCSTVisitor::visitBreakStmt(MiniCParser::BreakStmtContext * ctx)
 {
 	// 识别文法产生式：breakStmt : T_BREAK T_SEMICOLON
 
@@ -784,7 +738,7 @@ std::any MiniCCSTVisitor::visitBreakStmt(MiniCParser::BreakStmtContext * ctx)
 
 /// @brief 非终结符continueStmt的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitContinueStmt(MiniCParser::ContinueStmtContext * ctx)
+ast_node * MiniCCSTVisitor::visitContinueStmt(MiniCParser::ContinueStmtContext * ctx)
 {
     // 识别文法产生式：continueStmt: T_CONTINUE T_SEMICOLON
 
@@ -793,7 +747,7 @@ std::any MiniCCSTVisitor::visitContinueStmt(MiniCParser::ContinueStmtContext * c
 
 /// @brief 非终结符unaryExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitUnaryExp(MiniCParser::UnaryExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitUnaryExp(MiniCParser::UnaryExpContext * ctx)
 {
     // 识别文法产生式：unaryExp: primaryExp | T_ID T_L_PAREN realParamList? T_R_PAREN | unaryOp unaryExp;
 
@@ -811,20 +765,20 @@ std::any MiniCCSTVisitor::visitUnaryExp(MiniCParser::UnaryExpContext * ctx)
         // 函数调用
         if (ctx->realParamList()) {
             // 有参数
-            paramListNode = std::any_cast<ast_node *>(visitRealParamList(ctx->realParamList()));
+            paramListNode = visitRealParamList(ctx->realParamList());
         }
 
         // 创建函数调用节点，其孩子为被调用函数名和实参，
         return create_func_call(funcname_node, paramListNode);
     } else if (ctx->unaryOp()) {
 		// 识别到求负或逻辑非运算
-        auto operandNode = std::any_cast<ast_node *>(visitUnaryExp(ctx->unaryExp()));
+        auto operandNode = visitUnaryExp(ctx->unaryExp());
 
         if (!operandNode) {
-            return std::any{nullptr};
+            return nullptr;
         }
 
-        ast_operator_type op = std::any_cast<ast_operator_type>(visitUnaryOp(ctx->unaryOp()));
+        ast_operator_type op = visitUnaryOp(ctx->unaryOp());
 
         ast_node * unaryNode = ast_node::New(op, operandNode, nullptr);
 
@@ -836,20 +790,21 @@ std::any MiniCCSTVisitor::visitUnaryExp(MiniCParser::UnaryExpContext * ctx)
 
 /// @brief 非终结符unaryOp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitUnaryOp(MiniCParser::UnaryOpContext * ctx)
+ast_operator_type MiniCCSTVisitor::visitUnaryOp(MiniCParser::UnaryOpContext * ctx)
 {
     if (ctx->T_NOT()) {
         return ast_operator_type::AST_OP_NOT;
 	} else if (ctx->T_SUB()) {
 		return ast_operator_type::AST_OP_SUB;
     } else {
-        return std::any{nullptr};
+        // 文法上不可能出现，返回非法运算符
+        return ast_operator_type::AST_OP_MAX;
 	}
 }
 
 /// @brief 非终结符PrimaryExp的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitPrimaryExp(MiniCParser::PrimaryExpContext * ctx)
+ast_node * MiniCCSTVisitor::visitPrimaryExp(MiniCParser::PrimaryExpContext * ctx)
 {
     // 识别文法产生式 primaryExp: T_L_PAREN expr T_R_PAREN | T_DIGIT | lVal;
 
@@ -864,11 +819,11 @@ std::any MiniCCSTVisitor::visitPrimaryExp(MiniCParser::PrimaryExpContext * ctx)
     } else if (ctx->lVal()) {
         // 具有左值的表达式
         // 识别 primaryExp: lVal
-        node = std::any_cast<ast_node *>(visitLVal(ctx->lVal()));
+        node = visitLVal(ctx->lVal());
     } else if (ctx->expr()) {
         // 带有括号的表达式
         // primaryExp: T_L_PAREN expr T_R_PAREN
-        node = std::any_cast<ast_node *>(visitExpr(ctx->expr()));
+        node = visitExpr(ctx->expr());
     }
 
     return node;
@@ -876,7 +831,7 @@ std::any MiniCCSTVisitor::visitPrimaryExp(MiniCParser::PrimaryExpContext * ctx)
 
 /// @brief 非终结符LVal的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitLVal(MiniCParser::LValContext * ctx)
+ast_node * MiniCCSTVisitor::visitLVal(MiniCParser::LValContext * ctx)
 {
     // 识别文法产生式：lVal: T_ID (T_L_BRACKET expr T_R_BRACKET)*;
     // 获取ID的名字
@@ -890,7 +845,7 @@ std::any MiniCCSTVisitor::visitLVal(MiniCParser::LValContext * ctx)
 
     // 向上生长变量引用树
     for (auto indexCtx: ctx->expr()) {
-        ast_node * expr_node = std::any_cast<ast_node *>(visitExpr(indexCtx));
+        ast_node * expr_node = visitExpr(indexCtx);
 
         ast_node * new_index_node = nullptr;
         // 避免index嵌套
@@ -919,7 +874,7 @@ std::any MiniCCSTVisitor::visitLVal(MiniCParser::LValContext * ctx)
 
 /// @brief 非终结符VarDecl的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitVarDecl(MiniCParser::VarDeclContext * ctx)
+ast_node * MiniCCSTVisitor::visitVarDecl(MiniCParser::VarDeclContext * ctx)
 {
     // varDecl: basicType varDef (T_COMMA varDef)* T_SEMICOLON;
 
@@ -927,11 +882,11 @@ std::any MiniCCSTVisitor::visitVarDecl(MiniCParser::VarDeclContext * ctx)
     ast_node * stmt_node = create_contain_node(ast_operator_type::AST_OP_DECL_STMT);
 
     // 类型节点
-    type_attr typeAttr = std::any_cast<type_attr>(visitBasicType(ctx->basicType()));
+    type_attr typeAttr = visitBasicType(ctx->basicType());
 
     for (auto & varCtx: ctx->varDef()) {
 
-        VarDefInfo info = std::any_cast<VarDefInfo>(visitVarDef(varCtx));
+        VarDefInfo info = visitVarDef(varCtx);
 
         // 变量名节点
         ast_node * id_node = info.id_node;
@@ -985,7 +940,7 @@ std::any MiniCCSTVisitor::visitVarDecl(MiniCParser::VarDeclContext * ctx)
 
 /// @brief 非终结符VarDecl的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitVarDef(MiniCParser::VarDefContext * ctx)
+MiniCCSTVisitor::VarDefInfo MiniCCSTVisitor::visitVarDef(MiniCParser::VarDefContext * ctx)
 {
     // varDef: T_ID (T_L_BRACKET expr T_R_BRACKET)* (T_ASSIGN initVal)?;
     //! 这里修改方法，返回结构体，保存相关信息
@@ -1001,21 +956,21 @@ std::any MiniCCSTVisitor::visitVarDef(MiniCParser::VarDefContext * ctx)
 
     for (auto indexCtx: ctx->expr()) {
         ast_node * index_node = create_contain_node(ast_operator_type::AST_OP_ARRAY_DIM);
-        ast_node * expr_node = std::any_cast<ast_node *>(visitExpr(indexCtx));
+        ast_node * expr_node = visitExpr(indexCtx);
 
         (void) index_node->insert_son_node(expr_node);
         info.dim_nodes.push_back(index_node);
 	}
 
     if (ctx->T_ASSIGN()) {
-        info.init_node = std::any_cast<ast_node *>(visitInitVal(ctx->initVal()));
+        info.init_node = visitInitVal(ctx->initVal());
 	}
     return info;
 }
 
 /// @brief 非终结符BasicType的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitBasicType(MiniCParser::BasicTypeContext * ctx)
+type_attr MiniCCSTVisitor::visitBasicType(MiniCParser::BasicTypeContext * ctx)
 {
     // basicType: T_INT;
     type_attr attr{BasicType::TYPE_VOID, -1};
@@ -1029,7 +984,7 @@ std::any MiniCCSTVisitor::visitBasicType(MiniCParser::BasicTypeContext * ctx)
 
 /// @brief 非终结符RealParamList的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitRealParamList(MiniCParser::RealParamListContext * ctx)
+ast_node * MiniCCSTVisitor::visitRealParamList(MiniCParser::RealParamListContext * ctx)
 {
     // 识别的文法产生式：realParamList : expr (T_COMMA expr)*;
 
@@ -1037,7 +992,7 @@ std::any MiniCCSTVisitor::visitRealParamList(MiniCParser::RealParamListContext *
 
     for (auto paramCtx: ctx->expr()) {
 
-        auto paramNode = std::any_cast<ast_node *>(visitExpr(paramCtx));
+        auto paramNode = visitExpr(paramCtx);
 
         paramListNode->insert_son_node(paramNode);
     }
@@ -1047,7 +1002,7 @@ std::any MiniCCSTVisitor::visitRealParamList(MiniCParser::RealParamListContext *
 
 /// @brief 非终结符ExpressionStatement的分析
 /// @param ctx CST上下文
-std::any MiniCCSTVisitor::visitExpressionStatement(MiniCParser::ExpressionStatementContext * ctx)
+ast_node * MiniCCSTVisitor::visitExpressionStatement(MiniCParser::ExpressionStatementContext * ctx)
 {
     // 识别文法产生式  expr ? T_SEMICOLON #expressionStatement;
     if (ctx->expr()) {
@@ -1059,8 +1014,7 @@ std::any MiniCCSTVisitor::visitExpressionStatement(MiniCParser::ExpressionStatem
         // 空语句
 
         // 直接返回空指针，需要再把语句加入到语句块时要注意判断，空语句不要加入
-        //! 用ast_node包裹nullptr，避免出现bad_cast
-        return static_cast<ast_node *>(nullptr);
+        return nullptr;
     }
 }
 
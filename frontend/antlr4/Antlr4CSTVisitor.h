@@ -2,8 +2,8 @@
 /// @file Antlr4CSTVisitor.h
 /// @brief Antlr4的具体语法树的遍历产生AST
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,18 +12,28 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>直接产生AST节点，不再经过std::any
 /// </table>
 ///
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <vector>
+
 #include "AST.h"
-#include "MiniCBaseVisitor.h"
+#include "AttrType.h"
 #include "MiniCParser.h"
-#include <any>
 
+///
 /// @brief 遍历具体语法树产生抽象语法树
-class MiniCCSTVisitor : public MiniCBaseVisitor {
+///
+/// 每个非终结符的遍历函数直接返回其真实类型（ast_node*、type_attr或ast_operator_type等），
+/// 不再经过MiniCBaseVisitor的std::any装箱与拆箱。
+/// 语法分析按顶层的函数定义或变量声明逐个进行，每分析完一个就调用visitFuncDef或visitVarDecl
+/// 产生AST，之后该部分的具体语法树即可释放，不需要整个文件的具体语法树同时存在。
+///
+class MiniCCSTVisitor {
 
 public:
     /// @brief 构造函数
@@ -32,299 +42,301 @@ public:
     /// @brief 析构函数
     virtual ~MiniCCSTVisitor();
 
-    /// @brief 遍历CST产生AST
-    /// @param root CST语法树的根结点
-    /// @return AST的根节点
-    ast_node * run(MiniCParser::CompileUnitContext * root);
-
-protected:
-    /* 下面的函数都是从MiniCBaseVisitor继承下来的虚拟函数，需要重载实现 */
-
-    /// @brief 非终结运算符compileUnit的遍历
+    /// @brief 非终结运算符funcDef的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitCompileUnit(MiniCParser::CompileUnitContext * ctx) override;
+    ast_node * visitFuncDef(MiniCParser::FuncDefContext * ctx);
 
-    /// @brief 非终结运算符funcDef的遍历
+    ///
+    /// @brief 非终结符VarDecl的分析
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitFuncDef(MiniCParser::FuncDefContext * ctx) override;
+    ///
+    ast_node * visitVarDecl(MiniCParser::VarDeclContext * ctx);
+
+protected:
+    ///
+    /// @brief 用于从visitVarDef向visitVarDecl传递变量定义信息
+    ///
+    struct VarDefInfo {
+        /// @brief 变量名节点
+        ast_node * id_node = nullptr;
+
+        /// @brief 维度表达式节点列表
+        std::vector<ast_node *> dim_nodes;
+
+        /// @brief 初始化值节点
+        ast_node * init_node = nullptr;
+    };
 
     /// @brief 非终结运算符funcType的遍历
     /// @param ctx CST上下文
-    /// @return AST的节点
-    std::any visitFuncType(MiniCParser::FuncTypeContext * ctx) override;
+    /// @return 类型属性
+    type_attr visitFuncType(MiniCParser::FuncTypeContext * ctx);
 
-	/// @brief 非终结运算符funcFParams的遍历
+    /// @brief 非终结运算符funcFParams的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitFuncFParams(MiniCParser::FuncFParamsContext * ctx) override;
+    ast_node * visitFuncFParams(MiniCParser::FuncFParamsContext * ctx);
 
     /// @brief 非终结运算符funcFParam的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitFuncFParam(MiniCParser::FuncFParamContext * ctx) override;
+    ast_node * visitFuncFParam(MiniCParser::FuncFParamContext * ctx);
 
     /// @brief 非终结运算符block的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitBlock(MiniCParser::BlockContext * ctx) override;
+    ast_node * visitBlock(MiniCParser::BlockContext * ctx);
 
     /// @brief 非终结运算符blockItemList的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitBlockItemList(MiniCParser::BlockItemListContext * ctx) override;
+    ast_node * visitBlockItemList(MiniCParser::BlockItemListContext * ctx);
 
     /// @brief 非终结运算符blockItem的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitBlockItem(MiniCParser::BlockItemContext * ctx) override;
+    ast_node * visitBlockItem(MiniCParser::BlockItemContext * ctx);
 
     /// @brief 非终结运算符statement中的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitStmt(MiniCParser::StmtContext * ctx);
+    ast_node * visitStmt(MiniCParser::StmtContext * ctx);
 
     /// @brief 非终结运算符statement中的returnStatement的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitReturnStatement(MiniCParser::ReturnStatementContext * ctx) override;
+    ast_node * visitReturnStatement(MiniCParser::ReturnStatementContext * ctx);
 
     ///
     /// @brief 内部产生的非终结符assignStatement的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitAssignStatement(MiniCParser::AssignStatementContext * ctx) override;
+    ast_node * visitAssignStatement(MiniCParser::AssignStatementContext * ctx);
 
     ///
     /// @brief 内部产生的非终结符blockStatement的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitBlockStatement(MiniCParser::BlockStatementContext * ctx) override;
+    ast_node * visitBlockStatement(MiniCParser::BlockStatementContext * ctx);
 
     ///
     /// @brief 非终结符ExpressionStatement的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点，空语句时为空指针
     ///
-    std::any visitExpressionStatement(MiniCParser::ExpressionStatementContext * context) override;
+    ast_node * visitExpressionStatement(MiniCParser::ExpressionStatementContext * ctx);
 
     ///
     /// @brief 内部产生的非终结符ifStatement的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitIfStatement(MiniCParser::IfStatementContext * ctx) override;
+    ast_node * visitIfStatement(MiniCParser::IfStatementContext * ctx);
 
     ///
     /// @brief 内部产生的非终结符whileStatement的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitWhileStatement(MiniCParser::WhileStatementContext * ctx) override;
+    ast_node * visitWhileStatement(MiniCParser::WhileStatementContext * ctx);
 
     ///
     /// @brief 内部产生的非终结符breakStatement的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitBreakStatement(MiniCParser::BreakStatementContext * ctx) override;
+    ast_node * visitBreakStatement(MiniCParser::BreakStatementContext * ctx);
 
     ///
     /// @brief 内部产生的非终结符continueStatement的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitContinueStatement(MiniCParser::ContinueStatementContext * ctx) override;
+    ast_node * visitContinueStatement(MiniCParser::ContinueStatementContext * ctx);
 
     /// @brief 非终结符expr的遍历
     /// @param ctx CST上下文
     /// @return AST的节点
-    std::any visitExpr(MiniCParser::ExprContext * ctx) override;
+    ast_node * visitExpr(MiniCParser::ExprContext * ctx);
 
     ///
     /// @brief 非终结符cond的遍历
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-	std::any visitCond(MiniCParser::CondContext * ctx) override;
+    ast_node * visitCond(MiniCParser::CondContext * ctx);
 
     ///
     /// @brief 非终结符AddExp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-	std::any visitAddExp(MiniCParser::AddExpContext * ctx) override;
+    ast_node * visitAddExp(MiniCParser::AddExpContext * ctx);
 
     ///
     /// @brief 非终结符addOp的分析
     /// @param ctx CST上下文
-    /// @return std::any 类型
+    /// @return 运算符
     ///
-    std::any visitAddOp(MiniCParser::AddOpContext * ctx) override;
+    ast_operator_type visitAddOp(MiniCParser::AddOpContext * ctx);
 
     ///
     /// @brief 非终结符mulExp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-	std::any visitMulExp(MiniCParser::MulExpContext *ctx) override;
+    ast_node * visitMulExp(MiniCParser::MulExpContext * ctx);
 
-	///
-	/// @brief 非终结符mulOp的分析
-	/// @param ctx CST上下文
-	/// @return std::any AST的节点
-	///
-	std::any visitMulOp(MiniCParser::MulOpContext *ctx) override;
+    ///
+    /// @brief 非终结符mulOp的分析
+    /// @param ctx CST上下文
+    /// @return 运算符
+    ///
+    ast_operator_type visitMulOp(MiniCParser::MulOpContext * ctx);
 
-	///
-	/// @brief 非终结符relExp的分析
-	/// @param ctx CST上下文
-	/// @return std::any AST的节点
-	///
-    std::any visitRelExp(MiniCParser::RelExpContext * ctx) override;
+    ///
+    /// @brief 非终结符relExp的分析
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ///
+    ast_node * visitRelExp(MiniCParser::RelExpContext * ctx);
 
     ///
-	/// @brief 非终结符relOp的分析
-	/// @param ctx CST上下文
-	/// @return std::any AST的节点
-	///
-    std::any visitRelOp(MiniCParser::RelOpContext * ctx) override;
+    /// @brief 非终结符relOp的分析
+    /// @param ctx CST上下文
+    /// @return 运算符
+    ///
+    ast_operator_type visitRelOp(MiniCParser::RelOpContext * ctx);
 
-	///
-	/// @brief 非终结符eqExp的分析
-	/// @param ctx CST上下文
-	/// @return std::any AST的节点
-	///
-    std::any visitEqExp(MiniCParser::EqExpContext * ctx) override;
+    ///
+    /// @brief 非终结符eqExp的分析
+    /// @param ctx CST上下文
+    /// @return AST的节点
+    ///
+    ast_node * visitEqExp(MiniCParser::EqExpContext * ctx);
 
     ///
-	/// @brief 非终结符eqOp的分析
-	/// @param ctx CST上下文
-	/// @return std::any AST的节点
-	///
-    std::any visitEqOp(MiniCParser::EqOpContext * ctx) override;
+    /// @brief 非终结符eqOp的分析
+    /// @param ctx CST上下文
+    /// @return 运算符
+    ///
+    ast_operator_type visitEqOp(MiniCParser::EqOpContext * ctx);
 
     ///
     /// @brief 非终结符lAndExp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-	std::any visitLAndExp(MiniCParser::LAndExpContext * ctx) override;
+    ast_node * visitLAndExp(MiniCParser::LAndExpContext * ctx);
 
     ///
     /// @brief 非终结符lAndOp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return 运算符
     ///
-    std::any visitLAndOp(MiniCParser::LAndOpContext * ctx) override;
+    ast_operator_type visitLAndOp(MiniCParser::LAndOpContext * ctx);
 
     ///
     /// @brief 非终结符lOrExp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitLOrExp(MiniCParser::LOrExpContext * ctx) override;
+    ast_node * visitLOrExp(MiniCParser::LOrExpContext * ctx);
 
     ///
     /// @brief 非终结符lOrOp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return 运算符
     ///
-    std::any visitLOrOp(MiniCParser::LOrOpContext * ctx) override;
+    ast_operator_type visitLOrOp(MiniCParser::LOrOpContext * ctx);
 
     ///
     /// @brief 非终结符initVal的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitInitVal(MiniCParser::InitValContext * ctx) override;
+    ast_node * visitInitVal(MiniCParser::InitValContext * ctx);
 
     ///
     /// @brief 非终结符ifStmt的分析
     /// @param ctx CST上下文
-    /// @return std::any 类型
+    /// @return AST的节点
     ///
-    std::any visitIfStmt(MiniCParser::IfStmtContext * ctx) override;
+    ast_node * visitIfStmt(MiniCParser::IfStmtContext * ctx);
 
     ///
     /// @brief 非终结符whileStmt的分析
     /// @param ctx CST上下文
-    /// @return std::any 类型
+    /// @return AST的节点
     ///
-    std::any visitWhileStmt(MiniCParser::WhileStmtContext * ctx) override;
+    ast_node * visitWhileStmt(MiniCParser::WhileStmtContext * ctx);
 
     ///
     /// @brief 非终结符breakStmt的分析
     /// @param ctx CST上下文
-    /// @return std::any 类型
+    /// @return AST的节点
     ///
-    std::any visitBreakStmt(MiniCParser::BreakStmtContext * ctx) override;
+    ast_node * visitBreakStmt(MiniCParser::BreakStmtContext * ctx);
 
     ///
     /// @brief 非终结符continueStmt的分析
     /// @param ctx CST上下文
-    /// @return std::any 类型
+    /// @return AST的节点
     ///
-    std::any visitContinueStmt(MiniCParser::ContinueStmtContext * ctx) override;
+    ast_node * visitContinueStmt(MiniCParser::ContinueStmtContext * ctx);
 
     ///
     /// @brief 非终结符unaryExp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitUnaryExp(MiniCParser::UnaryExpContext * ctx) override;
-
-	///
-	/// @brief 非终结符unaryOp的分析
-	/// @param ctx CST上下文
-	/// @return std::any AST的节点
-	///
-	std::any visitUnaryOp(MiniCParser::UnaryOpContext *ctx) override;
+    ast_node * visitUnaryExp(MiniCParser::UnaryExpContext * ctx);
 
     ///
-    /// @brief 非终结符PrimaryExp的分析
+    /// @brief 非终结符unaryOp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return 运算符
     ///
-    std::any visitPrimaryExp(MiniCParser::PrimaryExpContext * ctx) override;
+    ast_operator_type visitUnaryOp(MiniCParser::UnaryOpContext * ctx);
 
     ///
-    /// @brief 非终结符LVal的分析
+    /// @brief 非终结符PrimaryExp的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitLVal(MiniCParser::LValContext * ctx) override;
+    ast_node * visitPrimaryExp(MiniCParser::PrimaryExpContext * ctx);
 
     ///
-    /// @brief 非终结符VarDecl的分析
+    /// @brief 非终结符LVal的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitVarDecl(MiniCParser::VarDeclContext * ctx) override;
+    ast_node * visitLVal(MiniCParser::LValContext * ctx);
 
     ///
-    /// @brief 非终结符VarDecl的分析
+    /// @brief 非终结符VarDef的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return 变量定义信息
     ///
-    std::any visitVarDef(MiniCParser::VarDefContext * ctx) override;
+    VarDefInfo visitVarDef(MiniCParser::VarDefContext * ctx);
 
     ///
     /// @brief 非终结符BasicType的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return 类型属性
     ///
-    std::any visitBasicType(MiniCParser::BasicTypeContext * ctx) override;
+    type_attr visitBasicType(MiniCParser::BasicTypeContext * ctx);
 
     ///
     /// @brief 非终结符RealParamList的分析
     /// @param ctx CST上下文
-    /// @return std::any AST的节点
+    /// @return AST的节点
     ///
-    std::any visitRealParamList(MiniCParser::RealParamListContext * ctx) override;
+    ast_node * visitRealParamList(MiniCParser::RealParamListContext * ctx);
 
 private:
     ///
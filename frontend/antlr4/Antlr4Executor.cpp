@@ -2,8 +2,8 @@
 /// @file Antlr4Executor.cpp
 /// @brief antlr4的词法与语法分析解析器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,9 +11,13 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>SLL与LL两阶段分析
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>按顶层定义逐个分析并产生AST
 /// </table>
 ///
+#include <cstdio>
 #include <iostream>
+#include <vector>
 
 #include "AST.h"
 #include "Antlr4Executor.h"
@@ -21,6 +25,49 @@
 #include "MiniCLexer.h"
 #include "Common.h"
 
+/// @brief 输出预测的统计信息，只列出被调用过的决策点
+/// @param parser 语法分析器，必须开启了profile
+/// @param itemCount 顶层定义的个数
+/// @param fallbackCount 回退到LL分析的顶层定义的个数
+static void outputPredictionStats(MiniCParser & parser, int itemCount, int fallbackCount)
+{
+    antlr4::atn::ParseInfo parseInfo = parser.getParseInfo();
+
+    printf("Antlr4 prediction: %d top-level items, %d fell back to LL, DFA states %zu, prediction time %lld ns\n",
+           itemCount,
+           fallbackCount,
+           parseInfo.getDFASize(),
+           (long long) parseInfo.getTotalTimeInPrediction());
+    printf("%8s %-24s %10s %10s %10s %10s %10s\n",
+           "decision",
+           "rule",
+           "invocation",
+           "SLL look",
+           "LL look",
+           "LL fallbk",
+           "time(ns)");
+
+    const std::vector<std::string> & ruleNames = parser.getRuleNames();
+    const antlr4::atn::ATN & atn = parser.getATN();
+
+    for (const antlr4::atn::DecisionInfo & info: parseInfo.getDecisionInfo()) {
+        if (info.invocations == 0) {
+            continue;
+        }
+
+        size_t ruleIndex = atn.getDecisionState(info.decision)->ruleIndex;
+
+        printf("%8zu %-24s %10lld %10lld %10lld %10lld %10lld\n",
+               info.decision,
+               ruleNames[ruleIndex].c_str(),
+               (long long) info.invocations,
+               (long long) info.SLL_TotalLook,
+               (long long) info.LL_TotalLook,
+               (long long) info.LL_Fallback,
+               (long long) info.timeInPrediction);
+    }
+}
+
 /// @brief 前端词法与语法解析生成AST
 /// @return true: 成功 false：错误
 bool Antlr4Executor::run()
@@ -41,21 +88,133 @@ bool Antlr4Executor::run()
     // 词法分析器实例转化成记号(Token)流
     antlr4::CommonTokenStream tokenStream{&lexer};
 
-    // 利用antlr4进行分析，从compileUnit开始分析输入字符串
+    // 预先识别出全部的记号，SLL失败回退时直接复用，同时按记号数预留AST节点
+    tokenStream.fill();
+    ast_node::Reserve(tokenStream.size());
+
+    // 语法分析器实例
     MiniCParser parser{&tokenStream};
 
-    // 从具体语法树的根结点进行深度优先遍历，生成抽象语法树
-    auto cstRoot = parser.compileUnit();
-    if (!cstRoot) {
+    // 预测统计需要采用带统计功能的ATN模拟器，必须在设置预测模式之前替换
+    if (showPredictionStats) {
+        parser.setProfile(true);
+    }
+
+    // 预测用的DFA缓存是MiniCParser的静态数据，同一进程内分析多个文件时一直有效
+    auto * interpreter = parser.getInterpreter<antlr4::atn::ParserATNSimulator>();
+
+    // 第一阶段遇到错误立即退出，第二阶段采用默认的错误恢复
+    auto bailStrategy = std::make_shared<antlr4::BailErrorStrategy>();
+    auto defaultStrategy = std::make_shared<antlr4::DefaultErrorStrategy>();
+
+    // 遍历器直接从具体语法树产生抽象语法树
+    MiniCCSTVisitor visitor;
+
+    // 请注意这里必须先遍历全局变量后遍历函数。肯定可以确保全局变量先声明后使用的规则，但有些情况却不能检查出。
+    // 事实上可能函数A后全局变量B后函数C，这时在函数A中是不能使用变量B的，需要报语义错误，但目前的处理不会。
+    // 因此在进行语义检查时，可能追加检查行号和列号，如果函数的行号/列号在全局变量的行号/列号的前面则需要报语义错误
+    // TODO 请追加实现。
+    std::vector<ast_node *> varDeclNodes;
+    std::vector<ast_node *> funcDefNodes;
+
+    int itemCount = 0;
+    int fallbackCount = 0;
+    size_t syntaxErrors = 0;
+
+    // compileUnit: (funcDef | varDecl)* EOF
+    // 不调用compileUnit一次分析整个文件，而是逐个分析顶层的函数定义或变量声明。
+    // 每个顶层定义产生AST之后，通过reset释放其具体语法树，因此同一时刻只保留一个顶层定义的具体语法树
+    while (tokenStream.LA(1) != antlr4::Token::EOF) {
+
+        size_t start = tokenStream.index();
+
+        // 函数定义以void开始，或者第三个记号为左括号，其它的按变量声明分析
+        bool isFuncDef =
+            (tokenStream.LA(1) == MiniCParser::T_VOID) || (tokenStream.LA(3) == MiniCParser::T_L_PAREN);
+
+        // 释放上一个顶层定义的具体语法树，reset会把记号流回到开头，需要重新定位
+        parser.reset();
+        tokenStream.seek(start);
+
+        // 第一阶段：SLL预测，不做全上下文预测，对于绝大多数正确的程序与LL的分析结果相同但快得多
+        interpreter->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+        parser.setErrorHandler(bailStrategy);
+        parser.removeErrorListeners();
+
+        antlr4::ParserRuleContext * itemCtx = nullptr;
+
+        try {
+            itemCtx = isFuncDef ? (antlr4::ParserRuleContext *) parser.funcDef()
+                                : (antlr4::ParserRuleContext *) parser.varDecl();
+        } catch (antlr4::ParseCancellationException &) {
+
+            // 第二阶段：SLL失败时可能是真的语法错误，也可能是SLL的能力不够，
+            // 复用已经识别的记号，回退到LL预测并采用默认的错误恢复与报告重新分析本顶层定义
+            fallbackCount++;
+
+            parser.reset();
+            tokenStream.seek(start);
+
+            interpreter->setPredictionMode(antlr4::atn::PredictionMode::LL);
+            parser.setErrorHandler(defaultStrategy);
+            parser.addErrorListener(&antlr4::ConsoleErrorListener::INSTANCE);
+
+            itemCtx = isFuncDef ? (antlr4::ParserRuleContext *) parser.funcDef()
+                                : (antlr4::ParserRuleContext *) parser.varDecl();
+        }
+
+        itemCount++;
+
+        if (parser.getNumberOfSyntaxErrors() > 0) {
+
+            // 有语法错误的具体语法树不完整，不产生AST，继续分析后面的定义以便报告更多的错误
+            syntaxErrors += parser.getNumberOfSyntaxErrors();
+
+            // 错误恢复后没有消耗任何记号时，跳过一个记号，避免死循环
+            if (tokenStream.index() == start) {
+                tokenStream.consume();
+            }
+
+            continue;
+        }
+
+        if (isFuncDef) {
+            funcDefNodes.push_back(visitor.visitFuncDef((MiniCParser::FuncDefContext *) itemCtx));
+        } else {
+            varDeclNodes.push_back(visitor.visitVarDecl((MiniCParser::VarDeclContext *) itemCtx));
+        }
+    }
+
+    if (showPredictionStats) {
+        outputPredictionStats(parser, itemCount, fallbackCount);
+    }
+
+    // 最后一个顶层定义的具体语法树
+    parser.reset();
+
+    if (syntaxErrors > 0) {
+
+        for (auto node: varDeclNodes) {
+            ast_node::Delete(node);
+        }
+        for (auto node: funcDefNodes) {
+            ast_node::Delete(node);
+        }
+
         minic_log(LOG_ERROR, "Antlr4的词语与语法分析错误");
         return false;
     }
 
-    /// 新建遍历器对具体语法树进行分析，产生抽象语法树
-    MiniCCSTVisitor visitor;
+    // 创建编译单元节点，先加入全局变量后加入函数
+    astRoot = create_contain_node(ast_operator_type::AST_OP_COMPILE_UNIT);
 
-    // 遍历产生抽象语法树
-    astRoot = visitor.run(cstRoot);
+    for (auto node: varDeclNodes) {
+        (void) astRoot->insert_son_node(node);
+    }
+
+    for (auto node: funcDefNodes) {
+        (void) astRoot->insert_son_node(node);
+    }
 
     return true;
 }
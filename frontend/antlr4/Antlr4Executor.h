@@ -2,8 +2,8 @@
 /// @file Antlr4Executor.h
 /// @brief antlr4的词法与语法分析解析器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>SLL与LL两阶段分析
 /// </table>
 ///
 
@@ -26,4 +27,15 @@ public:
     /// @brief 前端词法与语法解析生成AST
     /// @return true: 成功 false：错误
     bool run() override;
+
+    /// @brief 设置是否在分析结束后输出预测(adaptive prediction)的统计信息
+    /// @param show true：输出，false：不输出
+    void setShowPredictionStats(bool show)
+    {
+        showPredictionStats = show;
+    }
+
+protected:
+    /// @brief 是否输出预测的统计信息
+    bool showPredictionStats = false;
 };
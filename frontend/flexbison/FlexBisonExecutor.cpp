@@ -2,8 +2,8 @@
 /// @file FlexBisonExecutor.cpp
 /// @brief Flex+Bison词语与语法分析执行器
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>每次分析前复位扫描器，支持批量编译
 /// </table>
 ///
 #include "FlexBisonExecutor.h"
@@ -28,6 +29,10 @@ bool FlexBisonExecutor::run()
         return false;
     }
 
+    // 批量编译时同一进程多次分析，需复位行号与扫描器的缓冲区
+    yylineno = 1;
+    yyrestart(yyin);
+
     // 如果要查看LALR的移进与归约过程，请设置yydebug为1
 #ifdef BISON_DEBUG_ENABLE
     yydebug = 1;
@@ -21,9 +21,8 @@
 /// @return true: 成功 false：错误
 bool RecursiveDescentExecutor::run()
 {
-    // 若指定有参数，则作为词法分析的输入文件
-    rd_filein = fopen(filename.c_str(), "r");
-    if (rd_filein == nullptr) {
+    // 若指定有参数，则作为词法分析的输入文件，优先mmap映射
+    if (!rd_flex_open(filename)) {
         printf("Can't open file %s\n", filename.c_str());
         return false;
     }
@@ -36,13 +35,13 @@ bool RecursiveDescentExecutor::run()
     if (!astRoot) {
 
         // 关闭文件
-        fclose(rd_filein);
+        rd_flex_close();
 
         return false;
     }
 
     // 关闭文件
-    fclose(rd_filein);
+    rd_flex_close();
 
     return true;
 }
\ No newline at end of file
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentFlex.cpp
 /// @brief 词法分析的手动实现源文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,175 +12,246 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>支持注释，空白符与注释采用向量化扫描
 /// </table>
 ///
-#include <cctype>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <array>
 #include <string>
+#include <string_view>
 
+#include "RecursiveDescentFlex.h"
 #include "RecursiveDescentParser.h"
+#include "MappedFile.h"
+#include "CharScanner.h"
 #include "Common.h"
 
 /// @brief 词法分析的行号信息
 int64_t rd_line_no = 1;
 
-/// @brief 词法分析的token对应的字符识别
-std::string tokenValue;
+/// @brief 词法分析的token对应的字符识别，直接指向源文件的映射区，不做复制
+std::string_view tokenValue;
 
-/// @brief 输入源文件指针
-FILE * rd_filein;
+/// @brief 输入源文件的只读映射
+static MappedFile rd_source;
+
+/// @brief 当前扫描位置
+static const char * rd_cursor = nullptr;
+
+/// @brief 扫描的结束位置
+static const char * rd_limit = nullptr;
 
 /// @brief 关键字与Token类别的数据结构
 struct KeywordToken {
-    std::string name;
+    std::string_view name;
     enum RDTokenType type;
 };
 
 /// @brief  关键字与Token对应表
-static KeywordToken allKeywords[] = {
+static constexpr KeywordToken allKeywords[] = {
     {"int", RDTokenType::T_INT},
     {"return", RDTokenType::T_RETURN},
 };
 
+/// @brief 关键字完美散列表的槽位个数，必须是2的幂次
+#define RD_KEYWORD_SLOT_NUM 8
+
+/// @brief 关键字的散列函数，由长度与首字符决定，要求对所有关键字无冲突
+/// @param id 标识符，不能为空串
+/// @return 槽位
+static constexpr size_t keywordHash(std::string_view id)
+{
+    return (id.size() + (unsigned char) id[0]) & (RD_KEYWORD_SLOT_NUM - 1);
+}
+
+/// @brief 构建关键字完美散列表，槽位保存关键字在allKeywords中的下标，-1为空
+/// @return 散列表
+static constexpr std::array<int8_t, RD_KEYWORD_SLOT_NUM> buildKeywordSlots()
+{
+    std::array<int8_t, RD_KEYWORD_SLOT_NUM> slots{};
+    for (auto & slot: slots) {
+        slot = -1;
+    }
+    for (size_t k = 0; k < sizeof(allKeywords) / sizeof(allKeywords[0]); ++k) {
+        slots[keywordHash(allKeywords[k].name)] = (int8_t) k;
+    }
+    return slots;
+}
+
+/// @brief 检查关键字在散列函数下是否无冲突
+/// @return true：无冲突，false：存在冲突
+static constexpr bool keywordHashIsPerfect()
+{
+    auto slots = buildKeywordSlots();
+    size_t used = 0;
+    for (auto slot: slots) {
+        used += (slot != -1);
+    }
+    return used == sizeof(allKeywords) / sizeof(allKeywords[0]);
+}
+
+// 新增关键字后若冲突，请调整keywordHash或者增大RD_KEYWORD_SLOT_NUM
+static_assert(keywordHashIsPerfect(), "keyword hash collision");
+
+/// @brief 关键字完美散列表
+static constexpr std::array<int8_t, RD_KEYWORD_SLOT_NUM> keywordSlots = buildKeywordSlots();
+
 /// @brief 在标识符中检查是否时关键字，若是关键字则返回对应关键字的Token，否则返回T_ID
 /// @param id 标识符
 /// @return Token
-static RDTokenType getKeywordToken(std::string id)
+static RDTokenType getKeywordToken(std::string_view id)
 {
-    //如果在allkeywords中找到，则说明为关键字
-    for (auto & keyword: allKeywords) {
-        if (keyword.name == id) {
-            return keyword.type;
-        }
+    // 一次散列，一次比较
+    int8_t index = keywordSlots[keywordHash(id)];
+    if ((index != -1) && (allKeywords[index].name == id)) {
+        return allKeywords[index].type;
     }
+
     // 如果不再allkeywords中，说明是标识符
     return RDTokenType::T_ID;
 }
 
+/// @brief 打开源文件供词法分析使用，优先采用mmap映射
+/// @param filename 源文件路径
+/// @return true：成功，false：失败
+bool rd_flex_open(const std::string & filename)
+{
+    if (!rd_source.open(filename)) {
+        return false;
+    }
+
+    rd_cursor = rd_source.data();
+    rd_limit = rd_cursor + rd_source.size();
+    rd_line_no = 1;
+    tokenValue = {};
+
+    return true;
+}
+
+/// @brief 关闭源文件，之后tokenValue不再有效
+void rd_flex_close()
+{
+    rd_source.close();
+
+    rd_cursor = rd_limit = nullptr;
+    tokenValue = {};
+}
+
 /// @brief 词法文法，获取下一个Token
 /// @return  Token，值保存在rd_lval中
 int rd_flex()
 {
-    int c;              // 扫描的字符
+    const char * p = rd_cursor;
+    const char * end = rd_limit;
     int tokenKind = -1; // Token的值
 
-    // 忽略空白符号，主要有空格，TAB键和换行符
-    while ((c = fgetc(rd_filein)) == ' ' || c == '\t' || c == '\n' || c == '\r') {
-
-        // 支持Linux/Windows/Mac系统的行号分析
-        // Windows：\r\n
-        // Mac: \n
-        // Unix(Linux): \r
-        if (c == '\r') {
-            c = fgetc(rd_filein);
-            rd_line_no++;
-            if (c != '\n') {
-                // 不是\n，则回退
-                ungetc(c, rd_filein);
+    // 忽略空白符号与注释，空白符主要有空格，TAB键和换行符
+    // 支持Linux/Windows/Mac系统的行号分析
+    // Windows：\r\n
+    // Mac: \r
+    // Unix(Linux): \n
+    // 空白符与注释内容的扫描采用向量化的批量扫描，行号按跳过的换行数累加
+    for (;;) {
+        p = scan_skip_blank(p, end, rd_line_no);
+
+        if ((p + 1 >= end) || (p[0] != '/')) {
+            break;
+        }
+
+        if (p[1] == '/') {
+            // 单行注释，跳到换行符，换行符留给下一轮的空白符处理
+            p = scan_find_newline(p + 2, end);
+        } else if (p[1] == '*') {
+            // 多行注释
+            const char * commentEnd = scan_find_comment_end(p + 2, end, rd_line_no);
+            if (!commentEnd) {
+                printf("Line(%lld): Unterminated comment\n", (long long) rd_line_no);
+                rd_cursor = end;
+                tokenValue = {};
+                return RDTokenType::T_ERR;
             }
-        } else if (c == '\n') {
-            rd_line_no++;
+            p = commentEnd;
+        } else {
+            break;
         }
     }
 
     // 文件结束符
-    if (c == EOF) {
+    if (p >= end) {
+        rd_cursor = p;
+        tokenValue = {};
+
         // 返回文件结束符
         return RDTokenType::T_EOF;
     }
 
-    // TODO 请自行实现删除源文件中的注释，含单行注释和多行注释等
+    const char * start = p;
+    char c = *p++;
 
     // 处理数字
-    if (isdigit(c)) {
+    if (isDigital(c)) {
 
         // 识别无符号数，这里只处理正整数或者0
         // FIXME 0开头的整数这里也识别成了10进制整数，在C语言中0开头的数字串是8进制数字
 
-        rd_lval.integer_num.lineno = rd_line_no;
-        rd_lval.integer_num.val = c - '0';
+        uint32_t val = c - '0';
 
         // 最长匹配，直到非数字结束
-        while (isdigit(c = fgetc(rd_filein))) {
-            rd_lval.integer_num.val = rd_lval.integer_num.val * 10 + c - '0';
+        for (const char * digitEnd = scan_digit_end(p, end); p < digitEnd; ++p) {
+            val = val * 10 + (*p - '0');
         }
 
-        // 存储数字的token值
-        tokenValue = std::to_string(rd_lval.integer_num.val);
-
-        // 多读的字符回退
-        ungetc(c, rd_filein);
+        rd_lval.integer_num.lineno = rd_line_no;
+        rd_lval.integer_num.val = val;
 
         tokenKind = RDTokenType::T_DIGIT;
     } else if (c == '(') {
         // 识别字符(
         tokenKind = RDTokenType::T_L_PAREN;
-        // 存储字符(
-        tokenValue = "(";
     } else if (c == ')') {
         // 识别字符)
         tokenKind = RDTokenType::T_R_PAREN;
-        // 存储字符)
-        tokenValue = ")";
     } else if (c == '{') {
         // 识别字符{
         tokenKind = RDTokenType::T_L_BRACE;
-        // 存储字符{
-        tokenValue = "{";
     } else if (c == '}') {
         // 识别字符}
         tokenKind = RDTokenType::T_R_BRACE;
-        // 存储字符}
-        tokenValue = "}";
     } else if (c == ';') {
         // 识别字符;
         tokenKind = RDTokenType::T_SEMICOLON;
-        // 存储字符;
-        tokenValue = ";";
     } else if (c == '+') {
         // 识别字符+
         tokenKind = RDTokenType::T_ADD;
-		// 存储字符+
-        tokenValue = "+";
     } else if (c == '-') {
         // 识别字符-
         tokenKind = RDTokenType::T_SUB;
-		// 存储字符-
-        tokenValue = "-";
     } else if (c == '=') {
         // 识别字符=
         tokenKind = RDTokenType::T_ASSIGN;
-    }  else if (c == ',') {
-        // 识别字符;
+    } else if (c == ',') {
+        // 识别字符,
         tokenKind = RDTokenType::T_COMMA;
-		// 存储字符,
-        tokenValue = ",";
     } else if (isLetterUnderLine(c)) {
         // 识别标识符，包含关键字/保留字或自定义标识符
 
         // 最长匹配标识符
-        std::string name;
-
-        do {
-            // 记录字符
-            name.push_back(c);
-            c = fgetc(rd_filein);
-        } while (isLetterDigitalUnderLine(c));
-
-        // 存储标识符
-        tokenValue = name;
+        p = scan_ident_end(p, end);
 
-        // 多读的字符恢复，下次可继续读到该字符
-        ungetc(c, rd_filein);
+        std::string_view name(start, p - start);
 
         // 检查是否是关键字，若是则返回对应的Token，否则返回T_ID
         tokenKind = getKeywordToken(name);
         if (tokenKind == RDTokenType::T_ID) {
             // 自定义标识符
 
-            // 设置ID的值
-            rd_lval.var_id.id = strdup(name.c_str());
+            // 设置ID的值，AST节点创建后会通过free释放
+            char * id = (char *) malloc(name.size() + 1);
+            memcpy(id, name.data(), name.size());
+            id[name.size()] = '\0';
+            rd_lval.var_id.id = id;
 
             // 设置行号
             rd_lval.var_id.lineno = rd_line_no;
@@ -192,10 +263,15 @@ int rd_flex()
             rd_lval.type.lineno = rd_line_no;
         }
     } else {
-        printf("Line(%lld): Invalid char %s\n", (long long) rd_line_no, tokenValue.c_str());
+        printf("Line(%lld): Invalid char %c\n", (long long) rd_line_no, c);
         tokenKind = RDTokenType::T_ERR;
     }
 
+    // 存储Token的原始文本，指向映射区
+    tokenValue = std::string_view(start, p - start);
+
+    rd_cursor = p;
+
     // Token的类别
     return tokenKind;
 }
@@ -15,13 +15,21 @@
 ///
 #pragma once
 
-#include <stdio.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
 
 // 行号信息
-extern int rd_line_no;
+extern int64_t rd_line_no;
 
-// 输入文件指针
-extern FILE * rd_filein;
+// 当前Token的原始文本，指向源文件的映射区，源文件关闭后失效
+extern std::string_view tokenValue;
+
+/// 打开源文件，优先采用mmap映射，失败时读入缓冲区
+bool rd_flex_open(const std::string & filename);
+
+/// 关闭源文件
+void rd_flex_close();
 
 /// 识别词法
 int rd_flex();
@@ -2,8 +2,8 @@
 /// @file RecursiveDescentParser.cpp
 /// @brief 递归下降分析法实现的语法分析后产生抽象语法树的实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>修正无实参的函数调用
 /// </table>
 ///
 #include <stdarg.h>
@@ -24,9 +25,6 @@
 // 定义全局变量给词法分析使用，用于填充值
 RDSType rd_lval;
 
-// 词法识别的记号值，原始文本字符串
-extern std::string tokenValue;
-
 // 语法分析过程中的错误数目
 static int errno_num = 0;
 
@@ -91,7 +89,7 @@ static void semerror(const char * format, ...)
 
     va_end(ap);
 
-    printf("Line(%d): %s\n", rd_line_no, logStr);
+    printf("Line(%lld): %s\n", (long long) rd_line_no, logStr);
 
     errno_num++;
 }
@@ -154,8 +152,8 @@ static ast_node * idTail(var_id_attr & id)
 
         if (match(T_R_PAREN)) {
 
-            // 被调用函数没有实参，返回一个空的实参清单节点
-            return realParamsNode;
+            // 被调用函数没有实参，实参清单节点为空
+            return create_func_call(node, realParamsNode);
         }
 
         // 识别实参列表
@@ -0,0 +1,165 @@
+///
+/// @file BlockLayout.cpp
+/// @brief 根据剖析数据调整函数内基本块的次序
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <unordered_map>
+#include <vector>
+
+#include "BlockLayout.h"
+#include "BranchInstruction.h"
+#include "GotoInstruction.h"
+
+///
+/// @brief 构造函数
+/// @param _func 函数，函数体必须已加载
+///
+BlockLayout::BlockLayout(Function * _func) : func(_func)
+{}
+
+///
+/// @brief 调整基本块的次序
+///
+void BlockLayout::run()
+{
+    if (func->isBuiltin() || (func->getHotness() == FunctionHotness::UNKNOWN)) {
+        return;
+    }
+
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+
+    // 基本块：指令区间[begin, end)，以Label指令开始，第一个基本块之前的指令归入第一个基本块
+    struct Block {
+        size_t begin;
+        size_t end;
+        Instruction * terminator;
+    };
+    std::vector<Block> blocks;
+    std::unordered_map<Instruction *, int32_t> blockOfLabel;
+
+    for (size_t k = 0; k < insts.size(); k++) {
+        Instruction * inst = insts[k];
+        if (inst->isDead()) {
+            continue;
+        }
+        if ((inst->getOp() == IRInstOperator::IRINST_OP_LABEL) && (k > 0)) {
+            if (blocks.empty()) {
+                blocks.push_back({0, k, nullptr});
+            } else {
+                blocks.back().end = k;
+            }
+            blockOfLabel[inst] = (int32_t) blocks.size();
+            blocks.push_back({k, insts.size(), nullptr});
+        } else if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            blockOfLabel[inst] = 0;
+            blocks.push_back({0, insts.size(), nullptr});
+        }
+    }
+
+    if (blocks.size() < 3) {
+        return;
+    }
+
+    // 基本块的最后一条有效指令，是跳转或出口指令时为终结指令，否则顺序执行到下一基本块
+    int32_t exitBlock = -1;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        for (size_t k = blocks[b].end; k > blocks[b].begin; k--) {
+            Instruction * inst = insts[k - 1];
+            if (inst->isDead()) {
+                continue;
+            }
+            IRInstOperator op = inst->getOp();
+            if ((op == IRInstOperator::IRINST_OP_GOTO) || (op == IRInstOperator::IRINST_OP_BRANCH) ||
+                (op == IRInstOperator::IRINST_OP_EXIT)) {
+                blocks[b].terminator = inst;
+            }
+            if (op == IRInstOperator::IRINST_OP_EXIT) {
+                exitBlock = (int32_t) b;
+            }
+            break;
+        }
+    }
+
+    std::vector<bool> placed(blocks.size(), false);
+    std::vector<int32_t> order;
+    order.reserve(blocks.size());
+
+    // 未放置的、非出口的基本块才能作为后继紧跟其后
+    auto candidate = [&](Instruction * label) -> int32_t {
+        auto iter = blockOfLabel.find(label);
+        if ((iter == blockOfLabel.end()) || placed[iter->second] || (iter->second == exitBlock)) {
+            return -1;
+        }
+        return iter->second;
+    };
+
+    int32_t cur = 0;
+    placed[0] = true;
+    order.push_back(0);
+
+    while (order.size() < blocks.size()) {
+
+        int32_t next = -1;
+        Instruction * term = blocks[cur].terminator;
+
+        if (term == nullptr) {
+            if ((cur + 1 < (int32_t) blocks.size()) && !placed[cur + 1] && (cur + 1 != exitBlock)) {
+                next = cur + 1;
+            }
+        } else if (term->getOp() == IRInstOperator::IRINST_OP_GOTO) {
+            next = candidate(static_cast<GotoInstruction *>(term)->getTarget());
+        } else if (term->getOp() == IRInstOperator::IRINST_OP_BRANCH) {
+            auto branchInst = static_cast<BranchInstruction *>(term);
+            bool preferTrue = branchInst->getTrueProbability() >= 0.5;
+            next = candidate(preferTrue ? branchInst->getTarget1() : branchInst->getTarget2());
+            if (next < 0) {
+                next = candidate(preferTrue ? branchInst->getTarget2() : branchInst->getTarget1());
+            }
+        }
+
+        // 没有合适的后继，则取原次序中第一个未放置的基本块，出口基本块最后放置
+        if (next < 0) {
+            for (int32_t b = 0; b < (int32_t) blocks.size(); b++) {
+                if (!placed[b] && (b != exitBlock)) {
+                    next = b;
+                    break;
+                }
+            }
+            if (next < 0) {
+                next = exitBlock;
+            }
+        }
+
+        placed[next] = true;
+        order.push_back(next);
+        cur = next;
+    }
+
+    std::vector<Instruction *> newInsts;
+    newInsts.reserve(insts.size() + blocks.size());
+
+    for (size_t k = 0; k < order.size(); k++) {
+
+        const Block & block = blocks[order[k]];
+        newInsts.insert(newInsts.end(), insts.begin() + (std::ptrdiff_t) block.begin, insts.begin() + (std::ptrdiff_t) block.end);
+
+        // 原来顺序执行到的下一基本块不再紧跟其后时，补一条无条件跳转
+        int32_t fallthrough = order[k] + 1;
+        if ((block.terminator == nullptr) && (fallthrough < (int32_t) blocks.size()) &&
+            ((k + 1 == order.size()) || (order[k + 1] != fallthrough))) {
+            newInsts.push_back(new GotoInstruction(func, insts[blocks[fallthrough].begin]));
+        }
+    }
+
+    insts.swap(newInsts);
+}
@@ -0,0 +1,44 @@
+///
+/// @file BlockLayout.h
+/// @brief 根据剖析数据调整函数内基本块的次序
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include "Function.h"
+
+///
+/// @brief 基本块布局
+///
+/// 从入口基本块开始贪心地排列：分支指令的概率大的目标、无条件跳转的目标紧跟其后，
+/// 使热路径上的跳转变为顺序执行，出口基本块保持在最后。原来顺序执行到下一基本块的，
+/// 若下一基本块不再紧跟其后则补一条无条件跳转。没有剖析数据的函数不调整。
+///
+class BlockLayout {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 函数，函数体必须已加载
+    ///
+    explicit BlockLayout(Function * _func);
+
+    ///
+    /// @brief 调整基本块的次序
+    ///
+    void run();
+
+private:
+    /// @brief 函数
+    Function * func;
+};
@@ -0,0 +1,244 @@
+///
+/// @file ControlFlowGraph.cpp
+/// @brief 函数的控制流图
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加基本块的循环嵌套深度
+/// </table>
+///
+#include <algorithm>
+#include <unordered_map>
+
+#include "BranchInstruction.h"
+#include "ControlFlowGraph.h"
+#include "GotoInstruction.h"
+
+///
+/// @brief 构造函数，建立控制流图
+/// @param func 函数，函数体必须已加载
+///
+ControlFlowGraph::ControlFlowGraph(Function * _func) : func(_func)
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+
+    // Label指令-基本块
+    std::unordered_map<Instruction *, int32_t> blockOfLabel;
+
+    // 上一条有效指令是否结束了基本块
+    bool ended = true;
+
+    // 当前基本块是否已有Label之外的有效指令，没有时紧随的Label并入该块
+    bool blockHasInst = false;
+
+    for (size_t k = 0; k < insts.size(); k++) {
+
+        Instruction * inst = insts[k];
+        IRInstOperator op = inst->getOp();
+
+        if (inst->isDead()) {
+            if (!blocks.empty()) {
+                blocks.back().end = k + 1;
+            }
+            continue;
+        }
+
+        // Label指令开始新的基本块，连续的Label属于同一个基本块
+        bool startBlock = ended || ((op == IRInstOperator::IRINST_OP_LABEL) && blockHasInst);
+
+        if (startBlock) {
+            BasicBlock block;
+            block.index = (int32_t) blocks.size();
+            block.begin = k;
+            blocks.push_back(block);
+            blockHasInst = false;
+        }
+
+        if (op == IRInstOperator::IRINST_OP_LABEL) {
+            blockOfLabel[inst] = (int32_t) blocks.size() - 1;
+        } else {
+            blockHasInst = true;
+        }
+
+        blocks.back().end = k + 1;
+
+        ended = (op == IRInstOperator::IRINST_OP_GOTO) || (op == IRInstOperator::IRINST_OP_BRANCH) ||
+                (op == IRInstOperator::IRINST_OP_EXIT);
+    }
+
+    // 按最后一条有效指令确定后继
+    for (size_t b = 0; b < blocks.size(); b++) {
+
+        BasicBlock & block = blocks[b];
+
+        Instruction * last = nullptr;
+        for (size_t k = block.end; k > block.begin; k--) {
+            if (!insts[k - 1]->isDead()) {
+                last = insts[k - 1];
+                break;
+            }
+        }
+
+        IRInstOperator op = last ? last->getOp() : IRInstOperator::IRINST_OP_MAX;
+
+        if (op == IRInstOperator::IRINST_OP_GOTO) {
+            block.succs.push_back(blockOfLabel[static_cast<GotoInstruction *>(last)->getTarget()]);
+        } else if (op == IRInstOperator::IRINST_OP_BRANCH) {
+            auto branch = static_cast<BranchInstruction *>(last);
+            block.succs.push_back(blockOfLabel[branch->getTarget1()]);
+            block.succs.push_back(blockOfLabel[branch->getTarget2()]);
+        } else if ((op != IRInstOperator::IRINST_OP_EXIT) && ((b + 1) < blocks.size())) {
+            block.succs.push_back((int32_t) b + 1);
+        }
+    }
+
+    for (auto & block: blocks) {
+        for (int32_t succ: block.succs) {
+            std::vector<int32_t> & preds = blocks[succ].preds;
+            if (std::find(preds.begin(), preds.end(), block.index) == preds.end()) {
+                preds.push_back(block.index);
+            }
+        }
+    }
+
+    if (blocks.empty()) {
+        return;
+    }
+
+    // 逆后序，非递归的深度优先遍历
+    std::vector<bool> visited(blocks.size(), false);
+    std::vector<std::pair<int32_t, size_t>> stack;
+    stack.emplace_back(0, 0);
+    visited[0] = true;
+
+    while (!stack.empty()) {
+        auto & top = stack.back();
+        const BasicBlock & block = blocks[top.first];
+        if (top.second < block.succs.size()) {
+            int32_t succ = block.succs[top.second++];
+            if (!visited[succ]) {
+                visited[succ] = true;
+                stack.emplace_back(succ, 0);
+            }
+        } else {
+            rpo.push_back(top.first);
+            stack.pop_back();
+        }
+    }
+
+    std::reverse(rpo.begin(), rpo.end());
+    reachable = rpo.size();
+
+    for (size_t b = 0; b < blocks.size(); b++) {
+        if (!visited[b]) {
+            rpo.push_back((int32_t) b);
+        }
+    }
+}
+
+///
+/// @brief 计算各基本块的循环嵌套深度，回边的目标支配源时为自然循环，同一循环头的回边合并为一个循环
+/// @return std::vector<int32_t> 按基本块编号的深度，不在循环中或者不可达时为0
+///
+std::vector<int32_t> ControlFlowGraph::computeLoopDepths() const
+{
+    std::vector<int32_t> depths(blocks.size(), 0);
+    if (reachable == 0) {
+        return depths;
+    }
+
+    // 逆后序中的位置，不可达的块为-1
+    std::vector<int32_t> order(blocks.size(), -1);
+    for (size_t k = 0; k < reachable; k++) {
+        order[rpo[k]] = (int32_t) k;
+    }
+
+    // Cooper-Harvey-Kennedy的迭代算法求直接支配者
+    std::vector<int32_t> idom(blocks.size(), -1);
+    idom[rpo[0]] = rpo[0];
+
+    auto intersect = [&](int32_t a, int32_t b) {
+        while (a != b) {
+            while (order[a] > order[b]) {
+                a = idom[a];
+            }
+            while (order[b] > order[a]) {
+                b = idom[b];
+            }
+        }
+        return a;
+    };
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t k = 1; k < reachable; k++) {
+            int32_t b = rpo[k];
+            int32_t newIdom = -1;
+            for (int32_t pred: blocks[b].preds) {
+                if (idom[pred] == -1) {
+                    continue;
+                }
+                newIdom = (newIdom == -1) ? pred : intersect(pred, newIdom);
+            }
+            if (idom[b] != newIdom) {
+                idom[b] = newIdom;
+                changed = true;
+            }
+        }
+    }
+
+    auto dominates = [&](int32_t a, int32_t b) {
+        while (b != a) {
+            if (b == rpo[0]) {
+                return false;
+            }
+            b = idom[b];
+        }
+        return true;
+    };
+
+    // 循环体由回边的源逆向搜索到循环头为止，循环体内的基本块深度加一
+    std::vector<int32_t> mark(blocks.size(), -1);
+    for (size_t k = 0; k < reachable; k++) {
+
+        int32_t header = rpo[k];
+
+        std::vector<int32_t> work;
+        for (int32_t pred: blocks[header].preds) {
+            if ((order[pred] != -1) && dominates(header, pred)) {
+                work.push_back(pred);
+            }
+        }
+
+        if (work.empty()) {
+            continue;
+        }
+
+        mark[header] = header;
+        depths[header]++;
+
+        while (!work.empty()) {
+            int32_t b = work.back();
+            work.pop_back();
+            if (mark[b] == header) {
+                continue;
+            }
+            mark[b] = header;
+            depths[b]++;
+            for (int32_t pred: blocks[b].preds) {
+                if ((order[pred] != -1) && (mark[pred] != header)) {
+                    work.push_back(pred);
+                }
+            }
+        }
+    }
+
+    return depths;
+}
@@ -0,0 +1,104 @@
+///
+/// @file ControlFlowGraph.h
+/// @brief 函数的控制流图
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加基本块的循环嵌套深度
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Function.h"
+
+///
+/// @brief 基本块
+///
+struct BasicBlock {
+    /// @brief 编号，即在控制流图中的下标
+    int32_t index = 0;
+
+    /// @brief 第一条指令在函数指令列表中的下标
+    size_t begin = 0;
+
+    /// @brief 最后一条指令之后的下标
+    size_t end = 0;
+
+    /// @brief 后继基本块，分支指令时依次为目标1与目标2
+    std::vector<int32_t> succs;
+
+    /// @brief 前驱基本块，不重复
+    std::vector<int32_t> preds;
+};
+
+///
+/// @brief 函数的控制流图
+///
+/// 基本块以Label指令开始，以goto、bc、exit指令结束，第一个Label之前的指令属于入口基本块。
+/// 只根据指令列表建立，指令列表改变后需要重新建立。死指令不影响划分，但仍在基本块的区间内。
+///
+class ControlFlowGraph {
+
+public:
+    ///
+    /// @brief 构造函数，建立控制流图
+    /// @param func 函数，函数体必须已加载
+    ///
+    explicit ControlFlowGraph(Function * func);
+
+    ///
+    /// @brief 获取基本块，第一个为入口
+    /// @return std::vector<BasicBlock>& 基本块
+    ///
+    [[nodiscard]] const std::vector<BasicBlock> & getBlocks() const
+    {
+        return blocks;
+    }
+
+    ///
+    /// @brief 获取逆后序，从入口不可达的基本块按原来的次序排在最后
+    /// @return std::vector<int32_t>& 基本块的编号
+    ///
+    [[nodiscard]] const std::vector<int32_t> & getRPO() const
+    {
+        return rpo;
+    }
+
+    ///
+    /// @brief 计算各基本块的循环嵌套深度，回边的目标支配源时为自然循环，同一循环头的回边合并为一个循环
+    /// @return std::vector<int32_t> 按基本块编号的深度，不在循环中或者不可达时为0
+    ///
+    [[nodiscard]] std::vector<int32_t> computeLoopDepths() const;
+
+    ///
+    /// @brief 获取函数
+    /// @return Function* 函数
+    ///
+    [[nodiscard]] Function * getFunction() const
+    {
+        return func;
+    }
+
+private:
+    /// @brief 函数
+    Function * func;
+
+    /// @brief 基本块
+    std::vector<BasicBlock> blocks;
+
+    /// @brief 逆后序
+    std::vector<int32_t> rpo;
+
+    /// @brief 从入口可达的基本块个数，即逆后序中可达部分的长度
+    size_t reachable = 0;
+};
@@ -0,0 +1,140 @@
+///
+/// @file DataFlow.cpp
+/// @brief 基于位向量的迭代数据流分析框架
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "DataFlow.h"
+
+///
+/// @brief 构造函数，gen与kill初始为空集
+/// @param _cfg 控制流图
+/// @param _bits 位向量的位数
+/// @param _direction 方向
+/// @param _meet 交汇运算
+///
+BitVectorDataFlow::BitVectorDataFlow(const ControlFlowGraph & _cfg, size_t _bits, Direction _direction, Meet _meet)
+    : cfg(_cfg), bits(_bits), direction(_direction), meet(_meet), boundary(_bits)
+{
+    size_t count = cfg.getBlocks().size();
+    gen.assign(count, DynBitSet(bits));
+    kill.assign(count, DynBitSet(bits));
+    in.assign(count, DynBitSet(bits));
+    out.assign(count, DynBitSet(bits));
+}
+
+///
+/// @brief 设置边界值，前向问题为入口块的in，后向问题为没有后继的基本块的out，默认为空集
+/// @param value 边界值
+///
+void BitVectorDataFlow::setBoundary(const DynBitSet & value)
+{
+    boundary = value;
+}
+
+///
+/// @brief 求解
+/// @return int64_t 传递函数的计算次数
+///
+int64_t BitVectorDataFlow::solve()
+{
+    const std::vector<BasicBlock> & blocks = cfg.getBlocks();
+    if (blocks.empty()) {
+        return 0;
+    }
+
+    const bool forward = direction == Direction::FORWARD;
+
+    // 统一按前向问题处理：后向问题中in与out对调，前驱与后继对调
+    std::vector<DynBitSet> & before = forward ? in : out;
+    std::vector<DynBitSet> & after = forward ? out : in;
+
+    // 处理次序，后向问题为逆后序的反序
+    std::vector<int32_t> order = cfg.getRPO();
+    if (!forward) {
+        std::vector<int32_t>(order.rbegin(), order.rend()).swap(order);
+    }
+
+    // 基本块在处理次序中的位置
+    std::vector<int32_t> position(blocks.size());
+    for (size_t k = 0; k < order.size(); k++) {
+        position[order[k]] = (int32_t) k;
+    }
+
+    // 交集问题的初值为全集
+    if (meet == Meet::INTERSECTION) {
+        for (DynBitSet & value: after) {
+            value.setAll();
+        }
+    }
+
+    // 工作表按处理次序的位置标记，每一轮从前往后扫描，一轮中新加入的位置靠前的块在下一轮处理
+    std::vector<bool> pending(blocks.size(), true);
+    size_t pendingCount = blocks.size();
+    int64_t evaluations = 0;
+
+    while (pendingCount) {
+        for (size_t k = 0; k < order.size(); k++) {
+
+            if (!pending[k]) {
+                continue;
+            }
+            pending[k] = false;
+            pendingCount--;
+
+            const int32_t b = order[k];
+            const BasicBlock & block = blocks[b];
+            const std::vector<int32_t> & sources = forward ? block.preds : block.succs;
+            const std::vector<int32_t> & targets = forward ? block.succs : block.preds;
+
+            // 交汇，前向问题的入口块与后向问题的出口块取边界值
+            DynBitSet & value = before[b];
+            if ((forward && (b == 0)) || (!forward && sources.empty())) {
+                value = boundary;
+                if (forward) {
+                    for (int32_t src: sources) {
+                        if (meet == Meet::UNION) {
+                            value |= after[src];
+                        } else {
+                            value &= after[src];
+                        }
+                    }
+                }
+            } else if (sources.empty()) {
+                value.clear();
+            } else {
+                value = after[sources[0]];
+                for (size_t s = 1; s < sources.size(); s++) {
+                    if (meet == Meet::UNION) {
+                        value |= after[sources[s]];
+                    } else {
+                        value &= after[sources[s]];
+                    }
+                }
+            }
+
+            evaluations++;
+
+            if (after[b].assignTransfer(gen[b], value, kill[b])) {
+                for (int32_t target: targets) {
+                    size_t pos = (size_t) position[target];
+                    if (!pending[pos]) {
+                        pending[pos] = true;
+                        pendingCount++;
+                    }
+                }
+            }
+        }
+    }
+
+    return evaluations;
+}
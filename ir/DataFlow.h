@@ -0,0 +1,100 @@
+///
+/// @file DataFlow.h
+/// @brief 基于位向量的迭代数据流分析框架
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "DynBitSet.h"
+
+///
+/// @brief 基于位向量的数据流问题的求解器
+///
+/// 每个基本块的传递函数为 out = gen | (in - kill)，由使用者填写gen与kill。
+/// 前向问题的in为前驱out的交汇，后向问题的in、out含义对调，即out为后继in的交汇、in由out经传递函数得到。
+/// 求解用工作表：前向按逆后序、后向按逆后序的反序依次取出，基本块的结果变化时其后继（后向为前驱）重新入表。
+///
+class BitVectorDataFlow {
+
+public:
+    /// @brief 数据流的方向
+    enum class Direction {
+        /// @brief 前向，如到达定值
+        FORWARD,
+
+        /// @brief 后向，如活跃变量
+        BACKWARD,
+    };
+
+    /// @brief 交汇运算
+    enum class Meet {
+        /// @brief 并集，可能性问题
+        UNION,
+
+        /// @brief 交集，必然性问题
+        INTERSECTION,
+    };
+
+    ///
+    /// @brief 构造函数，gen与kill初始为空集
+    /// @param _cfg 控制流图
+    /// @param _bits 位向量的位数
+    /// @param _direction 方向
+    /// @param _meet 交汇运算
+    ///
+    BitVectorDataFlow(const ControlFlowGraph & _cfg, size_t _bits, Direction _direction, Meet _meet);
+
+    ///
+    /// @brief 设置边界值，前向问题为入口块的in，后向问题为没有后继的基本块的out，默认为空集
+    /// @param value 边界值
+    ///
+    void setBoundary(const DynBitSet & value);
+
+    ///
+    /// @brief 求解
+    /// @return int64_t 传递函数的计算次数
+    ///
+    int64_t solve();
+
+    /// @brief 各基本块的gen集合，按基本块编号
+    std::vector<DynBitSet> gen;
+
+    /// @brief 各基本块的kill集合，按基本块编号
+    std::vector<DynBitSet> kill;
+
+    /// @brief 各基本块入口处的值，按基本块编号
+    std::vector<DynBitSet> in;
+
+    /// @brief 各基本块出口处的值，按基本块编号
+    std::vector<DynBitSet> out;
+
+private:
+    /// @brief 控制流图
+    const ControlFlowGraph & cfg;
+
+    /// @brief 位数
+    size_t bits;
+
+    /// @brief 方向
+    Direction direction;
+
+    /// @brief 交汇运算
+    Meet meet;
+
+    /// @brief 边界值
+    DynBitSet boundary;
+};
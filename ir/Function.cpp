@@ -2,8 +2,8 @@
 /// @file Function.cpp
 /// @brief 函数实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>清理内存变量，支持批量编译时的资源回收
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>增加剖析得到的进入次数与热度
 /// </table>
 ///
 
@@ -297,6 +299,20 @@ void Function::Delete()
     }
 
     varsVector.clear();
+
+    // 清理后端创建的内存变量
+    for (auto & var: memVector) {
+        delete var;
+    }
+
+    memVector.clear();
+
+    // 清理形参
+    for (auto & param: params) {
+        delete param;
+    }
+
+    params.clear();
 }
 
 ///
@@ -357,3 +373,32 @@ void Function::realArgCountReset()
 {
     this->realArgCount = 0;
 }
+
+///
+/// @brief 设置剖析得到的函数进入次数与热度
+/// @param count 进入次数
+/// @param _hotness 热度
+///
+void Function::setProfile(uint64_t count, FunctionHotness _hotness)
+{
+    entryCount = count;
+    hotness = _hotness;
+}
+
+///
+/// @brief 获取剖析得到的函数进入次数，没有剖析数据时为0
+/// @return uint64_t 进入次数
+///
+uint64_t Function::getEntryCount()
+{
+    return entryCount;
+}
+
+///
+/// @brief 获取剖析得到的函数热度
+/// @return FunctionHotness 热度
+///
+FunctionHotness Function::getHotness()
+{
+    return hotness;
+}
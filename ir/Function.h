@@ -2,8 +2,8 @@
 /// @file Function.cpp
 /// @brief 函数头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析得到的进入次数与热度
 /// </table>
 ///
 #pragma once
@@ -25,6 +26,23 @@
 #include "MemVariable.h"
 #include "IRCode.h"
 
+///
+/// @brief 由剖析数据得到的函数热度
+///
+enum class FunctionHotness {
+    /// @brief 没有剖析数据
+    UNKNOWN,
+
+    /// @brief 从未执行
+    COLD,
+
+    /// @brief 执行过但不热
+    NORMAL,
+
+    /// @brief 执行的基本块次数占比高
+    HOT,
+};
+
 ///
 /// @brief 描述函数信息的类，是全局静态存储，其Value的类型为FunctionType
 ///
@@ -170,6 +188,25 @@ public:
     ///
     void realArgCountReset();
 
+    ///
+    /// @brief 设置剖析得到的函数进入次数与热度
+    /// @param count 进入次数
+    /// @param hotness 热度
+    ///
+    void setProfile(uint64_t count, FunctionHotness hotness);
+
+    ///
+    /// @brief 获取剖析得到的函数进入次数，没有剖析数据时为0
+    /// @return uint64_t 进入次数
+    ///
+    uint64_t getEntryCount();
+
+    ///
+    /// @brief 获取剖析得到的函数热度
+    /// @return FunctionHotness 热度
+    ///
+    FunctionHotness getHotness();
+
 private:
     ///
     /// @brief 函数的返回值类型，有点冗余，可删除，直接从type中取得即可
@@ -250,4 +287,14 @@ private:
     /// @brief 累计的实参个数，用于ARG指令的统计
     ///
     int32_t realArgCount = 0;
+
+    ///
+    /// @brief 剖析得到的函数进入次数
+    ///
+    uint64_t entryCount = 0;
+
+    ///
+    /// @brief 剖析得到的函数热度
+    ///
+    FunctionHotness hotness = FunctionHotness::UNKNOWN;
 };
@@ -2,8 +2,8 @@
 /// @file IRGenerator.cpp
 /// @brief AST遍历产生线性IR的源文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.3
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,8 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>函数体的并行翻译
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>翻译失败时释放函数出口指令
 /// </table>
 ///
 #include <any>
@@ -22,6 +24,7 @@
 #include <unordered_map>
 #include <vector>
 #include <iostream>
+#include <memory>
 
 #include "AST.h"
 #include "ArrayType.h"
@@ -49,6 +52,8 @@
 #include "BinaryInstruction.h"
 #include "MoveInstruction.h"
 #include "GotoInstruction.h"
+#include "ScopeStack.h"
+#include "ThreadPool.h"
 #include "Value.h"
 
 #define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
@@ -171,6 +176,10 @@ bool IRGenerator::ir_default(ast_node * node)
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_compile_unit(ast_node * node)
 {
+    if (jobs != 1) {
+        return ir_compile_unit_parallel(node);
+    }
+
     module->setCurrentFunction(nullptr);
 
     for (auto son: node->sons) {
@@ -187,19 +196,99 @@ bool IRGenerator::ir_compile_unit(ast_node * node)
     return true;
 }
 
+/// @brief 编译单元AST节点分两阶段翻译：先顺序处理全局变量与函数声明，再并行翻译各函数体
+/// @param node AST节点
+/// @return 翻译是否成功，true：成功，false：失败
+bool IRGenerator::ir_compile_unit_parallel(ast_node * node)
+{
+    // 一个函数体的翻译任务，记录函数定义处可见的全局变量与函数，保证与顺序翻译的语义一致
+    struct FunctionTask {
+        ast_node * node;
+        Function * func;
+        std::shared_ptr<const ScopeStack> scope;
+        size_t visibleFuncCount;
+    };
+
+    std::vector<FunctionTask> tasks;
+    std::shared_ptr<const ScopeStack> scope;
+
+    module->setCurrentFunction(nullptr);
+
+    // 第一阶段：顺序处理全局变量与函数声明（含形参）
+    for (auto son: node->sons) {
+
+        if (son->node_type != ast_operator_type::AST_OP_FUNC_DEF) {
+
+            // 全局变量的声明
+            if (!ir_visit_ast_node(son)) {
+                minic_log(LOG_ERROR, "函数或语句不存在");
+                return false;
+            }
+
+            // 全局变量有变化，需要新的作用域快照
+            scope.reset();
+            continue;
+        }
+
+        Function * func = ir_function_declare(son);
+        if (!func) {
+            minic_log(LOG_ERROR, "函数或语句不存在");
+            return false;
+        }
+
+        if (!scope) {
+            scope = module->snapshotScope();
+        }
+
+        tasks.push_back({son, func, scope, module->getFunctionCount()});
+    }
+
+    // 第二阶段：各函数体互不依赖，并行翻译
+    std::vector<char> results(tasks.size());
+
+    ThreadPool pool(jobs);
+    pool.parallelFor(tasks.size(), [&](size_t index) {
+        FunctionTask & task = tasks[index];
+
+        module->enterThreadFunction(*task.scope, task.visibleFuncCount);
+        results[index] = ir_function_body(task.node, task.func);
+        module->leaveThreadFunction();
+    });
+
+    for (auto result: results) {
+        if (!result) {
+            minic_log(LOG_ERROR, "函数或语句不存在");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /// @brief 函数定义AST节点翻译成线性中间IR
 /// @param node AST节点
 /// @return 翻译是否成功，true：成功，false：失败
 bool IRGenerator::ir_function_define(ast_node * node)
 {
-    bool result;
+    Function * newFunc = ir_function_declare(node);
+    if (!newFunc) {
+        return false;
+    }
 
+    return ir_function_body(node, newFunc);
+}
+
+/// @brief 函数定义AST节点的声明部分，创建函数及其形参
+/// @param node AST节点
+/// @return 新建的函数，失败时为空指针
+Function * IRGenerator::ir_function_declare(ast_node * node)
+{
     // 创建一个函数，用于当前函数处理
     if (module->getCurrentFunction()) {
         // 函数中嵌套定义函数，这是不允许的，错误退出
         // TODO 自行追加语义错误处理
         minic_log(LOG_ERROR, "不允许嵌套函数");
-        return false;
+        return nullptr;
     }
 
     // 函数定义的AST包含四个孩子
@@ -210,7 +299,6 @@ bool IRGenerator::ir_function_define(ast_node * node)
     ast_node * type_node = node->sons[0];
     ast_node * name_node = node->sons[1];
     ast_node * param_node = node->sons[2];
-    ast_node * block_node = node->sons[3];
 
     // 创建一个新的函数定义
     Function * newFunc = module->newFunction(name_node->name, type_node->type);
@@ -218,9 +306,30 @@ bool IRGenerator::ir_function_define(ast_node * node)
         // 新定义的函数已经存在，则失败返回。
         // TODO 自行追加语义错误处理
         minic_log(LOG_ERROR, "函数%s已存在", name_node->name.c_str());
-        return false;
+        return nullptr;
+    }
+
+    // 创建函数形参，并行翻译时其它函数体中的函数调用会检查形参，因此要在声明时创建
+    for (auto son: param_node->sons) {
+        newFunc->getParams().push_back(new FormalParam(son->type, ""));
     }
 
+    return newFunc;
+}
+
+/// @brief 函数定义AST节点的函数体部分翻译成线性中间IR，函数已由ir_function_declare创建
+/// @param node AST节点
+/// @param newFunc 函数
+/// @return 翻译是否成功，true：成功，false：失败
+bool IRGenerator::ir_function_body(ast_node * node, Function * newFunc)
+{
+    bool result;
+
+    ast_node * type_node = node->sons[0];
+    ast_node * name_node = node->sons[1];
+    ast_node * param_node = node->sons[2];
+    ast_node * block_node = node->sons[3];
+
     // 当前函数设置有效，变更为当前的函数
     module->setCurrentFunction(newFunc);
 
@@ -248,6 +357,8 @@ bool IRGenerator::ir_function_define(ast_node * node)
         // 形参解析失败
         // TODO 自行追加语义错误处理
         minic_log(LOG_ERROR, "函数 %s 形参列表解析失败",name_node->name.c_str());
+        newFunc->setExitLabel(nullptr);
+        delete exitLabelInst;
         return false;
     }
     node->blockInsts.addInst(param_node->blockInsts);
@@ -275,6 +386,8 @@ bool IRGenerator::ir_function_define(ast_node * node)
         // block解析失败
         // TODO 自行追加语义错误处理
         minic_log(LOG_ERROR, "函数 %s 语句块解析失败",name_node->name.c_str());
+        newFunc->setExitLabel(nullptr);
+        delete exitLabelInst;
         return false;
     }
 
@@ -313,14 +426,14 @@ bool IRGenerator::ir_function_formal_params(ast_node * node)
     // 然后产生赋值指令，用于把表达实参值的临时变量拷贝到形参局部变量上。
     // 请注意这些指令要放在Entry指令后面，因此处理的先后上要注意。
 
+    // 函数形参已在函数声明时创建
     auto currentFunc = module->getCurrentFunction();
-    for (auto son: node->sons) {
+    auto & params = currentFunc->getParams();
+    for (size_t k = 0; k < node->sons.size(); ++k) {
+        ast_node * son = node->sons[k];
 		// 获取形参类型
         Type * param_type = son->type;
-        // 创建函数形参
-        FormalParam * param = new FormalParam(param_type, "");
-        // 保存到函数的形参列表中
-        currentFunc->getParams().push_back(param);
+        FormalParam * param = params[k];
 
         // 创建临时变量保存形参传入值
         son->val = module->newVarValue(param_type, son->sons[1]->name);
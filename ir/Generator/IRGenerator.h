@@ -2,8 +2,8 @@
 /// @file IRGenerator.h
 /// @brief AST遍历产生线性IR的头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.1
-/// @date 2024-11-23
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// <tr><td>2024-11-23 <td>1.1     <td>zenglj  <td>表达式版增强
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>函数体的并行翻译
 /// </table>
 ///
 #pragma once
@@ -36,17 +37,42 @@ public:
     /// @brief 运行产生IR
     bool run();
 
+    ///
+    /// @brief 设置并行翻译函数体的线程数
+    /// @param num 线程数，1为不并行，小于等于0时取CPU的硬件线程数
+    ///
+    void setJobs(int num)
+    {
+        this->jobs = num;
+    }
+
 protected:
     /// @brief 编译单元AST节点翻译成线性中间IR
     /// @param node AST节点
     /// @return 翻译是否成功，true：成功，false：失败
     bool ir_compile_unit(ast_node * node);
 
+    /// @brief 编译单元AST节点分两阶段翻译：先顺序处理全局变量与函数声明，再并行翻译各函数体
+    /// @param node AST节点
+    /// @return 翻译是否成功，true：成功，false：失败
+    bool ir_compile_unit_parallel(ast_node * node);
+
     /// @brief 函数定义AST节点翻译成线性中间IR
     /// @param node AST节点
     /// @return 翻译是否成功，true：成功，false：失败
     bool ir_function_define(ast_node * node);
 
+    /// @brief 函数定义AST节点的声明部分，创建函数及其形参
+    /// @param node AST节点
+    /// @return 新建的函数，失败时为空指针
+    Function * ir_function_declare(ast_node * node);
+
+    /// @brief 函数定义AST节点的函数体部分翻译成线性中间IR，函数已由ir_function_declare创建
+    /// @param node AST节点
+    /// @param func 函数
+    /// @return 翻译是否成功，true：成功，false：失败
+    bool ir_function_body(ast_node * node, Function * func);
+
     /// @brief 形式参数AST节点翻译成线性中间IR
     /// @param node AST节点
     /// @return 翻译是否成功，true：成功，false：失败
@@ -234,4 +260,7 @@ private:
 
     /// @brief 符号表:模块
     Module * module;
+
+    /// @brief 并行翻译函数体的线程数
+    int jobs = 1;
 };
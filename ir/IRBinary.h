@@ -0,0 +1,274 @@
+///
+/// @file IRBinary.h
+/// @brief 二进制DragonIR文件的格式定义与变长整数的编解码
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 文件由固定长度的文件头与五个段组成，段的偏移都记录在文件头中：
+/// - 文件头：魔数DIRB、格式版本(u32)，以及字符串表、类型表、全局变量、函数索引、函数体五个段的偏移(u64)
+/// - 字符串表：个数，每个字符串为长度+内容
+/// - 类型表：个数，每个类型为种类+参数，引用的类型总在其前面
+/// - 全局变量：个数，每个为名字、类型、对齐、初值
+/// - 函数索引：个数，每个为名字、是否内置、返回类型、形参（类型、名字），函数体在函数体段中的偏移与长度
+/// - 函数体：每个函数的局部变量与指令流，指令的操作数用变长整数编码的Value引用
+///
+/// 除文件头外所有整数都是LEB128变长编码，有符号数先做ZigZag变换。
+/// 函数索引在加载模块时读入，函数体则在第一次使用时才根据偏移创建。
+///
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/// @brief 文件的魔数
+#define IR_BINARY_MAGIC "DIRB"
+
+/// @brief 格式版本，格式不兼容的修改时加一
+#define IR_BINARY_VERSION 1
+
+/// @brief 文件头的字节数：魔数4字节、版本4字节、五个段的偏移各8字节
+#define IR_BINARY_HEADER_SIZE (4 + 4 + 5 * 8)
+
+///
+/// @brief 类型表中类型的种类
+///
+enum class IRBinaryType : uint8_t {
+    VOID,
+    LABEL,
+    INTEGER,
+    POINTER,
+    ARRAY,
+};
+
+///
+/// @brief Value引用的种类，占引用编码的低3位，高位为常量值或者序号
+///
+enum class IRBinaryValue : uint8_t {
+    /// @brief 整数常量，高位为ZigZag变换后的值
+    CONST_INT,
+    /// @brief 全局变量，高位为全局变量的序号
+    GLOBAL,
+    /// @brief 形参，高位为形参的序号
+    PARAM,
+    /// @brief 局部变量，高位为局部变量的序号
+    LOCAL,
+    /// @brief 指令，高位为指令在函数内的序号
+    INST,
+};
+
+/// @brief Value引用中种类所占的位数
+#define IR_BINARY_VALUE_TAG_BITS 3
+
+///
+/// @brief 有符号数的ZigZag变换，使绝对值小的负数也编码得短
+/// @param v 有符号数
+/// @return uint64_t 变换后的无符号数
+///
+inline uint64_t zigzagEncode(int64_t v)
+{
+    return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63);
+}
+
+///
+/// @brief ZigZag变换的逆变换
+/// @param v 无符号数
+/// @return int64_t 有符号数
+///
+inline int64_t zigzagDecode(uint64_t v)
+{
+    return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+
+///
+/// @brief 向缓冲区追加二进制数据
+///
+class IRBinaryBuffer {
+
+public:
+    ///
+    /// @brief 追加LEB128编码的无符号数
+    /// @param v 无符号数
+    ///
+    void varint(uint64_t v)
+    {
+        while (v >= 0x80) {
+            data.push_back((char) ((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        data.push_back((char) v);
+    }
+
+    ///
+    /// @brief 追加ZigZag变换后LEB128编码的有符号数
+    /// @param v 有符号数
+    ///
+    void svarint(int64_t v)
+    {
+        varint(zigzagEncode(v));
+    }
+
+    ///
+    /// @brief 追加一个字节
+    /// @param v 字节
+    ///
+    void byte(uint8_t v)
+    {
+        data.push_back((char) v);
+    }
+
+    ///
+    /// @brief 追加小端的定长无符号数
+    /// @param v 无符号数
+    /// @param bytes 字节数
+    ///
+    void fixed(uint64_t v, int bytes)
+    {
+        for (int k = 0; k < bytes; ++k) {
+            data.push_back((char) (v >> (8 * k)));
+        }
+    }
+
+    ///
+    /// @brief 追加原始字节
+    /// @param bytes 字节串
+    ///
+    void raw(std::string_view bytes)
+    {
+        data.append(bytes.data(), bytes.size());
+    }
+
+    /// @brief 缓冲区内容
+    std::string data;
+};
+
+///
+/// @brief 从内存中顺序读取二进制数据，越界或者编码错误时置失败标记，之后读取的都为0
+///
+class IRBinaryCursor {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _begin 开始位置
+    /// @param _end 结束位置
+    ///
+    IRBinaryCursor(const uint8_t * _begin, const uint8_t * _end) : p(_begin), end(_end)
+    {}
+
+    ///
+    /// @brief 读取LEB128编码的无符号数
+    /// @return uint64_t 无符号数
+    ///
+    uint64_t varint()
+    {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p >= end) {
+                ok = false;
+                return 0;
+            }
+            uint8_t b = *p++;
+            v |= (uint64_t) (b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                return v;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    ///
+    /// @brief 读取ZigZag变换后LEB128编码的有符号数
+    /// @return int64_t 有符号数
+    ///
+    int64_t svarint()
+    {
+        return zigzagDecode(varint());
+    }
+
+    ///
+    /// @brief 读取一个字节
+    /// @return uint8_t 字节
+    ///
+    uint8_t byte()
+    {
+        if (p >= end) {
+            ok = false;
+            return 0;
+        }
+        return *p++;
+    }
+
+    ///
+    /// @brief 读取小端的定长无符号数
+    /// @param bytes 字节数
+    /// @return uint64_t 无符号数
+    ///
+    uint64_t fixed(int bytes)
+    {
+        if (end - p < bytes) {
+            ok = false;
+            return 0;
+        }
+        uint64_t v = 0;
+        for (int k = 0; k < bytes; ++k) {
+            v |= (uint64_t) p[k] << (8 * k);
+        }
+        p += bytes;
+        return v;
+    }
+
+    ///
+    /// @brief 读取指定长度的字节串，不复制
+    /// @param len 字节数
+    /// @return std::string_view 字节串
+    ///
+    std::string_view raw(uint64_t len)
+    {
+        if ((uint64_t) (end - p) < len) {
+            ok = false;
+            return {};
+        }
+        std::string_view v((const char *) p, len);
+        p += len;
+        return v;
+    }
+
+    ///
+    /// @brief 之前的读取是否都成功
+    /// @return true：成功，false：失败
+    ///
+    [[nodiscard]] bool good() const
+    {
+        return ok;
+    }
+
+    ///
+    /// @brief 置失败标记，用于读到的内容无效时
+    ///
+    void fail()
+    {
+        ok = false;
+    }
+
+private:
+    /// @brief 当前位置
+    const uint8_t * p;
+
+    /// @brief 结束位置
+    const uint8_t * end;
+
+    /// @brief 是否成功
+    bool ok = true;
+};
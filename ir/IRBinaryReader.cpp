@@ -0,0 +1,536 @@
+///
+/// @file IRBinaryReader.cpp
+/// @brief 从二进制IR文件加载模块的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>支持剖析计数指令
+/// </table>
+///
+#include <cstdio>
+#include <cstring>
+
+#include "ArgInstruction.h"
+#include "ArrayType.h"
+#include "BinaryInstruction.h"
+#include "BranchInstruction.h"
+#include "Common.h"
+#include "CounterInstruction.h"
+#include "EntryInstruction.h"
+#include "ExitInstruction.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "IntegerType.h"
+#include "IRBinaryReader.h"
+#include "LabelInstruction.h"
+#include "LabelType.h"
+#include "LoadInstruction.h"
+#include "MoveInstruction.h"
+#include "PointerType.h"
+#include "StoreInstruction.h"
+#include "UnaryInstruction.h"
+#include "VoidType.h"
+
+///
+/// @brief 检查文件是否是二进制IR文件
+/// @param filePath 文件路径
+/// @return true：是，false：不是
+///
+bool IRBinaryReader::isBinaryIR(const std::string & filePath)
+{
+    FILE * fp = fopen(filePath.c_str(), "rb");
+    if (nullptr == fp) {
+        return false;
+    }
+
+    char magic[4];
+    bool result = (fread(magic, 1, sizeof(magic), fp) == sizeof(magic)) && (memcmp(magic, IR_BINARY_MAGIC, 4) == 0);
+
+    fclose(fp);
+
+    return result;
+}
+
+///
+/// @brief 映射文件并检查文件头
+/// @param filePath 文件路径
+/// @return true：成功，false：失败
+///
+bool IRBinaryReader::open(const std::string & filePath)
+{
+    if (!file.open(filePath)) {
+        minic_log(LOG_ERROR, "文件%s打开失败", filePath.c_str());
+        return false;
+    }
+
+    const uint8_t * begin = (const uint8_t *) file.data();
+    IRBinaryCursor cursor(begin, begin + file.size());
+
+    bool valid = (cursor.raw(4) == IR_BINARY_MAGIC) && (cursor.fixed(4) == IR_BINARY_VERSION);
+
+    // 各段依次排列，且都在文件内
+    uint64_t last = IR_BINARY_HEADER_SIZE;
+    for (auto & offset: sectionOffsets) {
+        offset = cursor.fixed(8);
+        valid = valid && (offset >= last) && (offset <= file.size());
+        last = offset;
+    }
+
+    if (!valid || !cursor.good()) {
+        minic_log(LOG_ERROR, "文件%s不是有效的二进制IR文件或者版本不符", filePath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 文件中某个段的读取位置
+/// @param index 段在文件头中的序号
+/// @return IRBinaryCursor 读取位置
+///
+IRBinaryCursor IRBinaryReader::section(int index)
+{
+    const uint8_t * begin = (const uint8_t *) file.data();
+    uint64_t end = (index + 1 < 5) ? sectionOffsets[index + 1] : file.size();
+
+    return IRBinaryCursor(begin + sectionOffsets[index], begin + end);
+}
+
+///
+/// @brief 读取类型的引用
+/// @param cursor 读取位置
+/// @return Type* 类型，无效时为空指针并置失败
+///
+Type * IRBinaryReader::readType(IRBinaryCursor & cursor)
+{
+    uint64_t index = cursor.varint();
+    if (index >= types.size()) {
+        cursor.fail();
+        return nullptr;
+    }
+
+    return types[index];
+}
+
+///
+/// @brief 读取字符串的引用
+/// @param cursor 读取位置
+/// @return std::string 字符串，无效时为空串并置失败
+///
+std::string IRBinaryReader::readString(IRBinaryCursor & cursor)
+{
+    uint64_t index = cursor.varint();
+    if (index >= strings.size()) {
+        cursor.fail();
+        return "";
+    }
+
+    return std::string(strings[index]);
+}
+
+///
+/// @brief 加载字符串表、类型表、全局变量与函数的声明到模块中
+/// @param _module 模块
+/// @return true：成功，false：失败
+///
+bool IRBinaryReader::load(Module * _module)
+{
+    module = _module;
+
+    // 字符串表
+    IRBinaryCursor cursor = section(0);
+    uint64_t count = cursor.varint();
+    for (uint64_t k = 0; (k < count) && cursor.good(); ++k) {
+        strings.push_back(cursor.raw(cursor.varint()));
+    }
+
+    // 类型表，引用的类型总在前面
+    IRBinaryCursor typeCursor = section(1);
+    count = typeCursor.varint();
+    for (uint64_t k = 0; (k < count) && typeCursor.good(); ++k) {
+
+        Type * type = nullptr;
+
+        switch ((IRBinaryType) typeCursor.byte()) {
+            case IRBinaryType::VOID:
+                type = VoidType::getType();
+                break;
+            case IRBinaryType::LABEL:
+                type = LabelType::getType();
+                break;
+            case IRBinaryType::INTEGER: {
+                uint64_t bitWidth = typeCursor.varint();
+                if (bitWidth == 1) {
+                    type = IntegerType::getTypeBool();
+                } else if (bitWidth == 32) {
+                    type = IntegerType::getTypeInt();
+                }
+                break;
+            }
+            case IRBinaryType::POINTER: {
+                Type * pointee = readType(typeCursor);
+                if (pointee) {
+                    type = (Type *) PointerType::get(pointee);
+                }
+                break;
+            }
+            case IRBinaryType::ARRAY: {
+                Type * element = readType(typeCursor);
+                uint64_t numElements = typeCursor.varint();
+                if (element) {
+                    type = (Type *) ArrayType::get(element, numElements);
+                }
+                break;
+            }
+        }
+
+        if (type == nullptr) {
+            typeCursor.fail();
+        }
+
+        types.push_back(type);
+    }
+
+    // 全局变量
+    IRBinaryCursor globalCursor = section(2);
+    count = globalCursor.varint();
+    for (uint64_t k = 0; (k < count) && globalCursor.good(); ++k) {
+
+        std::string name = readString(globalCursor);
+        Type * type = readType(globalCursor);
+        int32_t alignment = (int32_t) globalCursor.varint();
+        bool hasInit = globalCursor.varint() != 0;
+        int64_t initVal = hasInit ? globalCursor.svarint() : 0;
+
+        if (!globalCursor.good()) {
+            break;
+        }
+
+        Instanceof(var, GlobalVariable *, module->newVarValue(type, name));
+        if (var == nullptr) {
+            globalCursor.fail();
+            break;
+        }
+
+        var->setAlignment(alignment);
+        if (hasInit) {
+            var->setInitVal(module->newConstInt((int32_t) initVal));
+        }
+
+        globals.push_back(var);
+    }
+
+    // 函数的声明，内置函数已经存在，直接查找
+    IRBinaryCursor funcCursor = section(3);
+    count = funcCursor.varint();
+    for (uint64_t k = 0; (k < count) && funcCursor.good(); ++k) {
+
+        std::string name = readString(funcCursor);
+        bool builtin = funcCursor.varint() != 0;
+        Type * returnType = readType(funcCursor);
+
+        std::vector<FormalParam *> params;
+        uint64_t paramCount = funcCursor.varint();
+        for (uint64_t p = 0; (p < paramCount) && funcCursor.good(); ++p) {
+            Type * paramType = readType(funcCursor);
+            std::string paramName = readString(funcCursor);
+            if (paramType) {
+                params.push_back(new FormalParam(paramType, paramName));
+            }
+        }
+
+        BodyRange range;
+        range.offset = funcCursor.varint();
+        range.size = funcCursor.varint();
+
+        // 形参在函数创建后加入，与IRGenerator翻译函数声明时相同
+        Function * func = nullptr;
+        if (funcCursor.good()) {
+            func = builtin ? module->findFunction(name) : module->newFunction(name, returnType);
+        }
+
+        if ((func != nullptr) && !builtin) {
+            func->getParams().assign(params.begin(), params.end());
+        } else {
+            for (auto param: params) {
+                delete param;
+            }
+        }
+
+        if (func == nullptr) {
+            funcCursor.fail();
+            break;
+        }
+
+        functions.push_back(func);
+
+        // 函数体要在函数体段内
+        uint64_t bodySize = file.size() - sectionOffsets[4];
+        if ((range.offset > bodySize) || (range.size > bodySize - range.offset)) {
+            funcCursor.fail();
+            break;
+        }
+
+        if (!builtin) {
+            bodies.emplace(func, range);
+        }
+    }
+
+    if (!cursor.good() || !typeCursor.good() || !globalCursor.good() || !funcCursor.good()) {
+        minic_log(LOG_ERROR, "二进制IR文件内容无效");
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 创建函数体的IR指令，已经创建过的函数直接返回成功
+/// @param func 函数
+/// @return true：成功，false：失败
+///
+bool IRBinaryReader::materialize(Function * func)
+{
+    auto bodyIter = bodies.find(func);
+    if ((bodyIter == bodies.end()) || bodyIter->second.done) {
+        return true;
+    }
+
+    BodyRange & range = bodyIter->second;
+    range.done = true;
+
+    const uint8_t * begin = (const uint8_t *) file.data() + sectionOffsets[4] + range.offset;
+    IRBinaryCursor cursor(begin, begin + range.size);
+
+    func->setExistFuncCall(cursor.varint() != 0);
+    func->setMaxFuncCallArgCnt((int) cursor.varint());
+
+    // 局部变量
+    std::vector<LocalVariable *> locals;
+    uint64_t count = cursor.varint();
+    for (uint64_t k = 0; (k < count) && cursor.good(); ++k) {
+        Type * type = readType(cursor);
+        std::string name = readString(cursor);
+        int32_t scopeLevel = (int32_t) cursor.svarint();
+        if (type) {
+            locals.push_back(func->newLocalVarValue(type, name, scopeLevel));
+        }
+    }
+
+    uint64_t retIndex = cursor.varint();
+    uint64_t exitIndex = cursor.varint();
+
+    // 先读出所有指令的记录，Label可能被前面的跳转指令引用，要先创建
+    struct InstRecord {
+        IRInstOperator op;
+        bool dead;
+        Type * type;
+        std::vector<uint64_t> operands;
+        uint64_t extra[2];
+    };
+
+    std::vector<InstRecord> records(cursor.varint());
+    for (auto & record: records) {
+
+        if (!cursor.good()) {
+            break;
+        }
+
+        record.op = (IRInstOperator) cursor.byte();
+        record.dead = cursor.varint() != 0;
+        record.type = readType(cursor);
+
+        uint64_t operandNum = cursor.varint();
+        for (uint64_t k = 0; (k < operandNum) && cursor.good(); ++k) {
+            record.operands.push_back(cursor.varint());
+        }
+
+        int extraNum = 0;
+        if (record.op == IRInstOperator::IRINST_OP_GOTO || record.op == IRInstOperator::IRINST_OP_FUNC_CALL) {
+            extraNum = 1;
+        } else if (record.op == IRInstOperator::IRINST_OP_BRANCH) {
+            extraNum = 2;
+        }
+        for (int k = 0; k < extraNum; ++k) {
+            record.extra[k] = cursor.varint();
+        }
+    }
+
+    std::vector<Instruction *> insts(records.size(), nullptr);
+
+    for (size_t k = 0; (k < records.size()) && cursor.good(); ++k) {
+        if (records[k].op == IRInstOperator::IRINST_OP_LABEL) {
+            insts[k] = new LabelInstruction(func);
+        }
+    }
+
+    // 根据引用编码查找Value，引用的指令必须已经创建
+    auto decodeValue = [&](uint64_t ref) -> Value * {
+        uint64_t payload = ref >> IR_BINARY_VALUE_TAG_BITS;
+        switch ((IRBinaryValue) (ref & ((1 << IR_BINARY_VALUE_TAG_BITS) - 1))) {
+            case IRBinaryValue::CONST_INT:
+                return module->newConstInt((int32_t) zigzagDecode(payload));
+            case IRBinaryValue::GLOBAL:
+                return payload < globals.size() ? globals[payload] : nullptr;
+            case IRBinaryValue::PARAM:
+                return payload < func->getParams().size() ? func->getParams()[payload] : nullptr;
+            case IRBinaryValue::LOCAL:
+                return payload < locals.size() ? locals[payload] : nullptr;
+            case IRBinaryValue::INST:
+                // 只有产生值的指令才能作为操作数
+                return (payload < insts.size()) && insts[payload] && insts[payload]->hasResultValue() ? insts[payload]
+                                                                                                       : nullptr;
+        }
+        return nullptr;
+    };
+
+    // 跳转目标必须是Label指令
+    auto labelAt = [&](uint64_t index) -> Instruction * {
+        if ((index < insts.size()) && (records[index].op == IRInstOperator::IRINST_OP_LABEL)) {
+            return insts[index];
+        }
+        return nullptr;
+    };
+
+    for (size_t k = 0; (k < records.size()) && cursor.good(); ++k) {
+
+        InstRecord & record = records[k];
+
+        std::vector<Value *> operands;
+        for (auto ref: record.operands) {
+            Value * val = decodeValue(ref);
+            if (val == nullptr) {
+                cursor.fail();
+                break;
+            }
+            operands.push_back(val);
+        }
+
+        if (!cursor.good() || (record.type == nullptr)) {
+            cursor.fail();
+            break;
+        }
+
+        Instruction * inst = nullptr;
+        size_t operandNum = operands.size();
+
+        switch (record.op) {
+            case IRInstOperator::IRINST_OP_LABEL:
+                inst = insts[k];
+                break;
+            case IRInstOperator::IRINST_OP_ENTRY:
+                inst = new EntryInstruction(func);
+                break;
+            case IRInstOperator::IRINST_OP_EXIT:
+                if (operandNum <= 1) {
+                    inst = new ExitInstruction(func, operandNum ? operands[0] : nullptr);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_GOTO:
+                if (labelAt(record.extra[0])) {
+                    inst = new GotoInstruction(func, labelAt(record.extra[0]));
+                }
+                break;
+            case IRInstOperator::IRINST_OP_BRANCH:
+                if ((operandNum == 1) && labelAt(record.extra[0]) && labelAt(record.extra[1])) {
+                    inst = new BranchInstruction(func, operands[0], labelAt(record.extra[0]), labelAt(record.extra[1]));
+                }
+                break;
+            case IRInstOperator::IRINST_OP_ADD_I:
+            case IRInstOperator::IRINST_OP_SUB_I:
+            case IRInstOperator::IRINST_OP_MUL_I:
+            case IRInstOperator::IRINST_OP_DIV_I:
+            case IRInstOperator::IRINST_OP_MOD_I:
+            case IRInstOperator::IRINST_OP_LT_I:
+            case IRInstOperator::IRINST_OP_GT_I:
+            case IRInstOperator::IRINST_OP_LE_I:
+            case IRInstOperator::IRINST_OP_GE_I:
+            case IRInstOperator::IRINST_OP_EQ_I:
+            case IRInstOperator::IRINST_OP_NE_I:
+                if (operandNum == 2) {
+                    inst = new BinaryInstruction(func, record.op, operands[0], operands[1], record.type);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_MINUS_I:
+                if (operandNum == 1) {
+                    inst = new UnaryInstruction(func, record.op, operands[0], record.type);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_ASSIGN:
+                if (operandNum == 2) {
+                    inst = new MoveInstruction(func, operands[0], operands[1]);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_FUNC_CALL:
+                if (record.extra[0] < functions.size()) {
+                    inst = new FuncCallInstruction(func, functions[record.extra[0]], operands, record.type);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_ARG:
+                if (operandNum == 1) {
+                    inst = new ArgInstruction(func, operands[0]);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_LOAD:
+                if (operandNum == 1) {
+                    inst = new LoadInstruction(func, operands[0], record.type);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_STORE:
+                if (operandNum == 2) {
+                    inst = new StoreInstruction(func, operands[0], operands[1]);
+                }
+                break;
+            case IRInstOperator::IRINST_OP_COUNTER:
+                if ((operandNum == 2) && dynamic_cast<ConstInt *>(operands[1])) {
+                    inst = new CounterInstruction(func, operands[0], static_cast<ConstInt *>(operands[1]));
+                }
+                break;
+            default:
+                break;
+        }
+
+        if (inst == nullptr) {
+            cursor.fail();
+            break;
+        }
+
+        inst->setDead(record.dead);
+        insts[k] = inst;
+    }
+
+    if (!cursor.good() || (retIndex > locals.size()) || (exitIndex > insts.size()) ||
+        ((exitIndex != 0) && !labelAt(exitIndex - 1))) {
+
+        // 释放已创建的指令，指令间可能相互引用，先全部解除使用关系。局部变量随函数释放
+        for (auto inst: insts) {
+            if (inst) {
+                inst->clearOperands();
+            }
+        }
+        for (auto inst: insts) {
+            delete inst;
+        }
+
+        minic_log(LOG_ERROR, "二进制IR文件中函数%s的函数体无效", func->getName().c_str());
+        return false;
+    }
+
+    InterCode & irCode = func->getInterCode();
+    for (auto inst: insts) {
+        irCode.addInst(inst);
+    }
+
+    func->setReturnValue(retIndex ? locals[retIndex - 1] : nullptr);
+    func->setExitLabel(exitIndex ? insts[exitIndex - 1] : nullptr);
+
+    return true;
+}
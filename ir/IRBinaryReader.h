@@ -0,0 +1,125 @@
+///
+/// @file IRBinaryReader.h
+/// @brief 从二进制IR文件加载模块，函数体按需创建
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "IRBinary.h"
+#include "MappedFile.h"
+#include "Module.h"
+
+///
+/// @brief 二进制IR文件的加载，格式见IRBinary.h
+///
+/// 文件通过mmap映射，字符串表中的字符串直接指向映射区。load只创建全局变量与函数的声明，
+/// 函数体在materialize时才根据函数索引中的偏移创建，因此加载器要与模块同时存在，
+/// 加载后通过Module::setMaterializer交给模块管理。
+///
+class IRBinaryReader : public IRMaterializer {
+
+public:
+    ///
+    /// @brief 检查文件是否是二进制IR文件
+    /// @param filePath 文件路径
+    /// @return true：是，false：不是
+    ///
+    static bool isBinaryIR(const std::string & filePath);
+
+    ///
+    /// @brief 映射文件并检查文件头
+    /// @param filePath 文件路径
+    /// @return true：成功，false：失败
+    ///
+    bool open(const std::string & filePath);
+
+    ///
+    /// @brief 加载字符串表、类型表、全局变量与函数的声明到模块中
+    /// @param _module 模块
+    /// @return true：成功，false：失败
+    ///
+    bool load(Module * _module);
+
+    ///
+    /// @brief 创建函数体的IR指令，已经创建过的函数直接返回成功
+    /// @param func 函数
+    /// @return true：成功，false：失败
+    ///
+    bool materialize(Function * func) override;
+
+protected:
+    ///
+    /// @brief 读取类型的引用
+    /// @param cursor 读取位置
+    /// @return Type* 类型，无效时为空指针并置失败
+    ///
+    Type * readType(IRBinaryCursor & cursor);
+
+    ///
+    /// @brief 读取字符串的引用
+    /// @param cursor 读取位置
+    /// @return std::string 字符串，无效时为空串并置失败
+    ///
+    std::string readString(IRBinaryCursor & cursor);
+
+    ///
+    /// @brief 文件中某个段的读取位置
+    /// @param index 段在文件头中的序号
+    /// @return IRBinaryCursor 读取位置
+    ///
+    IRBinaryCursor section(int index);
+
+private:
+    ///
+    /// @brief 函数体在函数体段中的位置
+    ///
+    struct BodyRange {
+        /// @brief 偏移
+        uint64_t offset = 0;
+
+        /// @brief 字节数
+        uint64_t size = 0;
+
+        /// @brief 是否已经创建
+        bool done = false;
+    };
+
+    /// @brief 映射的文件
+    MappedFile file;
+
+    /// @brief 五个段的偏移
+    uint64_t sectionOffsets[5] = {};
+
+    /// @brief 加载到的模块
+    Module * module = nullptr;
+
+    /// @brief 字符串表，指向映射区
+    std::vector<std::string_view> strings;
+
+    /// @brief 类型表
+    std::vector<Type *> types;
+
+    /// @brief 全局变量表
+    std::vector<GlobalVariable *> globals;
+
+    /// @brief 函数表
+    std::vector<Function *> functions;
+
+    /// @brief 各函数的函数体位置
+    std::unordered_map<Function *, BodyRange> bodies;
+};
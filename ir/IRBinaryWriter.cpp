@@ -0,0 +1,338 @@
+///
+/// @file IRBinaryWriter.cpp
+/// @brief 把模块的DragonIR输出为二进制IR文件的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <cstdio>
+
+#include "ArrayType.h"
+#include "BranchInstruction.h"
+#include "Common.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "IntegerType.h"
+#include "IRBinaryWriter.h"
+#include "PointerType.h"
+
+///
+/// @brief 构造函数
+/// @param _module 要输出的模块
+///
+IRBinaryWriter::IRBinaryWriter(Module * _module) : module(_module)
+{}
+
+///
+/// @brief 获取字符串在字符串表中的序号，不存在时加入
+/// @param str 字符串
+/// @return uint64_t 序号
+///
+uint64_t IRBinaryWriter::stringIndex(const std::string & str)
+{
+    auto iter = stringMap.find(str);
+    if (iter != stringMap.end()) {
+        return iter->second;
+    }
+
+    uint64_t index = stringMap.size();
+    stringMap.emplace(str, index);
+
+    strings.varint(str.size());
+    strings.raw(str);
+
+    return index;
+}
+
+///
+/// @brief 获取类型在类型表中的序号，不存在时加入，引用的类型先加入
+/// @param type 类型
+/// @param index 序号
+/// @return true：成功，false：不支持的类型
+///
+bool IRBinaryWriter::typeIndex(const Type * type, uint64_t & index)
+{
+    auto iter = typeMap.find(type);
+    if (iter != typeMap.end()) {
+        index = iter->second;
+        return true;
+    }
+
+    // 先加入引用的类型，保证读入时引用的类型已经存在
+    IRBinaryBuffer entry;
+    uint64_t ref;
+
+    switch (type->getTypeID()) {
+        case Type::VoidTyID:
+            entry.byte((uint8_t) IRBinaryType::VOID);
+            break;
+        case Type::LabelTyID:
+            entry.byte((uint8_t) IRBinaryType::LABEL);
+            break;
+        case Type::IntegerTyID: {
+            Instanceof(intType, const IntegerType *, type);
+            entry.byte((uint8_t) IRBinaryType::INTEGER);
+            entry.varint(intType->getBitWidth());
+            break;
+        }
+        case Type::PointerTyID: {
+            Instanceof(ptrType, const PointerType *, type);
+            if (!typeIndex(ptrType->getPointeeType(), ref)) {
+                return false;
+            }
+            entry.byte((uint8_t) IRBinaryType::POINTER);
+            entry.varint(ref);
+            break;
+        }
+        case Type::ArrayTyID: {
+            Instanceof(arrayType, const ArrayType *, type);
+            if (!typeIndex(arrayType->getElementType(), ref)) {
+                return false;
+            }
+            entry.byte((uint8_t) IRBinaryType::ARRAY);
+            entry.varint(ref);
+            entry.varint(arrayType->getNumElements());
+            break;
+        }
+        default:
+            minic_log(LOG_ERROR, "二进制IR不支持类型%s", type->toString().c_str());
+            return false;
+    }
+
+    index = typeMap.size();
+    typeMap.emplace(type, index);
+    types.raw(entry.data);
+
+    return true;
+}
+
+///
+/// @brief 输出一个函数的函数体
+/// @param func 函数
+/// @param out 输出的缓冲区
+/// @return true：成功，false：失败
+///
+bool IRBinaryWriter::writeBody(Function * func, IRBinaryBuffer & out)
+{
+    // 函数内Value的序号
+    std::unordered_map<Value *, uint64_t> paramMap, localMap, instMap;
+
+    for (auto param: func->getParams()) {
+        paramMap.emplace(param, paramMap.size());
+    }
+
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+    for (auto inst: insts) {
+        instMap.emplace(inst, instMap.size());
+    }
+
+    uint64_t typeRef;
+
+    // 函数调用相关的信息，后端栈帧分配时使用
+    out.varint(func->getExistFuncCall() ? 1 : 0);
+    out.varint(func->getMaxFuncCallArgCnt());
+
+    // 局部变量
+    out.varint(func->getVarValues().size());
+    for (auto var: func->getVarValues()) {
+        if (!typeIndex(var->getType(), typeRef)) {
+            return false;
+        }
+        localMap.emplace(var, localMap.size());
+        out.varint(typeRef);
+        out.varint(stringIndex(var->getName()));
+        out.svarint(var->getScopeLevel());
+    }
+
+    // 返回值变量与出口Label，序号加一，0表示没有
+    auto retIter = localMap.find(func->getReturnValue());
+    out.varint(retIter == localMap.end() ? 0 : retIter->second + 1);
+
+    auto exitIter = instMap.find(func->getExitLabel());
+    out.varint(exitIter == instMap.end() ? 0 : exitIter->second + 1);
+
+    // Value的引用编码
+    auto valueRef = [&](Value * val, uint64_t & ref) -> bool {
+        IRBinaryValue tag;
+        uint64_t payload;
+        std::unordered_map<Value *, uint64_t>::iterator iter;
+
+        Instanceof(constInt, ConstInt *, val);
+        if (constInt) {
+            tag = IRBinaryValue::CONST_INT;
+            payload = zigzagEncode(constInt->getVal());
+        } else if ((iter = globalMap.find(val)) != globalMap.end()) {
+            tag = IRBinaryValue::GLOBAL;
+            payload = iter->second;
+        } else if ((iter = paramMap.find(val)) != paramMap.end()) {
+            tag = IRBinaryValue::PARAM;
+            payload = iter->second;
+        } else if ((iter = localMap.find(val)) != localMap.end()) {
+            tag = IRBinaryValue::LOCAL;
+            payload = iter->second;
+        } else if ((iter = instMap.find(val)) != instMap.end()) {
+            tag = IRBinaryValue::INST;
+            payload = iter->second;
+        } else {
+            minic_log(LOG_ERROR, "函数%s引用了二进制IR不支持的Value", func->getName().c_str());
+            return false;
+        }
+
+        ref = (payload << IR_BINARY_VALUE_TAG_BITS) | (uint64_t) tag;
+        return true;
+    };
+
+    // 指令流：操作码、标记、类型、操作数，以及跳转目标或被调用函数
+    out.varint(insts.size());
+    for (auto inst: insts) {
+
+        if (!typeIndex(inst->getType(), typeRef)) {
+            return false;
+        }
+
+        out.byte((uint8_t) inst->getOp());
+        out.varint(inst->isDead() ? 1 : 0);
+        out.varint(typeRef);
+
+        auto & operands = inst->getOperands();
+        out.varint(operands.size());
+        for (auto use: operands) {
+            uint64_t ref;
+            if (!valueRef(use->getUsee(), ref)) {
+                return false;
+            }
+            out.varint(ref);
+        }
+
+        switch (inst->getOp()) {
+            case IRInstOperator::IRINST_OP_GOTO: {
+                Instanceof(gotoInst, GotoInstruction *, inst);
+                out.varint(instMap[gotoInst->getTarget()]);
+                break;
+            }
+            case IRInstOperator::IRINST_OP_BRANCH: {
+                Instanceof(branchInst, BranchInstruction *, inst);
+                out.varint(instMap[branchInst->getTarget1()]);
+                out.varint(instMap[branchInst->getTarget2()]);
+                break;
+            }
+            case IRInstOperator::IRINST_OP_FUNC_CALL: {
+                Instanceof(callInst, FuncCallInstruction *, inst);
+                out.varint(funcMap[callInst->calledFunction]);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 输出二进制IR文件
+/// @param filePath 文件路径
+/// @return true：成功，false：失败
+///
+bool IRBinaryWriter::write(const std::string & filePath)
+{
+    uint64_t typeRef;
+
+    // 全局变量
+    IRBinaryBuffer globals;
+    globals.varint(module->getGlobalVariables().size());
+    for (auto var: module->getGlobalVariables()) {
+        if (!typeIndex(var->getType(), typeRef)) {
+            return false;
+        }
+        globalMap.emplace(var, globalMap.size());
+        globals.varint(stringIndex(var->getName()));
+        globals.varint(typeRef);
+        globals.varint(var->getAlignment());
+        globals.varint(var->hasInitVal() ? 1 : 0);
+        if (var->hasInitVal()) {
+            globals.svarint(var->getInitVal()->getVal());
+        }
+    }
+
+    // 函数先全部编号，函数体中调用的函数可能在后面
+    for (auto func: module->getFunctionList()) {
+        funcMap.emplace(func, funcMap.size());
+    }
+
+    // 函数索引与函数体
+    IRBinaryBuffer funcs, bodies;
+    funcs.varint(module->getFunctionList().size());
+    for (auto func: module->getFunctionList()) {
+
+        funcs.varint(stringIndex(func->getName()));
+        funcs.varint(func->isBuiltin() ? 1 : 0);
+
+        if (!typeIndex(func->getReturnType(), typeRef)) {
+            return false;
+        }
+        funcs.varint(typeRef);
+
+        funcs.varint(func->getParams().size());
+        for (auto param: func->getParams()) {
+            if (!typeIndex(param->getType(), typeRef)) {
+                return false;
+            }
+            funcs.varint(typeRef);
+            funcs.varint(stringIndex(param->getName()));
+        }
+
+        // 内置函数没有函数体
+        size_t bodyBegin = bodies.data.size();
+        if (!func->isBuiltin() && !writeBody(func, bodies)) {
+            return false;
+        }
+        funcs.varint(bodyBegin);
+        funcs.varint(bodies.data.size() - bodyBegin);
+    }
+
+    // 字符串表与类型表最后才确定，加上个数
+    IRBinaryBuffer stringSection, typeSection;
+    stringSection.varint(stringMap.size());
+    stringSection.raw(strings.data);
+    typeSection.varint(typeMap.size());
+    typeSection.raw(types.data);
+
+    // 文件头
+    IRBinaryBuffer header;
+    header.raw(IR_BINARY_MAGIC);
+    header.fixed(IR_BINARY_VERSION, 4);
+
+    uint64_t offset = IR_BINARY_HEADER_SIZE;
+    for (auto section: {&stringSection, &typeSection, &globals, &funcs}) {
+        header.fixed(offset, 8);
+        offset += section->data.size();
+    }
+    header.fixed(offset, 8);
+
+    FILE * fp = fopen(filePath.c_str(), "wb");
+    if (nullptr == fp) {
+        minic_log(LOG_ERROR, "文件%s打开失败", filePath.c_str());
+        return false;
+    }
+
+    bool ok = true;
+    for (auto section: {&header, &stringSection, &typeSection, &globals, &funcs, &bodies}) {
+        ok = ok && (fwrite(section->data.data(), 1, section->data.size(), fp) == section->data.size());
+    }
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok) {
+        minic_log(LOG_ERROR, "文件%s写入失败", filePath.c_str());
+    }
+
+    return ok;
+}
@@ -0,0 +1,90 @@
+///
+/// @file IRBinaryWriter.h
+/// @brief 把模块的DragonIR输出为二进制IR文件
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "IRBinary.h"
+#include "Module.h"
+
+///
+/// @brief 二进制IR文件的输出，格式见IRBinary.h
+///
+/// 只能输出后端处理之前的IR，即Value只能是常量、全局变量、形参、局部变量与指令。
+///
+class IRBinaryWriter {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 要输出的模块
+    ///
+    explicit IRBinaryWriter(Module * _module);
+
+    ///
+    /// @brief 输出二进制IR文件
+    /// @param filePath 文件路径
+    /// @return true：成功，false：失败
+    ///
+    bool write(const std::string & filePath);
+
+protected:
+    ///
+    /// @brief 获取字符串在字符串表中的序号，不存在时加入
+    /// @param str 字符串
+    /// @return uint64_t 序号
+    ///
+    uint64_t stringIndex(const std::string & str);
+
+    ///
+    /// @brief 获取类型在类型表中的序号，不存在时加入，引用的类型先加入
+    /// @param type 类型
+    /// @param index 序号
+    /// @return true：成功，false：不支持的类型
+    ///
+    bool typeIndex(const Type * type, uint64_t & index);
+
+    ///
+    /// @brief 输出一个函数的函数体
+    /// @param func 函数
+    /// @param out 输出的缓冲区
+    /// @return true：成功，false：失败
+    ///
+    bool writeBody(Function * func, IRBinaryBuffer & out);
+
+private:
+    /// @brief 要输出的模块
+    Module * module;
+
+    /// @brief 字符串表的内容
+    IRBinaryBuffer strings;
+
+    /// @brief 字符串-序号
+    std::unordered_map<std::string, uint64_t> stringMap;
+
+    /// @brief 类型表的内容
+    IRBinaryBuffer types;
+
+    /// @brief 类型-序号
+    std::unordered_map<const Type *, uint64_t> typeMap;
+
+    /// @brief 全局变量-序号
+    std::unordered_map<Value *, uint64_t> globalMap;
+
+    /// @brief 函数-序号
+    std::unordered_map<Value *, uint64_t> funcMap;
+};
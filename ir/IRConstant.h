@@ -2,8 +2,8 @@
 /// @file IRConstant.h
 /// @brief DragonIR定义的符号常量
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析插桩使用的名字
 /// </table>
 ///
 #pragma once
@@ -25,3 +26,8 @@
 #define IR_KEYWORD_DEFINE "define"
 #define IR_KEYWORD_ADD_I "add"
 #define IR_KEYWORD_SUB_I "sub"
+#define IR_KEYWORD_COUNTER "counter"
+
+// 剖析插桩的计数器表，以及程序结束时输出计数器的运行时函数
+#define IR_PROFILE_COUNTERS "__minic_prof_counters"
+#define IR_PROFILE_DUMP "__minic_prof_dump"
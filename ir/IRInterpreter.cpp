@@ -0,0 +1,890 @@
+///
+/// @file IRInterpreter.cpp
+/// @brief DragonIR的解释执行器的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析计数指令与剖析数据的输出
+/// </table>
+///
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "ArrayType.h"
+#include "BranchInstruction.h"
+#include "Common.h"
+#include "ConstInt.h"
+#include "CounterInstruction.h"
+#include "FormalParam.h"
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "GlobalVariable.h"
+#include "GotoInstruction.h"
+#include "IRInterpreter.h"
+#include "LabelInstruction.h"
+#include "LocalVariable.h"
+#include "PointerType.h"
+#include "Profile.h"
+
+// GCC与Clang支持取标号地址，采用直接线索化分派，否则用switch分派
+#if defined(__GNUC__) || defined(__clang__)
+#define MINIC_THREADED_DISPATCH 1
+#endif
+
+/// @brief 线性内存的字节数
+static constexpr int32_t MEMORY_SIZE = 64 << 20;
+
+/// @brief 地址0开始的这段内存不可访问，用于发现空指针
+static constexpr int32_t NULL_GUARD = 16;
+
+/// @brief 所有栈帧的槽的总数
+static constexpr int32_t REG_STACK_SIZE = 4 << 20;
+
+/// @brief 内置函数，编号即下标，与tests/std.c中整数的输入输出函数以及剖析数据的输出函数对应
+static const char * const builtinNames[] = {
+    "putint",
+    "getint",
+    "putch",
+    "getch",
+    "putarray",
+    "getarray",
+    IR_PROFILE_DUMP,
+};
+
+/// @brief 内置函数最多的实参个数
+static constexpr int32_t BUILTIN_MAX_ARGS = 3;
+
+///
+/// @brief 变量是否是存放在内存中的数组，即指向元素个数非0的数组的指针。
+/// 元素个数为0的是数组形参，保存的是数组的地址
+/// @param type 变量的类型
+/// @return int32_t 数组的字节数，不是数组时为0
+///
+static int32_t arrayStorageSize(const Type * type)
+{
+    if (!type->isPointerType()) {
+        return 0;
+    }
+
+    auto array = dynamic_cast<const ArrayType *>(static_cast<const PointerType *>(type)->getPointeeType());
+    if ((array == nullptr) || (array->getNumElements() == 0)) {
+        return 0;
+    }
+
+    return array->getSize();
+}
+
+/// @brief 构造函数
+/// @param _module 要执行的模块，所有函数体必须已加载
+IRInterpreter::IRInterpreter(Module * _module) : module(_module)
+{
+#ifdef MINIC_THREADED_DISPATCH
+    int32_t unused;
+    (void) execute(0, unused, &handlers);
+#endif
+}
+
+/// @brief 析构函数
+IRInterpreter::~IRInterpreter()
+{
+    free(memory);
+    free(regs);
+}
+
+///
+/// @brief 运行时错误
+/// @param msg 错误信息
+/// @return false
+///
+bool IRInterpreter::error(const std::string & msg)
+{
+    minic_log(LOG_ERROR, "解释执行错误：%s", msg.c_str());
+    return false;
+}
+
+///
+/// @brief 检查一段内存是否可以访问
+/// @param addr 地址
+/// @param size 字节数
+/// @return true：可以，false：越界
+///
+bool IRInterpreter::validAddress(int64_t addr, int64_t size) const
+{
+    return (size >= 0) && (addr >= NULL_GUARD) && (addr + size <= MEMORY_SIZE);
+}
+
+///
+/// @brief 为全局变量分配内存并设置初值
+/// @return true：成功，false：内存不足
+///
+bool IRInterpreter::layoutGlobals()
+{
+    int64_t addr = NULL_GUARD;
+
+    for (auto var: module->getGlobalVariables()) {
+
+        int32_t size = arrayStorageSize(var->getType());
+        if (size == 0) {
+            size = 4;
+        }
+
+        if (addr + size > MEMORY_SIZE) {
+            return error("全局变量超出内存大小");
+        }
+
+        globalAddress[var] = (int32_t) addr;
+
+        if (var->hasInitVal()) {
+            int32_t val = var->getInitVal()->getVal();
+            memcpy(memory + addr, &val, sizeof(val));
+        }
+
+        addr += (size + 3) & ~3;
+    }
+
+    stackBase = (int32_t) ((addr + 15) & ~15);
+
+    return true;
+}
+
+///
+/// @brief 把函数的IR降级为字节码
+/// @param cf 降级后的函数，func已设置
+/// @return true：成功，false：有不支持的IR
+///
+bool IRInterpreter::compile(CompiledFunction & cf)
+{
+    Function * func = cf.func;
+    const std::string funcName = func->getName();
+
+    // Value-槽号。常量槽在所有普通槽之后，降级时先编为-2-k，结束时再换成真正的槽号
+    std::unordered_map<Value *, int32_t> slots;
+    std::unordered_map<Value *, int32_t> constSlots;
+    int32_t slotCount = 0;
+
+    // 形参在最前面，调用时实参直接复制到这里
+    for (auto param: func->getParams()) {
+        slots[param] = slotCount++;
+    }
+    cf.paramCount = slotCount;
+
+    // 局部变量，数组在栈帧内存中分配，槽中放数组的地址
+    for (auto var: func->getVarValues()) {
+        int32_t size = arrayStorageSize(var->getType());
+        if (size) {
+            cf.arraySlots.emplace_back(slotCount, cf.frameBytes);
+            cf.frameBytes += (size + 3) & ~3;
+        }
+        slots[var] = slotCount++;
+    }
+
+    // 指令的结果
+    auto & insts = func->getInterCode().getInsts();
+    for (auto inst: insts) {
+        if (inst->hasResultValue()) {
+            slots[inst] = slotCount++;
+        }
+    }
+
+    auto newConst = [&](Value * key, int32_t val) {
+        auto result = constSlots.emplace(key, (int32_t) cf.constants.size());
+        if (result.second) {
+            cf.constants.push_back(val);
+        }
+        return -2 - result.first->second;
+    };
+
+    auto emit = [&](BytecodeOp op, int32_t a = -1, int32_t b = -1, int32_t c = -1) {
+        cf.code.push_back({nullptr, op, a, b, c});
+    };
+
+    // 取得操作数的槽号，标量全局变量先读到新的槽中
+    auto operand = [&](Value * val, int32_t & slot) -> bool {
+        auto iter = slots.find(val);
+        if (iter != slots.end()) {
+            slot = iter->second;
+            return true;
+        }
+
+        if (Instanceof(constVal, ConstInt *, val)) {
+            slot = newConst(val, constVal->getVal());
+            return true;
+        }
+
+        auto global = globalAddress.find(val);
+        if (global != globalAddress.end()) {
+            if (arrayStorageSize(val->getType())) {
+                // 全局数组的值是其地址
+                slot = newConst(val, global->second);
+            } else {
+                slot = slotCount++;
+                emit(BytecodeOp::BC_LOADG, slot, global->second);
+            }
+            return true;
+        }
+
+        return error("函数" + funcName + "中的操作数" + val->getIRName() + "不支持");
+    };
+
+    // Label指令-字节码的下标，跳转目标在降级结束时回填
+    std::unordered_map<Instruction *, int32_t> labelPos;
+    std::vector<Instruction *> jumpFixups;
+    std::vector<size_t> jumpInsts;
+
+    // ARG指令给出的实参，后面无实参的调用使用
+    std::vector<Value *> pendingArgs;
+
+    for (auto inst: insts) {
+
+        if (inst->isDead()) {
+            continue;
+        }
+
+        int32_t a, b;
+
+        switch (inst->getOp()) {
+
+            case IRInstOperator::IRINST_OP_ENTRY:
+                break;
+
+            case IRInstOperator::IRINST_OP_LABEL:
+                labelPos[inst] = (int32_t) cf.code.size();
+                break;
+
+            case IRInstOperator::IRINST_OP_GOTO:
+                jumpInsts.push_back(cf.code.size());
+                emit(BytecodeOp::BC_JMP);
+                jumpFixups.push_back(static_cast<GotoInstruction *>(inst)->getTarget());
+                break;
+
+            case IRInstOperator::IRINST_OP_BRANCH: {
+                auto branchInst = static_cast<BranchInstruction *>(inst);
+                if (!operand(inst->getOperand(0), a)) {
+                    return false;
+                }
+                jumpInsts.push_back(cf.code.size());
+                emit(BytecodeOp::BC_BR, a);
+                jumpFixups.push_back(branchInst->getTarget1());
+                jumpFixups.push_back(branchInst->getTarget2());
+                break;
+            }
+
+            case IRInstOperator::IRINST_OP_EXIT:
+                a = -1;
+                if (inst->getOperandsNum() && !operand(inst->getOperand(0), a)) {
+                    return false;
+                }
+                emit(BytecodeOp::BC_RET, a);
+                break;
+
+            case IRInstOperator::IRINST_OP_ASSIGN: {
+                Value * dst = inst->getOperand(0);
+                if (!operand(inst->getOperand(1), b)) {
+                    return false;
+                }
+
+                auto iter = slots.find(dst);
+                auto global = globalAddress.find(dst);
+                if (iter != slots.end()) {
+                    emit(BytecodeOp::BC_MOV, iter->second, b);
+                } else if ((global != globalAddress.end()) && !arrayStorageSize(dst->getType())) {
+                    emit(BytecodeOp::BC_STOREG, global->second, b);
+                } else {
+                    return error("函数" + funcName + "中赋值的目标" + dst->getIRName() + "不支持");
+                }
+                break;
+            }
+
+            case IRInstOperator::IRINST_OP_ADD_I:
+            case IRInstOperator::IRINST_OP_SUB_I:
+            case IRInstOperator::IRINST_OP_MUL_I:
+            case IRInstOperator::IRINST_OP_DIV_I:
+            case IRInstOperator::IRINST_OP_MOD_I:
+            case IRInstOperator::IRINST_OP_LT_I:
+            case IRInstOperator::IRINST_OP_GT_I:
+            case IRInstOperator::IRINST_OP_LE_I:
+            case IRInstOperator::IRINST_OP_GE_I:
+            case IRInstOperator::IRINST_OP_EQ_I:
+            case IRInstOperator::IRINST_OP_NE_I: {
+                static const std::unordered_map<IRInstOperator, BytecodeOp> binaryOps = {
+                    {IRInstOperator::IRINST_OP_ADD_I, BytecodeOp::BC_ADD},
+                    {IRInstOperator::IRINST_OP_SUB_I, BytecodeOp::BC_SUB},
+                    {IRInstOperator::IRINST_OP_MUL_I, BytecodeOp::BC_MUL},
+                    {IRInstOperator::IRINST_OP_DIV_I, BytecodeOp::BC_DIV},
+                    {IRInstOperator::IRINST_OP_MOD_I, BytecodeOp::BC_MOD},
+                    {IRInstOperator::IRINST_OP_LT_I, BytecodeOp::BC_LT},
+                    {IRInstOperator::IRINST_OP_GT_I, BytecodeOp::BC_GT},
+                    {IRInstOperator::IRINST_OP_LE_I, BytecodeOp::BC_LE},
+                    {IRInstOperator::IRINST_OP_GE_I, BytecodeOp::BC_GE},
+                    {IRInstOperator::IRINST_OP_EQ_I, BytecodeOp::BC_EQ},
+                    {IRInstOperator::IRINST_OP_NE_I, BytecodeOp::BC_NE},
+                };
+                if (!operand(inst->getOperand(0), a) || !operand(inst->getOperand(1), b)) {
+                    return false;
+                }
+                emit(binaryOps.at(inst->getOp()), slots[inst], a, b);
+                break;
+            }
+
+            case IRInstOperator::IRINST_OP_MINUS_I:
+                if (!operand(inst->getOperand(0), a)) {
+                    return false;
+                }
+                emit(BytecodeOp::BC_NEG, slots[inst], a);
+                break;
+
+            case IRInstOperator::IRINST_OP_LOAD:
+                if (!operand(inst->getOperand(0), a)) {
+                    return false;
+                }
+                emit(BytecodeOp::BC_LOAD, slots[inst], a);
+                break;
+
+            case IRInstOperator::IRINST_OP_STORE:
+                if (!operand(inst->getOperand(0), a) || !operand(inst->getOperand(1), b)) {
+                    return false;
+                }
+                emit(BytecodeOp::BC_STORE, a, b);
+                break;
+
+            case IRInstOperator::IRINST_OP_ARG:
+                pendingArgs.push_back(inst->getOperand(0));
+                break;
+
+            case IRInstOperator::IRINST_OP_COUNTER: {
+                auto counterInst = static_cast<CounterInstruction *>(inst);
+                auto global = globalAddress.find(counterInst->getTable());
+                int64_t addr = (global == globalAddress.end()) ? 0 : global->second + (int64_t) counterInst->getIndex() * 4;
+                if (!validAddress(addr, 4)) {
+                    return error("函数" + funcName + "中的计数器不存在");
+                }
+                emit(BytecodeOp::BC_COUNTER, (int32_t) addr);
+                break;
+            }
+
+            case IRInstOperator::IRINST_OP_FUNC_CALL: {
+                auto callInst = static_cast<FuncCallInstruction *>(inst);
+                Function * callee = callInst->calledFunction;
+
+                // 没有实参的调用使用前面ARG指令给出的实参
+                std::vector<Value *> args;
+                for (int32_t k = 0; k < inst->getOperandsNum(); k++) {
+                    args.push_back(inst->getOperand(k));
+                }
+                if (args.empty()) {
+                    args.swap(pendingArgs);
+                }
+                pendingArgs.clear();
+
+                if (args.size() != callee->getParams().size()) {
+                    return error("函数" + funcName + "调用" + callee->getName() + "的实参个数不一致");
+                }
+
+                std::vector<int32_t> argSlots;
+                for (auto arg: args) {
+                    if (!operand(arg, a)) {
+                        return false;
+                    }
+                    argSlots.push_back(a);
+                }
+
+                int32_t argsPos = (int32_t) cf.callArgs.size();
+                cf.callArgs.push_back((int32_t) argSlots.size());
+                cf.callArgs.insert(cf.callArgs.end(), argSlots.begin(), argSlots.end());
+
+                int32_t dest = inst->hasResultValue() ? slots[inst] : -1;
+
+                if (callee->isBuiltin()) {
+                    int32_t id = -1;
+                    for (int32_t k = 0; k < (int32_t) (sizeof(builtinNames) / sizeof(builtinNames[0])); k++) {
+                        if (callee->getName() == builtinNames[k]) {
+                            id = k;
+                        }
+                    }
+                    if (id < 0) {
+                        return error("内置函数" + callee->getName() + "不支持");
+                    }
+                    emit(BytecodeOp::BC_CALL_BUILTIN, id, dest, argsPos);
+                } else {
+                    emit(BytecodeOp::BC_CALL, functionIndex[callee], dest, argsPos);
+                }
+                break;
+            }
+
+            default:
+                return error("函数" + funcName + "中的指令" + std::to_string((int) inst->getOp()) + "不支持");
+        }
+    }
+
+    if (cf.code.empty() || (cf.code.back().op != BytecodeOp::BC_RET)) {
+        return error("函数" + funcName + "没有出口指令");
+    }
+
+    // 回填跳转目标
+    size_t fixup = 0;
+    for (size_t index: jumpInsts) {
+        Bytecode & bc = cf.code[index];
+        int32_t * fields[2] = {&bc.a, &bc.c};
+        if (bc.op == BytecodeOp::BC_BR) {
+            fields[0] = &bc.b;
+        }
+        for (int k = 0; k < ((bc.op == BytecodeOp::BC_BR) ? 2 : 1); k++) {
+            auto iter = labelPos.find(jumpFixups[fixup++]);
+            if (iter == labelPos.end()) {
+                return error("函数" + funcName + "中的跳转目标不存在");
+            }
+            *fields[k] = iter->second;
+        }
+    }
+
+    // 常量槽放在最后，把-2-k换成真正的槽号。跳转目标、函数编号等都不小于-1，不会混淆
+    cf.constBase = slotCount;
+    cf.slotCount = slotCount + (int32_t) cf.constants.size();
+
+    auto relocate = [&cf](int32_t & field) {
+        if (field <= -2) {
+            field = cf.constBase + (-2 - field);
+        }
+    };
+
+    for (auto & bc: cf.code) {
+        if ((bc.op != BytecodeOp::BC_LOADG) && (bc.op != BytecodeOp::BC_STOREG) && (bc.op != BytecodeOp::BC_COUNTER)) {
+            relocate(bc.a);
+        }
+        relocate(bc.b);
+        relocate(bc.c);
+        if (handlers) {
+            bc.handler = handlers[(int) bc.op];
+        }
+    }
+
+    for (size_t k = 0; k < cf.callArgs.size(); k += cf.callArgs[k] + 1) {
+        for (int32_t j = 1; j <= cf.callArgs[k]; j++) {
+            relocate(cf.callArgs[k + j]);
+        }
+    }
+
+    return true;
+}
+
+///
+/// @brief 降级所有函数后从main函数开始执行
+/// @param exitValue main函数的返回值
+/// @return true：成功，false：降级或执行出错
+///
+bool IRInterpreter::run(int32_t & exitValue)
+{
+    memory = static_cast<uint8_t *>(calloc(MEMORY_SIZE, 1));
+    regs = static_cast<int32_t *>(calloc(REG_STACK_SIZE, sizeof(int32_t)));
+    if ((memory == nullptr) || (regs == nullptr)) {
+        return error("内存不足");
+    }
+
+    if (!layoutGlobals()) {
+        return false;
+    }
+
+    auto & funcList = module->getFunctionList();
+    functions.resize(funcList.size());
+    for (size_t k = 0; k < funcList.size(); k++) {
+        functions[k].func = funcList[k];
+        functionIndex[funcList[k]] = (int32_t) k;
+    }
+
+    int32_t mainIndex = -1;
+    for (auto & cf: functions) {
+        if (cf.func->isBuiltin()) {
+            continue;
+        }
+        if (!compile(cf)) {
+            return false;
+        }
+        if (cf.func->getName() == "main") {
+            mainIndex = functionIndex[cf.func];
+        }
+    }
+
+    if (mainIndex < 0) {
+        return error("没有main函数");
+    }
+
+    if (functions[mainIndex].paramCount != 0) {
+        return error("main函数不能有形参");
+    }
+
+    bool result = execute(mainIndex, exitValue);
+
+    fflush(stdout);
+
+    return result;
+}
+
+///
+/// @brief 执行内置函数
+/// @param id 内置函数编号
+/// @param args 实参
+/// @param argc 实参个数
+/// @param result 返回值
+/// @return true：成功，false：数组越界
+///
+bool IRInterpreter::callBuiltin(int32_t id, const int32_t * args, int32_t argc, int32_t & result)
+{
+    (void) argc;
+
+    result = 0;
+
+    switch (id) {
+        case 0:
+            // putint
+            printf("%d", args[0]);
+            break;
+        case 1:
+            // getint
+            if (scanf("%d", &result) != 1) {
+                result = 0;
+            }
+            break;
+        case 2:
+            // putch
+            putchar((char) args[0]);
+            break;
+        case 3: {
+            // getch
+            char c = 0;
+            if (scanf("%c", &c) == 1) {
+                result = c;
+            }
+            break;
+        }
+        case 4: {
+            // putarray
+            int32_t n = args[0];
+            if ((n > 0) && !validAddress(args[1], (int64_t) n * 4)) {
+                return error("putarray的数组越界");
+            }
+            printf("%d:", n);
+            for (int32_t k = 0; k < n; k++) {
+                int32_t val;
+                memcpy(&val, memory + args[1] + k * 4, sizeof(val));
+                printf(" %d", val);
+            }
+            printf("\n");
+            break;
+        }
+        case 5: {
+            // getarray
+            int32_t n = 0;
+            if (scanf("%d", &n) != 1) {
+                n = 0;
+            }
+            if ((n > 0) && !validAddress(args[0], (int64_t) n * 4)) {
+                return error("getarray的数组越界");
+            }
+            for (int32_t k = 0; k < n; k++) {
+                int32_t val = 0;
+                if (scanf("%d", &val) != 1) {
+                    val = 0;
+                }
+                memcpy(memory + args[0] + k * 4, &val, sizeof(val));
+            }
+            result = n;
+            break;
+        }
+        case 6: {
+            // __minic_prof_dump，与tests/std.c中的实现输出相同格式的剖析数据
+            int32_t n = args[1];
+            if ((n > 0) && !validAddress(args[2], (int64_t) n * 4)) {
+                return error("剖析计数器表越界");
+            }
+            const char * path = getenv("MINIC_PROFILE_FILE");
+            if ((path == nullptr) || (*path == '\0')) {
+                path = PROFILE_DEFAULT_FILE;
+            }
+            FILE * fp = fopen(path, "w");
+            if (fp == nullptr) {
+                return error(std::string("剖析数据文件") + path + "创建失败");
+            }
+            fprintf(fp, "%s %d %d\n", PROFILE_MAGIC, args[0], n);
+            for (int32_t k = 0; k < n; k++) {
+                uint32_t count;
+                memcpy(&count, memory + args[2] + k * 4, sizeof(count));
+                fprintf(fp, "%u\n", count);
+            }
+            fclose(fp);
+            break;
+        }
+        default:
+            break;
+    }
+
+    return true;
+}
+
+// 分派：直接线索化时跳到指令记录的处理代码，否则回到switch
+#ifdef MINIC_THREADED_DISPATCH
+#define INTERP_OP(name) L_##name:
+#define INTERP_DISPATCH() goto *pc->handler
+#else
+#define INTERP_OP(name) case BytecodeOp::name:
+#define INTERP_DISPATCH() continue
+#endif
+
+#define INTERP_NEXT()                                                                                                  \
+    ++pc;                                                                                                              \
+    INTERP_DISPATCH()
+
+// 整数运算按32位补码回绕，避免有符号溢出的未定义行为
+#define INTERP_ARITH(name, expr)                                                                                       \
+    INTERP_OP(name)                                                                                                    \
+    {                                                                                                                  \
+        uint32_t x = (uint32_t) r[pc->b], y = (uint32_t) r[pc->c];                                                     \
+        r[pc->a] = (int32_t) (expr);                                                                                   \
+        INTERP_NEXT();                                                                                                 \
+    }
+
+#define INTERP_CMP(name, cmp)                                                                                          \
+    INTERP_OP(name)                                                                                                    \
+    {                                                                                                                  \
+        r[pc->a] = (r[pc->b] cmp r[pc->c]) ? 1 : 0;                                                                    \
+        INTERP_NEXT();                                                                                                 \
+    }
+
+///
+/// @brief 执行函数
+/// @param entry 函数编号
+/// @param retValue 返回值
+/// @param table 非空时不执行，只取得直接线索化分派的处理代码地址表
+/// @return true：成功，false：运行时错误
+///
+bool IRInterpreter::execute(int32_t entry, int32_t & retValue, const void * const ** table)
+{
+#ifdef MINIC_THREADED_DISPATCH
+    // 与BytecodeOp的次序一致
+    static const void * const labels[(int) BytecodeOp::BC_MAX] = {
+        &&L_BC_MOV,    &&L_BC_ADD,   &&L_BC_SUB,    &&L_BC_MUL,    &&L_BC_DIV,    &&L_BC_MOD,
+        &&L_BC_NEG,    &&L_BC_LT,    &&L_BC_GT,     &&L_BC_LE,     &&L_BC_GE,     &&L_BC_EQ,
+        &&L_BC_NE,     &&L_BC_JMP,   &&L_BC_BR,     &&L_BC_LOAD,   &&L_BC_STORE,  &&L_BC_LOADG,
+        &&L_BC_STOREG, &&L_BC_CALL,  &&L_BC_CALL_BUILTIN, &&L_BC_RET, &&L_BC_COUNTER,
+    };
+
+    if (table) {
+        *table = labels;
+        return true;
+    }
+#else
+    (void) table;
+#endif
+
+    const CompiledFunction * cur = nullptr;
+    const Bytecode * pc = nullptr;
+    int32_t * r = regs;
+    int32_t sp = stackBase;
+    std::string msg;
+
+    frames.clear();
+
+    // 进入函数：复制常量槽，设置局部数组的地址，分配栈帧内存。实参已复制到nr的形参槽中
+    auto enter = [&](const CompiledFunction * callee, int32_t * nr) -> bool {
+        if ((nr + callee->slotCount > regs + REG_STACK_SIZE) || ((int64_t) sp + callee->frameBytes > MEMORY_SIZE)) {
+            return false;
+        }
+        if (!callee->constants.empty()) {
+            memcpy(nr + callee->constBase, callee->constants.data(), callee->constants.size() * sizeof(int32_t));
+        }
+        for (auto & slot: callee->arraySlots) {
+            nr[slot.first] = sp + slot.second;
+        }
+        sp += callee->frameBytes;
+        cur = callee;
+        r = nr;
+        pc = callee->code.data();
+        return true;
+    };
+
+    if (!enter(&functions[entry], regs)) {
+        return error("栈溢出");
+    }
+
+#ifdef MINIC_THREADED_DISPATCH
+    INTERP_DISPATCH();
+#else
+    for (;;) {
+        switch (pc->op) {
+#endif
+
+    INTERP_OP(BC_MOV)
+    {
+        r[pc->a] = r[pc->b];
+        INTERP_NEXT();
+    }
+
+    INTERP_ARITH(BC_ADD, x + y)
+    INTERP_ARITH(BC_SUB, x - y)
+    INTERP_ARITH(BC_MUL, x * y)
+
+    // 与ARM的sdiv一致：除数为0时商为0，INT_MIN/-1时商为INT_MIN。余数按a-(a/b)*b计算
+    INTERP_OP(BC_DIV)
+    INTERP_OP(BC_MOD)
+    {
+        int32_t x = r[pc->b], y = r[pc->c];
+        int32_t q;
+        if (y == 0) {
+            q = 0;
+        } else if ((y == -1) && (x == INT32_MIN)) {
+            q = INT32_MIN;
+        } else {
+            q = x / y;
+        }
+        r[pc->a] = (pc->op == BytecodeOp::BC_DIV) ? q : (int32_t) ((uint32_t) x - (uint32_t) q * (uint32_t) y);
+        INTERP_NEXT();
+    }
+
+    INTERP_OP(BC_NEG)
+    {
+        r[pc->a] = (int32_t) (0u - (uint32_t) r[pc->b]);
+        INTERP_NEXT();
+    }
+
+    INTERP_CMP(BC_LT, <)
+    INTERP_CMP(BC_GT, >)
+    INTERP_CMP(BC_LE, <=)
+    INTERP_CMP(BC_GE, >=)
+    INTERP_CMP(BC_EQ, ==)
+    INTERP_CMP(BC_NE, !=)
+
+    INTERP_OP(BC_JMP)
+    {
+        pc = cur->code.data() + pc->a;
+        INTERP_DISPATCH();
+    }
+
+    INTERP_OP(BC_BR)
+    {
+        pc = cur->code.data() + (r[pc->a] ? pc->b : pc->c);
+        INTERP_DISPATCH();
+    }
+
+    INTERP_OP(BC_LOAD)
+    {
+        int32_t addr = r[pc->b];
+        if (!validAddress(addr, 4)) {
+            msg = "读内存地址" + std::to_string(addr) + "越界";
+            goto lb_error;
+        }
+        memcpy(&r[pc->a], memory + addr, sizeof(int32_t));
+        INTERP_NEXT();
+    }
+
+    INTERP_OP(BC_STORE)
+    {
+        int32_t addr = r[pc->a];
+        if (!validAddress(addr, 4)) {
+            msg = "写内存地址" + std::to_string(addr) + "越界";
+            goto lb_error;
+        }
+        memcpy(memory + addr, &r[pc->b], sizeof(int32_t));
+        INTERP_NEXT();
+    }
+
+    INTERP_OP(BC_LOADG)
+    {
+        memcpy(&r[pc->a], memory + pc->b, sizeof(int32_t));
+        INTERP_NEXT();
+    }
+
+    INTERP_OP(BC_STOREG)
+    {
+        memcpy(memory + pc->a, &r[pc->b], sizeof(int32_t));
+        INTERP_NEXT();
+    }
+
+    INTERP_OP(BC_CALL)
+    {
+        const CompiledFunction * callee = &functions[pc->a];
+        const int32_t * args = cur->callArgs.data() + pc->c;
+        int32_t * nr = r + cur->slotCount;
+
+        if (nr + args[0] > regs + REG_STACK_SIZE) {
+            msg = "栈溢出";
+            goto lb_error;
+        }
+        for (int32_t k = 0; k < args[0]; k++) {
+            nr[k] = r[args[k + 1]];
+        }
+
+        frames.push_back({cur, pc + 1, r, sp, pc->b});
+
+        if (!enter(callee, nr)) {
+            msg = "栈溢出";
+            goto lb_error;
+        }
+        INTERP_DISPATCH();
+    }
+
+    INTERP_OP(BC_CALL_BUILTIN)
+    {
+        const int32_t * args = cur->callArgs.data() + pc->c;
+        int32_t argv[BUILTIN_MAX_ARGS] = {0, 0, 0};
+        for (int32_t k = 0; (k < args[0]) && (k < BUILTIN_MAX_ARGS); k++) {
+            argv[k] = r[args[k + 1]];
+        }
+
+        int32_t result;
+        if (!callBuiltin(pc->a, argv, args[0], result)) {
+            return false;
+        }
+        if (pc->b >= 0) {
+            r[pc->b] = result;
+        }
+        INTERP_NEXT();
+    }
+
+    INTERP_OP(BC_RET)
+    {
+        int32_t value = (pc->a >= 0) ? r[pc->a] : 0;
+
+        if (frames.empty()) {
+            retValue = value;
+            return true;
+        }
+
+        Frame & frame = frames.back();
+        cur = frame.func;
+        pc = frame.pc;
+        r = frame.regs;
+        sp = frame.sp;
+        if (frame.dest >= 0) {
+            r[frame.dest] = value;
+        }
+        frames.pop_back();
+        INTERP_DISPATCH();
+    }
+
+    INTERP_OP(BC_COUNTER)
+    {
+        uint32_t count;
+        memcpy(&count, memory + pc->a, sizeof(count));
+        count++;
+        memcpy(memory + pc->a, &count, sizeof(count));
+        INTERP_NEXT();
+    }
+
+#ifndef MINIC_THREADED_DISPATCH
+            default:
+                msg = "非法的字节码";
+                goto lb_error;
+        }
+    }
+#endif
+
+lb_error:
+    return error("函数" + cur->func->getName() + "中" + msg);
+}
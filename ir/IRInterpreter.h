@@ -0,0 +1,255 @@
+///
+/// @file IRInterpreter.h
+/// @brief DragonIR的解释执行器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析计数指令
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Module.h"
+
+/// @brief 解释执行的字节码操作码
+enum class BytecodeOp : std::uint8_t {
+    /// @brief a = b
+    BC_MOV,
+
+    /// @brief a = b op c，整数运算按32位补码回绕
+    BC_ADD,
+    BC_SUB,
+    BC_MUL,
+    BC_DIV,
+    BC_MOD,
+
+    /// @brief a = -b
+    BC_NEG,
+
+    /// @brief a = (b cmp c) ? 1 : 0
+    BC_LT,
+    BC_GT,
+    BC_LE,
+    BC_GE,
+    BC_EQ,
+    BC_NE,
+
+    /// @brief 跳转到a
+    BC_JMP,
+
+    /// @brief a非0时跳转到b，否则跳转到c
+    BC_BR,
+
+    /// @brief a = *b
+    BC_LOAD,
+
+    /// @brief *a = b
+    BC_STORE,
+
+    /// @brief a = 全局变量，b为全局变量的地址
+    BC_LOADG,
+
+    /// @brief 全局变量 = b，a为全局变量的地址
+    BC_STOREG,
+
+    /// @brief 调用函数，a为函数编号，b为保存返回值的槽（-1为没有），c为实参表的位置
+    BC_CALL,
+
+    /// @brief 调用内置函数，a为内置函数编号，b、c同BC_CALL
+    BC_CALL_BUILTIN,
+
+    /// @brief 返回a（-1为没有返回值）
+    BC_RET,
+
+    /// @brief 剖析计数，地址为a的计数器加一
+    BC_COUNTER,
+
+    BC_MAX,
+};
+
+/// @brief 字节码指令
+struct Bytecode {
+
+    /// @brief 直接线索化分派时为处理代码的地址
+    const void * handler;
+
+    /// @brief 操作码
+    BytecodeOp op;
+
+    /// @brief 操作数，槽号、跳转目标、立即数等，含义由操作码决定
+    int32_t a;
+    int32_t b;
+    int32_t c;
+};
+
+///
+/// @brief DragonIR的解释执行器
+///
+/// 每个函数的InterCode先降级为寄存器机器的字节码：Value操作数变为栈帧内的槽号，常量与全局数组的地址放在
+/// 栈帧末尾的常量槽中，Label变为字节码的下标。执行时用computed goto直接线索化分派（不支持时用switch）。
+/// 数组与全局变量位于一块线性内存中，地址为32位偏移，与ARM32的指针宽度相同。
+///
+class IRInterpreter {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 要执行的模块，所有函数体必须已加载
+    ///
+    explicit IRInterpreter(Module * _module);
+
+    ///
+    /// @brief 析构函数
+    ///
+    ~IRInterpreter();
+
+    IRInterpreter(const IRInterpreter &) = delete;
+    IRInterpreter & operator=(const IRInterpreter &) = delete;
+
+    ///
+    /// @brief 降级所有函数后从main函数开始执行
+    /// @param exitValue main函数的返回值
+    /// @return true：成功，false：降级或执行出错
+    ///
+    bool run(int32_t & exitValue);
+
+protected:
+    ///
+    /// @brief 降级后的函数
+    ///
+    struct CompiledFunction {
+        /// @brief 函数
+        Function * func = nullptr;
+
+        /// @brief 字节码
+        std::vector<Bytecode> code;
+
+        /// @brief 形参个数，形参占用最前面的槽
+        int32_t paramCount = 0;
+
+        /// @brief 槽的总数
+        int32_t slotCount = 0;
+
+        /// @brief 第一个常量槽
+        int32_t constBase = 0;
+
+        /// @brief 常量槽的初值，进入函数时复制
+        std::vector<int32_t> constants;
+
+        /// @brief 局部数组的槽与在栈帧内存中的偏移，进入函数时槽中设置数组的地址
+        std::vector<std::pair<int32_t, int32_t>> arraySlots;
+
+        /// @brief 局部数组占用的栈帧内存字节数
+        int32_t frameBytes = 0;
+
+        /// @brief 各调用的实参表，每个表先是实参个数，再是各实参的槽号
+        std::vector<int32_t> callArgs;
+    };
+
+    ///
+    /// @brief 调用的返回信息
+    ///
+    struct Frame {
+        /// @brief 调用者
+        const CompiledFunction * func;
+
+        /// @brief 返回后继续执行的指令
+        const Bytecode * pc;
+
+        /// @brief 调用者的槽
+        int32_t * regs;
+
+        /// @brief 调用前的栈顶
+        int32_t sp;
+
+        /// @brief 保存返回值的槽，-1为没有
+        int32_t dest;
+    };
+
+    ///
+    /// @brief 为全局变量分配内存并设置初值
+    /// @return true：成功，false：内存不足
+    ///
+    bool layoutGlobals();
+
+    ///
+    /// @brief 把函数的IR降级为字节码
+    /// @param cf 降级后的函数，func已设置
+    /// @return true：成功，false：有不支持的IR
+    ///
+    bool compile(CompiledFunction & cf);
+
+    ///
+    /// @brief 执行函数
+    /// @param entry 函数编号
+    /// @param retValue 返回值
+    /// @param table 非空时不执行，只取得直接线索化分派的处理代码地址表
+    /// @return true：成功，false：运行时错误
+    ///
+    bool execute(int32_t entry, int32_t & retValue, const void * const ** table = nullptr);
+
+    ///
+    /// @brief 执行内置函数
+    /// @param id 内置函数编号
+    /// @param args 实参
+    /// @param argc 实参个数
+    /// @param result 返回值
+    /// @return true：成功，false：数组越界
+    ///
+    bool callBuiltin(int32_t id, const int32_t * args, int32_t argc, int32_t & result);
+
+    ///
+    /// @brief 检查一段内存是否可以访问
+    /// @param addr 地址
+    /// @param size 字节数
+    /// @return true：可以，false：越界
+    ///
+    bool validAddress(int64_t addr, int64_t size) const;
+
+    ///
+    /// @brief 运行时错误
+    /// @param msg 错误信息
+    /// @return false
+    ///
+    bool error(const std::string & msg);
+
+private:
+    /// @brief 要执行的模块
+    Module * module;
+
+    /// @brief 各函数降级后的结果，与Module的函数列表一一对应，内置函数没有字节码
+    std::vector<CompiledFunction> functions;
+
+    /// @brief 函数-编号
+    std::unordered_map<Function *, int32_t> functionIndex;
+
+    /// @brief 全局变量-地址
+    std::unordered_map<Value *, int32_t> globalAddress;
+
+    /// @brief 线性内存，全局变量在前，局部数组的栈在后
+    uint8_t * memory = nullptr;
+
+    /// @brief 局部数组栈的开始地址
+    int32_t stackBase = 0;
+
+    /// @brief 所有栈帧的槽
+    int32_t * regs = nullptr;
+
+    /// @brief 调用的返回信息
+    std::vector<Frame> frames;
+
+    /// @brief 直接线索化分派的处理代码地址表，按操作码索引，不支持时为空
+    const void * const * handlers = nullptr;
+};
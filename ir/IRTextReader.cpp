@@ -0,0 +1,825 @@
+///
+/// @file IRTextReader.cpp
+/// @brief 从文本形式的DragonIR文件加载模块的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>支持剖析计数指令
+/// </table>
+///
+#include <cstdlib>
+#include <unordered_set>
+
+#include "ArgInstruction.h"
+#include "ArrayType.h"
+#include "BinaryInstruction.h"
+#include "BranchInstruction.h"
+#include "Common.h"
+#include "CounterInstruction.h"
+#include "EntryInstruction.h"
+#include "ExitInstruction.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "IntegerType.h"
+#include "IRConstant.h"
+#include "IRTextReader.h"
+#include "LabelInstruction.h"
+#include "LoadInstruction.h"
+#include "MoveInstruction.h"
+#include "PointerType.h"
+#include "StoreInstruction.h"
+#include "UnaryInstruction.h"
+#include "VoidType.h"
+
+///
+/// @brief 去掉首尾的空白
+/// @param s 字符串
+/// @return std::string_view 去掉空白后的字符串
+///
+static std::string_view trim(std::string_view s)
+{
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+
+    return s.substr(begin, s.find_last_not_of(" \t\r") - begin + 1);
+}
+
+///
+/// @brief 取出下一个单词。逗号与括号单独成为单词，其它单词以空白分隔
+/// @param s 字符串，取出后指向剩余部分
+/// @return std::string_view 单词，没有时为空
+///
+static std::string_view nextToken(std::string_view & s)
+{
+    s = trim(s);
+    if (s.empty()) {
+        return {};
+    }
+
+    size_t len = 1;
+    if ((s[0] != ',') && (s[0] != '(') && (s[0] != ')')) {
+        len = s.find_first_of(" \t,()");
+        if (len == std::string_view::npos) {
+            len = s.size();
+        }
+    }
+
+    std::string_view token = s.substr(0, len);
+    s.remove_prefix(len);
+
+    return token;
+}
+
+///
+/// @brief 解析整数
+/// @param s 字符串
+/// @param val 整数值
+/// @return true：成功，false：不是int32范围内的整数
+///
+static bool parseInt(std::string_view s, int64_t & val)
+{
+    std::string str(s);
+    if (str.empty() || !(isDigital(str[0]) || (str[0] == '-'))) {
+        return false;
+    }
+
+    char * end;
+    val = std::strtoll(str.c_str(), &end, 10);
+
+    return (*end == '\0') && (val >= INT32_MIN) && (val <= INT32_MAX);
+}
+
+///
+/// @brief 解析类型，即i32、i1、void后跟若干个*
+/// @param s 类型的字符串
+/// @return Type* 类型，无法识别时为空指针
+///
+static Type * parseType(std::string_view s)
+{
+    size_t pointerDepth = 0;
+    while (!s.empty() && (s.back() == '*')) {
+        s.remove_suffix(1);
+        pointerDepth++;
+    }
+
+    Type * type = nullptr;
+    if (s == "i32") {
+        type = IntegerType::getTypeInt();
+    } else if (s == "i1") {
+        type = IntegerType::getTypeBool();
+    } else if (s == "void") {
+        type = VoidType::getType();
+    } else {
+        return nullptr;
+    }
+
+    for (size_t k = 0; k < pointerDepth; ++k) {
+        type = (Type *) PointerType::get(type);
+    }
+
+    return type;
+}
+
+///
+/// @brief 解析带维度的名字，如%l1[10][20]。有维度时变量的类型为指向数组的指针
+/// @param s 带维度的名字
+/// @param type 元素类型，有维度时改为指向数组的指针
+/// @param name 名字
+/// @return true：成功，false：维度无效
+///
+static bool parseDeclName(std::string_view s, Type *& type, std::string_view & name)
+{
+    size_t bracket = s.find('[');
+    name = s.substr(0, bracket);
+    if (bracket == std::string_view::npos) {
+        return !name.empty();
+    }
+
+    std::vector<uint64_t> dims;
+    std::string_view rest = s.substr(bracket);
+    while (!rest.empty()) {
+        size_t close = rest.find(']');
+        int64_t dim;
+        if ((rest[0] != '[') || (close == std::string_view::npos) || !parseInt(rest.substr(1, close - 1), dim) ||
+            (dim < 0)) {
+            return false;
+        }
+        dims.push_back((uint64_t) dim);
+        rest.remove_prefix(close + 1);
+    }
+
+    // 从最内层的维度开始构造数组类型
+    for (auto iter = dims.rbegin(); iter != dims.rend(); ++iter) {
+        type = (Type *) ArrayType::get(type, *iter);
+    }
+    type = (Type *) PointerType::get(type);
+
+    return !name.empty();
+}
+
+///
+/// @brief 赋值号右侧的第一个单词是否表明指令产生值，否则为赋值指令
+/// @param keyword 赋值号右侧的第一个单词
+/// @return true：产生值的指令，false：赋值指令
+///
+static bool isValueInst(std::string_view keyword)
+{
+    return !keyword.empty() && ((keyword[0] == '*') || (keyword == "add") || (keyword == "sub") ||
+                                (keyword == "mul") || (keyword == "div") || (keyword == "mod") ||
+                                (keyword == "icmp") || (keyword == "neg") || (keyword == "call"));
+}
+
+///
+/// @brief 去掉行尾;开始的注释
+/// @param s 行
+/// @param comment 注释的内容
+/// @return std::string_view 去掉注释后的行
+///
+static std::string_view stripComment(std::string_view s, std::string_view & comment)
+{
+    size_t pos = s.find(';');
+    if (pos == std::string_view::npos) {
+        comment = {};
+        return s;
+    }
+
+    comment = trim(s.substr(pos + 1));
+    return trim(s.substr(0, pos));
+}
+
+///
+/// @brief 构造函数
+/// @param _module 加载到的模块
+///
+IRTextReader::IRTextReader(Module * _module) : module(_module)
+{}
+
+///
+/// @brief 根据扩展名检查文件是否是文本IR文件
+/// @param filePath 文件路径
+/// @return true：是，false：不是
+///
+bool IRTextReader::isTextIR(const std::string & filePath)
+{
+    const std::string ext = ".ir";
+
+    return (filePath.size() > ext.size()) && (filePath.compare(filePath.size() - ext.size(), ext.size(), ext) == 0);
+}
+
+///
+/// @brief 输出带行号的错误信息
+/// @param line 行
+/// @param msg 错误信息
+/// @return false
+///
+bool IRTextReader::error(const Line & line, const std::string & msg)
+{
+    minic_log(LOG_ERROR, "第%d行: %s", line.lineNo, msg.c_str());
+    return false;
+}
+
+///
+/// @brief 根据名字查找函数内可用的Value，整数为常量
+/// @param name 名字
+/// @return Value* 找不到时为空指针
+///
+Value * IRTextReader::findValue(std::string_view name)
+{
+    int64_t val;
+    if (parseInt(name, val)) {
+        return module->newConstInt((int32_t) val);
+    }
+
+    auto & table = (!name.empty() && (name[0] == '@')) ? globals : locals;
+
+    auto iter = table.find(name);
+
+    return iter == table.end() ? nullptr : iter->second;
+}
+
+///
+/// @brief 读取全局变量的声明，形如declare i32 @a[10]或者declare i32 @b = 5
+/// @param line 行
+/// @return true：成功，false：失败
+///
+bool IRTextReader::readGlobal(const Line & line)
+{
+    std::string_view rest = line.text;
+    (void) nextToken(rest);
+
+    Type * type = parseType(nextToken(rest));
+    std::string_view name;
+    if (!type || !parseDeclName(nextToken(rest), type, name) || (name[0] != '@')) {
+        return error(line, "全局变量的声明无效");
+    }
+
+    bool hasInit = false;
+    int64_t initVal = 0;
+    if (!rest.empty()) {
+        if ((nextToken(rest) != "=") || !parseInt(nextToken(rest), initVal) || !rest.empty()) {
+            return error(line, "全局变量的初值无效");
+        }
+        hasInit = true;
+    }
+
+    Instanceof(var, GlobalVariable *, module->newVarValue(type, std::string(name.substr(1))));
+    if (var == nullptr) {
+        return error(line, "全局变量" + std::string(name) + "无效或者重复定义");
+    }
+
+    if (hasInit) {
+        var->setInitVal(module->newConstInt((int32_t) initVal));
+    }
+
+    globals.emplace(name, var);
+
+    return true;
+}
+
+///
+/// @brief 读取函数定义的函数头，形如define i32 @f(i32 %t0, i32 %t1[0][10])
+/// @param line 行
+/// @param range 函数定义的位置，函数与形参名字在这里设置
+/// @return true：成功，false：失败
+///
+bool IRTextReader::readFunctionHeader(const Line & line, FunctionRange & range)
+{
+    std::string_view rest = line.text;
+    (void) nextToken(rest);
+
+    Type * returnType = parseType(nextToken(rest));
+    std::string_view name = nextToken(rest);
+    if (!returnType || (name.size() < 2) || (name[0] != '@') || (nextToken(rest) != "(")) {
+        return error(line, "函数头无效");
+    }
+
+    // 形参在函数创建后加入，与IRGenerator翻译函数声明时相同
+    std::vector<FormalParam *> params;
+
+    bool valid = true;
+    if (trim(rest).substr(0, 1) == ")") {
+        (void) nextToken(rest);
+    } else {
+        for (;;) {
+            Type * type = parseType(nextToken(rest));
+            std::string_view paramName;
+            if (!type || !parseDeclName(nextToken(rest), type, paramName)) {
+                valid = false;
+                break;
+            }
+
+            params.push_back(new FormalParam(type, ""));
+            range.paramNames.push_back(paramName);
+
+            std::string_view sep = nextToken(rest);
+            if (sep == ")") {
+                break;
+            } else if (sep != ",") {
+                valid = false;
+                break;
+            }
+        }
+    }
+
+    Function * func = nullptr;
+    if (valid && rest.empty()) {
+        func = module->newFunction(std::string(name.substr(1)), returnType);
+    }
+
+    if (func == nullptr) {
+        for (auto param: params) {
+            delete param;
+        }
+        return error(line, valid ? "函数" + std::string(name) + "重复定义" : "函数的形参无效");
+    }
+
+    func->getParams().assign(params.begin(), params.end());
+    range.func = func;
+
+    return true;
+}
+
+///
+/// @brief 读取函数体，先创建局部变量与所有的Label，再按次序创建指令
+/// @param range 函数定义的位置
+/// @return true：成功，false：失败
+///
+bool IRTextReader::readFunctionBody(const FunctionRange & range)
+{
+    Function * func = range.func;
+
+    locals.clear();
+    for (size_t k = 0; k < range.paramNames.size(); ++k) {
+        if (!locals.emplace(range.paramNames[k], func->getParams()[k]).second) {
+            return error(lines[range.begin - 1], "形参" + std::string(range.paramNames[k]) + "重复");
+        }
+    }
+
+    // 产生值的指令的名字也有declare语句，先找出这些名字，其余的declare语句为局部变量
+    std::unordered_set<std::string_view> results;
+    for (size_t k = range.begin; k < range.end; ++k) {
+
+        std::string_view comment;
+        std::string_view text = stripComment(lines[k].text, comment);
+
+        size_t eq = text.find(" = ");
+        if ((eq == std::string_view::npos) || text.empty() || (text[0] == '*') || (text.substr(0, 8) == IR_KEYWORD_DECLARE " ")) {
+            continue;
+        }
+
+        std::string_view rhs = text.substr(eq + 3);
+        if (isValueInst(nextToken(rhs))) {
+            results.insert(trim(text.substr(0, eq)));
+        }
+    }
+
+    // 局部变量与指令结果的类型
+    std::unordered_map<std::string_view, Type *> resultTypes;
+
+    // Label可能在定义前被跳转指令引用，先全部创建
+    std::unordered_map<std::string_view, Instruction *> labels;
+    std::unordered_set<Instruction *> placedLabels;
+
+    bool ok = true;
+
+    for (size_t k = range.begin; ok && (k < range.end); ++k) {
+
+        const Line & line = lines[k];
+        std::string_view comment;
+        std::string_view text = stripComment(line.text, comment);
+
+        if (text.empty()) {
+            continue;
+        } else if (text.back() == ':') {
+            std::string_view name = text.substr(0, text.size() - 1);
+            if (labels.count(name)) {
+                ok = error(line, "Label" + std::string(name) + "重复定义");
+            } else {
+                labels.emplace(name, new LabelInstruction(func));
+            }
+            continue;
+        }
+
+        std::string_view rest = text;
+        if (nextToken(rest) != IR_KEYWORD_DECLARE) {
+            continue;
+        }
+
+        Type * type = parseType(nextToken(rest));
+        std::string_view name;
+        if (!type || !parseDeclName(nextToken(rest), type, name) || !rest.empty() ||
+            ((name[0] != '%') && (name[0] != '@'))) {
+            ok = error(line, "变量的声明无效");
+            break;
+        }
+
+        if (results.count(name)) {
+            resultTypes[name] = type;
+            continue;
+        }
+
+        // 注释为作用域层级与源程序中的名字，如; 1:a
+        int64_t scopeLevel = 1;
+        std::string realName;
+        if (!comment.empty()) {
+            size_t colon = comment.find(':');
+            if ((colon == std::string_view::npos) || !parseInt(comment.substr(0, colon), scopeLevel)) {
+                ok = error(line, "变量的注释无效");
+                break;
+            }
+            realName = std::string(comment.substr(colon + 1));
+        }
+
+        if (!locals.emplace(name, func->newLocalVarValue(type, realName, (int32_t) scopeLevel)).second) {
+            ok = error(line, "变量" + std::string(name) + "重复定义");
+        }
+    }
+
+    // 依次创建指令，ARG指令的实参在之后的函数调用中使用
+    InterCode & irCode = func->getInterCode();
+    std::vector<Value *> pendingArgs;
+
+    auto findLabel = [&](std::string_view name) -> Instruction * {
+        auto iter = labels.find(name);
+        return iter == labels.end() ? nullptr : iter->second;
+    };
+
+    for (size_t k = range.begin; ok && (k < range.end); ++k) {
+
+        const Line & line = lines[k];
+        std::string_view comment;
+        std::string_view text = stripComment(line.text, comment);
+
+        if (text.empty()) {
+            continue;
+        } else if (text.back() == ':') {
+            Instruction * label = findLabel(text.substr(0, text.size() - 1));
+            irCode.addInst(label);
+            placedLabels.insert(label);
+            continue;
+        }
+
+        std::string_view rest = text;
+        std::string_view keyword = nextToken(rest);
+        if (keyword == IR_KEYWORD_DECLARE) {
+            continue;
+        }
+
+        // 操作数依次解析，有一个无效则整条指令无效
+        bool valid = true;
+        auto operand = [&]() -> Value * {
+            std::string_view name = nextToken(rest);
+            Value * val = findValue(name);
+            if (valid && (val == nullptr)) {
+                valid = false;
+                error(line, "值" + std::string(name) + "未定义");
+            }
+            return val;
+        };
+        auto expect = [&](std::string_view token) {
+            if (valid && (nextToken(rest) != token)) {
+                valid = false;
+                error(line, "缺少" + std::string(token));
+            }
+        };
+        auto label = [&]() -> Instruction * {
+            expect("label");
+            std::string_view name = nextToken(rest);
+            Instruction * target = findLabel(name);
+            if (valid && (target == nullptr)) {
+                valid = false;
+                error(line, "Label" + std::string(name) + "未定义");
+            }
+            return target;
+        };
+
+        // 函数调用的被调用函数与实参，实参形如i32 %t1，只有值有用
+        auto call = [&](Type *& type) -> Instruction * {
+            (void) nextToken(rest);
+            std::string_view name = nextToken(rest);
+            Function * callee = (name.size() > 1) ? module->findFunction(std::string(name.substr(1))) : nullptr;
+            if (callee == nullptr) {
+                valid = false;
+                error(line, "函数" + std::string(name) + "未定义");
+                return nullptr;
+            }
+
+            expect("(");
+
+            std::vector<Value *> args;
+            std::string_view last;
+            while (valid) {
+                std::string_view token = nextToken(rest);
+                if (token.empty()) {
+                    expect(")");
+                } else if ((token == ",") || (token == ")")) {
+                    if (!last.empty()) {
+                        Value * arg = findValue(last);
+                        if (arg == nullptr) {
+                            valid = false;
+                            error(line, "值" + std::string(last) + "未定义");
+                        }
+                        args.push_back(arg);
+                    }
+                    last = {};
+                    if (token == ")") {
+                        break;
+                    }
+                } else {
+                    last = token;
+                }
+            }
+
+            if (!valid) {
+                return nullptr;
+            }
+
+            // 没有列出实参时，实参由之前的ARG指令给出
+            if (args.empty()) {
+                args.swap(pendingArgs);
+            }
+            pendingArgs.clear();
+
+            func->setExistFuncCall(true);
+            if ((int32_t) args.size() > func->getMaxFuncCallArgCnt()) {
+                func->setMaxFuncCallArgCnt((int32_t) args.size());
+            }
+
+            type = callee->getReturnType();
+
+            return new FuncCallInstruction(func, callee, args, type);
+        };
+
+        Instruction * inst = nullptr;
+
+        if (keyword == "entry") {
+            inst = new EntryInstruction(func);
+        } else if (keyword == "exit") {
+            Value * val = trim(rest).empty() ? nullptr : operand();
+            if (valid) {
+                inst = new ExitInstruction(func, val);
+
+                // 出口指令前的Label为函数的出口，返回值保存在局部变量中
+                if (!irCode.getInsts().empty() && placedLabels.count(irCode.getInsts().back())) {
+                    func->setExitLabel(irCode.getInsts().back());
+                }
+                Instanceof(retVal, LocalVariable *, val);
+                func->setReturnValue(retVal);
+            }
+        } else if (keyword == "br") {
+            Instruction * target = label();
+            if (valid) {
+                inst = new GotoInstruction(func, target);
+            }
+        } else if (keyword == "bc") {
+            Value * cond = operand();
+            expect(",");
+            Instruction * target1 = label();
+            expect(",");
+            Instruction * target2 = label();
+            if (valid) {
+                inst = new BranchInstruction(func, cond, target1, target2);
+            }
+        } else if (keyword == "arg") {
+            Value * val = operand();
+            if (valid) {
+                inst = new ArgInstruction(func, val);
+                pendingArgs.push_back(val);
+            }
+        } else if (keyword == "call") {
+            Type * type;
+            inst = call(type);
+        } else if (keyword == IR_KEYWORD_COUNTER) {
+            // 剖析计数，counter @table, 3
+            Value * table = operand();
+            expect(",");
+            Value * index = operand();
+            Instanceof(indexVal, ConstInt *, index);
+            if (valid && (indexVal == nullptr)) {
+                valid = false;
+                error(line, "计数器的下标必须是常量");
+            }
+            if (valid) {
+                inst = new CounterInstruction(func, table, indexVal);
+            }
+        } else if (keyword[0] == '*') {
+            // 通过指针写内存，*%t1 = %t2
+            rest = text.substr(1);
+            Value * addr = operand();
+            expect("=");
+            Value * val = operand();
+            if (valid) {
+                inst = new StoreInstruction(func, addr, val);
+            }
+        } else {
+            std::string_view opName;
+            expect("=");
+            std::string_view rhs = rest;
+            opName = nextToken(rhs);
+
+            if (!valid) {
+                // 已输出错误信息
+            } else if (!isValueInst(opName)) {
+                // 赋值，%l1 = %t2
+                Value * dst = findValue(keyword);
+                Value * src = operand();
+                if (valid && (dst == nullptr)) {
+                    valid = false;
+                    error(line, "值" + std::string(keyword) + "未定义");
+                }
+                if (valid) {
+                    inst = new MoveInstruction(func, dst, src);
+                }
+            } else if (locals.count(keyword)) {
+                valid = false;
+                error(line, "值" + std::string(keyword) + "重复定义");
+            } else {
+                auto typeIter = resultTypes.find(keyword);
+                Type * type = (typeIter == resultTypes.end()) ? IntegerType::getTypeInt() : typeIter->second;
+
+                static const std::unordered_map<std::string_view, IRInstOperator> binaryOps = {
+                    {"add", IRInstOperator::IRINST_OP_ADD_I},
+                    {"sub", IRInstOperator::IRINST_OP_SUB_I},
+                    {"mul", IRInstOperator::IRINST_OP_MUL_I},
+                    {"div", IRInstOperator::IRINST_OP_DIV_I},
+                    {"mod", IRInstOperator::IRINST_OP_MOD_I},
+                };
+                static const std::unordered_map<std::string_view, IRInstOperator> compareOps = {
+                    {"lt", IRInstOperator::IRINST_OP_LT_I},
+                    {"gt", IRInstOperator::IRINST_OP_GT_I},
+                    {"le", IRInstOperator::IRINST_OP_LE_I},
+                    {"ge", IRInstOperator::IRINST_OP_GE_I},
+                    {"eq", IRInstOperator::IRINST_OP_EQ_I},
+                    {"ne", IRInstOperator::IRINST_OP_NE_I},
+                };
+
+                IRInstOperator op = IRInstOperator::IRINST_OP_MAX;
+                if (binaryOps.count(opName)) {
+                    (void) nextToken(rest);
+                    op = binaryOps.at(opName);
+                } else if (opName == "icmp") {
+                    (void) nextToken(rest);
+                    auto iter = compareOps.find(nextToken(rest));
+                    if (iter == compareOps.end()) {
+                        valid = false;
+                        error(line, "比较运算无效");
+                    } else {
+                        op = iter->second;
+                        if (typeIter == resultTypes.end()) {
+                            type = IntegerType::getTypeBool();
+                        }
+                    }
+                }
+
+                if (op != IRInstOperator::IRINST_OP_MAX) {
+                    Value * src1 = operand();
+                    expect(",");
+                    Value * src2 = operand();
+                    if (valid) {
+                        inst = new BinaryInstruction(func, op, src1, src2, type);
+                    }
+                } else if (!valid) {
+                    // 已输出错误信息
+                } else if (opName == "neg") {
+                    (void) nextToken(rest);
+                    Value * src = operand();
+                    if (valid) {
+                        inst = new UnaryInstruction(func, IRInstOperator::IRINST_OP_MINUS_I, src, type);
+                    }
+                } else if (opName == "call") {
+                    (void) nextToken(rest);
+                    inst = call(type);
+                } else {
+                    // 通过指针读内存，%t2 = *%t1
+                    rest = trim(rest).substr(1);
+                    Value * addr = operand();
+                    if (valid) {
+                        inst = new LoadInstruction(func, addr, type);
+                    }
+                }
+
+                if (inst) {
+                    locals.emplace(keyword, inst);
+                }
+            }
+        }
+
+        if (inst && !trim(rest).empty()) {
+            valid = false;
+            error(line, "指令末尾有多余的内容");
+        }
+
+        if (inst == nullptr) {
+            if (valid) {
+                error(line, "无法识别的指令");
+            }
+            ok = false;
+            break;
+        }
+
+        if (!valid) {
+            inst->clearOperands();
+            delete inst;
+            ok = false;
+            break;
+        }
+
+        irCode.addInst(inst);
+    }
+
+    // 未加入函数的Label需要释放，跳转指令不是Label的使用者
+    if (!ok) {
+        for (auto & [name, inst]: labels) {
+            (void) name;
+            if (!placedLabels.count(inst)) {
+                delete inst;
+            }
+        }
+    }
+
+    return ok;
+}
+
+///
+/// @brief 加载文本IR文件
+/// @param filePath 文件路径
+/// @return true：成功，false：失败
+///
+bool IRTextReader::read(const std::string & filePath)
+{
+    if (!file.open(filePath)) {
+        minic_log(LOG_ERROR, "文件%s打开失败", filePath.c_str());
+        return false;
+    }
+
+    // 分行，去掉空行
+    std::string_view content(file.data(), file.size());
+    int lineNo = 0;
+    while (!content.empty()) {
+        size_t pos = content.find('\n');
+        std::string_view text = content.substr(0, pos);
+        content.remove_prefix(pos == std::string_view::npos ? content.size() : pos + 1);
+
+        lineNo++;
+        text = trim(text);
+        if (!text.empty()) {
+            lines.push_back({lineNo, text});
+        }
+    }
+
+    // 先读入全局变量与函数头，函数体可能调用其后定义的函数
+    std::vector<FunctionRange> ranges;
+
+    for (size_t k = 0; k < lines.size(); ++k) {
+
+        const Line & line = lines[k];
+        std::string_view rest = line.text;
+        std::string_view keyword = nextToken(rest);
+
+        if (keyword == IR_KEYWORD_DECLARE) {
+            if (!readGlobal(line)) {
+                return false;
+            }
+        } else if (keyword == IR_KEYWORD_DEFINE) {
+
+            FunctionRange range;
+            if (!readFunctionHeader(line, range)) {
+                return false;
+            }
+
+            if ((k + 1 >= lines.size()) || (lines[k + 1].text != "{")) {
+                return error(line, "函数定义缺少{");
+            }
+
+            range.begin = k + 2;
+            for (range.end = range.begin; (range.end < lines.size()) && (lines[range.end].text != "}"); ++range.end) {
+            }
+
+            if (range.end >= lines.size()) {
+                return error(line, "函数定义缺少}");
+            }
+
+            ranges.push_back(range);
+            k = range.end;
+        } else {
+            return error(line, "无法识别的内容");
+        }
+    }
+
+    for (auto & range: ranges) {
+        if (!readFunctionBody(range)) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,136 @@
+///
+/// @file IRTextReader.h
+/// @brief 从文本形式的DragonIR文件加载模块
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "MappedFile.h"
+#include "Module.h"
+
+///
+/// @brief 文本IR文件的加载，格式即Module::outputIR的输出
+///
+/// 先读入所有全局变量与函数的声明，再逐个函数创建局部变量与指令，因此函数可以调用其后定义的函数。
+/// 函数内的名字只在本函数内有效，加载后IR名字会在输出时重新命名。
+///
+class IRTextReader {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 加载到的模块
+    ///
+    explicit IRTextReader(Module * _module);
+
+    ///
+    /// @brief 根据扩展名检查文件是否是文本IR文件
+    /// @param filePath 文件路径
+    /// @return true：是，false：不是
+    ///
+    static bool isTextIR(const std::string & filePath);
+
+    ///
+    /// @brief 加载文本IR文件
+    /// @param filePath 文件路径
+    /// @return true：成功，false：失败
+    ///
+    bool read(const std::string & filePath);
+
+protected:
+    ///
+    /// @brief 文件中的一行
+    ///
+    struct Line {
+        /// @brief 行号
+        int lineNo;
+
+        /// @brief 去掉首尾空白后的内容
+        std::string_view text;
+    };
+
+    ///
+    /// @brief 函数定义在文件中的位置
+    ///
+    struct FunctionRange {
+        /// @brief 函数
+        Function * func;
+
+        /// @brief 形参的IR名字
+        std::vector<std::string_view> paramNames;
+
+        /// @brief 函数体的第一行，即{之后的一行
+        size_t begin;
+
+        /// @brief 函数体的结束行，即}所在的行
+        size_t end;
+    };
+
+    ///
+    /// @brief 读取全局变量的声明
+    /// @param line 行
+    /// @return true：成功，false：失败
+    ///
+    bool readGlobal(const Line & line);
+
+    ///
+    /// @brief 读取函数定义的函数头，创建函数与形参
+    /// @param line 行
+    /// @param range 函数定义的位置，函数与形参名字在这里设置
+    /// @return true：成功，false：失败
+    ///
+    bool readFunctionHeader(const Line & line, FunctionRange & range);
+
+    ///
+    /// @brief 读取函数体，创建局部变量与指令
+    /// @param range 函数定义的位置
+    /// @return true：成功，false：失败
+    ///
+    bool readFunctionBody(const FunctionRange & range);
+
+    ///
+    /// @brief 根据名字查找函数内可用的Value，整数为常量
+    /// @param name 名字
+    /// @return Value* 找不到时为空指针
+    ///
+    Value * findValue(std::string_view name);
+
+    ///
+    /// @brief 输出带行号的错误信息
+    /// @param line 行
+    /// @param msg 错误信息
+    /// @return false
+    ///
+    bool error(const Line & line, const std::string & msg);
+
+private:
+    /// @brief 加载到的模块
+    Module * module;
+
+    /// @brief 映射的文件，各行的内容都指向映射区
+    MappedFile file;
+
+    /// @brief 文件的各行，空行已去掉
+    std::vector<Line> lines;
+
+    /// @brief 全局变量的IR名字-全局变量
+    std::unordered_map<std::string_view, Value *> globals;
+
+    /// @brief 当前函数内的IR名字-形参、局部变量与指令
+    std::unordered_map<std::string_view, Value *> locals;
+};
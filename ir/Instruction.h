@@ -2,8 +2,8 @@
 /// @file Instruction.h
 /// @brief IR指令头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-11-21
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析计数指令
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>增加寄存器编号的设置
 /// </table>
 ///
 #pragma once
@@ -90,6 +92,9 @@ enum class IRInstOperator : std::int8_t {
     /// @brief store指令
     IRINST_OP_STORE,
 
+    /// @brief 剖析计数指令，插桩时产生
+    IRINST_OP_COUNTER,
+
     /// @brief 最大指令码，也是无效指令
     IRINST_OP_MAX
 };
@@ -153,6 +158,15 @@ public:
         return regId;
     }
 
+    ///
+    /// @brief 设置寄存器编号，寄存器分配时使用
+    /// @param _regId 寄存器编号
+    ///
+    void setRegId(int32_t _regId)
+    {
+        this->regId = _regId;
+    }
+
     ///
     /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
     /// @param regId 寄存器编号
@@ -2,8 +2,8 @@
 /// @file BranchInstruction.cpp
 /// @brief 分支跳转指令
 /// @author Syrix555 (2383402647@qq.com)
-/// @version 1.0
-/// @date 2025-05-11
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2025
 ///
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2025-05-11 <td>1.0     <td>Syrix  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析得到的跳转次数
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>增加剖析得到的跳转次数的获取
 /// </table>
 ///
 
@@ -43,6 +45,11 @@ void BranchInstruction::toString(std::string & str)
     Value * src = getOperand(0);
     
     str = "bc " + src->getIRName() + ", label " + target1->getIRName() + ", label " + target2->getIRName();
+
+    // 剖析数据以注释的形式输出
+    if (profiled) {
+        str += " ; profile " + std::to_string(trueCount) + ", " + std::to_string(falseCount);
+    }
 }
 
 ///
@@ -61,4 +68,56 @@ LabelInstruction * BranchInstruction::getTarget1() const
 LabelInstruction * BranchInstruction::getTarget2() const
 {
     return target2;
+}
+
+///
+/// @brief 设置剖析得到的两个目标的执行次数
+/// @param _trueCount 跳转到目标1的次数
+/// @param _falseCount 跳转到目标2的次数
+///
+void BranchInstruction::setProfile(uint64_t _trueCount, uint64_t _falseCount)
+{
+    trueCount = _trueCount;
+    falseCount = _falseCount;
+    profiled = true;
+}
+
+///
+/// @brief 是否有剖析数据
+/// @return true：有，false：没有
+///
+bool BranchInstruction::hasProfile() const
+{
+    return profiled;
+}
+
+///
+/// @brief 获取剖析得到的跳转到目标1的次数，没有剖析数据时为0
+/// @return uint64_t 次数
+///
+uint64_t BranchInstruction::getTrueCount() const
+{
+    return trueCount;
+}
+
+///
+/// @brief 获取剖析得到的跳转到目标2的次数，没有剖析数据时为0
+/// @return uint64_t 次数
+///
+uint64_t BranchInstruction::getFalseCount() const
+{
+    return falseCount;
+}
+
+///
+/// @brief 获取跳转到目标1的概率，没有剖析数据或者从未执行时为0.5
+/// @return double 概率
+///
+double BranchInstruction::getTrueProbability() const
+{
+    if (!profiled || (trueCount + falseCount == 0)) {
+        return 0.5;
+    }
+
+    return (double) trueCount / (double) (trueCount + falseCount);
 }
\ No newline at end of file
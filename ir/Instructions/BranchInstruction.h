@@ -2,8 +2,8 @@
 /// @file BranchInstruction.h
 /// @brief 分支跳转指令
 /// @author Syrix555 (2383402647@qq.com)
-/// @version 1.0
-/// @date 2025-05-11
+/// @version 1.2
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2025
 ///
@@ -11,6 +11,8 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2025-05-11 <td>1.0     <td>Syrix  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析得到的跳转次数
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>增加剖析得到的跳转次数的获取
 /// </table>
 ///
 #pragma once
@@ -52,10 +54,52 @@ class BranchInstruction final : public Instruction {
 		///
 		[[nodiscard]] LabelInstruction * getTarget2() const;
 
+        ///
+        /// @brief 设置剖析得到的两个目标的执行次数
+        /// @param trueCount 跳转到目标1的次数
+        /// @param falseCount 跳转到目标2的次数
+        ///
+        void setProfile(uint64_t trueCount, uint64_t falseCount);
+
+        ///
+        /// @brief 是否有剖析数据
+        /// @return true：有，false：没有
+        ///
+        [[nodiscard]] bool hasProfile() const;
+
+        ///
+        /// @brief 获取剖析得到的跳转到目标1的次数，没有剖析数据时为0
+        /// @return uint64_t 次数
+        ///
+        [[nodiscard]] uint64_t getTrueCount() const;
+
+        ///
+        /// @brief 获取剖析得到的跳转到目标2的次数，没有剖析数据时为0
+        /// @return uint64_t 次数
+        ///
+        [[nodiscard]] uint64_t getFalseCount() const;
+
+        ///
+        /// @brief 获取跳转到目标1的概率，没有剖析数据或者从未执行时为0.5
+        /// @return double 概率
+        ///
+        [[nodiscard]] double getTrueProbability() const;
+
 	private:
 		///
 		/// @brief 跳转到的目标Label指令
 		///
         LabelInstruction * target1;
         LabelInstruction * target2;
+
+        ///
+        /// @brief 剖析得到的跳转到目标1、目标2的次数
+        ///
+        uint64_t trueCount = 0;
+        uint64_t falseCount = 0;
+
+        ///
+        /// @brief 是否有剖析数据
+        ///
+        bool profiled = false;
 	};
\ No newline at end of file
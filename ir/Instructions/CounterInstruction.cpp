@@ -0,0 +1,57 @@
+///
+/// @file CounterInstruction.cpp
+/// @brief 剖析计数指令，插桩时插入，执行一次对应的计数器加一
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include "VoidType.h"
+
+#include "CounterInstruction.h"
+
+///
+/// @brief 剖析计数指令的构造函数
+/// @param _func 所属的函数
+/// @param _table 计数器表，int类型的全局数组
+/// @param _index 计数器在表中的下标
+///
+CounterInstruction::CounterInstruction(Function * _func, Value * _table, ConstInt * _index)
+    : Instruction(_func, IRInstOperator::IRINST_OP_COUNTER, VoidType::getType())
+{
+    addOperand(_table);
+    addOperand(_index);
+}
+
+/// @brief 转换成IR指令文本
+void CounterInstruction::toString(std::string & str)
+{
+    str = "counter " + getOperand(0)->getIRName() + ", " + getOperand(1)->getIRName();
+}
+
+///
+/// @brief 获取计数器表
+/// @return Value* 计数器表
+///
+Value * CounterInstruction::getTable()
+{
+    return getOperand(0);
+}
+
+///
+/// @brief 获取计数器在表中的下标
+/// @return int32_t 下标
+///
+int32_t CounterInstruction::getIndex()
+{
+    return static_cast<ConstInt *>(getOperand(1))->getVal();
+}
@@ -0,0 +1,54 @@
+///
+/// @file CounterInstruction.h
+/// @brief 剖析计数指令，插桩时插入，执行一次对应的计数器加一
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <string>
+
+#include "ConstInt.h"
+#include "Function.h"
+#include "GlobalVariable.h"
+#include "Instruction.h"
+
+///
+/// @brief 剖析计数指令，counter @table, k 使计数器表的第k个元素加一
+///
+class CounterInstruction final : public Instruction {
+
+public:
+    ///
+    /// @brief 剖析计数指令的构造函数
+    /// @param _func 所属的函数
+    /// @param _table 计数器表，int类型的全局数组
+    /// @param _index 计数器在表中的下标
+    ///
+    CounterInstruction(Function * _func, Value * _table, ConstInt * _index);
+
+    /// @brief 转换成字符串
+    void toString(std::string & str) override;
+
+    ///
+    /// @brief 获取计数器表
+    /// @return Value* 计数器表
+    ///
+    [[nodiscard]] Value * getTable();
+
+    ///
+    /// @brief 获取计数器在表中的下标
+    /// @return int32_t 下标
+    ///
+    [[nodiscard]] int32_t getIndex();
+};
@@ -0,0 +1,185 @@
+///
+/// @file Liveness.cpp
+/// @brief 基本块级的活跃变量分析
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "DataFlow.h"
+#include "FormalParam.h"
+#include "LocalVariable.h"
+#include "Liveness.h"
+#include "Use.h"
+
+///
+/// @brief 构造函数
+/// @param _cfg 控制流图
+///
+Liveness::Liveness(const ControlFlowGraph & _cfg) : cfg(_cfg)
+{}
+
+///
+/// @brief 是否是参与分析的值
+/// @param val 值
+/// @return true：是，false：不是
+///
+bool Liveness::isTracked(Value * val)
+{
+    if (auto inst = dynamic_cast<Instruction *>(val)) {
+        return inst->hasResultValue();
+    }
+
+    return (dynamic_cast<LocalVariable *>(val) != nullptr) || (dynamic_cast<FormalParam *>(val) != nullptr);
+}
+
+///
+/// @brief 获取指令定值的值，即有结果的指令本身或者赋值指令的目的操作数
+/// @param inst 指令
+/// @return Value* 参与分析的值，没有时为空指针
+///
+Value * Liveness::getDef(Instruction * inst)
+{
+    if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+        Value * dst = inst->getOperand(0);
+        return isTracked(dst) ? dst : nullptr;
+    }
+
+    return inst->hasResultValue() ? inst : nullptr;
+}
+
+///
+/// @brief 获取值的编号
+/// @param val 值
+/// @return int32_t 编号，全局值小于getGlobalCount()，不参与分析或者函数中没有出现时为-1
+///
+int32_t Liveness::getIndex(Value * val) const
+{
+    auto iter = indices.find(val);
+    return (iter == indices.end()) ? -1 : iter->second;
+}
+
+///
+/// @brief 为值编号，全局值在前
+///
+void Liveness::numberValues()
+{
+    std::vector<Instruction *> & insts = cfg.getFunction()->getInterCode().getInsts();
+    const std::vector<BasicBlock> & blocks = cfg.getBlocks();
+
+    // 先按出现的次序临时编号，同时找出向上暴露的值
+    std::unordered_map<Value *, int32_t> order;
+    std::vector<Value *> seen;
+    std::vector<int32_t> defBlock;
+    std::vector<bool> exposed;
+
+    // isTracked需要动态类型转换，每个值只判断一次，不参与的记为-1
+    auto number = [&](Value * val) {
+        auto result = order.emplace(val, (int32_t) seen.size());
+        if (result.second) {
+            if (!isTracked(val)) {
+                result.first->second = -1;
+                return -1;
+            }
+            seen.push_back(val);
+            defBlock.push_back(-1);
+            exposed.push_back(false);
+        }
+        return result.first->second;
+    };
+
+    for (const BasicBlock & block: blocks) {
+        for (size_t k = block.begin; k < block.end; k++) {
+
+            Instruction * inst = insts[k];
+            if (inst->isDead()) {
+                continue;
+            }
+
+            std::vector<Use *> & operands = inst->getOperands();
+            size_t first = (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) ? 1 : 0;
+            for (size_t u = first; u < operands.size(); u++) {
+                int32_t id = number(operands[u]->getUsee());
+                if ((id >= 0) && (defBlock[id] != block.index)) {
+                    exposed[id] = true;
+                }
+            }
+
+            Value * def = getDef(inst);
+            if (def) {
+                int32_t id = number(def);
+                defBlock[id] = block.index;
+            }
+        }
+    }
+
+    // 全局值在前，各自保持出现的次序
+    values.reserve(seen.size());
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t id = 0; id < seen.size(); id++) {
+            if (exposed[id] == (pass == 0)) {
+                indices[seen[id]] = (int32_t) values.size();
+                values.push_back(seen[id]);
+            }
+        }
+        if (pass == 0) {
+            globalCount = (int32_t) values.size();
+        }
+    }
+}
+
+///
+/// @brief 进行分析
+///
+void Liveness::run()
+{
+    numberValues();
+
+    std::vector<Instruction *> & insts = cfg.getFunction()->getInterCode().getInsts();
+    const std::vector<BasicBlock> & blocks = cfg.getBlocks();
+
+    // 后向、并集：out为后继in的并集，in = use | (out - def)
+    BitVectorDataFlow dataFlow(cfg, (size_t) globalCount, BitVectorDataFlow::Direction::BACKWARD,
+                               BitVectorDataFlow::Meet::UNION);
+
+    for (const BasicBlock & block: blocks) {
+
+        DynBitSet & use = dataFlow.gen[block.index];
+        DynBitSet & def = dataFlow.kill[block.index];
+
+        for (size_t k = block.begin; k < block.end; k++) {
+
+            Instruction * inst = insts[k];
+            if (inst->isDead()) {
+                continue;
+            }
+
+            std::vector<Use *> & operands = inst->getOperands();
+            size_t first = (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) ? 1 : 0;
+            for (size_t u = first; u < operands.size(); u++) {
+                int32_t id = getIndex(operands[u]->getUsee());
+                if ((id >= 0) && (id < globalCount) && !def.test((size_t) id)) {
+                    use.set((size_t) id);
+                }
+            }
+
+            Value * val = getDef(inst);
+            int32_t id = val ? getIndex(val) : -1;
+            if ((id >= 0) && (id < globalCount)) {
+                def.set((size_t) id);
+            }
+        }
+    }
+
+    evaluations = dataFlow.solve();
+
+    liveIn = std::move(dataFlow.in);
+    liveOut = std::move(dataFlow.out);
+}
@@ -0,0 +1,146 @@
+///
+/// @file Liveness.h
+/// @brief 基本块级的活跃变量分析
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "DynBitSet.h"
+
+///
+/// @brief 活跃变量分析，求各基本块入口与出口处活跃的值
+///
+/// 分析的值为有结果的指令（临时变量）、局部变量与形参，常量、全局变量、内存变量与物理寄存器不参与。
+/// 赋值指令的第一个操作数是定值，其余指令的操作数都是使用，有结果的指令定值其自身。
+///
+/// 只有在某个基本块中先使用后定值（向上暴露）的值才可能在基本块之间活跃，这类值称为全局值，
+/// 编号在前，其余的值只在基本块内活跃，编号在后。数据流只对全局值求解，位向量的长度为全局值的个数，
+/// 临时变量多为块内的值，十万个值的函数也只需很短的位向量。
+///
+/// 寄存器分配等需要指令级的活跃信息时，从基本块出口的活跃集合出发逆序扫描指令即可。
+///
+class Liveness {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _cfg 控制流图
+    ///
+    explicit Liveness(const ControlFlowGraph & _cfg);
+
+    ///
+    /// @brief 进行分析
+    ///
+    void run();
+
+    ///
+    /// @brief 是否是参与分析的值
+    /// @param val 值
+    /// @return true：是，false：不是
+    ///
+    static bool isTracked(Value * val);
+
+    ///
+    /// @brief 获取指令定值的值，即有结果的指令本身或者赋值指令的目的操作数
+    /// @param inst 指令
+    /// @return Value* 参与分析的值，没有时为空指针
+    ///
+    static Value * getDef(Instruction * inst);
+
+    ///
+    /// @brief 获取值的编号
+    /// @param val 值
+    /// @return int32_t 编号，全局值小于getGlobalCount()，不参与分析或者函数中没有出现时为-1
+    ///
+    [[nodiscard]] int32_t getIndex(Value * val) const;
+
+    ///
+    /// @brief 按编号获取值
+    /// @return std::vector<Value*>& 值，前getGlobalCount()个为全局值
+    ///
+    [[nodiscard]] const std::vector<Value *> & getValues() const
+    {
+        return values;
+    }
+
+    ///
+    /// @brief 获取全局值的个数，即活跃集合的位数
+    /// @return int32_t 个数
+    ///
+    [[nodiscard]] int32_t getGlobalCount() const
+    {
+        return globalCount;
+    }
+
+    ///
+    /// @brief 获取基本块入口处活跃的全局值
+    /// @param block 基本块编号
+    /// @return DynBitSet& 按编号的位集合
+    ///
+    [[nodiscard]] const DynBitSet & getLiveIn(int32_t block) const
+    {
+        return liveIn[block];
+    }
+
+    ///
+    /// @brief 获取基本块出口处活跃的全局值
+    /// @param block 基本块编号
+    /// @return DynBitSet& 按编号的位集合
+    ///
+    [[nodiscard]] const DynBitSet & getLiveOut(int32_t block) const
+    {
+        return liveOut[block];
+    }
+
+    ///
+    /// @brief 获取求解时传递函数的计算次数
+    /// @return int64_t 次数
+    ///
+    [[nodiscard]] int64_t getEvaluations() const
+    {
+        return evaluations;
+    }
+
+protected:
+    ///
+    /// @brief 为值编号，全局值在前
+    ///
+    void numberValues();
+
+private:
+    /// @brief 控制流图
+    const ControlFlowGraph & cfg;
+
+    /// @brief 值-编号
+    std::unordered_map<Value *, int32_t> indices;
+
+    /// @brief 编号-值
+    std::vector<Value *> values;
+
+    /// @brief 全局值的个数
+    int32_t globalCount = 0;
+
+    /// @brief 各基本块入口处活跃的全局值
+    std::vector<DynBitSet> liveIn;
+
+    /// @brief 各基本块出口处活跃的全局值
+    std::vector<DynBitSet> liveOut;
+
+    /// @brief 传递函数的计算次数
+    int64_t evaluations = 0;
+};
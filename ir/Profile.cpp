@@ -0,0 +1,272 @@
+///
+/// @file Profile.cpp
+/// @brief 剖析制导优化：插桩产生计数器，以及读入剖析数据标注到IR上
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "ArrayType.h"
+#include "Common.h"
+#include "CounterInstruction.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "IntegerType.h"
+#include "LabelInstruction.h"
+#include "PointerType.h"
+#include "Profile.h"
+#include "VoidType.h"
+
+///
+/// @brief 构造函数，计算模块的计数器编号，所有函数体必须已加载
+/// @param module 模块
+///
+ProfileLayout::ProfileLayout(Module * module)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const void * data, size_t size) {
+        for (size_t k = 0; k < size; k++) {
+            hash = (hash ^ static_cast<const uint8_t *>(data)[k]) * 16777619u;
+        }
+    };
+
+    for (auto func: module->getFunctionList()) {
+
+        if (func->isBuiltin()) {
+            continue;
+        }
+
+        FunctionCounters counters;
+        counters.func = func;
+        counters.base = total;
+
+        for (auto inst: func->getInterCode().getInsts()) {
+            if (inst->isDead()) {
+                continue;
+            }
+            if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+                counters.blocks.push_back(inst);
+            } else if (inst->getOp() == IRInstOperator::IRINST_OP_BRANCH) {
+                counters.branches.push_back(static_cast<BranchInstruction *>(inst));
+                counters.branchBlocks.push_back(std::max((int32_t) counters.blocks.size() - 1, 0));
+            }
+        }
+
+        const std::string name = func->getName();
+        uint32_t sizes[2] = {(uint32_t) counters.blocks.size(), (uint32_t) counters.branches.size()};
+        mix(name.data(), name.size() + 1);
+        mix(sizes, sizeof(sizes));
+
+        total += (int32_t) (counters.blocks.size() + counters.branches.size());
+        functions.push_back(std::move(counters));
+    }
+
+    checksum = (int32_t) (hash & 0x7FFFFFFF);
+}
+
+///
+/// @brief 构造函数
+/// @param _module 模块，所有函数体必须已加载
+///
+ProfileInstrumenter::ProfileInstrumenter(Module * _module) : module(_module)
+{}
+
+///
+/// @brief 插桩
+/// @return true：成功，false：没有main函数
+///
+bool ProfileInstrumenter::run()
+{
+    Function * mainFunc = module->findFunction("main");
+    if ((mainFunc == nullptr) || mainFunc->isBuiltin()) {
+        minic_log(LOG_ERROR, "剖析插桩需要main函数");
+        return false;
+    }
+
+    ProfileLayout layout(module);
+
+    // 计数器表，未初始化的全局数组在BSS段中，初值为0
+    Type * tableType =
+        (Type *) PointerType::get((Type *) ArrayType::get(IntegerType::getTypeInt(), (uint64_t) std::max(layout.total, 1)));
+    Instanceof(table, GlobalVariable *, module->newVarValue(tableType, IR_PROFILE_COUNTERS));
+    if (table == nullptr) {
+        minic_log(LOG_ERROR, "剖析插桩的计数器表%s已经存在", IR_PROFILE_COUNTERS);
+        return false;
+    }
+
+    for (auto & counters: layout.functions) {
+
+        Function * func = counters.func;
+        std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+        std::vector<Instruction *> newInsts;
+        newInsts.reserve(insts.size() + counters.blocks.size() + counters.branches.size() * 3);
+
+        auto newCounter = [&](int32_t index) {
+            return new CounterInstruction(func, table, module->newConstInt(counters.base + index));
+        };
+
+        int32_t blockIndex = 0;
+        int32_t branchIndex = 0;
+
+        for (size_t k = 0; k < insts.size(); k++) {
+
+            Instruction * inst = insts[k];
+            newInsts.push_back(inst);
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+
+                // 计数指令放在入口指令之后，第一个基本块还要在形参拷贝到局部变量之后，
+                // 这样ARM32的翻译中形参所在的寄存器不会被计数使用的寄存器覆盖
+                if ((k + 1 < insts.size()) && (insts[k + 1]->getOp() == IRInstOperator::IRINST_OP_ENTRY)) {
+                    newInsts.push_back(insts[++k]);
+                    while ((k + 1 < insts.size()) && (insts[k + 1]->getOp() == IRInstOperator::IRINST_OP_ASSIGN) &&
+                           (dynamic_cast<FormalParam *>(insts[k + 1]->getOperand(1)) != nullptr)) {
+                        newInsts.push_back(insts[++k]);
+                    }
+                }
+
+                newInsts.push_back(newCounter(blockIndex++));
+
+            } else if (inst->getOp() == IRInstOperator::IRINST_OP_BRANCH) {
+
+                // 目标1边拆分出一个新的基本块计数：bc c, .Lsplit, .L2; .Lsplit: counter; br .L1
+                auto branchInst = static_cast<BranchInstruction *>(inst);
+                LabelInstruction * split = new LabelInstruction(func);
+                BranchInstruction * newBranch =
+                    new BranchInstruction(func, branchInst->getOperand(0), split, branchInst->getTarget2());
+
+                newInsts.back() = newBranch;
+                newInsts.push_back(split);
+                newInsts.push_back(newCounter((int32_t) counters.blocks.size() + branchIndex++));
+                newInsts.push_back(new GotoInstruction(func, branchInst->getTarget1()));
+
+                branchInst->clearOperands();
+                delete branchInst;
+            }
+        }
+
+        insts.swap(newInsts);
+    }
+
+    // main函数出口指令之前输出计数器
+    std::vector<Instruction *> & mainInsts = mainFunc->getInterCode().getInsts();
+    auto exitIter = std::find_if(mainInsts.begin(), mainInsts.end(), [](Instruction * inst) {
+        return !inst->isDead() && (inst->getOp() == IRInstOperator::IRINST_OP_EXIT);
+    });
+    if (exitIter == mainInsts.end()) {
+        minic_log(LOG_ERROR, "main函数没有出口指令");
+        return false;
+    }
+
+    std::vector<Value *> args = {module->newConstInt(layout.checksum), module->newConstInt(layout.total), table};
+    Function * dumpFunc = module->findFunction(IR_PROFILE_DUMP);
+    mainInsts.insert(exitIter, new FuncCallInstruction(mainFunc, dumpFunc, args, VoidType::getType()));
+
+    mainFunc->setExistFuncCall(true);
+    if (mainFunc->getMaxFuncCallArgCnt() < (int) args.size()) {
+        mainFunc->setMaxFuncCallArgCnt((int) args.size());
+    }
+
+    return true;
+}
+
+///
+/// @brief 构造函数
+/// @param _module 模块，所有函数体必须已加载
+/// @param _path 剖析数据文件
+///
+ProfileLoader::ProfileLoader(Module * _module, const std::string & _path) : module(_module), path(_path)
+{}
+
+///
+/// @brief 读入并标注
+/// @return true：成功，false：文件不能读取或者与模块不一致
+///
+bool ProfileLoader::run()
+{
+    FILE * fp = fopen(path.c_str(), "r");
+    if (nullptr == fp) {
+        minic_log(LOG_ERROR, "剖析数据文件(%s)打开失败", path.c_str());
+        return false;
+    }
+
+    ProfileLayout layout(module);
+
+    char magic[32] = {0};
+    long long checksum = -1, total = -1;
+    bool ok = (fscanf(fp, "%31s %lld %lld", magic, &checksum, &total) == 3) && (strcmp(magic, PROFILE_MAGIC) == 0);
+
+    if (ok && ((checksum != layout.checksum) || (total != layout.total))) {
+        fclose(fp);
+        minic_log(LOG_ERROR, "剖析数据文件(%s)与源程序不一致", path.c_str());
+        return false;
+    }
+
+    std::vector<uint64_t> counts((size_t) layout.total);
+    for (size_t k = 0; ok && (k < counts.size()); k++) {
+        unsigned long long value;
+        ok = fscanf(fp, "%llu", &value) == 1;
+        counts[k] = value;
+    }
+
+    fclose(fp);
+
+    if (!ok) {
+        minic_log(LOG_ERROR, "剖析数据文件(%s)格式错误", path.c_str());
+        return false;
+    }
+
+    // 函数的热度按其基本块执行次数之和与最热函数的比较确定
+    std::vector<uint64_t> funcTotals;
+    uint64_t maxTotal = 0;
+    for (auto & counters: layout.functions) {
+        uint64_t sum = 0;
+        for (size_t k = 0; k < counters.blocks.size(); k++) {
+            sum += counts[counters.base + k];
+        }
+        funcTotals.push_back(sum);
+        maxTotal = std::max(maxTotal, sum);
+    }
+
+    for (size_t f = 0; f < layout.functions.size(); f++) {
+
+        auto & counters = layout.functions[f];
+        const uint64_t * blockCounts = counts.data() + counters.base;
+        const uint64_t * edgeCounts = blockCounts + counters.blocks.size();
+
+        for (size_t k = 0; k < counters.branches.size(); k++) {
+            uint64_t blockCount = blockCounts[counters.branchBlocks[k]];
+            uint64_t trueCount = std::min(edgeCounts[k], blockCount);
+            counters.branches[k]->setProfile(trueCount, blockCount - trueCount);
+        }
+
+        uint64_t entryCount = counters.blocks.empty() ? 0 : blockCounts[0];
+        FunctionHotness hotness;
+        if (entryCount == 0) {
+            hotness = FunctionHotness::COLD;
+        } else if (funcTotals[f] * HOT_RATIO >= maxTotal) {
+            hotness = FunctionHotness::HOT;
+        } else {
+            hotness = FunctionHotness::NORMAL;
+        }
+        counters.func->setProfile(entryCount, hotness);
+    }
+
+    return true;
+}
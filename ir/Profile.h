@@ -0,0 +1,131 @@
+///
+/// @file Profile.h
+/// @brief 剖析制导优化：插桩产生计数器，以及读入剖析数据标注到IR上
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+/// 每个函数的每个基本块（以Label指令开始）一个计数器，每条分支指令的目标1边一个计数器，
+/// 目标2边的次数由所在基本块的次数减去目标1边的次数得到。计数器按函数在模块中的次序、
+/// 函数内先基本块后分支指令的次序编号，插桩与使用剖析数据时由同一份IR得到相同的编号。
+///
+/// 剖析数据文件为文本格式，第一行为 minic-profile 校验和 计数器个数，之后每行一个计数器的值。
+/// 校验和由各函数的名字、基本块与分支指令的个数计算，用于发现源程序与剖析数据不一致。
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BranchInstruction.h"
+#include "Module.h"
+
+/// @brief 剖析数据文件第一行的开头
+#define PROFILE_MAGIC "minic-profile"
+
+/// @brief 没有指定时插桩程序输出的剖析数据文件，可用环境变量MINIC_PROFILE_FILE指定
+#define PROFILE_DEFAULT_FILE "minic.profdata"
+
+///
+/// @brief 模块中计数器的编号方案
+///
+class ProfileLayout {
+
+public:
+    ///
+    /// @brief 一个函数的计数器
+    ///
+    struct FunctionCounters {
+        /// @brief 函数
+        Function * func = nullptr;
+
+        /// @brief 第一个计数器的编号
+        int32_t base = 0;
+
+        /// @brief 各基本块开始的Label指令
+        std::vector<Instruction *> blocks;
+
+        /// @brief 各分支指令
+        std::vector<BranchInstruction *> branches;
+
+        /// @brief 各分支指令所在的基本块
+        std::vector<int32_t> branchBlocks;
+    };
+
+    ///
+    /// @brief 构造函数，计算模块的计数器编号，所有函数体必须已加载
+    /// @param module 模块
+    ///
+    explicit ProfileLayout(Module * module);
+
+    /// @brief 各函数的计数器，内置函数没有
+    std::vector<FunctionCounters> functions;
+
+    /// @brief 计数器的总数
+    int32_t total = 0;
+
+    /// @brief 校验和，非负
+    int32_t checksum = 0;
+};
+
+///
+/// @brief 剖析插桩：插入计数指令，并在main函数出口输出计数器
+///
+class ProfileInstrumenter {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 模块，所有函数体必须已加载
+    ///
+    explicit ProfileInstrumenter(Module * _module);
+
+    ///
+    /// @brief 插桩
+    /// @return true：成功，false：没有main函数
+    ///
+    bool run();
+
+private:
+    /// @brief 模块
+    Module * module;
+};
+
+///
+/// @brief 读入剖析数据，标注分支指令的跳转次数、函数的进入次数与热度
+///
+class ProfileLoader {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 模块，所有函数体必须已加载
+    /// @param _path 剖析数据文件
+    ///
+    ProfileLoader(Module * _module, const std::string & _path);
+
+    ///
+    /// @brief 读入并标注
+    /// @return true：成功，false：文件不能读取或者与模块不一致
+    ///
+    bool run();
+
+    /// @brief 基本块执行次数之和不小于最热函数的1/HOT_RATIO的函数为热函数
+    static constexpr uint64_t HOT_RATIO = 10;
+
+private:
+    /// @brief 模块
+    Module * module;
+
+    /// @brief 剖析数据文件
+    std::string path;
+};
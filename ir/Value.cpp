@@ -3,8 +3,8 @@
 /// @brief 值操作类型，所有的变量、函数、常量都是Value
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,14 +12,20 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>支持函数并行生成代码
 /// </table>
 ///
 
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 #include "Value.h"
 #include "Use.h"
 
+/// @brief 保护use边的增删。常量、全局变量等Value被多个函数共享，函数并行生成代码时会被多个线程同时增删
+static std::mutex usesLock;
+
 /// @brief 构造函数
 /// @param _type
 Value::Value(Type * _type) : type(_type)
@@ -78,6 +84,7 @@ Type * Value::getType()
 ///
 void Value::addUse(Use * use)
 {
+    std::lock_guard<std::mutex> guard(usesLock);
     uses.push_back(use);
 }
 
@@ -87,6 +94,7 @@ void Value::addUse(Use * use)
 ///
 void Value::removeUse(Use * use)
 {
+    std::lock_guard<std::mutex> guard(usesLock);
     auto pIter = std::find(uses.begin(), uses.end(), use);
     if (pIter != uses.end()) {
         uses.erase(pIter);
@@ -141,4 +149,32 @@ int32_t Value::getLoadRegId()
 void Value::setLoadRegId(int32_t regId)
 {
     (void) regId;
-}
\ No newline at end of file
+}
+
+/// @brief 共享Value在当前线程中的Load寄存器编号，只记录有效的编号
+static thread_local std::unordered_map<const Value *, int32_t> threadLoadRegIds;
+
+///
+/// @brief 获取被多个函数共享的Value在当前线程中的Load寄存器编号
+/// @param val 共享的Value
+/// @return int32_t 寄存器编号，没有时为-1
+///
+int32_t Value::getThreadLoadRegId(const Value * val)
+{
+    auto pIter = threadLoadRegIds.find(val);
+    return pIter == threadLoadRegIds.end() ? -1 : pIter->second;
+}
+
+///
+/// @brief 设置被多个函数共享的Value在当前线程中的Load寄存器编号
+/// @param val 共享的Value
+/// @param regId 寄存器编号，-1表示清除
+///
+void Value::setThreadLoadRegId(const Value * val, int32_t regId)
+{
+    if (regId == -1) {
+        threadLoadRegIds.erase(val);
+    } else {
+        threadLoadRegIds[val] = regId;
+    }
+}
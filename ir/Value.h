@@ -124,4 +124,20 @@ public:
     /// @return int32_t 寄存器编号
     ///
     virtual void setLoadRegId(int32_t regId);
+
+protected:
+    ///
+    /// @brief 获取被多个函数共享的Value（常量、全局变量）在当前线程中的Load寄存器编号。
+    /// 函数并行生成代码时，各线程对同一个共享Value的寄存器分配互不干扰
+    /// @param val 共享的Value
+    /// @return int32_t 寄存器编号，没有时为-1
+    ///
+    static int32_t getThreadLoadRegId(const Value * val);
+
+    ///
+    /// @brief 设置被多个函数共享的Value在当前线程中的Load寄存器编号
+    /// @param val 共享的Value
+    /// @param regId 寄存器编号，-1表示清除
+    ///
+    static void setThreadLoadRegId(const Value * val, int32_t regId);
 };
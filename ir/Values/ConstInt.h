@@ -58,7 +58,8 @@ public:
     ///
     int32_t getLoadRegId() override
     {
-        return this->loadRegNo;
+        // 被多个函数共享，按线程分别记录
+        return getThreadLoadRegId(this);
     }
 
     ///
@@ -67,7 +68,7 @@ public:
     ///
     void setLoadRegId(int32_t regId) override
     {
-        this->loadRegNo = regId;
+        setThreadLoadRegId(this, regId);
     }
 
 private:
@@ -75,9 +76,4 @@ private:
     /// @brief 整数值
     ///
     int32_t intVal;
-
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
 };
\ No newline at end of file
@@ -101,7 +101,8 @@ public:
     ///
     int32_t getLoadRegId() override
     {
-        return this->loadRegNo;
+        // 被多个函数共享，按线程分别记录
+        return getThreadLoadRegId(this);
     }
 
     ///
@@ -110,7 +111,7 @@ public:
     ///
     void setLoadRegId(int32_t regId) override
     {
-        this->loadRegNo = regId;
+        setThreadLoadRegId(this, regId);
     }
 
     ///
@@ -136,11 +137,6 @@ public:
     }
 
 private:
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
-
     ///
     /// @brief 默认全局变量在BSS段，没有初始化，或者即使初始化过，但都值都为0
     ///
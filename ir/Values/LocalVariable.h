@@ -3,8 +3,8 @@
 /// @brief 局部变量描述的类
 ///
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -12,6 +12,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加寄存器编号的设置
 /// </table>
 ///
 #pragma once
@@ -58,6 +59,15 @@ public:
         return regId;
     }
 
+    ///
+    /// @brief 设置寄存器编号，寄存器分配时使用
+    /// @param _regId 寄存器编号
+    ///
+    void setRegId(int32_t _regId)
+    {
+        this->regId = _regId;
+    }
+
     ///
     /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
     /// @param regId 寄存器编号
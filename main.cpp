@@ -9,12 +9,24 @@
  *
  */
 
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <getopt.h>
 
 #ifdef _WIN32
 #include <Windows.h>
+#else
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 #endif
 
 #include "Common.h"
@@ -22,12 +34,25 @@
 #include "Antlr4Executor.h"
 #include "CodeGenerator.h"
 #include "CodeGeneratorArm32.h"
+#include "CodeGeneratorX64.h"
+#include "BlockLayout.h"
+#include "CharScanner.h"
+#include "CompileCache.h"
 #include "FlexBisonExecutor.h"
 #include "FrontEndExecutor.h"
 #include "Graph.h"
+#include "IRBinaryReader.h"
+#include "IRBinaryWriter.h"
+#include "IRTextReader.h"
 #include "IRGenerator.h"
+#include "IRInterpreter.h"
+#include "JitX64.h"
 #include "RecursiveDescentExecutor.h"
+#include "MappedFile.h"
 #include "Module.h"
+#include "Profile.h"
+#include "ThreadPool.h"
+#include "TimeReport.h"
 
 ///
 /// @brief 是否显示帮助信息
@@ -35,56 +60,144 @@
 static bool gShowHelp = false;
 
 ///
-/// @brief 显示抽象语法树，非线性IR
+/// @brief 一次编译的选项，批量编译时每个编译任务各有一份
 ///
-static bool gShowAST = false;
+struct CompileOptions {
+    ///
+    /// @brief 显示抽象语法树，非线性IR
+    ///
+    bool showAST = false;
 
-///
-/// @brief 产生线性IR，线性IR，默认输出
-///
-static bool gShowLineIR = false;
+    ///
+    /// @brief 产生线性IR，线性IR，默认输出
+    ///
+    bool showLineIR = false;
 
-///
-/// @brief 显示汇编
-///
-static bool gShowASM = false;
+    ///
+    /// @brief 显示汇编
+    ///
+    bool showASM = false;
 
-///
-/// @brief 输出中间IR，含汇编或者自定义IR等，默认输出线性IR
-///
-static bool gShowSymbol = false;
+    ///
+    /// @brief 输出中间IR，含汇编或者自定义IR等，默认输出线性IR
+    ///
+    bool showSymbol = false;
 
-///
-/// @brief 前端分析器，默认选Flex和Bison
-///
-static bool gFrontEndFlexBison = true;
+    ///
+    /// @brief 前端分析器，默认选Flex和Bison
+    ///
+    bool frontEndFlexBison = true;
 
-///
-/// @brief 前端分析器Antlr4，是否选中
-///
-static bool gFrontEndAntlr4 = false;
+    ///
+    /// @brief 前端分析器Antlr4，是否选中
+    ///
+    bool frontEndAntlr4 = false;
 
-///
-/// @brief 前端分析器用递归下降分析法，是否选中
-///
-static bool gFrontEndRecursiveDescentParsing = false;
+    ///
+    /// @brief 前端分析器用递归下降分析法，是否选中
+    ///
+    bool frontEndRecursiveDescentParsing = false;
 
-///
-/// @brief 在输出汇编时是否输出中间IR作为注释
-///
-static bool gAsmAlsoShowIR = false;
+    ///
+    /// @brief 在输出汇编时是否输出中间IR作为注释
+    ///
+    bool asmAlsoShowIR = false;
+
+    ///
+    /// @brief 前端分析器Antlr4是否输出预测的统计信息
+    ///
+    bool antlr4PredictionStats = false;
+
+    /// @brief 以函数为单位并行翻译IR与生成代码的线程数，即-j后面的数字，默认为1不并行，0为CPU的硬件线程数
+    int jobs = 1;
+
+    /// @brief 优化的级别，即-O后面的数字，默认为0
+    int optLevel = 0;
+
+    /// @brief 指定CPU目标架构，这里默认为ARM32
+    std::string cpuTarget = "ARM32";
+
+    /// @brief 输入源文件
+    std::string inputFile;
+
+    /// @brief 输出文件，不同的选项输出的内容不同
+    std::string outputFile;
 
-/// @brief 优化的级别，即-O后面的数字，默认为0
-static int gOptLevel = 0;
+    /// @brief 编译缓存的目录，即--cache后的目录，为空时不使用缓存
+    std::string cacheDir;
 
-/// @brief 指定CPU目标架构，这里默认为ARM32
-static std::string gCPUTarget = "ARM32";
+    /// @brief 是否以函数为单位缓存汇编代码，即--cache-func
+    bool cacheFunctions = false;
 
-/// @brief 输入源文件
-static std::string gInputFile;
+    /// @brief 中间IR以二进制格式输出，即--ir-binary
+    bool irBinary = false;
 
-/// @brief 输出文件，不同的选项输出的内容不同
-static std::string gOutputFile;
+    /// @brief 编译结束时在标准错误上输出各阶段的耗时报告，即--time-report
+    bool timeReport = false;
+
+    /// @brief 各阶段的耗时报告以JSON格式输出到的文件，即--time-report-json后的文件名
+    std::string timeReportJSON;
+
+    /// @brief 不生成汇编，解释执行中间IR，即-R
+    bool run = false;
+
+    /// @brief 不生成汇编，即时编译为本机的机器码后执行，即-J
+    bool jit = false;
+
+    /// @brief 插桩产生剖析数据，即--profile-generate
+    bool profileGenerate = false;
+
+    /// @brief 使用的剖析数据文件，即--profile-use后的文件名，为空时不使用
+    std::string profileUse;
+
+    /// @brief 各函数的汇编代码之后以注释输出静态估计的周期数与代码大小等，即--estimate
+    bool estimate = false;
+
+    /// @brief 静态估计以JSON格式输出到的文件，即--estimate-json后的文件名
+    std::string estimateJSON;
+
+    /// @brief 寄存器分配方法，即--regalloc后的simple或graph
+    std::string regAlloc = "simple";
+};
+
+/// @brief 命令行指定的编译选项
+static CompileOptions gOptions;
+
+/// @brief 解释执行或者即时编译执行时main函数的返回值，作为命令行的退出码
+static int gRunExitValue = 0;
+
+/// @brief 批量编译的清单文件，即--batch后的文件名，-为标准输入
+static std::string gBatchFile;
+
+/// @brief 编译服务监听的Unix域套接字路径，即--serve后的路径
+static std::string gServePath;
+
+/// @brief 批量编译时同时进行的编译任务数，即--batch-jobs后面的数字
+static int gBatchJobs = 1;
+
+/// @brief Flex+Bison与递归下降分析器使用全局变量，多个编译任务并发时需互斥执行
+static std::mutex gFrontEndLock;
+
+/// @brief getopt使用全局变量，并发解析编译任务的选项时需互斥执行
+static std::mutex gArgsLock;
+
+/// @brief 只有长选项形式的选项值，从256开始避免与短选项冲突
+enum LongOnlyOption {
+    OPT_ANTLR4_STATS = 256,
+    OPT_BATCH,
+    OPT_SERVE,
+    OPT_BATCH_JOBS,
+    OPT_CACHE,
+    OPT_CACHE_FUNC,
+    OPT_IR_BINARY,
+    OPT_TIME_REPORT,
+    OPT_TIME_REPORT_JSON,
+    OPT_PROFILE_GENERATE,
+    OPT_PROFILE_USE,
+    OPT_ESTIMATE,
+    OPT_ESTIMATE_JSON,
+    OPT_REGALLOC,
+};
 
 static struct option long_options[] = {
     {"help", no_argument, 0, 'h'},
@@ -97,6 +210,23 @@ static struct option long_options[] = {
     {"optimize", required_argument, 0, 'O'},
     {"target", required_argument, 0, 't'},
     {"asmir", no_argument, 0, 'c'},
+    {"jobs", required_argument, 0, 'j'},
+    {"run", no_argument, 0, 'R'},
+    {"jit", no_argument, 0, 'J'},
+    {"antlr4-stats", no_argument, 0, OPT_ANTLR4_STATS},
+    {"batch", required_argument, 0, OPT_BATCH},
+    {"serve", required_argument, 0, OPT_SERVE},
+    {"batch-jobs", required_argument, 0, OPT_BATCH_JOBS},
+    {"cache", required_argument, 0, OPT_CACHE},
+    {"cache-func", no_argument, 0, OPT_CACHE_FUNC},
+    {"ir-binary", no_argument, 0, OPT_IR_BINARY},
+    {"time-report", no_argument, 0, OPT_TIME_REPORT},
+    {"time-report-json", required_argument, 0, OPT_TIME_REPORT_JSON},
+    {"profile-generate", no_argument, 0, OPT_PROFILE_GENERATE},
+    {"profile-use", required_argument, 0, OPT_PROFILE_USE},
+    {"estimate", no_argument, 0, OPT_ESTIMATE},
+    {"estimate-json", required_argument, 0, OPT_ESTIMATE_JSON},
+    {"regalloc", required_argument, 0, OPT_REGALLOC},
     {0, 0, 0, 0}
 };
 
@@ -104,25 +234,48 @@ static struct option long_options[] = {
 /// @param exeName
 static void showHelp(const std::string & exeName)
 {
-    std::cout << exeName + " -S [--symbol] [-A | --antlr4 | -D | --recursive-descent] [-T | --ast | -I | --ir] [-o output | --output=output] source\n";
+    std::cout << exeName + " -S [--symbol] [-A | --antlr4 | -D | --recursive-descent] [-T | --ast | -I | --ir | -R | --run | -J | --jit] [-o output | --output=output] source\n";
+    std::cout << exeName + " --batch=MANIFEST | --serve=SOCKET [--batch-jobs=N]\n";
     std::cout << "Options:\n";
     std::cout << "  -h, --help                 Show this help message\n";
     std::cout << "  -o, --output=FILE          Specify output file\n";
     std::cout << "  -S, --symbol               Show symbol information\n";
     std::cout << "  -T, --ast                  Output abstract syntax tree\n";
     std::cout << "  -I, --ir                   Output intermediate representation\n";
+    std::cout << "  -R, --run                  Interpret the intermediate representation instead of generating assembly\n";
+    std::cout << "  -J, --jit                  Compile to x86-64 machine code in memory and run it (x86-64 Linux hosts)\n";
     std::cout << "  -A, --antlr4               Use Antlr4 for lexical and syntax analysis\n";
     std::cout << "  -D, --recursive-descent    Use recursive descent parsing\n";
     std::cout << "  -O, --optimize=LEVEL       Set optimization level\n";
-    std::cout << "  -t, --target=CPU           Specify target CPU architecture\n";
+    std::cout << "  -t, --target=CPU           Specify target CPU architecture: ARM32 (default) or X64\n";
     std::cout << "  -c, --asmir                Show IR instructions as comments in assembly output\n";
+    std::cout << "  -j, --jobs=N               Translate and generate code for N functions in parallel (0: all CPUs)\n";
+    std::cout << "      --ir-binary            Output the intermediate representation in binary form (with -I)\n";
+    std::cout << "      --antlr4-stats         Show Antlr4 adaptive prediction statistics\n";
+    std::cout << "      --cache=DIR            Reuse outputs of unchanged sources cached in DIR\n";
+    std::cout << "      --cache-func           Also cache and reuse the assembly of unchanged functions\n";
+    std::cout << "      --time-report          Show time and peak memory of each compile phase on stderr\n";
+    std::cout << "      --time-report-json=FILE  Write the time report to FILE in JSON form\n";
+    std::cout << "      --profile-generate     Instrument the program to write block and branch counts on exit\n";
+    std::cout << "      --profile-use=FILE     Lay out blocks and place functions by the counts in FILE\n";
+    std::cout << "      --estimate             Append estimated cycles, size, spills and branches of each function as comments (ARM32)\n";
+    std::cout << "      --estimate-json=FILE   Write the estimates of each function to FILE in JSON form (ARM32)\n";
+    std::cout << "      --regalloc=METHOD      Register allocation: simple (default) or graph coloring (ARM32)\n";
+    std::cout << "      --batch=MANIFEST       Compile every job line of MANIFEST (- for stdin) in one process\n";
+    std::cout << "      --serve=SOCKET         Serve job lines on a Unix domain socket\n";
+    std::cout << "      --batch-jobs=N         Run N batch jobs concurrently\n";
+    std::cout << "A job line holds the options and source of one compile, e.g. -S -A -o a.s a.c\n";
+    std::cout << "A .ir file or a binary IR file given as source is compiled without the front end\n";
+    std::cout << "Each job is answered with a line: result <0 | -1> <source>\n";
 }
 
 /// @brief 参数解析与有效性检查
 /// @param argc
 /// @param argv
+/// @param options 解析出的编译选项
+/// @param isJob true：批量编译的一个编译任务，不允许出现批量编译的选项，false：命令行
 /// @return
-static int ArgsAnalysis(int argc, char * argv[])
+static int ArgsAnalysis(int argc, char * argv[], CompileOptions & options, bool isJob)
 {
     int ch;
 
@@ -134,52 +287,125 @@ static int ArgsAnalysis(int argc, char * argv[])
     // -O要求必须带有附加整数，指明优化的级别
     // -t要求必须带有目标CPU，指明目标CPU的汇编
     // -c选项在输出汇编时有效，附带输出IR指令内容
-    const char options[] = "ho:STIADO:t:c";
+    // -j要求必须带有附加整数，指明以函数为单位并行翻译与生成代码的线程数
+    // -R解释执行中间IR，不产生输出文件，只能在命令行中指定
+    const char shortOptions[] = "ho:STIRJADO:t:cj:";
     int option_index = 0;
 
     opterr = 1;
 
+    // 重新初始化getopt，批量编译时会多次解析
+    optind = 0;
+
 lb_check:
-    while ((ch = getopt_long(argc, argv, options, long_options, &option_index)) != -1) {
+    while ((ch = getopt_long(argc, argv, shortOptions, long_options, &option_index)) != -1) {
         switch (ch) {
             case 'h':
+                if (isJob) {
+                    return -1;
+                }
                 gShowHelp = true;
                 break;
             case 'o':
-                gOutputFile = optarg;
+                options.outputFile = optarg;
                 break;
             case 'S':
-                gShowSymbol = true;
+                options.showSymbol = true;
                 break;
             case 'T':
-                gShowAST = true;
+                options.showAST = true;
                 break;
             case 'I':
                 // 产生中间IR
-                gShowLineIR = true;
+                options.showLineIR = true;
+                break;
                 break;
+            case 'R':
+                // 解释执行，退出码为main函数的返回值，批量编译时无法返回
+                if (isJob) {
+                    return -1;
+                }
+                options.run = true;
+                break;
+            case 'J':
+                // 即时编译执行，退出码同-R
+                if (isJob) {
+                    return -1;
+                }
+                options.jit = true;
                 break;
             case 'A':
                 // 选用antlr4
-                gFrontEndAntlr4 = true;
-                gFrontEndFlexBison = false;
-                gFrontEndRecursiveDescentParsing = false;
+                options.frontEndAntlr4 = true;
+                options.frontEndFlexBison = false;
+                options.frontEndRecursiveDescentParsing = false;
                 break;
             case 'D':
                 // 选用递归下降分析法与词法手动实现
-                gFrontEndAntlr4 = false;
-                gFrontEndFlexBison = false;
-                gFrontEndRecursiveDescentParsing = true;
+                options.frontEndAntlr4 = false;
+                options.frontEndFlexBison = false;
+                options.frontEndRecursiveDescentParsing = true;
                 break;
             case 'O':
                 // 优化级别分析，暂时没有用，如开启优化时请使用
-                gOptLevel = std::stoi(optarg);
+                options.optLevel = std::stoi(optarg);
                 break;
             case 't':
-                gCPUTarget = optarg;
+                options.cpuTarget = optarg;
                 break;
             case 'c':
-                gAsmAlsoShowIR = true;
+                options.asmAlsoShowIR = true;
+                break;
+            case 'j':
+                options.jobs = std::stoi(optarg);
+                break;
+            case OPT_ANTLR4_STATS:
+                options.antlr4PredictionStats = true;
+                break;
+            case OPT_CACHE:
+                options.cacheDir = optarg;
+                break;
+            case OPT_CACHE_FUNC:
+                options.cacheFunctions = true;
+                break;
+            case OPT_IR_BINARY:
+                options.irBinary = true;
+                break;
+            case OPT_TIME_REPORT:
+                options.timeReport = true;
+                break;
+            case OPT_TIME_REPORT_JSON:
+                options.timeReportJSON = optarg;
+                break;
+            case OPT_PROFILE_GENERATE:
+                options.profileGenerate = true;
+                break;
+            case OPT_PROFILE_USE:
+                options.profileUse = optarg;
+                break;
+            case OPT_ESTIMATE:
+                options.estimate = true;
+                break;
+            case OPT_ESTIMATE_JSON:
+                options.estimateJSON = optarg;
+                break;
+            case OPT_REGALLOC:
+                options.regAlloc = optarg;
+                break;
+            case OPT_BATCH:
+            case OPT_SERVE:
+            case OPT_BATCH_JOBS:
+                // 批量编译的选项只能在命令行中指定
+                if (isJob) {
+                    return -1;
+                }
+                if (ch == OPT_BATCH) {
+                    gBatchFile = optarg;
+                } else if (ch == OPT_SERVE) {
+                    gServePath = optarg;
+                } else {
+                    gBatchJobs = std::stoi(optarg);
+                }
                 break;
             default:
                 return -1;
@@ -193,9 +419,9 @@ lb_check:
     if (argc >= 1) {
 
         // 第一次设置
-        if (gInputFile.empty()) {
+        if (options.inputFile.empty()) {
 
-            gInputFile = argv[0];
+            options.inputFile = argv[0];
         } else {
             // 重复设置则出错
             return -1;
@@ -208,36 +434,69 @@ lb_check:
         }
     }
 
+    // 批量编译，编译任务的选项与源文件在清单或请求中给出
+    if (!isJob && (!gBatchFile.empty() || !gServePath.empty())) {
+        return (options.inputFile.empty() && (gBatchFile.empty() || gServePath.empty())) ? 0 : -1;
+    }
+
     // 必须指定要进行编译的输入文件
-    if (gInputFile.empty()) {
+    if (options.inputFile.empty()) {
         return -1;
     }
 
     // 显示符号信息，必须指定，可选抽象语法树、中间IR(DragonIR)等显示
-    if (!gShowSymbol) {
+    if (!options.showSymbol) {
         return -1;
     }
 
-    int flag = (int) gShowLineIR + (int) gShowAST;
+    int flag = (int) options.showLineIR + (int) options.showAST + (int) options.run + (int) options.jit;
 
     if (0 == flag) {
         // 没有指定，则输出汇编指令
-        gShowASM = true;
+        options.showASM = true;
     } else if (flag != 1) {
-        // 线性中间IR、抽象语法树只能同时选择一个
+        // 线性中间IR、抽象语法树、解释执行、即时编译执行只能同时选择一个
+        return -1;
+    }
+
+    // 二进制格式只用于中间IR的输出
+    if (options.irBinary && !options.showLineIR) {
+        return -1;
+    }
+
+    // 函数级的缓存必须指定缓存目录
+    if (options.cacheFunctions && options.cacheDir.empty()) {
+        return -1;
+    }
+
+    // 插桩与使用剖析数据不能同时进行
+    if (options.profileGenerate && !options.profileUse.empty()) {
+        return -1;
+    }
+
+    // 静态估计只用于ARM32汇编的输出
+    if ((options.estimate || !options.estimateJSON.empty()) && (!options.showASM || (options.cpuTarget != "ARM32"))) {
+        return -1;
+    }
+
+    // 寄存器分配方法只有simple与graph，图着色只用于ARM32汇编的输出
+    if ((options.regAlloc != "simple") && (options.regAlloc != "graph")) {
+        return -1;
+    }
+    if ((options.regAlloc == "graph") && (!options.showASM || (options.cpuTarget != "ARM32"))) {
         return -1;
     }
 
     // 没有指定输出文件则产生默认文件
-    if (gOutputFile.empty()) {
+    if (options.outputFile.empty()) {
 
         // 默认文件名
-        if (gShowAST) {
-            gOutputFile = "output.png";
-        } else if (gShowLineIR) {
-            gOutputFile = "output.ir";
+        if (options.showAST) {
+            options.outputFile = "output.png";
+        } else if (options.showLineIR) {
+            options.outputFile = options.irBinary ? "output.dirb" : "output.ir";
         } else {
-            gOutputFile = "output.s";
+            options.outputFile = "output.s";
         }
     }
 
@@ -245,12 +504,65 @@ lb_check:
 }
 
 ///
-/// @brief 对源文件进行编译处理生成汇编
+/// @brief 影响编译结果的编译器版本与选项，参与缓存键值的计算。输入输出文件与线程数不影响结果
+/// @param options 编译选项
+/// @return std::string 版本与选项的文本
+///
+static std::string compileCacheSalt(const CompileOptions & options)
+{
+    std::string salt = MINIC_VERSION;
+
+    salt += options.frontEndAntlr4 ? " -A" : (options.frontEndRecursiveDescentParsing ? " -D" : "");
+    salt += options.showLineIR ? " -I" : "";
+    salt += options.irBinary ? " --ir-binary" : "";
+    salt += options.asmAlsoShowIR ? " -c" : "";
+    salt += " -O" + std::to_string(options.optLevel);
+    salt += " -t" + options.cpuTarget;
+    salt += options.profileGenerate ? " --profile-generate" : "";
+    salt += options.estimate ? " --estimate" : "";
+    salt += (options.regAlloc == "graph") ? " --regalloc=graph" : "";
+
+    // 剖析数据不同则结果不同，按其内容计算
+    if (!options.profileUse.empty()) {
+        std::string profile;
+        (void) CompileCache::readFile(options.profileUse, profile);
+        salt += " --profile-use=" + CacheKey().add(profile).digest();
+    }
+
+    return salt;
+}
+
+///
+/// @brief 输出各阶段的耗时报告
+/// @param options 编译选项
+/// @param report 耗时报告，空指针时不输出
+///
+static void outputTimeReport(const CompileOptions & options, TimeReport * report)
+{
+    if (!report) {
+        return;
+    }
+
+    if (!options.timeReportJSON.empty()) {
+        if (!report->writeJSON(options.timeReportJSON)) {
+            minic_log(LOG_ERROR, "耗时报告文件(%s)写入失败", options.timeReportJSON.c_str());
+        }
+    } else {
+        report->print(stderr);
+    }
+}
+
+///
+/// @brief 对源文件进行编译处理生成汇编。不同的编译任务可在不同的线程中同时进行
+/// @param options 编译选项
 /// @return true 成功
 /// @return false 失败
 ///
-static int compile(std::string inputFile, std::string outputFile)
+static int compile(const CompileOptions & options)
 {
+    const std::string & inputFile = options.inputFile;
+    const std::string & outputFile = options.outputFile;
+
     // 函数返回值，默认-1
     int result = -1;
 
@@ -259,6 +571,49 @@ static int compile(std::string inputFile, std::string outputFile)
 
     Module * module = nullptr;
 
+    // 各阶段的耗时报告，没有指定时为空指针，各阶段不计时
+    std::unique_ptr<TimeReport> timeReport;
+    if (options.timeReport || !options.timeReportJSON.empty()) {
+        timeReport = std::make_unique<TimeReport>(inputFile);
+    }
+
+    // 输入为二进制IR文件或者.ir文件时跳过前端与IR生成，直接加载IR
+    const bool binaryInput = IRBinaryReader::isBinaryIR(inputFile);
+    const bool textInput = !binaryInput && IRTextReader::isTextIR(inputFile);
+
+    // 编译缓存，整个文件的键值由规范化的源代码、编译器版本与选项计算，
+    // 只有空白与注释不同的源文件可共用缓存。IR文件则按原始内容计算。AST图片的输出不使用缓存
+    CompileCache cache(options.cacheDir);
+    std::string cacheSalt, fileKey;
+    bool cacheHit = false;
+
+    // 解释执行与即时编译执行没有输出文件，不使用缓存。静态估计的JSON文件在代码生成时才产生，也不使用缓存
+    if (!options.cacheDir.empty() && !options.run && !options.jit && options.estimateJSON.empty()) {
+
+        TimeReport::Scope timer(timeReport.get(), "cache-lookup");
+
+        cacheSalt = compileCacheSalt(options);
+
+        MappedFile source;
+        if (!options.showAST && source.open(inputFile)) {
+
+            fileKey = CacheKey()
+                          .add("file")
+                          .add(cacheSalt)
+                          .add((binaryInput || textInput) ? std::string(source.data(), source.size())
+                                           : scan_normalize_source(source.data(), source.data() + source.size()))
+                          .digest();
+
+            std::string output;
+            cacheHit = cache.load(fileKey, output) && CompileCache::writeFile(outputFile, output);
+        }
+    }
+
+    if (cacheHit) {
+        outputTimeReport(options, timeReport.get());
+        return 0;
+    }
+
     // 这里采用do {} while(0)架构的目的是如果处理出错可通过break退出循环，出口唯一
     // 在编译器编译优化时会自动去除，因为while恒假的缘故
     do {
@@ -269,43 +624,183 @@ static int compile(std::string inputFile, std::string outputFile)
         // 3) 对线性IR进行优化：目前不支持
         // 4) 把线性IR转换成汇编
 
-        // 创建词法语法分析器
-        FrontEndExecutor * frontEndExecutor;
-        if (gFrontEndAntlr4) {
-            // Antlr4
-            frontEndExecutor = new Antlr4Executor(inputFile);
-        } else if (gFrontEndRecursiveDescentParsing) {
-            // 递归下降分析法
-            frontEndExecutor = new RecursiveDescentExecutor(inputFile);
+        if (binaryInput || textInput) {
+
+            // 抽象语法树只能由源文件产生
+            if (options.showAST) {
+                minic_log(LOG_ERROR, "IR文件不能输出抽象语法树");
+                break;
+            }
+
+            module = new Module(inputFile);
+
+            TimeReport::Scope timer(timeReport.get(), "ir-load");
+
+            if (textInput) {
+
+                // 文本IR一次全部加载
+                IRTextReader reader(module);
+                if (!reader.read(inputFile)) {
+                    break;
+                }
+            } else {
+
+                // 只加载全局变量与函数的声明，函数体在使用时才创建
+                auto reader = std::make_unique<IRBinaryReader>();
+                if (!reader->open(inputFile) || !reader->load(module)) {
+                    break;
+                }
+
+                module->setMaterializer(std::move(reader));
+            }
         } else {
-            // 默认为Flex+Bison
-            frontEndExecutor = new FlexBisonExecutor(inputFile);
-        }
 
-        // 前端执行：词法分析、语法分析后产生抽象语法树，其root为全局变量ast_root
-        subResult = frontEndExecutor->run();
-        if (!subResult) {
+            // 创建词法语法分析器
+            FrontEndExecutor * frontEndExecutor;
+            if (options.frontEndAntlr4) {
+                // Antlr4
+                Antlr4Executor * antlr4Executor = new Antlr4Executor(inputFile);
+                antlr4Executor->setShowPredictionStats(options.antlr4PredictionStats);
+                frontEndExecutor = antlr4Executor;
+            } else if (options.frontEndRecursiveDescentParsing) {
+                // 递归下降分析法
+                frontEndExecutor = new RecursiveDescentExecutor(inputFile);
+            } else {
+                // 默认为Flex+Bison
+                frontEndExecutor = new FlexBisonExecutor(inputFile);
+            }
 
-            minic_log(LOG_ERROR, "前端分析错误");
-            // 退出循环
-            break;
-        }
+            // Flex+Bison与递归下降分析器使用全局变量，同时只能有一个编译任务使用
+            std::unique_lock<std::mutex> frontEndGuard(gFrontEndLock, std::defer_lock);
+            if (!options.frontEndAntlr4) {
+                frontEndGuard.lock();
+            }
+
+            // 前端执行：词法分析、语法分析后产生抽象语法树，其root为全局变量ast_root
+            // 语法分析时同时构建抽象语法树，两者合在一起计时
+            {
+                TimeReport::Scope timer(timeReport.get(), "frontend");
+                subResult = frontEndExecutor->run();
+            }
+
+            // 获取抽象语法树的根节点
+            ast_node * astRoot = frontEndExecutor->getASTRoot();
+
+            // 清理前端资源
+            delete frontEndExecutor;
+
+            if (frontEndGuard.owns_lock()) {
+                frontEndGuard.unlock();
+            }
+
+            if (!subResult) {
+
+                minic_log(LOG_ERROR, "前端分析错误");
+                // 退出循环
+                break;
+            }
+
+            // 这里可进行非线性AST的优化
+
+            if (options.showAST) {
+
+                // 遍历抽象语法树，生成抽象语法树图片
+                TimeReport::Scope timer(timeReport.get(), "ast-output");
+                OutputAST(astRoot, outputFile);
+
+                // 清理抽象语法树
+                free_ast(astRoot);
+
+                // 设置返回结果：正常
+                result = 0;
 
-        // 获取抽象语法树的根节点
-        ast_node * astRoot = frontEndExecutor->getASTRoot();
+                break;
+            }
+
+            // 输出线性中间IR、计算器模拟解释执行、输出汇编指令
+            // 都需要遍历AST转换成线性IR指令
 
-        // 清理前端资源
-        delete frontEndExecutor;
+            // 符号表，保存所有的变量以及函数等信息
+            module = new Module(inputFile);
+
+            // 遍历抽象语法树产生线性IR，相关信息保存到符号表中
+            IRGenerator ast2IR(astRoot, module);
+            ast2IR.setJobs(options.jobs);
+            {
+                TimeReport::Scope timer(timeReport.get(), "irgen");
+                subResult = ast2IR.run();
+            }
+            if (!subResult) {
 
-        // 这里可进行非线性AST的优化
+                // 输出错误信息
+                minic_log(LOG_ERROR, "中间IR生成错误");
 
-        if (gShowAST) {
+                // 清理抽象语法树
+                free_ast(astRoot);
 
-            // 遍历抽象语法树，生成抽象语法树图片
-            OutputAST(astRoot, outputFile);
+                break;
+            }
 
             // 清理抽象语法树
             free_ast(astRoot);
+        }
+
+        // 剖析插桩或者使用剖析数据，都需要加载所有函数体
+        if (options.profileGenerate || !options.profileUse.empty()) {
+
+            if (!module->materializeAll()) {
+                break;
+            }
+
+            TimeReport::Scope timer(timeReport.get(), "profile");
+
+            if (options.profileGenerate) {
+                ProfileInstrumenter instrumenter(module);
+                if (!instrumenter.run()) {
+                    break;
+                }
+            } else {
+                ProfileLoader loader(module, options.profileUse);
+                if (!loader.run()) {
+                    break;
+                }
+
+                // 根据分支的执行次数调整基本块的次序
+                for (auto func: module->getFunctionList()) {
+                    BlockLayout layout(func);
+                    layout.run();
+                }
+            }
+        }
+
+        if (options.showLineIR) {
+
+            // 输出前所有函数体都要加载
+            if (!module->materializeAll()) {
+                break;
+            }
+
+            TimeReport::Scope timer(timeReport.get(), "ir-output");
+
+            if (options.irBinary) {
+
+                // 输出二进制IR
+                IRBinaryWriter writer(module);
+                if (!writer.write(outputFile)) {
+                    break;
+                }
+
+                // 设置返回结果：正常
+                result = 0;
+
+                break;
+            }
+
+            // 对IR的名字重命名
+            module->renameIR();
+
+            // 输出IR
+            module->outputIR(outputFile);
 
             // 设置返回结果：正常
             result = 0;
@@ -313,33 +808,43 @@ static int compile(std::string inputFile, std::string outputFile)
             break;
         }
 
-        // 输出线性中间IR、计算器模拟解释执行、输出汇编指令
-        // 都需要遍历AST转换成线性IR指令
+        if (options.run) {
+
+            // 解释执行前所有函数体都要加载
+            if (!module->materializeAll()) {
+                break;
+            }
+
+            TimeReport::Scope timer(timeReport.get(), "run");
 
-        // 符号表，保存所有的变量以及函数等信息
-        Module * module = new Module(inputFile);
+            IRInterpreter interpreter(module);
+            int32_t exitValue;
+            if (!interpreter.run(exitValue)) {
+                break;
+            }
 
-        // 遍历抽象语法树产生线性IR，相关信息保存到符号表中
-        IRGenerator ast2IR(astRoot, module);
-        subResult = ast2IR.run();
-        if (!subResult) {
+            // 与进程的退出码一样只保留低8位
+            gRunExitValue = exitValue & 0xFF;
 
-            // 输出错误信息
-            minic_log(LOG_ERROR, "中间IR生成错误");
+            // 设置返回结果：正常
+            result = 0;
 
             break;
         }
 
-        // 清理抽象语法树
-        free_ast(astRoot);
+        if (options.jit) {
 
-        if (gShowLineIR) {
+            // 函数体在第一次调用时编译，此时才加载
+            TimeReport::Scope timer(timeReport.get(), "jit");
 
-            // 对IR的名字重命名
-            module->renameIR();
+            JitX64 jit(module);
+            int32_t exitValue;
+            if (!jit.run(exitValue)) {
+                break;
+            }
 
-            // 输出IR
-            module->outputIR(outputFile);
+            // 与进程的退出码一样只保留低8位
+            gRunExitValue = exitValue & 0xFF;
 
             // 设置返回结果：正常
             result = 0;
@@ -348,8 +853,15 @@ static int compile(std::string inputFile, std::string outputFile)
         }
 
         // 要使得汇编能输出IR指令作为注释，必须对IR的名字进行命名，否则为空值
-        if (gAsmAlsoShowIR) {
+        if (options.asmAlsoShowIR) {
+
+            // 所有函数体都要加载后才能命名
+            if (!module->materializeAll()) {
+                break;
+            }
+
             // 对IR的名字重命名
+            TimeReport::Scope timer(timeReport.get(), "ir-rename");
             module->renameIR();
         }
 
@@ -358,37 +870,338 @@ static int compile(std::string inputFile, std::string outputFile)
         // 后端处理，体系结果相关的操作
         // 这里提供一种面向ARM32的汇编产生器CodeGeneratorArm32作为参考
         // 需要时可根据需要修改或追加新的目标体系架构
-        if (gShowASM) {
+        if (options.showASM) {
 
             CodeGenerator * generator = nullptr;
 
-            if (gCPUTarget == "ARM32") {
+            if (options.cpuTarget == "ARM32") {
                 // 输出面向ARM32的汇编指令
                 generator = new CodeGeneratorArm32(module);
-                generator->setShowLinearIR(gAsmAlsoShowIR);
-                generator->run(outputFile);
+            } else if (options.cpuTarget == "X64") {
+                // 输出面向x86-64的汇编指令，可在构建机上直接运行与测量
+                generator = new CodeGeneratorX64(module);
             } else {
                 // 不支持指定的CPU架构
-                minic_log(LOG_ERROR, "指定的目标CPU架构(%s)不支持", gCPUTarget.c_str());
+                minic_log(LOG_ERROR, "指定的目标CPU架构(%s)不支持", options.cpuTarget.c_str());
                 break;
             }
 
+            generator->setShowLinearIR(options.asmAlsoShowIR);
+            generator->setJobs(options.jobs);
+            if (options.cacheFunctions && options.estimateJSON.empty()) {
+                generator->setCache(&cache, cacheSalt);
+            }
+            generator->setEstimate(options.estimate, options.estimateJSON);
+            generator->setGraphColoring(options.regAlloc == "graph");
+            generator->setTimeReport(timeReport.get());
+            subResult = generator->run(outputFile);
+
             delete generator;
-        }
 
-        // 清理符号表
-        module->Delete();
+            if (!subResult) {
+                minic_log(LOG_ERROR, "汇编代码生成错误");
+                break;
+            }
+        }
 
         // 成功执行
         result = 0;
 
     } while (false);
 
-    delete module;
+    // 编译成功时把输出文件的内容存入缓存
+    if ((result == 0) && !fileKey.empty()) {
+        TimeReport::Scope timer(timeReport.get(), "cache-store");
+        std::string output;
+        if (CompileCache::readFile(outputFile, output)) {
+            (void) cache.store(fileKey, output);
+        }
+    }
+
+    // 清理符号表，批量编译时下一个编译任务不能残留本次的信息
+    if (module) {
+        module->Delete();
+        delete module;
+    }
+
+    outputTimeReport(options, timeReport.get());
+
+    return result;
+}
+
+///
+/// @brief 把一行编译任务拆分成参数。参数以空白分隔，含有空白的参数可用单引号或双引号括起来
+/// @param line 编译任务
+/// @return std::vector<std::string> 参数列表
+///
+static std::vector<std::string> splitJobLine(const std::string & line)
+{
+    std::vector<std::string> args;
+    std::string arg;
+    bool inArg = false;
+    char quote = '\0';
+
+    for (char c: line) {
+
+        if (quote != '\0') {
+            // 引号内的字符原样保留
+            if (c == quote) {
+                quote = '\0';
+            } else {
+                arg += c;
+            }
+        } else if ((c == '"') || (c == '\'')) {
+            quote = c;
+            inArg = true;
+        } else if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n')) {
+            if (inArg) {
+                args.push_back(arg);
+                arg.clear();
+                inArg = false;
+            }
+        } else {
+            arg += c;
+            inArg = true;
+        }
+    }
+
+    if (inArg) {
+        args.push_back(arg);
+    }
+
+    return args;
+}
+
+///
+/// @brief 是否是需要编译的任务行，空行与#开头的注释行忽略
+/// @param line 编译任务
+/// @return true：需要编译，false：忽略
+///
+static bool isJobLine(const std::string & line)
+{
+    size_t pos = line.find_first_not_of(" \t\r\n");
+
+    return (pos != std::string::npos) && (line[pos] != '#');
+}
+
+///
+/// @brief 执行一行编译任务，不同的编译任务可在不同的线程中同时执行
+/// @param line 编译任务，格式与命令行的选项和源文件相同，如-S -A -o a.s a.c
+/// @return std::string 应答行：result 编译结果 源文件
+///
+static std::string compileJob(const std::string & line)
+{
+    static char programName[] = "minic";
+
+    std::vector<std::string> args = splitJobLine(line);
+
+    // getopt要求argv[0]为程序名
+    std::vector<char *> argv;
+    argv.push_back(programName);
+    for (auto & arg: args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    // 每个编译任务从缺省的选项开始，不继承其它任务的选项
+    CompileOptions options;
+    int result;
+    {
+        std::lock_guard<std::mutex> guard(gArgsLock);
+        result = ArgsAnalysis((int) argv.size() - 1, argv.data(), options, true);
+    }
+
+    if (result < 0) {
+        minic_log(LOG_ERROR, "编译任务(%s)的选项错误", line.c_str());
+    } else {
+        result = compile(options);
+    }
+
+    return "result " + std::to_string(result) + " " + options.inputFile + "\n";
+}
+
+///
+/// @brief 从流中逐行读取编译任务并按次序执行，每个任务完成后立即输出应答行
+/// @param in 输入流
+/// @return int 0：全部成功，-1：有失败的任务
+///
+static int streamCompile(std::istream & in)
+{
+    int result = 0;
+    std::string line;
+
+    while (std::getline(in, line)) {
+
+        if (!isJobLine(line)) {
+            continue;
+        }
+
+        std::string reply = compileJob(line);
+        if (reply.compare(0, 9, "result 0 ") != 0) {
+            result = -1;
+        }
+
+        std::cout << reply << std::flush;
+    }
+
+    return result;
+}
+
+///
+/// @brief 批量编译清单中的所有任务，可同时执行多个任务，应答行按清单的次序输出
+/// @param manifest 清单文件，每行一个编译任务，-为标准输入
+/// @return int 0：全部成功，-1：有失败的任务
+///
+static int batchCompile(const std::string & manifest)
+{
+    // 标准输入的任务随到随编译
+    if (manifest == "-") {
+        return streamCompile(std::cin);
+    }
+
+    std::ifstream in(manifest);
+    if (!in) {
+        minic_log(LOG_ERROR, "清单文件(%s)打开失败", manifest.c_str());
+        return -1;
+    }
+
+    std::vector<std::string> jobs;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (isJobLine(line)) {
+            jobs.push_back(line);
+        }
+    }
+
+    std::vector<std::string> replies(jobs.size());
+
+    ThreadPool pool(gBatchJobs);
+    pool.parallelFor(jobs.size(), [&](size_t index) { replies[index] = compileJob(jobs[index]); });
+
+    int result = 0;
+    for (auto & reply: replies) {
+        if (reply.compare(0, 9, "result 0 ") != 0) {
+            result = -1;
+        }
+        std::cout << reply;
+    }
 
     return result;
 }
 
+#ifndef _WIN32
+///
+/// @brief 处理编译服务的一个连接，按次序执行连接上的每一行编译任务并应答
+/// @param fd 连接的套接字
+///
+static void serveConnection(int fd)
+{
+    std::string pending;
+    char buf[4096];
+    ssize_t len;
+
+    while ((len = recv(fd, buf, sizeof(buf), 0)) > 0) {
+
+        pending.append(buf, (size_t) len);
+
+        size_t pos;
+        while ((pos = pending.find('\n')) != std::string::npos) {
+
+            std::string line = pending.substr(0, pos);
+            pending.erase(0, pos + 1);
+
+            if (!isJobLine(line)) {
+                continue;
+            }
+
+            std::string reply = compileJob(line);
+            if (send(fd, reply.data(), reply.size(), MSG_NOSIGNAL) < 0) {
+                close(fd);
+                return;
+            }
+        }
+    }
+
+    close(fd);
+}
+
+///
+/// @brief 在Unix域套接字上提供编译服务。每个连接由一个线程处理，最多同时处理--batch-jobs个连接
+/// @param path 套接字路径
+/// @return int 服务异常退出时返回-1
+///
+static int serve(const std::string & path)
+{
+    struct sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        minic_log(LOG_ERROR, "套接字路径(%s)过长", path.c_str());
+        return -1;
+    }
+    path.copy(addr.sun_path, path.size());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        minic_log(LOG_ERROR, "套接字创建失败");
+        return -1;
+    }
+
+    // 删除上次服务残留的套接字文件
+    (void) unlink(path.c_str());
+
+    if ((bind(listenFd, (struct sockaddr *) &addr, sizeof(addr)) < 0) || (listen(listenFd, SOMAXCONN) < 0)) {
+        minic_log(LOG_ERROR, "套接字(%s)监听失败", path.c_str());
+        close(listenFd);
+        return -1;
+    }
+
+    int limit = gBatchJobs > 0 ? gBatchJobs : (int) std::thread::hardware_concurrency();
+    if (limit <= 0) {
+        limit = 1;
+    }
+
+    std::mutex activeLock;
+    std::condition_variable activeCond;
+    int active = 0;
+
+    for (;;) {
+
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        {
+            std::unique_lock<std::mutex> guard(activeLock);
+            activeCond.wait(guard, [&] { return active < limit; });
+            active++;
+        }
+
+        std::thread([fd, &activeLock, &activeCond, &active] {
+            serveConnection(fd);
+
+            {
+                std::lock_guard<std::mutex> guard(activeLock);
+                active--;
+            }
+            activeCond.notify_all();
+        }).detach();
+    }
+
+    minic_log(LOG_ERROR, "套接字(%s)接收连接失败", path.c_str());
+    close(listenFd);
+
+    // 等待正在处理的连接结束
+    std::unique_lock<std::mutex> guard(activeLock);
+    activeCond.wait(guard, [&] { return active == 0; });
+
+    return -1;
+}
+#endif
+
 /// @brief 主程序
 /// @param argc
 /// @param argv
@@ -403,7 +1216,7 @@ int main(int argc, char * argv[])
 #endif
 
     // 参数解析
-    result = ArgsAnalysis(argc, argv);
+    result = ArgsAnalysis(argc, argv, gOptions, false);
     if (result < 0) {
 
         // 在终端显示程序帮助信息
@@ -421,8 +1234,28 @@ int main(int argc, char * argv[])
         return 0;
     }
 
-    // 参数解析正确，进行编译处理，目前只支持一个文件的编译。
-    result = compile(gInputFile, gOutputFile);
+    // 编译服务，常驻进程，编译任务来自Unix域套接字
+    if (!gServePath.empty()) {
+#ifdef _WIN32
+        minic_log(LOG_ERROR, "Windows下不支持编译服务");
+        return -1;
+#else
+        return serve(gServePath);
+#endif
+    }
+
+    // 批量编译，一个进程编译清单中的多个文件
+    if (!gBatchFile.empty()) {
+        return batchCompile(gBatchFile);
+    }
+
+    // 参数解析正确，进行编译处理
+    result = compile(gOptions);
+
+    // 解释执行或者即时编译执行成功时退出码为main函数的返回值
+    if ((result == 0) && (gOptions.run || gOptions.jit)) {
+        result = gRunExitValue;
+    }
 
     return result;
 }
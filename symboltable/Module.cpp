@@ -2,8 +2,8 @@
 /// @file Module.cpp
 /// @brief  符号表-模块类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.4
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,10 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>支持函数体的并行翻译
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>释放模块内的全部资源，支持批量编译
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>支持函数体的按需加载
+/// <tr><td>2026-10-18 <td>1.4     <td>zenglj  <td>增加剖析插桩的运行时函数
 /// </table>
 ///
 #include "Module.h"
@@ -20,8 +24,29 @@
 #include "PointerType.h"
 #include "ScopeStack.h"
 #include "Common.h"
+#include "IRConstant.h"
 #include "VoidType.h"
 
+///
+/// @brief 并行翻译函数体时线程私有的翻译上下文
+///
+struct ModuleThreadContext {
+    /// @brief 所属的模块
+    Module * module;
+
+    /// @brief 线程私有的作用域栈
+    ScopeStack scopeStack;
+
+    /// @brief 当前处理的函数
+    Function * currentFunc = nullptr;
+
+    /// @brief 可见的函数个数
+    size_t visibleFuncCount;
+};
+
+/// @brief 当前线程的翻译上下文，没有并行翻译函数体时为空
+static thread_local ModuleThreadContext * threadContext = nullptr;
+
 Module::Module(std::string _name) : name(_name)
 {
     // 创建作用域栈
@@ -38,24 +63,79 @@ Module::Module(std::string _name) : name(_name)
     (void) newFunction("putarray",
                        VoidType::getType(),
                        {new FormalParam{IntegerType::getTypeInt(), ""},
-                        new FormalParam{new PointerType(IntegerType::getTypeInt()), ""}},
+                        new FormalParam{(Type *) PointerType::get(IntegerType::getTypeInt()), ""}},
                        true);
     (void) newFunction("getarray",
                        IntegerType::getTypeInt(),
-                       {new FormalParam{new PointerType(IntegerType::getTypeInt()), ""}},
+                       {new FormalParam{(Type *) PointerType::get(IntegerType::getTypeInt()), ""}},
+                       true);
+
+    // 剖析插桩时在main函数出口调用，输出计数器：校验和、计数器个数、计数器表
+    (void) newFunction(IR_PROFILE_DUMP,
+                       VoidType::getType(),
+                       {new FormalParam{IntegerType::getTypeInt(), ""},
+                        new FormalParam{IntegerType::getTypeInt(), ""},
+                        new FormalParam{(Type *) PointerType::get(IntegerType::getTypeInt()), ""}},
                        true);
 }
 
+/// @brief 析构函数，释放作用域栈
+Module::~Module()
+{
+    delete scopeStack;
+}
+
 /// @brief 进入作用域，如进入函数体块、语句块等
 void Module::enterScope()
 {
-    scopeStack->enterScope();
+    currentScopeStack()->enterScope();
 }
 
 /// @brief 退出作用域，如退出函数体块、语句块等
 void Module::leaveScope()
 {
-    scopeStack->leaveScope();
+    currentScopeStack()->leaveScope();
+}
+
+///
+/// @brief 获取当前线程使用的作用域栈，并行翻译函数体时为线程私有的作用域栈
+/// @return ScopeStack* 作用域栈
+///
+ScopeStack * Module::currentScopeStack()
+{
+    if (threadContext && (threadContext->module == this)) {
+        return &threadContext->scopeStack;
+    }
+
+    return scopeStack;
+}
+
+///
+/// @brief 获取当前作用域栈的快照，用于函数体的并行翻译
+/// @return std::shared_ptr<const ScopeStack> 作用域栈的快照
+///
+std::shared_ptr<const ScopeStack> Module::snapshotScope()
+{
+    return std::make_shared<const ScopeStack>(*scopeStack);
+}
+
+///
+/// @brief 当前线程开始翻译一个函数体，之后本线程使用线程私有的上下文
+/// @param scope 函数定义处的作用域栈快照
+/// @param visibleFuncCount 函数定义处可见的函数个数
+///
+void Module::enterThreadFunction(const ScopeStack & scope, size_t visibleFuncCount)
+{
+    threadContext = new ModuleThreadContext{this, scope, nullptr, visibleFuncCount};
+}
+
+///
+/// @brief 当前线程结束函数体的翻译，恢复使用模块的上下文
+///
+void Module::leaveThreadFunction()
+{
+    delete threadContext;
+    threadContext = nullptr;
 }
 
 ///
@@ -64,6 +144,10 @@ void Module::leaveScope()
 ///
 Function * Module::getCurrentFunction()
 {
+    if (threadContext && (threadContext->module == this)) {
+        return threadContext->currentFunc;
+    }
+
     return currentFunc;
 }
 
@@ -73,6 +157,11 @@ Function * Module::getCurrentFunction()
 ///
 void Module::setCurrentFunction(Function * current)
 {
+    if (threadContext && (threadContext->module == this)) {
+        threadContext->currentFunc = current;
+        return;
+    }
+
     currentFunc = current;
 }
 
@@ -100,6 +189,7 @@ Function * Module::newFunction(std::string name, Type * returnType, std::vector<
 
     /// 函数类型参数
     FunctionType * type = new FunctionType(returnType, paramsType);
+    types.push_back(type);
 
     // 新建函数对象
     tempFunc = new Function(name, type, builtin);
@@ -119,12 +209,17 @@ Function * Module::findFunction(std::string name)
 {
     // 根据名字查找
     auto pIter = funcMap.find(name);
-    if (pIter != funcMap.end()) {
-        // 查找到
-        return pIter->second;
+    if (pIter == funcMap.end()) {
+        return nullptr;
+    }
+
+    // 并行翻译函数体时，只能看到函数定义处之前的函数，与顺序翻译时一致
+    if (threadContext && (threadContext->module == this) && (pIter->second >= threadContext->visibleFuncCount)) {
+        return nullptr;
     }
 
-    return nullptr;
+    // 查找到
+    return funcVector[pIter->second];
 }
 
 ///
@@ -133,7 +228,7 @@ Function * Module::findFunction(std::string name)
 ///
 void Module::insertFunctionDirectly(Function * func)
 {
-    funcMap.insert({func->getName(), func});
+    funcMap.insert({func->getName(), funcVector.size()});
     funcVector.emplace_back(func);
 }
 
@@ -159,7 +254,19 @@ void Module::insertConstIntDirectly(ConstInt * val)
 /// @return 常量Value
 ConstInt * Module::newConstInt(int32_t intVal)
 {
-    // 查找整数字符串
+    // 常量大多已经存在，先用共享锁查找
+    {
+        std::shared_lock<std::shared_mutex> guard(constIntLock);
+
+        ConstInt * val = findConstInt(intVal);
+        if (val) {
+            return val;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> guard(constIntLock);
+
+    // 加锁期间其它线程可能已经创建，需要再次查找
     ConstInt * val = findConstInt(intVal);
     if (!val) {
 
@@ -198,39 +305,43 @@ Value * Module::newVarValue(Type * type, std::string name)
     Value * retVal;
     std::string varName;
 
+    // 并行翻译函数体时为线程私有的当前函数与作用域栈
+    Function * func = getCurrentFunction();
+    ScopeStack * scope = currentScopeStack();
+
     // 若变量名有效，检查当前作用域中是否存在变量，如存在则语义错误
     // 反之，因无效需创建新的变量名，肯定不现在的不同，不需要查找
     if (!name.empty()) {
-        Value * tempValue = scopeStack->findCurrentScope(name);
+        Value * tempValue = scope->findCurrentScope(name);
         if (tempValue) {
             // 变量存在，语义错误
             minic_log(LOG_ERROR, "变量(%s)已经存在", name.c_str());
             return nullptr;
         }
-    } else if (!currentFunc) {
+    } else if (!func) {
         // 全局变量要求name不能为空串，必须有效
         minic_log(LOG_ERROR, "变量名为空");
         return nullptr;
     }
 
-    if (currentFunc) {
+    if (func) {
 
         // 获取变量作用域的层级
         int32_t scope_level;
         if (name.empty()) {
             scope_level = 1;
         } else {
-            scope_level = scopeStack->getCurrentScopeLevel();
+            scope_level = scope->getCurrentScopeLevel();
         }
 
-        retVal = currentFunc->newLocalVarValue(type, name, scope_level);
+        retVal = func->newLocalVarValue(type, name, scope_level);
 
     } else {
         retVal = newGlobalVariable(type, name);
     }
 
     // 增加做作用域中
-    scopeStack->insertValue(retVal);
+    scope->insertValue(retVal);
 
     return retVal;
 }
@@ -243,7 +354,7 @@ Value * Module::newVarValue(Type * type, std::string name)
 Value * Module::findVarValue(std::string name)
 {
     // 逐层级作用域查找
-    Value * tempValue = scopeStack->findAllScope(name);
+    Value * tempValue = currentScopeStack()->findAllScope(name);
 
     return tempValue;
 }
@@ -283,6 +394,9 @@ GlobalVariable * Module::findGlobalVariable(std::string name)
 /// @brief 清理注册的所有Value资源
 void Module::Delete()
 {
+    // 加载器记录了函数等信息，先释放
+    materializer.reset();
+
     // 清除所有的函数
     for (auto func: funcVector) {
         delete func;
@@ -293,6 +407,19 @@ void Module::Delete()
         delete var;
     }
 
+    // 清理常量
+    for (auto & [val, constInt]: constIntMap) {
+        (void) val;
+        delete constInt;
+    }
+    constIntMap.clear();
+
+    // 清理函数类型
+    for (auto type: types) {
+        delete type;
+    }
+    types.clear();
+
     // 相关列表清空
     globalVariableMap.clear();
     globalVariableVector.clear();
@@ -301,6 +428,35 @@ void Module::Delete()
     funcVector.clear();
 }
 
+///
+/// @brief 确保函数体已经创建，在使用函数的IR指令之前调用
+/// @param func 函数
+/// @return true：成功，false：失败
+///
+bool Module::materialize(Function * func)
+{
+    if (!materializer || func->isBuiltin()) {
+        return true;
+    }
+
+    return materializer->materialize(func);
+}
+
+///
+/// @brief 创建所有函数的函数体
+/// @return true：成功，false：失败
+///
+bool Module::materializeAll()
+{
+    for (auto func: funcVector) {
+        if (!materialize(func)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 ///
 /// @brief 对IR指令中没有名字的全部命名
 ///
@@ -2,8 +2,8 @@
 /// @file Module.h
 /// @brief 符号表-模块类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.3
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,10 +11,15 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>支持函数体的并行翻译
+/// <tr><td>2026-10-18 <td>1.2     <td>zenglj  <td>释放模块内的全部资源，支持批量编译
+/// <tr><td>2026-10-18 <td>1.3     <td>zenglj  <td>支持函数体的按需加载
 /// </table>
 ///
 #pragma once
 
+#include <memory>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -26,6 +31,23 @@
 
 class ScopeStack;
 
+///
+/// @brief 函数体的按需加载接口，如从二进制IR文件中加载的模块，函数体在第一次使用时才创建
+///
+class IRMaterializer {
+
+public:
+    /// @brief 析构函数
+    virtual ~IRMaterializer() = default;
+
+    ///
+    /// @brief 创建函数体的IR指令，已经创建过的函数直接返回成功
+    /// @param func 函数
+    /// @return true：成功，false：失败
+    ///
+    virtual bool materialize(Function * func) = 0;
+};
+
 ///
 /// @brief  一个Module代表一个C语言的源文件
 ///
@@ -39,9 +61,9 @@ public:
     Module(std::string _name);
 
     ///
-    /// @brief 缺省的析构函数
+    /// @brief 析构函数，释放作用域栈
     ///
-    virtual ~Module() = default;
+    virtual ~Module();
 
     ///
     /// @brief 输出IR代码
@@ -76,6 +98,35 @@ public:
     ///
     void setCurrentFunction(Function * current);
 
+    ///
+    /// @brief 获取当前作用域栈的快照，用于函数体的并行翻译。
+    /// 快照中只有到目前为止声明的全局变量，保证函数体只能看到其前面声明的全局变量
+    /// @return std::shared_ptr<const ScopeStack> 作用域栈的快照
+    ///
+    std::shared_ptr<const ScopeStack> snapshotScope();
+
+    ///
+    /// @brief 获取函数的个数（含内置函数）
+    /// @return size_t 函数个数
+    ///
+    size_t getFunctionCount()
+    {
+        return funcVector.size();
+    }
+
+    ///
+    /// @brief 当前线程开始翻译一个函数体，之后本线程的当前函数、作用域栈与函数查找使用线程私有的上下文，
+    /// 不同线程可同时翻译不同的函数体
+    /// @param scope 函数定义处的作用域栈快照，复制一份供本线程使用
+    /// @param visibleFuncCount 函数定义处可见的函数个数，只能查找到这些函数（含函数自身）
+    ///
+    void enterThreadFunction(const ScopeStack & scope, size_t visibleFuncCount);
+
+    ///
+    /// @brief 当前线程结束函数体的翻译，恢复使用模块的上下文
+    ///
+    void leaveThreadFunction();
+
     /// @brief 新建函数并放到函数列表中
     /// @param name 函数名
     /// @param returnType 返回值类型
@@ -134,7 +185,35 @@ public:
     ///
     void renameIR();
 
+    ///
+    /// @brief 设置函数体的按需加载器，由模块负责释放
+    /// @param loader 加载器
+    ///
+    void setMaterializer(std::unique_ptr<IRMaterializer> loader)
+    {
+        materializer = std::move(loader);
+    }
+
+    ///
+    /// @brief 确保函数体已经创建，在使用函数的IR指令之前调用
+    /// @param func 函数
+    /// @return true：成功，false：失败
+    ///
+    bool materialize(Function * func);
+
+    ///
+    /// @brief 创建所有函数的函数体
+    /// @return true：成功，false：失败
+    ///
+    bool materializeAll();
+
 protected:
+    ///
+    /// @brief 获取当前线程使用的作用域栈，并行翻译函数体时为线程私有的作用域栈
+    /// @return ScopeStack* 作用域栈
+    ///
+    ScopeStack * currentScopeStack();
+
     /// @brief 根据整数值获取当前符号
     /// \param name 变量名
     /// \return 变量对应的值
@@ -182,8 +261,8 @@ private:
     /// @brief 遍历抽象树过程中的当前处理函数
     Function * currentFunc = nullptr;
 
-    /// @brief 函数映射表，函数名-函数，便于检索
-    std::unordered_map<std::string, Function *> funcMap;
+    /// @brief 函数映射表，函数名-函数在函数列表中的序号，便于检索
+    std::unordered_map<std::string, size_t> funcMap;
 
     /// @brief  函数列表
     std::vector<Function *> funcVector;
@@ -196,4 +275,10 @@ private:
 
     /// @brief 常量表
     std::unordered_map<int32_t, ConstInt *> constIntMap;
+
+    /// @brief 保护常量表，函数体并行翻译时多个线程会同时创建常量
+    std::shared_mutex constIntLock;
+
+    /// @brief 函数体的按需加载器，没有时所有函数体都已经创建
+    std::unique_ptr<IRMaterializer> materializer;
 };
\ No newline at end of file
@@ -13,16 +13,20 @@
 /// <tr><td>2024-09-19 <td>1.0     <td>zenglj  <td>新建
 /// </table>
 ///
+#include <functional>
+
 #include "ScopeStack.h"
 
+/// @brief 符号表初始的槽位个数，必须是2的幂次
+#define SCOPE_INIT_SLOT_NUM 64
+
 ///
 /// @brief 进入作用域
 ///
 void ScopeStack::enterScope()
 {
-    // 在栈顶新加入一层，没有变量
-    std::unordered_map<std::string, Value *> valueMap;
-    valueStack.emplace_back(valueMap);
+    // 只记录撤销日志的位置，不需要新建任何表
+    scopeMarks.push_back(undoLog.size());
 }
 
 ///
@@ -30,7 +34,14 @@ void ScopeStack::enterScope()
 ///
 void ScopeStack::leaveScope()
 {
-    valueStack.pop_back();
+    size_t mark = scopeMarks.back();
+    scopeMarks.pop_back();
+
+    // 逆序撤销本作用域内的绑定，恢复被遮蔽的外层变量
+    while (undoLog.size() > mark) {
+        bindings[undoLog.back()].pop_back();
+        undoLog.pop_back();
+    }
 }
 
 ///
@@ -39,7 +50,24 @@ void ScopeStack::leaveScope()
 ///
 void ScopeStack::insertValue(Value * value)
 {
-    valueStack.back().insert(make_pair(value->getName(), value));
+    const std::string & name = value->getName();
+
+    // 没有名字的临时变量不可能被按名字查找，不需要加入
+    if (name.empty()) {
+        return;
+    }
+
+    int32_t symbol = intern(name, true);
+    int32_t level = getCurrentScopeLevel();
+
+    // 同一作用域内已存在，则保留先加入的变量
+    std::vector<Binding> & stack = bindings[symbol];
+    if (!stack.empty() && stack.back().level == level) {
+        return;
+    }
+
+    stack.push_back({level, value});
+    undoLog.push_back(symbol);
 }
 
 ///
@@ -47,12 +75,17 @@ void ScopeStack::insertValue(Value * value)
 /// @param  name 变量名
 /// @return Value* 变量对象，若没有，则返回空指针
 ///
-Value * ScopeStack::findCurrentScope(std::string name)
+Value * ScopeStack::findCurrentScope(const std::string & name)
 {
-    // 在栈顶的作用域中查找，即当前作用域
-    auto it = valueStack.back().find(name);
-    if (it != valueStack.back().end()) {
-        return it->second;
+    int32_t symbol = intern(name, false);
+    if (symbol == -1) {
+        return nullptr;
+    }
+
+    // 栈顶的绑定属于当前作用域才算找到
+    std::vector<Binding> & stack = bindings[symbol];
+    if (!stack.empty() && stack.back().level == getCurrentScopeLevel()) {
+        return stack.back().value;
     }
     return nullptr;
 }
@@ -62,14 +95,17 @@ Value * ScopeStack::findCurrentScope(std::string name)
 /// @param  name 变量名
 /// @return Value* 变量对象。若没有，则返回空指针
 ///
-Value * ScopeStack::findAllScope(std::string name)
+Value * ScopeStack::findAllScope(const std::string & name)
 {
-    // 模拟栈操作，从栈顶开始查找
-    for (auto it = valueStack.rbegin(); it != valueStack.rend(); ++it) {
-        auto p = it->find(name);
-        if (p != it->end()) {
-            return p->second;
-        }
+    int32_t symbol = intern(name, false);
+    if (symbol == -1) {
+        return nullptr;
+    }
+
+    // 栈顶即最内层可见的变量
+    std::vector<Binding> & stack = bindings[symbol];
+    if (!stack.empty()) {
+        return stack.back().value;
     }
     return nullptr;
 }
@@ -80,5 +116,77 @@ Value * ScopeStack::findAllScope(std::string name)
 ///
 int ScopeStack::getCurrentScopeLevel()
 {
-    return valueStack.size() - 1;
+    return (int) scopeMarks.size() - 1;
+}
+
+///
+/// @brief 变量名驻留，返回变量名对应的符号ID
+/// @param name 变量名
+/// @param create 不存在时是否创建
+/// @return int32_t 符号ID，不存在且不创建时返回-1
+///
+int32_t ScopeStack::intern(const std::string & name, bool create)
+{
+    if (slots.empty()) {
+        if (!create) {
+            return -1;
+        }
+        slots.assign(SCOPE_INIT_SLOT_NUM, -1);
+    }
+
+    size_t hash = std::hash<std::string>{}(name);
+    size_t mask = slots.size() - 1;
+
+    // 线性探测
+    for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+
+        int32_t symbol = slots[pos];
+        if (symbol == -1) {
+            break;
+        }
+
+        if (symbolHashes[symbol] == hash && symbolNames[symbol] == name) {
+            return symbol;
+        }
+    }
+
+    if (!create) {
+        return -1;
+    }
+
+    // 新建符号
+    int32_t symbol = (int32_t) symbolNames.size();
+    symbolNames.push_back(name);
+    symbolHashes.push_back(hash);
+    bindings.emplace_back();
+
+    // 装载因子超过1/2则扩容，否则直接放入探测到的空槽位
+    if (symbolNames.size() * 2 > slots.size()) {
+        rehash();
+    } else {
+        size_t pos = hash & mask;
+        while (slots[pos] != -1) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos] = symbol;
+    }
+
+    return symbol;
+}
+
+///
+/// @brief 符号表扩容，并重新散列所有的符号
+///
+void ScopeStack::rehash()
+{
+    slots.assign(slots.size() * 2, -1);
+    size_t mask = slots.size() - 1;
+
+    for (int32_t symbol = 0; symbol < (int32_t) symbolNames.size(); ++symbol) {
+        size_t pos = symbolHashes[symbol] & mask;
+        while (slots[pos] != -1) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos] = symbol;
+    }
 }
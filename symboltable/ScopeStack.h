@@ -15,16 +15,21 @@
 ///
 #pragma once
 
-#include <unordered_map>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include "Value.h"
 
 ///
-/// @brief 变量作用域管理类，内部通过栈来实现
+/// @brief 变量作用域管理类，采用链式遮蔽(chained shadowing)的扁平符号表实现
+///
+/// 所有作用域共用一张开放定址的符号表，变量名先被驻留(intern)为整数符号ID，
+/// 每个符号ID对应一个绑定栈，栈中保存(作用域层级, Value*)，栈顶即当前可见的变量。
+/// 每个作用域记录自己在撤销日志中的起始位置，离开作用域时只回退本作用域内声明过的变量，
+/// 因此进入/离开作用域的开销与层数无关，查找也只需一次哈希探测。
 ///
 class ScopeStack {
-    // 作用域栈
 
 public:
     ///
@@ -38,7 +43,7 @@ public:
     /// @param  name 变量名
     /// @return Value* 变量对象，若没有，则返回空指针
     ///
-    Value * findCurrentScope(std::string name);
+    Value * findCurrentScope(const std::string & name);
 
     ///
     /// @brief 获取当前的作用域栈的层号
@@ -51,7 +56,7 @@ public:
     /// @param  name 变量名
     /// @return Value* 变量对象。若没有，则返回空指针
     ///
-    Value * findAllScope(std::string name);
+    Value * findAllScope(const std::string & name);
 
     ///
     /// @brief 进入作用域
@@ -65,7 +70,56 @@ public:
 
 protected:
     ///
-    /// @brief 变量作用域栈，最外层用vector来模拟栈，每一层用unordered_map来实现，变量名为key，变量为value
+    /// @brief 变量名驻留，返回变量名对应的符号ID
+    /// @param name 变量名
+    /// @param create 不存在时是否创建
+    /// @return int32_t 符号ID，不存在且不创建时返回-1
+    ///
+    int32_t intern(const std::string & name, bool create);
+
+    ///
+    /// @brief 符号表扩容，并重新散列所有的符号
+    ///
+    void rehash();
+
+    ///
+    /// @brief 一次变量绑定，记录变量所在的作用域层级
+    ///
+    struct Binding {
+        /// @brief 作用域层级
+        int32_t level;
+
+        /// @brief 变量
+        Value * value;
+    };
+
+    ///
+    /// @brief 开放定址（线性探测）的符号槽位，保存符号ID，-1表示空槽位。容量总是2的幂次
+    ///
+    std::vector<int32_t> slots;
+
+    ///
+    /// @brief 符号ID对应的变量名
+    ///
+    std::vector<std::string> symbolNames;
+
+    ///
+    /// @brief 符号ID对应的变量名的哈希值，扩容时避免重新计算
+    ///
+    std::vector<size_t> symbolHashes;
+
+    ///
+    /// @brief 符号ID对应的绑定栈，栈顶为当前可见的变量
+    ///
+    std::vector<std::vector<Binding>> bindings;
+
+    ///
+    /// @brief 撤销日志，按声明次序记录被绑定的符号ID
+    ///
+    std::vector<int32_t> undoLog;
+
+    ///
+    /// @brief 每层作用域进入时撤销日志的长度，其大小即为作用域的层数
     ///
-    std::vector<std::unordered_map<std::string, Value *>> valueStack;
+    std::vector<size_t> scopeMarks;
 };
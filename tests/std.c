@@ -2,8 +2,8 @@
 /// @file std.c
 /// @brief 外部或内置函数实现
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 /// 
 /// @copyright Copyright (c) 2024
 /// 
@@ -11,9 +11,11 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析数据输出函数
 /// </table>
 ///
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdarg.h>
 
 int getint()
@@ -119,3 +121,27 @@ void putf(char a[], ...)
     va_end(args);
 }
 
+
+void __minic_prof_dump(int checksum, int n, int * counters)
+{
+    // 剖析数据文件，环境变量MINIC_PROFILE_FILE可指定
+    const char * path = getenv("MINIC_PROFILE_FILE");
+    if (path == NULL) {
+        path = "minic.profdata";
+    }
+
+    FILE * fp = fopen(path, "w");
+    if (fp == NULL) {
+        return;
+    }
+
+    // 文件头：魔数、校验和、计数器个数
+    fprintf(fp, "minic-profile %d %d\n", checksum, n);
+
+    // 每行一个计数器的值
+    for (int k = 0; k < n; k++) {
+        fprintf(fp, "%u\n", (unsigned) counters[k]);
+    }
+
+    fclose(fp);
+}
@@ -2,8 +2,8 @@
 /// @file std.h
 /// @brief 外部或内置函数头文件
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,6 +11,7 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新做
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加剖析数据输出函数
 /// </table>
 ///
 
@@ -34,4 +35,7 @@ void putfloat(float a);
 void putfarray(int n, float a[]);
 void putf(char a[], ...);
 
+/* Profile functions，--profile-generate生成的程序退出前调用 */
+void __minic_prof_dump(int checksum, int n, int counters[]);
+
 #endif // MINIC_STD_H
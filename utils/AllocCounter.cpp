@@ -0,0 +1,101 @@
+///
+/// @file AllocCounter.cpp
+/// @brief 动态内存分配的次数与字节数统计的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocCounter.h"
+
+/// @brief 整个进程的分配次数
+static std::atomic<int64_t> processAllocs{0};
+
+/// @brief 整个进程的分配字节数
+static std::atomic<int64_t> processBytes{0};
+
+/// @brief 当前线程的分配计数
+static thread_local AllocCounter::Count threadCount;
+
+///
+/// @brief 获取整个进程的分配计数
+/// @return Count 计数
+///
+AllocCounter::Count AllocCounter::process()
+{
+    Count count;
+    count.allocs = processAllocs.load(std::memory_order_relaxed);
+    count.bytes = processBytes.load(std::memory_order_relaxed);
+    return count;
+}
+
+///
+/// @brief 获取当前线程的分配计数
+/// @return Count 计数
+///
+AllocCounter::Count AllocCounter::thread()
+{
+    return threadCount;
+}
+
+///
+/// @brief 累计一次分配，由operator new调用
+/// @param size 字节数
+///
+void AllocCounter::record(size_t size)
+{
+    processAllocs.fetch_add(1, std::memory_order_relaxed);
+    processBytes.fetch_add((int64_t) size, std::memory_order_relaxed);
+    threadCount.allocs++;
+    threadCount.bytes += (int64_t) size;
+}
+
+///
+/// @brief 替换全局的operator new，统计后用malloc分配
+/// @param size 字节数
+/// @return void* 分配的内存
+///
+/// 标准库默认的operator new[]、nothrow版本都转调operator new(size_t)，operator delete[]与带大小的
+/// operator delete都转调operator delete(void *)，因此只需替换这两个。
+///
+void * operator new(std::size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+
+    AllocCounter::record(size);
+
+    for (;;) {
+        void * ptr = std::malloc(size);
+        if (ptr) {
+            return ptr;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+///
+/// @brief 替换全局的operator delete，与operator new对应用free释放
+/// @param ptr 内存
+///
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,58 @@
+///
+/// @file AllocCounter.h
+/// @brief 动态内存分配的次数与字节数统计
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// @brief 统计经过operator new的内存分配
+///
+/// AllocCounter.cpp替换了全局的operator new，每次分配同时累计到整个进程与当前线程的计数中。
+/// 直接调用malloc的分配不统计。计数只增不减，统计一段代码的分配时取前后两次计数的差。
+///
+class AllocCounter {
+
+public:
+    ///
+    /// @brief 分配的计数
+    ///
+    struct Count {
+        /// @brief 分配的次数
+        int64_t allocs = 0;
+
+        /// @brief 分配的字节数
+        int64_t bytes = 0;
+    };
+
+    ///
+    /// @brief 获取整个进程的分配计数
+    /// @return Count 计数
+    ///
+    static Count process();
+
+    ///
+    /// @brief 获取当前线程的分配计数
+    /// @return Count 计数
+    ///
+    static Count thread();
+
+    ///
+    /// @brief 累计一次分配，由operator new调用
+    /// @param size 字节数
+    ///
+    static void record(size_t size);
+};
@@ -0,0 +1,184 @@
+///
+/// @file BufferedWriter.cpp
+/// @brief 大缓冲区的文件输出类的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+#include <climits>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "BufferedWriter.h"
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+///
+/// @brief 析构函数，关闭文件
+///
+BufferedWriter::~BufferedWriter()
+{
+    (void) close();
+}
+
+///
+/// @brief 创建文件，之前打开的文件会被关闭
+/// @param path 文件路径，空串时输出到标准输出
+/// @return true：成功，false：失败
+///
+bool BufferedWriter::open(const std::string & path)
+{
+    (void) close();
+
+    ok = true;
+    owned = !path.empty();
+
+#ifdef _WIN32
+    fp = owned ? fopen(path.c_str(), "wb") : stdout;
+    if (nullptr == fp) {
+        return false;
+    }
+#else
+    fd = owned ? ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+    if (fd < 0) {
+        return false;
+    }
+#endif
+
+    buffer.reserve(FLUSH_SIZE + FLUSH_SIZE / 4);
+
+    return true;
+}
+
+///
+/// @brief 写入缓冲区的剩余内容并关闭文件
+/// @return true：所有内容都写入成功，false：有写入失败
+///
+bool BufferedWriter::close()
+{
+#ifdef _WIN32
+    if (nullptr == fp) {
+        return ok;
+    }
+
+    flush();
+
+    if (owned) {
+        ok = (fclose(fp) == 0) && ok;
+    } else {
+        ok = (fflush(fp) == 0) && ok;
+    }
+    fp = nullptr;
+#else
+    if (fd < 0) {
+        return ok;
+    }
+
+    flush();
+
+    if (owned) {
+        ok = (::close(fd) == 0) && ok;
+    }
+    fd = -1;
+#endif
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    return ok;
+}
+
+///
+/// @brief 缓冲区的内容写入文件
+///
+void BufferedWriter::flush()
+{
+    writeRaw(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+///
+/// @brief 把一段内存完整写入文件
+/// @param data 首地址
+/// @param size 字节数
+///
+void BufferedWriter::writeRaw(const char * data, size_t size)
+{
+#ifdef _WIN32
+    if (ok && (size > 0) && (fwrite(data, 1, size, fp) != size)) {
+        ok = false;
+    }
+#else
+    while (ok && (size > 0)) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            ok = (errno == EINTR);
+            continue;
+        }
+        data += n;
+        size -= (size_t) n;
+    }
+#endif
+}
+
+///
+/// @brief 先写入缓冲区的内容，再把多段内容依次写入文件
+/// @param buffers 各段内容
+///
+void BufferedWriter::writeBuffers(const std::vector<std::string> & buffers)
+{
+    flush();
+
+#ifdef _WIN32
+    for (auto & buf: buffers) {
+        writeRaw(buf.data(), buf.size());
+    }
+#else
+    std::vector<struct iovec> iov;
+    iov.reserve(buffers.size());
+    for (auto & buf: buffers) {
+        if (!buf.empty()) {
+            iov.push_back({const_cast<char *>(buf.data()), buf.size()});
+        }
+    }
+
+    // 一次writev最多IOV_MAX段，可能只写入一部分，从写到的位置继续
+    size_t index = 0;
+    while (ok && (index < iov.size())) {
+
+        int count = (int) std::min(iov.size() - index, (size_t) IOV_MAX);
+        ssize_t n = ::writev(fd, &iov[index], count);
+        if (n < 0) {
+            ok = (errno == EINTR);
+            continue;
+        }
+
+        size_t written = (size_t) n;
+        while ((index < iov.size()) && (written >= iov[index].iov_len)) {
+            written -= iov[index].iov_len;
+            index++;
+        }
+
+        if (written > 0) {
+            iov[index].iov_base = static_cast<char *>(iov[index].iov_base) + written;
+            iov[index].iov_len -= written;
+        }
+    }
+#endif
+}
@@ -0,0 +1,149 @@
+///
+/// @file BufferedWriter.h
+/// @brief 大缓冲区的文件输出类
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+///
+/// @brief 整数以十进制追加到字符串中，不产生临时字符串
+/// @param str 字符串
+/// @param v 整数
+///
+template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+inline void appendInt(std::string & str, T v)
+{
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), v);
+    str.append(digits, result.ptr - digits);
+}
+
+///
+/// @brief 带大缓冲区的文件输出
+///
+/// 输出内容先追加到数MB的缓冲区中，满了才用一次write写入文件，整数用std::to_chars格式化。
+/// 已经在内存中的多段内容（如各函数的汇编代码）可用writeBuffers一次writev写入，不再复制到缓冲区。
+///
+class BufferedWriter {
+
+public:
+    ///
+    /// @brief 构造函数
+    ///
+    BufferedWriter() = default;
+
+    ///
+    /// @brief 析构函数，关闭文件
+    ///
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter & operator=(const BufferedWriter &) = delete;
+
+    ///
+    /// @brief 创建文件，之前打开的文件会被关闭
+    /// @param path 文件路径，空串时输出到标准输出
+    /// @return true：成功，false：失败
+    ///
+    bool open(const std::string & path);
+
+    ///
+    /// @brief 写入缓冲区的剩余内容并关闭文件
+    /// @return true：所有内容都写入成功，false：有写入失败
+    ///
+    bool close();
+
+    ///
+    /// @brief 追加字符串
+    /// @param str 字符串
+    /// @return BufferedWriter& 自身，便于连续输出
+    ///
+    BufferedWriter & operator<<(std::string_view str)
+    {
+        buffer.append(str.data(), str.size());
+        if (buffer.size() >= FLUSH_SIZE) {
+            flush();
+        }
+        return *this;
+    }
+
+    ///
+    /// @brief 追加字符
+    /// @param c 字符
+    /// @return BufferedWriter& 自身，便于连续输出
+    ///
+    BufferedWriter & operator<<(char c)
+    {
+        buffer.push_back(c);
+        return *this;
+    }
+
+    ///
+    /// @brief 以十进制追加整数
+    /// @param v 整数
+    /// @return BufferedWriter& 自身，便于连续输出
+    ///
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char>, int> = 0>
+    BufferedWriter & operator<<(T v)
+    {
+        appendInt(buffer, v);
+        return *this;
+    }
+
+    ///
+    /// @brief 先写入缓冲区的内容，再把多段内容依次写入文件
+    /// @param buffers 各段内容
+    ///
+    void writeBuffers(const std::vector<std::string> & buffers);
+
+protected:
+    ///
+    /// @brief 缓冲区的内容写入文件
+    ///
+    void flush();
+
+    ///
+    /// @brief 把一段内存完整写入文件
+    /// @param data 首地址
+    /// @param size 字节数
+    ///
+    void writeRaw(const char * data, size_t size);
+
+private:
+    /// @brief 缓冲区超过该字节数时写入文件
+    static constexpr size_t FLUSH_SIZE = 4 << 20;
+
+    /// @brief 缓冲区
+    std::string buffer;
+
+#ifdef _WIN32
+    /// @brief 文件指针
+    FILE * fp = nullptr;
+#else
+    /// @brief 文件描述符
+    int fd = -1;
+#endif
+
+    /// @brief 是否需要关闭文件，标准输出不关闭
+    bool owned = false;
+
+    /// @brief 写入是否都成功
+    bool ok = true;
+};
@@ -0,0 +1,286 @@
+///
+/// @file CompileCache.cpp
+/// @brief 以内容哈希为键的磁盘编译缓存的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "CompileCache.h"
+
+/// @brief 64位循环左移
+static inline uint64_t rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+/// @brief MurmurHash3的最终混合
+static inline uint64_t fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+/// @brief 按小端读取64位整数
+static inline uint64_t load64(const uint8_t * p)
+{
+    uint64_t v = 0;
+    for (int k = 7; k >= 0; --k) {
+        v = (v << 8) | p[k];
+    }
+    return v;
+}
+
+///
+/// @brief MurmurHash3_x64_128，速度快且分布均匀，用于缓存键值
+/// @param data 数据
+/// @param len 字节数
+/// @param h1 结果的低64位
+/// @param h2 结果的高64位
+///
+static void murmur3_128(const void * data, size_t len, uint64_t & h1, uint64_t & h2)
+{
+    const uint8_t * bytes = (const uint8_t *) data;
+    const size_t nblocks = len / 16;
+
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    h1 = 0;
+    h2 = 0;
+
+    for (size_t i = 0; i < nblocks; i++) {
+        uint64_t k1 = load64(bytes + i * 16);
+        uint64_t k2 = load64(bytes + i * 16 + 8);
+
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+
+        h1 = rotl64(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+
+        h2 = rotl64(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // 不足16字节的尾部
+    const uint8_t * tail = bytes + nblocks * 16;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    for (size_t k = len & 15; k > 8; --k) {
+        k2 |= (uint64_t) tail[k - 1] << ((k - 9) * 8);
+    }
+    if ((len & 15) > 8) {
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+
+    for (size_t k = std::min<size_t>(len & 15, 8); k > 0; --k) {
+        k1 |= (uint64_t) tail[k - 1] << ((k - 1) * 8);
+    }
+    if ((len & 15) > 0) {
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= len;
+    h2 ^= len;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+}
+
+///
+/// @brief 加入一部分内容
+/// @param part 内容
+/// @return CacheKey& 自身，便于连续加入
+///
+CacheKey & CacheKey::add(std::string_view part)
+{
+    material += std::to_string(part.size());
+    material += ':';
+    material.append(part.data(), part.size());
+
+    return *this;
+}
+
+///
+/// @brief 加入一个整数
+/// @param value 整数
+/// @return CacheKey& 自身，便于连续加入
+///
+CacheKey & CacheKey::add(int64_t value)
+{
+    return add(std::string_view(std::to_string(value)));
+}
+
+///
+/// @brief 计算128位的摘要
+/// @return std::string 32个十六进制字符
+///
+std::string CacheKey::digest() const
+{
+    uint64_t h1, h2;
+    murmur3_128(material.data(), material.size(), h1, h2);
+
+    char buf[33];
+    snprintf(buf, sizeof(buf), "%016llx%016llx", (unsigned long long) h2, (unsigned long long) h1);
+
+    return buf;
+}
+
+///
+/// @brief 构造函数
+/// @param dir 缓存目录，不存在时在第一次写入时创建
+///
+CompileCache::CompileCache(std::string _dir) : dir(std::move(_dir))
+{}
+
+///
+/// @brief 缓存项的文件路径，按键值的前两个字符分子目录，避免单个目录下的文件过多
+/// @param key 键值
+/// @return std::string 文件路径
+///
+std::string CompileCache::entryPath(const std::string & key) const
+{
+    return dir + "/" + key.substr(0, 2) + "/" + key.substr(2);
+}
+
+///
+/// @brief 读取缓存项
+/// @param key 键值
+/// @param data 读取的内容
+/// @return true：命中，false：没有命中
+///
+bool CompileCache::load(const std::string & key, std::string & data) const
+{
+    return readFile(entryPath(key), data);
+}
+
+///
+/// @brief 写入缓存项
+/// @param key 键值
+/// @param data 要写入的内容
+/// @return true：成功，false：失败
+///
+bool CompileCache::store(const std::string & key, std::string_view data) const
+{
+    // 同一进程内的多个线程以及多个进程的临时文件名都不能相同
+    static std::atomic<uint64_t> tempIndex{0};
+
+    std::string path = entryPath(key);
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    if (ec) {
+        return false;
+    }
+
+    std::string tempPath = path + ".tmp" + std::to_string(getpid()) + "." + std::to_string(tempIndex++);
+
+    if (!writeFile(tempPath, data)) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief 读取整个文件的内容
+/// @param path 文件路径
+/// @param data 文件内容
+/// @return true：成功，false：失败
+///
+bool CompileCache::readFile(const std::string & path, std::string & data)
+{
+    FILE * fp = fopen(path.c_str(), "rb");
+    if (nullptr == fp) {
+        return false;
+    }
+
+    data.clear();
+
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        data.append(buf, n);
+    }
+
+    bool ok = !ferror(fp);
+    fclose(fp);
+
+    return ok;
+}
+
+///
+/// @brief 把内容写入文件
+/// @param path 文件路径
+/// @param data 要写入的内容
+/// @return true：成功，false：失败
+///
+bool CompileCache::writeFile(const std::string & path, std::string_view data)
+{
+    FILE * fp = fopen(path.c_str(), "wb");
+    if (nullptr == fp) {
+        return false;
+    }
+
+    bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+
+    // 关闭时才真正写入磁盘，也要检查
+    ok = (fclose(fp) == 0) && ok;
+
+    return ok;
+}
@@ -0,0 +1,124 @@
+///
+/// @file CompileCache.h
+/// @brief 以内容哈希为键的磁盘编译缓存
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+///
+/// @brief 编译器的版本，参与缓存键值的计算，版本变化后旧的缓存自动失效
+///
+#ifndef MINIC_VERSION
+#define MINIC_VERSION "unknown"
+#endif
+
+///
+/// @brief 缓存键值的计算，依次加入参与计算的各部分内容后取摘要
+///
+/// 每部分内容前都加入其长度，避免不同的划分方式拼接出相同的内容。
+///
+class CacheKey {
+
+public:
+    ///
+    /// @brief 加入一部分内容
+    /// @param part 内容
+    /// @return CacheKey& 自身，便于连续加入
+    ///
+    CacheKey & add(std::string_view part);
+
+    ///
+    /// @brief 加入一个整数
+    /// @param value 整数
+    /// @return CacheKey& 自身，便于连续加入
+    ///
+    CacheKey & add(int64_t value);
+
+    ///
+    /// @brief 计算128位的摘要
+    /// @return std::string 32个十六进制字符
+    ///
+    [[nodiscard]] std::string digest() const;
+
+private:
+    ///
+    /// @brief 参与计算的全部内容
+    ///
+    std::string material;
+};
+
+///
+/// @brief 磁盘编译缓存，每个缓存项是缓存目录下以键值命名的一个文件
+///
+/// 缓存项先写入临时文件再改名，多个线程或进程同时编译时读到的缓存项总是完整的。
+/// 缓存只是加速手段，读写失败时都当作没有命中处理，不影响编译结果。
+///
+class CompileCache {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param dir 缓存目录，不存在时在第一次写入时创建
+    ///
+    explicit CompileCache(std::string dir);
+
+    ///
+    /// @brief 读取缓存项
+    /// @param key 键值
+    /// @param data 读取的内容
+    /// @return true：命中，false：没有命中
+    ///
+    bool load(const std::string & key, std::string & data) const;
+
+    ///
+    /// @brief 写入缓存项
+    /// @param key 键值
+    /// @param data 要写入的内容
+    /// @return true：成功，false：失败
+    ///
+    bool store(const std::string & key, std::string_view data) const;
+
+    ///
+    /// @brief 读取整个文件的内容
+    /// @param path 文件路径
+    /// @param data 文件内容
+    /// @return true：成功，false：失败
+    ///
+    static bool readFile(const std::string & path, std::string & data);
+
+    ///
+    /// @brief 把内容写入文件
+    /// @param path 文件路径
+    /// @param data 要写入的内容
+    /// @return true：成功，false：失败
+    ///
+    static bool writeFile(const std::string & path, std::string_view data);
+
+protected:
+    ///
+    /// @brief 缓存项的文件路径，按键值的前两个字符分子目录，避免单个目录下的文件过多
+    /// @param key 键值
+    /// @return std::string 文件路径
+    ///
+    [[nodiscard]] std::string entryPath(const std::string & key) const;
+
+private:
+    ///
+    /// @brief 缓存目录
+    ///
+    std::string dir;
+};
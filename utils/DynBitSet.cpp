@@ -0,0 +1,553 @@
+///
+/// @file DynBitSet.cpp
+/// @brief 以64位字存储的动态位集合，供数据流分析使用
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>小容量内联存储，批量运算按CPU能力选择SSE2/AVX2实现，增加查找接口
+/// </table>
+///
+#include <cstring>
+
+#include "DynBitSet.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITSET_HAS_X86 1
+#include <immintrin.h>
+#endif
+
+using Word = DynBitSet::Word;
+
+//
+// 逐字运算，每种运算提供标量、SSE2与AVX2三种形式，由同一个模板循环展开
+//
+
+/// @brief 并集
+struct OrOp {
+    static Word scalar(Word d, Word s)
+    {
+        return d | s;
+    }
+#ifdef BITSET_HAS_X86
+    __attribute__((target("sse2"))) static __m128i sse2(__m128i d, __m128i s)
+    {
+        return _mm_or_si128(d, s);
+    }
+    __attribute__((target("avx2"))) static __m256i avx2(__m256i d, __m256i s)
+    {
+        return _mm256_or_si256(d, s);
+    }
+#endif
+};
+
+/// @brief 交集
+struct AndOp {
+    static Word scalar(Word d, Word s)
+    {
+        return d & s;
+    }
+#ifdef BITSET_HAS_X86
+    __attribute__((target("sse2"))) static __m128i sse2(__m128i d, __m128i s)
+    {
+        return _mm_and_si128(d, s);
+    }
+    __attribute__((target("avx2"))) static __m256i avx2(__m256i d, __m256i s)
+    {
+        return _mm256_and_si256(d, s);
+    }
+#endif
+};
+
+/// @brief 差集
+struct AndNotOp {
+    static Word scalar(Word d, Word s)
+    {
+        return d & ~s;
+    }
+#ifdef BITSET_HAS_X86
+    __attribute__((target("sse2"))) static __m128i sse2(__m128i d, __m128i s)
+    {
+        return _mm_andnot_si128(s, d);
+    }
+    __attribute__((target("avx2"))) static __m256i avx2(__m256i d, __m256i s)
+    {
+        return _mm256_andnot_si256(s, d);
+    }
+#endif
+};
+
+/// @brief 批量运算的函数表，启动时根据CPU能力选择一次
+struct BitSetOps {
+    /// @brief dst = dst | src，返回dst是否改变
+    bool (*orWords)(Word * dst, const Word * src, size_t n);
+
+    /// @brief dst = dst & src，返回dst是否改变
+    bool (*andWords)(Word * dst, const Word * src, size_t n);
+
+    /// @brief dst = dst & ~src，返回dst是否改变
+    bool (*andNotWords)(Word * dst, const Word * src, size_t n);
+
+    /// @brief dst = gen | (in & ~kill)，返回dst是否改变
+    bool (*transferWords)(Word * dst, const Word * gen, const Word * in, const Word * kill, size_t n);
+
+    /// @brief 为1的位数
+    size_t (*countWords)(const Word * p, size_t n);
+
+    /// @brief 实现的名字
+    const char * name;
+};
+
+//
+// 标量实现，逐字累计变化，循环内没有分支
+//
+
+template <typename Op>
+static bool scalarBinary(Word * dst, const Word * src, size_t n)
+{
+    Word changed = 0;
+    for (size_t k = 0; k < n; k++) {
+        Word word = Op::scalar(dst[k], src[k]);
+        changed |= word ^ dst[k];
+        dst[k] = word;
+    }
+    return changed != 0;
+}
+
+static bool scalarTransfer(Word * dst, const Word * gen, const Word * in, const Word * kill, size_t n)
+{
+    Word changed = 0;
+    for (size_t k = 0; k < n; k++) {
+        Word word = gen[k] | (in[k] & ~kill[k]);
+        changed |= word ^ dst[k];
+        dst[k] = word;
+    }
+    return changed != 0;
+}
+
+static size_t scalarCount(const Word * p, size_t n)
+{
+    size_t total = 0;
+    for (size_t k = 0; k < n; k++) {
+        total += (size_t) __builtin_popcountll(p[k]);
+    }
+    return total;
+}
+
+static const BitSetOps scalarOps = {
+    scalarBinary<OrOp>,
+    scalarBinary<AndOp>,
+    scalarBinary<AndNotOp>,
+    scalarTransfer,
+    scalarCount,
+    "scalar",
+};
+
+#ifdef BITSET_HAS_X86
+
+//
+// SSE2实现，一次处理2个字，剩余的字按标量处理
+//
+
+template <typename Op>
+__attribute__((target("sse2"))) static bool sse2Binary(Word * dst, const Word * src, size_t n)
+{
+    __m128i changed = _mm_setzero_si128();
+    size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + k));
+        __m128i word = Op::sse2(d, _mm_loadu_si128((const __m128i *) (src + k)));
+        changed = _mm_or_si128(changed, _mm_xor_si128(word, d));
+        _mm_storeu_si128((__m128i *) (dst + k), word);
+    }
+    bool tail = scalarBinary<Op>(dst + k, src + k, n - k);
+    return tail || (_mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) != 0xFFFF);
+}
+
+__attribute__((target("sse2"))) static bool
+sse2Transfer(Word * dst, const Word * gen, const Word * in, const Word * kill, size_t n)
+{
+    __m128i changed = _mm_setzero_si128();
+    size_t k = 0;
+    for (; k + 2 <= n; k += 2) {
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + k));
+        __m128i g = _mm_loadu_si128((const __m128i *) (gen + k));
+        __m128i i = _mm_loadu_si128((const __m128i *) (in + k));
+        __m128i c = _mm_loadu_si128((const __m128i *) (kill + k));
+        __m128i word = _mm_or_si128(g, _mm_andnot_si128(c, i));
+        changed = _mm_or_si128(changed, _mm_xor_si128(word, d));
+        _mm_storeu_si128((__m128i *) (dst + k), word);
+    }
+    bool tail = scalarTransfer(dst + k, gen + k, in + k, kill + k, n - k);
+    return tail || (_mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) != 0xFFFF);
+}
+
+static const BitSetOps sse2Ops = {
+    sse2Binary<OrOp>,
+    sse2Binary<AndOp>,
+    sse2Binary<AndNotOp>,
+    sse2Transfer,
+    scalarCount,
+    "sse2",
+};
+
+//
+// AVX2实现，一次处理4个字，剩余的字按标量处理
+//
+
+template <typename Op>
+__attribute__((target("avx2"))) static bool avx2Binary(Word * dst, const Word * src, size_t n)
+{
+    __m256i changed = _mm256_setzero_si256();
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + k));
+        __m256i word = Op::avx2(d, _mm256_loadu_si256((const __m256i *) (src + k)));
+        changed = _mm256_or_si256(changed, _mm256_xor_si256(word, d));
+        _mm256_storeu_si256((__m256i *) (dst + k), word);
+    }
+    bool tail = scalarBinary<Op>(dst + k, src + k, n - k);
+    return tail || !_mm256_testz_si256(changed, changed);
+}
+
+__attribute__((target("avx2"))) static bool
+avx2Transfer(Word * dst, const Word * gen, const Word * in, const Word * kill, size_t n)
+{
+    __m256i changed = _mm256_setzero_si256();
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + k));
+        __m256i g = _mm256_loadu_si256((const __m256i *) (gen + k));
+        __m256i i = _mm256_loadu_si256((const __m256i *) (in + k));
+        __m256i c = _mm256_loadu_si256((const __m256i *) (kill + k));
+        __m256i word = _mm256_or_si256(g, _mm256_andnot_si256(c, i));
+        changed = _mm256_or_si256(changed, _mm256_xor_si256(word, d));
+        _mm256_storeu_si256((__m256i *) (dst + k), word);
+    }
+    bool tail = scalarTransfer(dst + k, gen + k, in + k, kill + k, n - k);
+    return tail || !_mm256_testz_si256(changed, changed);
+}
+
+///
+/// @brief 按半字节查表统计位数，每个字节的结果用_mm256_sad_epu8累加到64位的计数中。
+/// 不足4个字的部分用popcnt指令统计
+///
+__attribute__((target("avx2,popcnt"))) static size_t avx2Count(const Word * p, size_t n)
+{
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, //
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+
+    __m256i total = _mm256_setzero_si256();
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (p + k));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+
+    size_t count = (size_t) _mm256_extract_epi64(total, 0) + (size_t) _mm256_extract_epi64(total, 1) +
+                   (size_t) _mm256_extract_epi64(total, 2) + (size_t) _mm256_extract_epi64(total, 3);
+    for (; k < n; k++) {
+        count += (size_t) __builtin_popcountll(p[k]);
+    }
+    return count;
+}
+
+static const BitSetOps avx2Ops = {
+    avx2Binary<OrOp>,
+    avx2Binary<AndOp>,
+    avx2Binary<AndNotOp>,
+    avx2Transfer,
+    avx2Count,
+    "avx2",
+};
+
+#endif
+
+/// @brief 根据CPU能力选择批量运算的实现
+/// @return 函数表
+static const BitSetOps & selectBitSetOps()
+{
+#ifdef BITSET_HAS_X86
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        return avx2Ops;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return sse2Ops;
+    }
+#endif
+    return scalarOps;
+}
+
+/// @brief 获取批量运算的函数表，只在第一次调用时选择
+/// @return 函数表
+static const BitSetOps & bitSetOps()
+{
+    static const BitSetOps & ops = selectBitSetOps();
+    return ops;
+}
+
+///
+/// @brief 构造函数
+/// @param bits 容量，即位数，初始全部为0
+///
+DynBitSet::DynBitSet(size_t _bits)
+{
+    resize(_bits);
+}
+
+///
+/// @brief 改变容量，新增的位为0
+/// @param bits 容量
+///
+void DynBitSet::resize(size_t _bits)
+{
+    size_t newWords = (_bits + WORD_BITS - 1) / WORD_BITS;
+
+    if ((numWords <= INLINE_WORDS) && (newWords > INLINE_WORDS)) {
+        // 内联存储搬到堆上
+        heapWords.assign(newWords, 0);
+        std::memcpy(heapWords.data(), inlineWords, numWords * sizeof(Word));
+    } else if ((numWords > INLINE_WORDS) && (newWords <= INLINE_WORDS)) {
+        // 堆上的存储搬回内联存储
+        inlineWords[0] = inlineWords[1] = 0;
+        std::memcpy(inlineWords, heapWords.data(), newWords * sizeof(Word));
+        std::vector<Word>().swap(heapWords);
+    } else if (newWords > INLINE_WORDS) {
+        heapWords.resize(newWords, 0);
+    } else {
+        for (size_t w = newWords; w < INLINE_WORDS; w++) {
+            inlineWords[w] = 0;
+        }
+    }
+
+    bits = _bits;
+    numWords = newWords;
+
+    // 缩小时清除容量之外的位
+    if (bits % WORD_BITS) {
+        data()[numWords - 1] &= (Word(1) << (bits % WORD_BITS)) - 1;
+    }
+}
+
+///
+/// @brief 全部位清零
+///
+void DynBitSet::clear()
+{
+    std::memset(data(), 0, numWords * sizeof(Word));
+}
+
+///
+/// @brief 全部位置1
+///
+void DynBitSet::setAll()
+{
+    if (numWords == 0) {
+        return;
+    }
+
+    Word * words = data();
+    std::memset(words, 0xFF, numWords * sizeof(Word));
+    if (bits % WORD_BITS) {
+        words[numWords - 1] = (Word(1) << (bits % WORD_BITS)) - 1;
+    }
+}
+
+///
+/// @brief 是否全部为0
+/// @return true：是，false：不是
+///
+bool DynBitSet::none() const
+{
+    const Word * words = data();
+    Word any = 0;
+    for (size_t w = 0; w < numWords; w++) {
+        any |= words[w];
+    }
+    return any == 0;
+}
+
+///
+/// @brief 为1的位数
+/// @return size_t 位数
+///
+size_t DynBitSet::count() const
+{
+    if (numWords <= INLINE_WORDS) {
+        return scalarCount(inlineWords, numWords);
+    }
+    return bitSetOps().countWords(heapWords.data(), numWords);
+}
+
+///
+/// @brief 查找编号不小于n的为1的位
+/// @param n 位的编号
+/// @return size_t 位的编号，没有时为npos
+///
+size_t DynBitSet::findFrom(size_t n) const
+{
+    if (n >= bits) {
+        return npos;
+    }
+
+    const Word * words = data();
+    size_t w = n / WORD_BITS;
+
+    // 首字屏蔽掉编号小于n的位
+    Word word = words[w] & (~Word(0) << (n % WORD_BITS));
+    while (word == 0) {
+        if (++w >= numWords) {
+            return npos;
+        }
+        word = words[w];
+    }
+
+    return w * WORD_BITS + (size_t) __builtin_ctzll(word);
+}
+
+///
+/// @brief 查找编号最小的为0的位
+/// @return size_t 位的编号，全部为1时为npos
+///
+size_t DynBitSet::findFirstZero() const
+{
+    const Word * words = data();
+    for (size_t w = 0; w < numWords; w++) {
+        Word word = ~words[w];
+        if (word) {
+            size_t n = w * WORD_BITS + (size_t) __builtin_ctzll(word);
+            return (n < bits) ? n : npos;
+        }
+    }
+    return npos;
+}
+
+///
+/// @brief 并集
+/// @param other 参与运算的集合
+/// @return DynBitSet& 本集合
+///
+DynBitSet & DynBitSet::operator|=(const DynBitSet & other)
+{
+    unionWith(other);
+    return *this;
+}
+
+///
+/// @brief 交集
+/// @param other 参与运算的集合
+/// @return DynBitSet& 本集合
+///
+DynBitSet & DynBitSet::operator&=(const DynBitSet & other)
+{
+    intersectWith(other);
+    return *this;
+}
+
+///
+/// @brief 差集
+/// @param other 参与运算的集合
+/// @return DynBitSet& 本集合
+///
+DynBitSet & DynBitSet::operator-=(const DynBitSet & other)
+{
+    if (numWords <= INLINE_WORDS) {
+        scalarBinary<AndNotOp>(inlineWords, other.inlineWords, numWords);
+    } else {
+        bitSetOps().andNotWords(heapWords.data(), other.heapWords.data(), numWords);
+    }
+    return *this;
+}
+
+///
+/// @brief 比较是否相等
+/// @param other 参与比较的集合
+/// @return true：相等，false：不等
+///
+bool DynBitSet::operator==(const DynBitSet & other) const
+{
+    return (bits == other.bits) && (std::memcmp(data(), other.data(), numWords * sizeof(Word)) == 0);
+}
+
+///
+/// @brief 并集，同时判断本集合是否改变
+/// @param other 参与运算的集合
+/// @return true：有变化，false：没有变化
+///
+bool DynBitSet::unionWith(const DynBitSet & other)
+{
+    // 小集合直接按标量计算，省去函数表的间接调用
+    if (numWords <= INLINE_WORDS) {
+        return scalarBinary<OrOp>(inlineWords, other.inlineWords, numWords);
+    }
+    return bitSetOps().orWords(heapWords.data(), other.heapWords.data(), numWords);
+}
+
+///
+/// @brief 交集，同时判断本集合是否改变
+/// @param other 参与运算的集合
+/// @return true：有变化，false：没有变化
+///
+bool DynBitSet::intersectWith(const DynBitSet & other)
+{
+    if (numWords <= INLINE_WORDS) {
+        return scalarBinary<AndOp>(inlineWords, other.inlineWords, numWords);
+    }
+    return bitSetOps().andWords(heapWords.data(), other.heapWords.data(), numWords);
+}
+
+///
+/// @brief 数据流的传递函数，本集合设置为 gen | (in - kill)，同时判断本集合是否改变
+/// @param gen 产生的集合
+/// @param in 输入的集合
+/// @param kill 杀死的集合
+/// @return true：有变化，false：没有变化
+///
+bool DynBitSet::assignTransfer(const DynBitSet & gen, const DynBitSet & in, const DynBitSet & kill)
+{
+    if (numWords <= INLINE_WORDS) {
+        return scalarTransfer(inlineWords, gen.inlineWords, in.inlineWords, kill.inlineWords, numWords);
+    }
+    return bitSetOps().transferWords(heapWords.data(),
+                                     gen.heapWords.data(),
+                                     in.heapWords.data(),
+                                     kill.heapWords.data(),
+                                     numWords);
+}
+
+///
+/// @brief 变换成字符串显示，如{1,5,7}
+/// @return std::string 字符串
+///
+std::string DynBitSet::toString() const
+{
+    std::string str = "{";
+    bool first = true;
+    forEach([&](size_t n) {
+        if (!first) {
+            str += ',';
+        }
+        str += std::to_string(n);
+        first = false;
+    });
+    str += '}';
+    return str;
+}
+
+///
+/// @brief 获取批量运算所选用的实现的名字
+/// @return const char* 名字，如avx2
+///
+const char * DynBitSet::implName()
+{
+    return bitSetOps().name;
+}
@@ -0,0 +1,281 @@
+///
+/// @file DynBitSet.h
+/// @brief 以64位字存储的动态位集合，供数据流分析使用
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>小容量内联存储，批量运算按CPU能力选择SSE2/AVX2实现，增加查找接口
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///
+/// @brief 动态位集合，容量在运行时确定
+///
+/// 位按64位的字连续存放。不超过INLINE_BITS位时存放在对象内部，不分配堆内存，
+/// 寄存器集合等小集合的构造、复制都很廉价；超过时存放在堆上。
+/// 并、交、差、传递函数与计数等批量运算在启动时根据CPU能力选择AVX2、SSE2或者标量实现。
+/// 参与二元运算的两个集合的容量必须相同。
+///
+class DynBitSet {
+
+public:
+    /// @brief 字的类型
+    using Word = uint64_t;
+
+    /// @brief 每个字的位数
+    static constexpr size_t WORD_BITS = 64;
+
+    /// @brief 内联存储的字数
+    static constexpr size_t INLINE_WORDS = 2;
+
+    /// @brief 内联存储的位数，不超过时不分配堆内存
+    static constexpr size_t INLINE_BITS = INLINE_WORDS * WORD_BITS;
+
+    /// @brief 查找失败时的返回值
+    static constexpr size_t npos = ~size_t(0);
+
+    ///
+    /// @brief 构造函数
+    /// @param bits 容量，即位数，初始全部为0
+    ///
+    explicit DynBitSet(size_t bits = 0);
+
+    ///
+    /// @brief 改变容量，新增的位为0
+    /// @param bits 容量
+    ///
+    void resize(size_t bits);
+
+    ///
+    /// @brief 获取容量
+    /// @return size_t 位数
+    ///
+    [[nodiscard]] size_t size() const
+    {
+        return bits;
+    }
+
+    ///
+    /// @brief 置位
+    /// @param n 位的编号，必须小于容量
+    ///
+    void set(size_t n)
+    {
+        data()[n / WORD_BITS] |= Word(1) << (n % WORD_BITS);
+    }
+
+    ///
+    /// @brief 清零
+    /// @param n 位的编号，必须小于容量
+    ///
+    void reset(size_t n)
+    {
+        data()[n / WORD_BITS] &= ~(Word(1) << (n % WORD_BITS));
+    }
+
+    ///
+    /// @brief 获取指定位的值
+    /// @param n 位的编号，必须小于容量
+    /// @return true：为1，false：为0
+    ///
+    [[nodiscard]] bool test(size_t n) const
+    {
+        return (data()[n / WORD_BITS] >> (n % WORD_BITS)) & 1;
+    }
+
+    ///
+    /// @brief 全部位清零
+    ///
+    void clear();
+
+    ///
+    /// @brief 全部位置1
+    ///
+    void setAll();
+
+    ///
+    /// @brief 是否全部为0
+    /// @return true：是，false：不是
+    ///
+    [[nodiscard]] bool none() const;
+
+    ///
+    /// @brief 是否有为1的位
+    /// @return true：有，false：没有
+    ///
+    [[nodiscard]] bool any() const
+    {
+        return !none();
+    }
+
+    ///
+    /// @brief 为1的位数
+    /// @return size_t 位数
+    ///
+    [[nodiscard]] size_t count() const;
+
+    ///
+    /// @brief 查找编号最小的为1的位
+    /// @return size_t 位的编号，没有时为npos
+    ///
+    [[nodiscard]] size_t findFirst() const
+    {
+        return findFrom(0);
+    }
+
+    ///
+    /// @brief 查找编号大于n的为1的位，与findFirst配合遍历
+    /// @param n 位的编号
+    /// @return size_t 位的编号，没有时为npos
+    ///
+    [[nodiscard]] size_t findNext(size_t n) const
+    {
+        return findFrom(n + 1);
+    }
+
+    ///
+    /// @brief 查找编号最小的为0的位
+    /// @return size_t 位的编号，全部为1时为npos
+    ///
+    [[nodiscard]] size_t findFirstZero() const;
+
+    ///
+    /// @brief 并集
+    /// @param other 参与运算的集合
+    /// @return DynBitSet& 本集合
+    ///
+    DynBitSet & operator|=(const DynBitSet & other);
+
+    ///
+    /// @brief 交集
+    /// @param other 参与运算的集合
+    /// @return DynBitSet& 本集合
+    ///
+    DynBitSet & operator&=(const DynBitSet & other);
+
+    ///
+    /// @brief 差集
+    /// @param other 参与运算的集合
+    /// @return DynBitSet& 本集合
+    ///
+    DynBitSet & operator-=(const DynBitSet & other);
+
+    ///
+    /// @brief 比较是否相等
+    /// @param other 参与比较的集合
+    /// @return true：相等，false：不等
+    ///
+    bool operator==(const DynBitSet & other) const;
+
+    ///
+    /// @brief 比较是否不等
+    /// @param other 参与比较的集合
+    /// @return true：不等，false：相等
+    ///
+    bool operator!=(const DynBitSet & other) const
+    {
+        return !(*this == other);
+    }
+
+    ///
+    /// @brief 并集，同时判断本集合是否改变
+    /// @param other 参与运算的集合
+    /// @return true：有变化，false：没有变化
+    ///
+    bool unionWith(const DynBitSet & other);
+
+    ///
+    /// @brief 交集，同时判断本集合是否改变
+    /// @param other 参与运算的集合
+    /// @return true：有变化，false：没有变化
+    ///
+    bool intersectWith(const DynBitSet & other);
+
+    ///
+    /// @brief 数据流的传递函数，本集合设置为 gen | (in - kill)，同时判断本集合是否改变
+    /// @param gen 产生的集合
+    /// @param in 输入的集合
+    /// @param kill 杀死的集合
+    /// @return true：有变化，false：没有变化
+    ///
+    bool assignTransfer(const DynBitSet & gen, const DynBitSet & in, const DynBitSet & kill);
+
+    ///
+    /// @brief 按编号由小到大访问为1的位
+    /// @tparam F 函数类型，参数为位的编号
+    /// @param f 访问函数
+    ///
+    template <typename F>
+    void forEach(F f) const
+    {
+        const Word * words = data();
+        for (size_t w = 0; w < numWords; w++) {
+            for (Word word = words[w]; word; word &= word - 1) {
+                f(w * WORD_BITS + (size_t) __builtin_ctzll(word));
+            }
+        }
+    }
+
+    ///
+    /// @brief 变换成字符串显示，如{1,5,7}
+    /// @return std::string 字符串
+    ///
+    [[nodiscard]] std::string toString() const;
+
+    ///
+    /// @brief 获取批量运算所选用的实现的名字
+    /// @return const char* 名字，如avx2
+    ///
+    static const char * implName();
+
+private:
+    ///
+    /// @brief 获取位的存储
+    /// @return Word* 首字的地址
+    ///
+    Word * data()
+    {
+        return (numWords <= INLINE_WORDS) ? inlineWords : heapWords.data();
+    }
+
+    ///
+    /// @brief 获取位的存储
+    /// @return const Word* 首字的地址
+    ///
+    [[nodiscard]] const Word * data() const
+    {
+        return (numWords <= INLINE_WORDS) ? inlineWords : heapWords.data();
+    }
+
+    ///
+    /// @brief 查找编号不小于n的为1的位
+    /// @param n 位的编号
+    /// @return size_t 位的编号，没有时为npos
+    ///
+    [[nodiscard]] size_t findFrom(size_t n) const;
+
+    /// @brief 容量
+    size_t bits = 0;
+
+    /// @brief 字数
+    size_t numWords = 0;
+
+    /// @brief 内联存储，容量不超过INLINE_BITS时使用，容量之外的位始终为0
+    Word inlineWords[INLINE_WORDS] = {0, 0};
+
+    /// @brief 堆上的存储，容量超过INLINE_BITS时使用，容量之外的位始终为0
+    std::vector<Word> heapWords;
+};
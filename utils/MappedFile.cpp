@@ -0,0 +1,120 @@
+///
+/// @file MappedFile.cpp
+/// @brief 源文件只读映射类的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include <cstdio>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+///
+/// @brief 析构函数，解除映射
+///
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+///
+/// @brief 打开并映射文件，之前映射的文件会被关闭
+/// @param path 文件路径
+/// @return true：成功，false：失败
+///
+bool MappedFile::open(const std::string & path)
+{
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+
+        void * addr = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+
+            // 词法分析是顺序扫描，提示内核预读
+            (void) madvise(addr, (size_t) st.st_size, MADV_SEQUENTIAL);
+
+            base = static_cast<const char *>(addr);
+            length = (size_t) st.st_size;
+            mapped = true;
+        }
+    }
+
+    ::close(fd);
+
+    if (mapped) {
+        return true;
+    }
+#endif
+
+    // 空文件、管道或者映射失败时读入缓冲区
+    return readAll(path);
+}
+
+///
+/// @brief 解除映射或释放缓冲区
+///
+void MappedFile::close()
+{
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char *>(base), length);
+    }
+#endif
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    base = nullptr;
+    length = 0;
+    mapped = false;
+}
+
+///
+/// @brief 映射失败时把文件读入缓冲区
+/// @param path 文件路径
+/// @return true：成功，false：失败
+///
+bool MappedFile::readAll(const std::string & path)
+{
+    FILE * fp = fopen(path.c_str(), "rb");
+    if (nullptr == fp) {
+        return false;
+    }
+
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + n);
+    }
+
+    bool ok = !ferror(fp);
+    fclose(fp);
+
+    base = buffer.data();
+    length = buffer.size();
+
+    return ok;
+}
@@ -0,0 +1,120 @@
+///
+/// @file MappedFile.h
+/// @brief 源文件只读映射类
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+///
+/// @brief 以只读方式把整个文件映射到内存中，映射失败时退化为读入缓冲区
+///
+/// 词法分析可直接用指针在映射的内存上扫描，Token的文本用string_view指向映射区，不需要复制。
+///
+class MappedFile {
+
+public:
+    ///
+    /// @brief 构造函数
+    ///
+    MappedFile() = default;
+
+    ///
+    /// @brief 析构函数，解除映射
+    ///
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    ///
+    /// @brief 打开并映射文件，之前映射的文件会被关闭
+    /// @param path 文件路径
+    /// @return true：成功，false：失败
+    ///
+    bool open(const std::string & path);
+
+    ///
+    /// @brief 解除映射或释放缓冲区
+    ///
+    void close();
+
+    ///
+    /// @brief 文件内容的首地址
+    /// @return const char* 首地址，空文件时可能为空指针
+    ///
+    [[nodiscard]] const char * data() const
+    {
+        return base;
+    }
+
+    ///
+    /// @brief 文件的字节数
+    /// @return size_t 字节数
+    ///
+    [[nodiscard]] size_t size() const
+    {
+        return length;
+    }
+
+    ///
+    /// @brief 文件内容的视图
+    /// @return std::string_view 视图
+    ///
+    [[nodiscard]] std::string_view view() const
+    {
+        return {base, length};
+    }
+
+    ///
+    /// @brief 是否是通过mmap映射的，否则是读入的缓冲区
+    /// @return true：mmap映射，false：缓冲区
+    ///
+    [[nodiscard]] bool isMapped() const
+    {
+        return mapped;
+    }
+
+protected:
+    ///
+    /// @brief 映射失败时把文件读入缓冲区
+    /// @param path 文件路径
+    /// @return true：成功，false：失败
+    ///
+    bool readAll(const std::string & path);
+
+private:
+    ///
+    /// @brief 文件内容首地址
+    ///
+    const char * base = nullptr;
+
+    ///
+    /// @brief 文件的字节数
+    ///
+    size_t length = 0;
+
+    ///
+    /// @brief 是否是mmap映射
+    ///
+    bool mapped = false;
+
+    ///
+    /// @brief 映射失败时使用的缓冲区
+    ///
+    std::vector<char> buffer;
+};
@@ -2,8 +2,8 @@
 /// @file StorageSet.h
 /// @brief 存储集合类
 /// @author zenglj (zenglj@live.com)
-/// @version 1.0
-/// @date 2024-09-29
+/// @version 1.1
+/// @date 2026-10-18
 ///
 /// @copyright Copyright (c) 2024
 ///
@@ -11,20 +11,26 @@
 /// <table>
 /// <tr><th>Date       <th>Version <th>Author  <th>Description
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>加锁，支持多线程并发获取
 /// </table>
 ///
 #pragma once
 
+#include <mutex>
 #include <unordered_set>
 
 template <typename T, typename Hasher, typename Equal>
 class StorageSet final {
     std::unordered_set<T, Hasher, Equal> mStorage;
 
+    /// @brief 函数并行生成代码时可能被多个线程同时访问
+    std::mutex mLock;
+
 public:
     template <typename... Args>
     const T * get(Args &&... args)
     {
+        std::lock_guard<std::mutex> guard(mLock);
         return &*mStorage.emplace(std::forward<Args>(args)...).first;
     }
 };
@@ -0,0 +1,199 @@
+///
+/// @file ThreadPool.cpp
+/// @brief 采用工作窃取(work stealing)的线程池，用于以函数为单位的并行处理
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#include "ThreadPool.h"
+
+///
+/// @brief 构造函数
+/// @param threadNum 线程数（含调用者线程），小于等于0时取CPU的硬件线程数，为1时不创建线程
+///
+ThreadPool::ThreadPool(int _threadNum) : threadNum(_threadNum)
+{
+    if (threadNum <= 0) {
+        threadNum = (int) std::thread::hardware_concurrency();
+        if (threadNum <= 0) {
+            threadNum = 1;
+        }
+    }
+
+    for (int k = 0; k < threadNum; ++k) {
+        ranges.push_back(std::make_unique<TaskRange>());
+    }
+
+    // 0号为调用者线程，不需要创建
+    for (int k = 1; k < threadNum; ++k) {
+        workers.emplace_back(&ThreadPool::workerMain, this, k);
+    }
+}
+
+///
+/// @brief 析构函数，等待所有的工作线程退出
+///
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    startCond.notify_all();
+
+    for (auto & worker: workers) {
+        worker.join();
+    }
+}
+
+///
+/// @brief 并行执行task(0)到task(count - 1)，所有任务完成后返回
+/// @param count 任务个数
+/// @param task 任务函数，参数为任务下标
+///
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> & task)
+{
+    // 单线程或者任务太少时直接顺序执行
+    if ((threadNum == 1) || (count <= 1)) {
+        for (size_t k = 0; k < count; ++k) {
+            task(k);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        currentTask = &task;
+        remaining = count;
+    }
+
+    // 任务下标平均划分给各个线程
+    for (int k = 0; k < threadNum; ++k) {
+        std::lock_guard<std::mutex> guard(ranges[k]->lock);
+        ranges[k]->begin = count * k / threadNum;
+        ranges[k]->end = count * (k + 1) / threadNum;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        generation++;
+    }
+    startCond.notify_all();
+
+    // 调用者线程也参与执行
+    runTasks(0);
+
+    // 等待所有任务完成，并且所有工作线程都不再访问本批次的任务
+    std::unique_lock<std::mutex> guard(stateLock);
+    doneCond.wait(guard, [this] { return (remaining == 0) && (activeWorkers == 0); });
+    currentTask = nullptr;
+}
+
+///
+/// @brief 工作线程的主函数
+/// @param id 线程编号，从1开始
+///
+void ThreadPool::workerMain(int id)
+{
+    uint64_t seen = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            startCond.wait(guard, [&] { return stopping || (generation != seen); });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            activeWorkers++;
+        }
+
+        runTasks(id);
+
+        {
+            std::lock_guard<std::mutex> guard(stateLock);
+            activeWorkers--;
+        }
+        doneCond.notify_all();
+    }
+}
+
+///
+/// @brief 不断地取任务并执行，直到取不到任务
+/// @param id 线程编号
+///
+void ThreadPool::runTasks(int id)
+{
+    size_t index;
+
+    while (takeTask(id, index)) {
+
+        (*currentTask)(index);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> guard(stateLock);
+            last = (--remaining == 0);
+        }
+        if (last) {
+            doneCond.notify_all();
+        }
+    }
+}
+
+///
+/// @brief 取一个任务，先从自己的区间头部取，没有时从其它线程区间的尾部窃取一半
+/// @param id 线程编号
+/// @param index 取到的任务下标
+/// @return true：取到，false：所有区间都已空
+///
+bool ThreadPool::takeTask(int id, size_t & index)
+{
+    TaskRange & own = *ranges[id];
+
+    {
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (own.begin < own.end) {
+            index = own.begin++;
+            return true;
+        }
+    }
+
+    // 自己的区间已空，依次查看其它线程的区间
+    for (int k = 1; k < threadNum; ++k) {
+
+        TaskRange & victim = *ranges[(id + k) % threadNum];
+
+        size_t stolenBegin, stolenEnd;
+        {
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.begin >= victim.end) {
+                continue;
+            }
+
+            // 窃取尾部的一半，至少一个
+            stolenEnd = victim.end;
+            stolenBegin = victim.end - (victim.end - victim.begin + 1) / 2;
+            victim.end = stolenBegin;
+        }
+
+        // 第一个直接执行，其余的放入自己的区间
+        index = stolenBegin;
+
+        std::lock_guard<std::mutex> guard(own.lock);
+        own.begin = stolenBegin + 1;
+        own.end = stolenEnd;
+
+        return true;
+    }
+
+    return false;
+}
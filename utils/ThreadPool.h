@@ -0,0 +1,156 @@
+///
+/// @file ThreadPool.h
+/// @brief 采用工作窃取(work stealing)的线程池，用于以函数为单位的并行处理
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///
+/// @brief 线程池
+///
+/// parallelFor把任务下标[0, count)平均划分给各个线程，每个线程从自己区间的头部依次取任务，
+/// 自己的区间做完后，从其它线程区间的尾部窃取一半的任务继续做，直到所有区间为空。
+/// 调用parallelFor的线程也作为其中一个工作线程参与执行。
+///
+class ThreadPool {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param threadNum 线程数（含调用者线程），小于等于0时取CPU的硬件线程数，为1时不创建线程
+    ///
+    explicit ThreadPool(int threadNum);
+
+    ///
+    /// @brief 析构函数，等待所有的工作线程退出
+    ///
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    ///
+    /// @brief 获取线程数（含调用者线程）
+    /// @return int 线程数
+    ///
+    int getThreadNum() const
+    {
+        return threadNum;
+    }
+
+    ///
+    /// @brief 并行执行task(0)到task(count - 1)，所有任务完成后返回。任务的执行次序不确定
+    /// @param count 任务个数
+    /// @param task 任务函数，参数为任务下标
+    ///
+    void parallelFor(size_t count, const std::function<void(size_t)> & task);
+
+protected:
+    ///
+    /// @brief 每个线程的任务区间[begin, end)
+    ///
+    struct TaskRange {
+        /// @brief 保护区间的锁
+        std::mutex lock;
+
+        /// @brief 区间开始
+        size_t begin = 0;
+
+        /// @brief 区间结束
+        size_t end = 0;
+    };
+
+    ///
+    /// @brief 工作线程的主函数
+    /// @param id 线程编号，从1开始，0为调用者线程
+    ///
+    void workerMain(int id);
+
+    ///
+    /// @brief 不断地取任务并执行，直到取不到任务
+    /// @param id 线程编号
+    ///
+    void runTasks(int id);
+
+    ///
+    /// @brief 取一个任务，先从自己的区间取，没有时从其它线程窃取
+    /// @param id 线程编号
+    /// @param index 取到的任务下标
+    /// @return true：取到，false：所有区间都已空
+    ///
+    bool takeTask(int id, size_t & index);
+
+    ///
+    /// @brief 线程数
+    ///
+    int threadNum;
+
+    ///
+    /// @brief 工作线程
+    ///
+    std::vector<std::thread> workers;
+
+    ///
+    /// @brief 每个线程的任务区间，下标为线程编号
+    ///
+    std::vector<std::unique_ptr<TaskRange>> ranges;
+
+    ///
+    /// @brief 当前执行的任务函数
+    ///
+    const std::function<void(size_t)> * currentTask = nullptr;
+
+    ///
+    /// @brief 保护下面状态的锁
+    ///
+    std::mutex stateLock;
+
+    ///
+    /// @brief 有新的一批任务时通知工作线程
+    ///
+    std::condition_variable startCond;
+
+    ///
+    /// @brief 任务全部完成时通知调用者线程
+    ///
+    std::condition_variable doneCond;
+
+    ///
+    /// @brief 任务批次号，每次parallelFor加一
+    ///
+    uint64_t generation = 0;
+
+    ///
+    /// @brief 尚未完成的任务个数
+    ///
+    size_t remaining = 0;
+
+    ///
+    /// @brief 正在取任务或执行任务的工作线程个数
+    ///
+    int activeWorkers = 0;
+
+    ///
+    /// @brief 是否要求工作线程退出
+    ///
+    bool stopping = false;
+};
@@ -0,0 +1,304 @@
+///
+/// @file TimeReport.cpp
+/// @brief 编译各阶段的时间与内存统计的实现
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加内存分配的次数与字节数
+/// </table>
+///
+#include <algorithm>
+#include <ctime>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "TimeReport.h"
+
+///
+/// @brief 字符串以JSON字符串的形式输出
+/// @param fp 文件
+/// @param str 字符串
+///
+static void writeJSONString(FILE * fp, const std::string & str)
+{
+    fputc('"', fp);
+    for (unsigned char c: str) {
+        if ((c == '"') || (c == '\\')) {
+            fputc('\\', fp);
+            fputc(c, fp);
+        } else if (c < 0x20) {
+            fprintf(fp, "\\u%04x", c);
+        } else {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+///
+/// @brief 构造函数，开始计时
+/// @param report 报告，空指针时不计时
+/// @param phase 阶段名
+/// @param clock CPU时间的统计范围
+/// @param function 函数名，非空时墙钟时间也累计到该函数
+///
+TimeReport::Scope::Scope(TimeReport * _report, const char * _phase, CpuClock _clock, const std::string * _function)
+    : report(_report), phase(_phase), clock(_clock), function(_function)
+{
+    if (report) {
+        wallStart = std::chrono::steady_clock::now();
+        cpuStart = cpuTime(clock);
+        allocStart = allocCount(clock);
+    }
+}
+
+///
+/// @brief 析构函数，结束计时
+///
+TimeReport::Scope::~Scope()
+{
+    if (report) {
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        AllocCounter::Count allocEnd = allocCount(clock);
+        report->addPhase(phase,
+                         wall,
+                         cpuTime(clock) - cpuStart,
+                         allocEnd.allocs - allocStart.allocs,
+                         allocEnd.bytes - allocStart.bytes);
+        if (function) {
+            report->addFunction(*function, wall);
+        }
+    }
+}
+
+///
+/// @brief 构造函数，开始统计总时间
+/// @param _inputFile 被编译的源文件
+///
+TimeReport::TimeReport(const std::string & _inputFile)
+    : inputFile(_inputFile), wallStart(std::chrono::steady_clock::now()), cpuStart(cpuTime(CPU_PROCESS)),
+      allocStart(allocCount(CPU_PROCESS))
+{
+    total.name = "total";
+}
+
+///
+/// @brief 累计一个阶段的时间
+/// @param phase 阶段名
+/// @param wall 墙钟时间，单位秒
+/// @param cpu CPU时间，单位秒
+/// @param allocs 分配次数
+/// @param allocBytes 分配的字节数
+///
+void TimeReport::addPhase(const char * phase, double wall, double cpu, int64_t allocs, int64_t allocBytes)
+{
+    int64_t rss = peakRSS();
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    // 阶段只有几个，顺序查找即可
+    auto iter = std::find_if(phases.begin(), phases.end(), [phase](const Phase & p) { return p.name == phase; });
+    if (iter == phases.end()) {
+        phases.emplace_back();
+        iter = phases.end() - 1;
+        iter->name = phase;
+    }
+
+    iter->count++;
+    iter->wall += wall;
+    iter->cpu += cpu;
+    iter->allocs += allocs;
+    iter->allocBytes += allocBytes;
+    iter->peakRSS = std::max(iter->peakRSS, rss);
+}
+
+///
+/// @brief 累计一个函数的时间
+/// @param function 函数名
+/// @param wall 墙钟时间，单位秒
+///
+void TimeReport::addFunction(const std::string & function, double wall)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto result = functionIndex.emplace(function, functions.size());
+    if (result.second) {
+        functions.push_back({function, 0});
+    }
+
+    functions[result.first->second].wall += wall;
+}
+
+///
+/// @brief 结束总时间的统计，并把函数按耗时由大到小排序
+///
+void TimeReport::finish()
+{
+    total.count = 1;
+    total.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    total.cpu = cpuTime(CPU_PROCESS) - cpuStart;
+    AllocCounter::Count allocEnd = allocCount(CPU_PROCESS);
+    total.allocs = allocEnd.allocs - allocStart.allocs;
+    total.allocBytes = allocEnd.bytes - allocStart.bytes;
+    total.peakRSS = peakRSS();
+
+    std::stable_sort(functions.begin(), functions.end(), [](const FunctionTime & a, const FunctionTime & b) {
+        return a.wall > b.wall;
+    });
+    functionIndex.clear();
+}
+
+///
+/// @brief 结束统计，以表格形式输出报告
+/// @param fp 输出的文件，一般为标准错误
+///
+void TimeReport::print(FILE * fp)
+{
+    finish();
+
+    fprintf(fp, "===== Time report: %s =====\n", inputFile.c_str());
+    fprintf(fp,
+            "%-24s %8s %12s %12s %12s %14s %14s\n",
+            "phase",
+            "count",
+            "wall(s)",
+            "cpu(s)",
+            "allocs",
+            "alloc(KB)",
+            "peak RSS(KB)");
+
+    for (auto & phase: phases) {
+        fprintf(fp,
+                "%-24s %8lld %12.6f %12.6f %12lld %14lld %14lld\n",
+                phase.name.c_str(),
+                (long long) phase.count,
+                phase.wall,
+                phase.cpu,
+                (long long) phase.allocs,
+                (long long) (phase.allocBytes / 1024),
+                (long long) phase.peakRSS);
+    }
+
+    fprintf(fp,
+            "%-24s %8s %12.6f %12.6f %12lld %14lld %14lld\n",
+            total.name.c_str(),
+            "",
+            total.wall,
+            total.cpu,
+            (long long) total.allocs,
+            (long long) (total.allocBytes / 1024),
+            (long long) total.peakRSS);
+
+    if (!functions.empty()) {
+        fprintf(fp, "Slowest functions:\n");
+        for (size_t k = 0; (k < functions.size()) && (k < TOP_FUNCTIONS); k++) {
+            fprintf(fp, "  %12.6f  %s\n", functions[k].wall, functions[k].name.c_str());
+        }
+    }
+}
+
+///
+/// @brief 结束统计，以JSON格式输出报告
+/// @param path 输出文件
+/// @return true：成功，false：失败
+///
+bool TimeReport::writeJSON(const std::string & path)
+{
+    finish();
+
+    FILE * fp = fopen(path.c_str(), "w");
+    if (nullptr == fp) {
+        return false;
+    }
+
+    auto writePhase = [fp](const Phase & phase) {
+        fprintf(fp, "{\"name\": ");
+        writeJSONString(fp, phase.name);
+        fprintf(fp,
+                ", \"count\": %lld, \"wall\": %.6f, \"cpu\": %.6f, \"allocs\": %lld, \"alloc_bytes\": %lld, "
+                "\"peak_rss_kb\": %lld}",
+                (long long) phase.count,
+                phase.wall,
+                phase.cpu,
+                (long long) phase.allocs,
+                (long long) phase.allocBytes,
+                (long long) phase.peakRSS);
+    };
+
+    fprintf(fp, "{\n  \"input\": ");
+    writeJSONString(fp, inputFile);
+
+    fprintf(fp, ",\n  \"phases\": [");
+    for (size_t k = 0; k < phases.size(); k++) {
+        fprintf(fp, "%s\n    ", k ? "," : "");
+        writePhase(phases[k]);
+    }
+
+    fprintf(fp, "\n  ],\n  \"total\": ");
+    writePhase(total);
+
+    fprintf(fp, ",\n  \"functions\": [");
+    for (size_t k = 0; (k < functions.size()) && (k < TOP_FUNCTIONS); k++) {
+        fprintf(fp, "%s\n    {\"name\": ", k ? "," : "");
+        writeJSONString(fp, functions[k].name);
+        fprintf(fp, ", \"wall\": %.6f}", functions[k].wall);
+    }
+    fprintf(fp, "\n  ]\n}\n");
+
+    return fclose(fp) == 0;
+}
+
+///
+/// @brief 获取CPU时间
+/// @param clock 统计范围
+/// @return double CPU时间，单位秒
+///
+double TimeReport::cpuTime(CpuClock clock)
+{
+#ifdef _WIN32
+    (void) clock;
+    return (double) std::clock() / CLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+    if (clock_gettime((clock == CPU_THREAD) ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+#endif
+}
+
+///
+/// @brief 获取分配计数
+/// @param clock 统计范围
+/// @return AllocCounter::Count 计数
+///
+AllocCounter::Count TimeReport::allocCount(CpuClock clock)
+{
+    return (clock == CPU_THREAD) ? AllocCounter::thread() : AllocCounter::process();
+}
+
+///
+/// @brief 获取进程的峰值常驻内存
+/// @return int64_t 单位KB，不支持时为0
+///
+int64_t TimeReport::peakRSS()
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (int64_t) usage.ru_maxrss;
+#endif
+}
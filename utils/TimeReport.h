@@ -0,0 +1,223 @@
+///
+/// @file TimeReport.h
+/// @brief 编译各阶段的时间与内存统计
+/// @author zenglj (zenglj@live.com)
+/// @version 1.1
+/// @date 2026-10-18
+///
+/// @copyright Copyright (c) 2026
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-18 <td>1.0     <td>zenglj  <td>新建
+/// <tr><td>2026-10-18 <td>1.1     <td>zenglj  <td>增加内存分配的次数与字节数
+/// </table>
+///
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AllocCounter.h"
+
+///
+/// @brief 一次编译的各阶段耗时报告，即--time-report
+///
+/// 每个阶段累计墙钟时间、CPU时间、operator new的分配次数与字节数以及阶段结束时进程的峰值常驻内存。
+/// 以函数为单位的阶段会在多个线程中同时累计，其CPU时间与分配计数为各线程之和；编译任务级的阶段使用
+/// 整个进程的CPU时间与分配计数，批量并发编译时包含其它任务。
+///
+class TimeReport {
+
+public:
+    /// @brief CPU时间与分配计数的统计范围
+    enum CpuClock {
+        /// @brief 整个进程，用于编译任务级的阶段，含其中并行的工作线程
+        CPU_PROCESS,
+
+        /// @brief 当前线程，用于以函数为单位在工作线程中进行的阶段
+        CPU_THREAD,
+    };
+
+    ///
+    /// @brief 计时范围，构造时开始计时，析构时累计到报告中。报告为空指针时什么都不做
+    ///
+    class Scope {
+
+    public:
+        ///
+        /// @brief 构造函数，开始计时
+        /// @param report 报告，空指针时不计时
+        /// @param phase 阶段名
+        /// @param clock CPU时间的统计范围
+        /// @param function 函数名，非空时墙钟时间也累计到该函数
+        ///
+        Scope(TimeReport * report, const char * phase, CpuClock clock = CPU_PROCESS, const std::string * function = nullptr);
+
+        ///
+        /// @brief 析构函数，结束计时
+        ///
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+
+    private:
+        /// @brief 报告
+        TimeReport * report;
+
+        /// @brief 阶段名
+        const char * phase;
+
+        /// @brief CPU时间的统计范围
+        CpuClock clock;
+
+        /// @brief 函数名
+        const std::string * function;
+
+        /// @brief 开始时的墙钟时间
+        std::chrono::steady_clock::time_point wallStart;
+
+        /// @brief 开始时的CPU时间，单位秒
+        double cpuStart = 0;
+
+        /// @brief 开始时的分配计数
+        AllocCounter::Count allocStart;
+    };
+
+    ///
+    /// @brief 构造函数，开始统计总时间
+    /// @param _inputFile 被编译的源文件
+    ///
+    explicit TimeReport(const std::string & _inputFile);
+
+    ///
+    /// @brief 累计一个阶段的时间
+    /// @param phase 阶段名
+    /// @param wall 墙钟时间，单位秒
+    /// @param cpu CPU时间，单位秒
+    /// @param allocs 分配次数
+    /// @param allocBytes 分配的字节数
+    ///
+    void addPhase(const char * phase, double wall, double cpu, int64_t allocs = 0, int64_t allocBytes = 0);
+
+    ///
+    /// @brief 累计一个函数的时间
+    /// @param function 函数名
+    /// @param wall 墙钟时间，单位秒
+    ///
+    void addFunction(const std::string & function, double wall);
+
+    ///
+    /// @brief 结束统计，以表格形式输出报告
+    /// @param fp 输出的文件，一般为标准错误
+    ///
+    void print(FILE * fp);
+
+    ///
+    /// @brief 结束统计，以JSON格式输出报告
+    /// @param path 输出文件
+    /// @return true：成功，false：失败
+    ///
+    bool writeJSON(const std::string & path);
+
+    ///
+    /// @brief 获取CPU时间
+    /// @param clock 统计范围
+    /// @return double CPU时间，单位秒
+    ///
+    static double cpuTime(CpuClock clock);
+
+    ///
+    /// @brief 获取分配计数
+    /// @param clock 统计范围
+    /// @return AllocCounter::Count 计数
+    ///
+    static AllocCounter::Count allocCount(CpuClock clock);
+
+    ///
+    /// @brief 获取进程的峰值常驻内存
+    /// @return int64_t 单位KB，不支持时为0
+    ///
+    static int64_t peakRSS();
+
+    /// @brief 报告中列出的最慢的函数个数
+    static constexpr size_t TOP_FUNCTIONS = 10;
+
+protected:
+    ///
+    /// @brief 一个阶段的统计
+    ///
+    struct Phase {
+        /// @brief 阶段名
+        std::string name;
+
+        /// @brief 进入的次数
+        int64_t count = 0;
+
+        /// @brief 墙钟时间，单位秒
+        double wall = 0;
+
+        /// @brief CPU时间，单位秒
+        double cpu = 0;
+
+        /// @brief 分配次数
+        int64_t allocs = 0;
+
+        /// @brief 分配的字节数
+        int64_t allocBytes = 0;
+
+        /// @brief 阶段结束时进程的峰值常驻内存，单位KB
+        int64_t peakRSS = 0;
+    };
+
+    ///
+    /// @brief 一个函数的统计
+    ///
+    struct FunctionTime {
+        /// @brief 函数名
+        std::string name;
+
+        /// @brief 墙钟时间，单位秒
+        double wall = 0;
+    };
+
+    ///
+    /// @brief 结束总时间的统计，并把函数按耗时由大到小排序
+    ///
+    void finish();
+
+private:
+    /// @brief 被编译的源文件
+    std::string inputFile;
+
+    /// @brief 保护以下统计，以函数为单位的阶段在多个线程中累计
+    std::mutex lock;
+
+    /// @brief 各阶段，按第一次出现的先后次序
+    std::vector<Phase> phases;
+
+    /// @brief 各函数
+    std::vector<FunctionTime> functions;
+
+    /// @brief 函数名-在functions中的下标
+    std::unordered_map<std::string, size_t> functionIndex;
+
+    /// @brief 整个编译的统计
+    Phase total;
+
+    /// @brief 开始时的墙钟时间
+    std::chrono::steady_clock::time_point wallStart;
+
+    /// @brief 开始时的进程CPU时间
+    double cpuStart;
+
+    /// @brief 开始时的进程分配计数
+    AllocCounter::Count allocStart;
+};